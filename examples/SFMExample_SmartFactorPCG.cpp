@@ -96,6 +96,9 @@ int main(int argc, char* argv[]) {
       boost::make_shared<PCGSolverParameters>();
   pcg->preconditioner_ =
       boost::make_shared<BlockJacobiPreconditionerParameters>();
+  // Alternatively, IncompleteCholeskyPreconditionerParameters (IC(0)/ICT) or
+  // ClusterJacobiPreconditionerParameters usually need fewer PCG iterations,
+  // see "timeSFMBAL --pcg" for a comparison on BAL problems.
   // Following is crucial:
   pcg->setEpsilon_abs(1e-10);
   pcg->setEpsilon_rel(1e-10);
@@ -0,0 +1,66 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file   MappedFile.cpp
+ * @brief  Read-only view of a whole file, memory-mapped where possible
+ * @date   October 2026
+ */
+
+#include <gtsam/base/MappedFile.h>
+
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+namespace gtsam {
+
+/* ************************************************************************* */
+MappedFile::MappedFile(const string& filename) {
+#ifndef _WIN32
+  const int fd = ::open(filename.c_str(), O_RDONLY);
+  if (fd < 0)
+    throw invalid_argument("MappedFile: can not open file " + filename);
+  struct stat st;
+  if (::fstat(fd, &st) == 0 && st.st_size > 0) {
+    void* data = ::mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (data != MAP_FAILED) {
+      mapped_ = static_cast<const char*>(data);
+      size_ = st.st_size;
+    }
+  }
+  ::close(fd);
+  if (mapped_) return;
+#endif
+  ifstream is(filename.c_str(), ios::binary);
+  if (!is)
+    throw invalid_argument("MappedFile: can not open file " + filename);
+  buffer_.assign(istreambuf_iterator<char>(is), istreambuf_iterator<char>());
+  size_ = buffer_.size();
+}
+
+/* ************************************************************************* */
+MappedFile::~MappedFile() {
+#ifndef _WIN32
+  if (mapped_) ::munmap(const_cast<char*>(mapped_), size_);
+#endif
+}
+
+}  // namespace gtsam
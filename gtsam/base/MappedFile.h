@@ -0,0 +1,62 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file   MappedFile.h
+ * @brief  Read-only view of a whole file, memory-mapped where possible
+ * @date   October 2026
+ */
+
+#pragma once
+
+#include <gtsam/dllexport.h>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace gtsam {
+
+/**
+ * Read-only view of the contents of a file. On POSIX systems the file is
+ * mapped into memory, so opening it costs nothing until pages are touched;
+ * elsewhere, or if mapping fails, the file is read into a buffer.
+ * The view stays valid for the lifetime of the MappedFile.
+ */
+class GTSAM_EXPORT MappedFile {
+ public:
+  /// Map filename, throws std::invalid_argument if it can not be opened
+  explicit MappedFile(const std::string& filename);
+
+  ~MappedFile();
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  /// First byte of the file
+  const char* begin() const { return mapped_ ? mapped_ : buffer_.data(); }
+
+  /// One past the last byte of the file
+  const char* end() const { return begin() + size_; }
+
+  /// Size of the file in bytes
+  size_t size() const { return size_; }
+
+  /// True if the contents are memory-mapped rather than copied
+  bool isMapped() const { return mapped_ != nullptr; }
+
+ private:
+  const char* mapped_ = nullptr;
+  size_t size_ = 0;
+  std::vector<char> buffer_;
+};
+
+}  // namespace gtsam
@@ -69,6 +69,11 @@ GTSAM_MAKE_MATRIX_DEFS(7);
 GTSAM_MAKE_MATRIX_DEFS(8);
 GTSAM_MAKE_MATRIX_DEFS(9);
 
+// Matrices with a fixed number of rows and one column per element, e.g., of
+// tangent vectors processed in a batch
+typedef Eigen::Matrix<double, 3, Eigen::Dynamic> Matrix3X;
+typedef Eigen::Matrix<double, 6, Eigen::Dynamic> Matrix6X;
+
 // Matrix expressions for accessing parts of matrices
 typedef Eigen::Block<Matrix> SubMatrix;
 typedef Eigen::Block<const Matrix> ConstSubMatrix;
@@ -0,0 +1,130 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file   Metrics.cpp
+ * @brief  Machine-readable performance counters reported by the solvers
+ * @date   October 2026
+ */
+
+#include <gtsam/base/Metrics.h>
+
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <stdexcept>
+
+namespace gtsam {
+
+namespace {
+// The owning pointer is only touched by setMetricsSink, reporting sites read
+// the raw pointer.
+boost::shared_ptr<MetricsSink> gSinkOwner;
+std::atomic<MetricsSink*> gSink(nullptr);
+std::mutex gSinkMutex;
+
+// Enough digits to read back the same double
+std::string formatValue(double value) {
+  char buffer[32];
+  std::snprintf(buffer, sizeof(buffer), "%.17g", value);
+  return buffer;
+}
+
+// Escape the characters that can not appear verbatim in a JSON string
+std::string jsonString(const std::string& s) {
+  std::string result = "\"";
+  for (char c : s) {
+    if (c == '"' || c == '\\') {
+      result += '\\';
+      result += c;
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      char buffer[8];
+      std::snprintf(buffer, sizeof(buffer), "\\u%04x", c);
+      result += buffer;
+    } else {
+      result += c;
+    }
+  }
+  return result + '"';
+}
+
+// Quote a CSV field if it contains a separator, quote or newline
+std::string csvField(const std::string& s) {
+  if (s.find_first_of(",\"\n") == std::string::npos) return s;
+  std::string result = "\"";
+  for (char c : s) {
+    if (c == '"') result += '"';
+    result += c;
+  }
+  return result + '"';
+}
+
+std::ostream* openFile(std::ofstream& file, const std::string& filename) {
+  file.open(filename.c_str());
+  if (!file)
+    throw std::invalid_argument("Metrics: can not open " + filename);
+  return &file;
+}
+}  // namespace
+
+/* ************************************************************************* */
+void setMetricsSink(const boost::shared_ptr<MetricsSink>& sink) {
+  std::lock_guard<std::mutex> lock(gSinkMutex);
+  if (gSinkOwner) gSinkOwner->flush();
+  gSink = sink.get();
+  gSinkOwner = sink;
+}
+
+/* ************************************************************************* */
+MetricsSink* metricsSink() { return gSink.load(std::memory_order_acquire); }
+
+/* ************************************************************************* */
+JsonMetricsSink::JsonMetricsSink(const std::string& filename)
+    : os_(openFile(file_, filename)) {}
+
+void JsonMetricsSink::record(const std::string& source, size_t iteration,
+                             const std::string& metric, double value) {
+  // JSON has no literals for infinity and NaN
+  const std::string text = std::isfinite(value) ? formatValue(value) : "null";
+  std::lock_guard<std::mutex> lock(mutex_);
+  *os_ << "{\"source\":" << jsonString(source) << ",\"iteration\":" << iteration
+       << ",\"metric\":" << jsonString(metric) << ",\"value\":" << text << "}\n";
+}
+
+void JsonMetricsSink::flush() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  os_->flush();
+}
+
+/* ************************************************************************* */
+CsvMetricsSink::CsvMetricsSink(std::ostream& os) : os_(&os) {
+  *os_ << "source,iteration,metric,value\n";
+}
+
+CsvMetricsSink::CsvMetricsSink(const std::string& filename)
+    : os_(openFile(file_, filename)) {
+  *os_ << "source,iteration,metric,value\n";
+}
+
+void CsvMetricsSink::record(const std::string& source, size_t iteration,
+                            const std::string& metric, double value) {
+  const std::string text = formatValue(value);
+  std::lock_guard<std::mutex> lock(mutex_);
+  *os_ << csvField(source) << ',' << iteration << ',' << csvField(metric)
+       << ',' << text << '\n';
+}
+
+void CsvMetricsSink::flush() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  os_->flush();
+}
+
+}  // namespace gtsam
@@ -0,0 +1,145 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file   Metrics.h
+ * @brief  Machine-readable performance counters reported by the solvers
+ * @date   October 2026
+ */
+
+#pragma once
+
+#include <gtsam/dllexport.h>
+
+#include <boost/shared_ptr.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <fstream>
+#include <mutex>
+#include <ostream>
+#include <string>
+
+namespace gtsam {
+
+/**
+ * Receiver of performance counters. Once a sink is installed with
+ * setMetricsSink, the nonlinear optimizers, ISAM2 and the elimination of
+ * cluster trees report one record per measured quantity, e.g.
+ *   ("LevenbergMarquardtOptimizer", 3, "solve_seconds", 0.012)
+ * The iteration is the optimizer iteration or ISAM2 update count, and 0 for
+ * sources that do not iterate. Records may arrive from several threads.
+ * Without a sink, each reporting site costs a single pointer load.
+ */
+class GTSAM_EXPORT MetricsSink {
+ public:
+  virtual ~MetricsSink() {}
+
+  /// Receive one value, must be thread-safe
+  virtual void record(const std::string& source, size_t iteration,
+                      const std::string& metric, double value) = 0;
+
+  /// Write out buffered records
+  virtual void flush() {}
+};
+
+/**
+ * Install the sink all solvers report into, or remove it with a null pointer.
+ * Set the sink before starting solvers: replacing it while they run is not
+ * safe.
+ */
+GTSAM_EXPORT void setMetricsSink(const boost::shared_ptr<MetricsSink>& sink);
+
+/// The installed sink, or nullptr if there is none
+GTSAM_EXPORT MetricsSink* metricsSink();
+
+/// Report a value to the installed sink, if any
+inline void recordMetric(const char* source, size_t iteration,
+                         const char* metric, double value) {
+  if (MetricsSink* sink = metricsSink())
+    sink->record(source, iteration, metric, value);
+}
+
+/// Reports the wall-clock seconds spent in its scope to the installed sink
+class MetricsTimer {
+ public:
+  MetricsTimer(const char* source, size_t iteration, const char* metric)
+      : sink_(metricsSink()),
+        source_(source),
+        metric_(metric),
+        iteration_(iteration) {
+    if (sink_) start_ = std::chrono::steady_clock::now();
+  }
+
+  ~MetricsTimer() { stop(); }
+
+  /// Report the time so far, the end of the scope then reports nothing
+  void stop() {
+    if (sink_)
+      sink_->record(source_, iteration_, metric_,
+                    std::chrono::duration<double>(
+                        std::chrono::steady_clock::now() - start_).count());
+    sink_ = nullptr;
+  }
+
+  MetricsTimer(const MetricsTimer&) = delete;
+  MetricsTimer& operator=(const MetricsTimer&) = delete;
+
+ private:
+  MetricsSink* sink_;
+  const char* source_;
+  const char* metric_;
+  size_t iteration_;
+  std::chrono::steady_clock::time_point start_;
+};
+
+/**
+ * Writes each record as one JSON object per line (JSON Lines), e.g.
+ *   {"source":"ISAM2","iteration":12,"metric":"cliques","value":840}
+ */
+class GTSAM_EXPORT JsonMetricsSink : public MetricsSink {
+ public:
+  /// Write to os, which must outlive the sink
+  explicit JsonMetricsSink(std::ostream& os) : os_(&os) {}
+
+  /// Write to a new file, throws std::invalid_argument if it can not be opened
+  explicit JsonMetricsSink(const std::string& filename);
+
+  void record(const std::string& source, size_t iteration,
+              const std::string& metric, double value) override;
+  void flush() override;
+
+ private:
+  std::ofstream file_;
+  std::ostream* os_;
+  std::mutex mutex_;
+};
+
+/// Writes records as CSV with the header "source,iteration,metric,value"
+class GTSAM_EXPORT CsvMetricsSink : public MetricsSink {
+ public:
+  /// Write to os, which must outlive the sink
+  explicit CsvMetricsSink(std::ostream& os);
+
+  /// Write to a new file, throws std::invalid_argument if it can not be opened
+  explicit CsvMetricsSink(const std::string& filename);
+
+  void record(const std::string& source, size_t iteration,
+              const std::string& metric, double value) override;
+  void flush() override;
+
+ private:
+  std::ofstream file_;
+  std::ostream* os_;
+  std::mutex mutex_;
+};
+
+}  // namespace gtsam
@@ -0,0 +1,49 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file   parallelFor.h
+ * @brief  Simple parallel loop over an index range, serial without TBB
+ * @date   October 2026
+ */
+
+#pragma once
+
+#include <gtsam/config.h> // for GTSAM_USE_TBB
+
+#ifdef GTSAM_USE_TBB
+#  include <tbb/blocked_range.h>
+#  include <tbb/parallel_for.h>
+#endif
+
+#include <cstddef>
+
+namespace gtsam {
+
+/**
+ * Call body(i) for all i in [0,n). With TBB the calls are distributed over
+ * the TBB worker threads, so body must be safe to call concurrently for
+ * different i. Without TBB this is a plain loop.
+ */
+template <typename BODY>
+void parallelFor(size_t n, const BODY& body) {
+#ifdef GTSAM_USE_TBB
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, n),
+                    [&body](const tbb::blocked_range<size_t>& range) {
+                      for (size_t i = range.begin(); i != range.end(); ++i)
+                        body(i);
+                    });
+#else
+  for (size_t i = 0; i < n; ++i) body(i);
+#endif
+}
+
+}  // namespace gtsam
@@ -0,0 +1,83 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    testMetrics.cpp
+ * @brief   Unit tests for the metrics sinks
+ * @date    October 2026
+ */
+
+#include <gtsam/base/Metrics.h>
+
+#include <CppUnitLite/TestHarness.h>
+
+#include <boost/make_shared.hpp>
+
+#include <limits>
+#include <sstream>
+
+using namespace std;
+using namespace gtsam;
+
+/* ************************************************************************* */
+TEST(Metrics, json) {
+  stringstream ss;
+  JsonMetricsSink sink(ss);
+  sink.record("LM", 3, "solve_seconds", 0.25);
+  sink.record("a\"b", 0, "error", numeric_limits<double>::infinity());
+  EXPECT(ss.str() ==
+         "{\"source\":\"LM\",\"iteration\":3,\"metric\":\"solve_seconds\","
+         "\"value\":0.25}\n"
+         "{\"source\":\"a\\\"b\",\"iteration\":0,\"metric\":\"error\","
+         "\"value\":null}\n");
+}
+
+/* ************************************************************************* */
+TEST(Metrics, csv) {
+  stringstream ss;
+  CsvMetricsSink sink(ss);
+  sink.record("ISAM2", 12, "cliques", 840);
+  sink.record("a,b", 1, "error", 0.1);
+  EXPECT(ss.str() ==
+         "source,iteration,metric,value\n"
+         "ISAM2,12,cliques,840\n"
+         "\"a,b\",1,error,0.10000000000000001\n");
+}
+
+/* ************************************************************************* */
+TEST(Metrics, timer) {
+  stringstream ss;
+  setMetricsSink(boost::make_shared<CsvMetricsSink>(ss));
+  EXPECT(metricsSink() != nullptr);
+  {
+    MetricsTimer timer("test", 1, "scope_seconds");
+    timer.stop();
+  }  // stopped timers report only once
+  recordMetric("test", 2, "count", 5);
+  setMetricsSink(nullptr);
+  EXPECT(metricsSink() == nullptr);
+  recordMetric("test", 3, "count", 6);  // dropped
+
+  string header, line1, line2, extra;
+  getline(ss, header);
+  getline(ss, line1);
+  getline(ss, line2);
+  EXPECT(line1.find("test,1,scope_seconds,") == 0);
+  EXPECT(line2 == "test,2,count,5");
+  EXPECT(!getline(ss, extra));
+}
+
+/* ************************************************************************* */
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
+/* ************************************************************************* */
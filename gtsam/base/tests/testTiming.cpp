@@ -0,0 +1,112 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    testTiming.cpp
+ * @brief   Unit tests for the tic/toc timing library
+ * @date    October 2026
+ */
+
+#include <gtsam/base/timing.h>
+
+#include <CppUnitLite/TestHarness.h>
+
+#include <boost/filesystem/operations.hpp>
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace gtsam;
+
+namespace {
+void timedWork(size_t n) {
+  for (size_t i = 0; i < n; i++) {
+    gttic_(outer);
+    gttic_(inner);
+  }
+}
+}  // namespace
+
+/* ************************************************************************* */
+TEST(Timing, nested) {
+  tictoc_reset_();
+  timedWork(5);
+  tictoc_getNode(outerNode, outer);
+  EXPECT(outerNode->secs() > 0);
+  // The self time of outer includes the time of its child inner
+  EXPECT(outerNode->self() >= outerNode->secs());
+
+  // Mismatched toc
+  {
+    gttic_(a);
+    gttic_(b);
+    CHECK_EXCEPTION(gttoc_(a), std::invalid_argument);
+    gttoc_(b);
+  }
+}
+
+/* ************************************************************************* */
+TEST(Timing, threads) {
+  tictoc_reset_();
+  const size_t nrThreads = 4, n = 100;
+  vector<thread> threads;
+  for (size_t t = 0; t < nrThreads; t++)
+    threads.emplace_back([&] { timedWork(n); });
+  for (thread& t : threads) t.join();
+  timedWork(n);
+
+  // All threads end up in one outline, with every call counted once
+  const auto merged = internal::mergedTimings();
+  stringstream ss;
+  streambuf* cout_buf = cout.rdbuf(ss.rdbuf());
+  merged->print();
+  cout.rdbuf(cout_buf);
+  const string printed = ss.str();
+  EXPECT(printed.find("-outer: ") != string::npos);
+  EXPECT(printed.find("(500 times") != string::npos);
+  EXPECT(printed.find("|   |   -inner: ") != string::npos);
+}
+
+/* ************************************************************************* */
+TEST(Timing, trace) {
+  tictoc_reset_();
+  tictoc_enableTrace_();
+  thread worker([] { timedWork(2); });
+  worker.join();
+  timedWork(1);
+  tictoc_enableTrace_(false);
+  timedWork(1);  // not recorded
+
+  const string filename =
+      (boost::filesystem::temp_directory_path() / "testTiming.json").string();
+  tictoc_saveTrace_(filename);
+  ifstream is(filename.c_str());
+  const string json((istreambuf_iterator<char>(is)), istreambuf_iterator<char>());
+  size_t nrEvents = 0;
+  for (size_t pos = json.find("\"ph\":\"X\""); pos != string::npos;
+       pos = json.find("\"ph\":\"X\"", pos + 1))
+    nrEvents++;
+  EXPECT_LONGS_EQUAL(6, nrEvents);
+  EXPECT(json.find("{\"traceEvents\":[") == 0);
+  EXPECT(json.find("\"name\":\"inner\"") != string::npos);
+  boost::filesystem::remove(filename);
+}
+
+/* ************************************************************************* */
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
+/* ************************************************************************* */
@@ -22,32 +22,105 @@
 #include <boost/algorithm/string/replace.hpp>
 #include <boost/format.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <cmath>
 #include <cstddef>
+#include <cstdio>
 #include <cassert>
+#include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <limits>
 #include <map>
+#include <mutex>
 #include <stdexcept>
 #include <utility>
+#include <vector>
 
 namespace gtsam {
 namespace internal {
 
-GTSAM_EXPORT boost::shared_ptr<TimingOutline> gTimingRoot(
-    new TimingOutline("Total", getTicTocID("Total")));
-GTSAM_EXPORT boost::weak_ptr<TimingOutline> gCurrentTimer(gTimingRoot);
+namespace {
+
+// Nanoseconds on the steady clock, which is far cheaper to read than CPU time
+int64_t now() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// A timed section, recorded while tracing is enabled
+struct TraceEvent {
+  size_t id;
+  int64_t start, duration;
+};
+
+// The timing tree of one thread. These are never freed, so that the timings
+// of threads which have finished can still be printed.
+struct ThreadTimings {
+  boost::shared_ptr<TimingOutline> root;
+  TimingOutline* current;
+  size_t index;
+  std::vector<TraceEvent> trace;
+  ThreadTimings* next;
+};
+
+// Lock-free list of the timing trees of all threads, newest first
+std::atomic<ThreadTimings*> gThreads(nullptr);
+std::atomic<size_t> gNrThreads(0);
+std::atomic<bool> gTracing(false);
+thread_local ThreadTimings* tThreadTimings = nullptr;
+
+ThreadTimings* registerThread() {
+  ThreadTimings* timings = new ThreadTimings;
+  timings->root.reset(new TimingOutline("Total", getTicTocID("Total")));
+  timings->current = timings->root.get();
+  timings->index = gNrThreads++;
+  timings->next = gThreads.load();
+  while (!gThreads.compare_exchange_weak(timings->next, timings)) {
+  }
+  return timings;
+}
+
+inline ThreadTimings& threadTimings() {
+  if (!tThreadTimings) tThreadTimings = registerThread();
+  return *tThreadTimings;
+}
+
+// The timing trees of all threads, in the order the threads started timing
+std::vector<ThreadTimings*> allThreads() {
+  std::vector<ThreadTimings*> threads;
+  for (ThreadTimings* t = gThreads.load(); t; t = t->next) threads.push_back(t);
+  std::reverse(threads.begin(), threads.end());
+  return threads;
+}
+
+// Map from labels to ID numbers and back, built on first use as sections may
+// be reached during static initialization, or from several threads at once
+struct TicTocIDs {
+  std::mutex mutex;
+  gtsam::FastMap<std::string, size_t> ids;
+  std::vector<std::string> labels;
+};
+
+TicTocIDs& ticTocIDs() {
+  static TicTocIDs ticTocIDs;
+  return ticTocIDs;
+}
+
+}  // namespace
 
 /* ************************************************************************* */
 // Implementation of TimingOutline
 /* ************************************************************************* */
 
 /* ************************************************************************* */
-void TimingOutline::add(size_t usecs, size_t usecsWall) {
-  t_ += usecs;
-  tWall_ += usecsWall;
-  tIt_ += usecs;
-  double secs = (double(usecs) / 1000000.0);
+void TimingOutline::add(size_t nsecs, size_t nsecsWall) {
+  t_ += nsecs;
+  tWall_ += nsecsWall;
+  tIt_ += nsecs;
+  double secs = (double(nsecs) / 1e9);
   t2_ += secs * secs;
   ++n_;
 }
@@ -55,10 +128,8 @@ void TimingOutline::add(size_t usecs, size_t usecsWall) {
 /* ************************************************************************* */
 TimingOutline::TimingOutline(const std::string& label, size_t id) :
     id_(id), t_(0), tWall_(0), t2_(0.0), tIt_(0), tMax_(0), tMin_(0), n_(0), myOrder_(
-        0), lastChildOrder_(0), label_(label) {
-#ifdef GTSAM_USING_NEW_BOOST_TIMERS
-  timer_.stop();
-#endif
+        0), lastChildOrder_(0), label_(label), parent_(nullptr), lastChild_(
+        nullptr), start_(-1) {
 }
 
 /* ************************************************************************* */
@@ -79,9 +150,9 @@ size_t TimingOutline::time() const {
 void TimingOutline::print(const std::string& outline) const {
   std::string formattedLabel = label_;
   boost::replace_all(formattedLabel, "_", " ");
-  std::cout << outline << "-" << formattedLabel << ": " << self() << " CPU ("
-      << n_ << " times, " << wall() << " wall, " << secs() << " children, min: "
-      << min() << " max: " << max() << ")\n";
+  std::cout << outline << "-" << formattedLabel << ": " << self()
+      << " thread (" << n_ << " times, " << wall() << " wall, " << secs()
+      << " children, min: " << min() << " max: " << max() << ")\n";
   // Order children
   typedef FastMap<size_t, boost::shared_ptr<TimingOutline> > ChildOrder;
   ChildOrder childOrder;
@@ -141,65 +212,41 @@ void TimingOutline::print2(const std::string& outline,
 }
 
 /* ************************************************************************* */
-const boost::shared_ptr<TimingOutline>& TimingOutline::child(size_t child,
-    const std::string& label, const boost::weak_ptr<TimingOutline>& thisPtr) {
-  assert(thisPtr.lock().get() == this);
+TimingOutline* TimingOutline::child(size_t child, const char* label) {
+  if (lastChild_ && lastChild_->id_ == child)
+    return lastChild_;
   boost::shared_ptr<TimingOutline>& result = children_[child];
   if (!result) {
     // Create child if necessary
     result.reset(new TimingOutline(label, child));
     ++this->lastChildOrder_;
     result->myOrder_ = this->lastChildOrder_;
-    result->parent_ = thisPtr;
+    result->parent_ = this;
   }
-  return result;
+  lastChild_ = result.get();
+  return lastChild_;
+}
+
+/* ************************************************************************* */
+const boost::shared_ptr<TimingOutline>& TimingOutline::child(size_t child,
+    const std::string& label) {
+  this->child(child, label.c_str());
+  return children_[child];
 }
 
 /* ************************************************************************* */
 void TimingOutline::tic() {
-#ifdef GTSAM_USING_NEW_BOOST_TIMERS
-  assert(timer_.is_stopped());
-  timer_.start();
-#else
-  assert(!timerActive_);
-  timer_.restart();
-  *timerActive_ = true;
-#endif
-
-#ifdef GTSAM_USE_TBB
-  tbbTimer_ = tbb::tick_count::now();
-#endif
+  assert(start_ < 0);
+  start_ = now();
 }
 
 /* ************************************************************************* */
-void TimingOutline::toc() {
-#ifdef GTSAM_USING_NEW_BOOST_TIMERS
-
-  assert(!timer_.is_stopped());
-  timer_.stop();
-  size_t cpuTime = (timer_.elapsed().user + timer_.elapsed().system) / 1000;
-#  ifndef GTSAM_USE_TBB
-  size_t wallTime = timer_.elapsed().wall / 1000;
-#  endif
-
-#else
-
-  assert(timerActive_);
-  double elapsed = timer_.elapsed();
-  size_t cpuTime = size_t(elapsed * 1000000.0);
-  *timerActive_ = false;
-#  ifndef GTSAM_USE_TBB
-  size_t wallTime = cpuTime;
-#  endif
-
-#endif
-
-#ifdef GTSAM_USE_TBB
-  size_t wallTime = size_t(
-      (tbb::tick_count::now() - tbbTimer_).seconds() * 1e6);
-#endif
-
-  add(cpuTime, wallTime);
+size_t TimingOutline::toc() {
+  assert(start_ >= 0);
+  const size_t elapsed = size_t(now() - start_);
+  start_ = -1;
+  add(elapsed, elapsed);
+  return elapsed;
 }
 
 /* ************************************************************************* */
@@ -214,19 +261,38 @@ void TimingOutline::finishedIteration() {
   }
 }
 
+/* ************************************************************************* */
+void TimingOutline::merge(const TimingOutline& other) {
+  t_ += other.t_;
+  tWall_ = std::max(tWall_, other.tWall_);
+  t2_ += other.t2_;
+  tIt_ += other.tIt_;
+  tMax_ = std::max(tMax_, other.tMax_);
+  if (tMin_ == 0 || (other.tMin_ != 0 && other.tMin_ < tMin_))
+    tMin_ = other.tMin_;
+  n_ += other.n_;
+  // Children in the order they were first timed in the other tree
+  std::map<size_t, const TimingOutline*> childOrder;
+  for(const ChildMap::value_type& child: other.children_)
+    childOrder[child.second->myOrder_] = child.second.get();
+  for(const auto& order_child: childOrder) {
+    const TimingOutline& otherChild = *order_child.second;
+    child(otherChild.id_, otherChild.label_.c_str())->merge(otherChild);
+  }
+}
+
 /* ************************************************************************* */
 size_t getTicTocID(const char *descriptionC) {
   const std::string description(descriptionC);
-  // Global (static) map from strings to ID numbers and current next ID number
-  static size_t nextId = 0;
-  static gtsam::FastMap<std::string, size_t> idMap;
+  TicTocIDs& table = ticTocIDs();
+  std::lock_guard<std::mutex> lock(table.mutex);
 
   // Retrieve or add this string
-  gtsam::FastMap<std::string, size_t>::const_iterator it = idMap.find(
+  gtsam::FastMap<std::string, size_t>::const_iterator it = table.ids.find(
       description);
-  if (it == idMap.end()) {
-    it = idMap.insert(std::make_pair(description, nextId)).first;
-    ++nextId;
+  if (it == table.ids.end()) {
+    it = table.ids.insert(std::make_pair(description, table.labels.size())).first;
+    table.labels.push_back(description);
   }
 
   // Return ID
@@ -235,32 +301,107 @@ size_t getTicTocID(const char *descriptionC) {
 
 /* ************************************************************************* */
 void tic(size_t id, const char *labelC) {
-  const std::string label(labelC);
-  boost::shared_ptr<TimingOutline> node = //
-      gCurrentTimer.lock()->child(id, label, gCurrentTimer);
-  gCurrentTimer = node;
+  ThreadTimings& timings = threadTimings();
+  TimingOutline* node = timings.current->child(id, labelC);
+  timings.current = node;
   node->tic();
 }
 
 /* ************************************************************************* */
 void toc(size_t id, const char *label) {
-  boost::shared_ptr<TimingOutline> current(gCurrentTimer.lock());
+  ThreadTimings& timings = threadTimings();
+  TimingOutline* current = timings.current;
   if (id != current->id_) {
-    gTimingRoot->print();
+    timings.root->print();
     throw std::invalid_argument(
         (boost::format(
             "gtsam timing:  Mismatched tic/toc: gttoc(\"%s\") called when last tic was \"%s\".")
             % label % current->label_).str());
   }
-  if (!current->parent_.lock()) {
-    gTimingRoot->print();
+  if (!current->parent_) {
+    timings.root->print();
     throw std::invalid_argument(
         (boost::format(
             "gtsam timing:  Mismatched tic/toc: extra gttoc(\"%s\"), already at the root")
             % label).str());
   }
-  current->toc();
-  gCurrentTimer = current->parent_;
+  const int64_t start = current->start_;
+  const size_t elapsed = current->toc();
+  if (gTracing.load(std::memory_order_relaxed))
+    timings.trace.push_back(TraceEvent{id, start, int64_t(elapsed)});
+  timings.current = current->parent_;
+}
+
+/* ************************************************************************* */
+TimingOutline* currentTimer() {
+  return threadTimings().current;
+}
+
+/* ************************************************************************* */
+boost::shared_ptr<TimingOutline> mergedTimings() {
+  boost::shared_ptr<TimingOutline> merged(
+      new TimingOutline("Total", getTicTocID("Total")));
+  for (const ThreadTimings* timings : allThreads())
+    merged->merge(*timings->root);
+  return merged;
+}
+
+/* ************************************************************************* */
+void finishedIteration() {
+  for (ThreadTimings* timings : allThreads())
+    timings->root->finishedIteration();
+}
+
+/* ************************************************************************* */
+void resetTimings() {
+  for (ThreadTimings* timings : allThreads()) {
+    timings->root.reset(new TimingOutline("Total", getTicTocID("Total")));
+    timings->current = timings->root.get();
+    timings->trace.clear();
+  }
+}
+
+/* ************************************************************************* */
+void enableTrace(bool enable) {
+  gTracing = enable;
+}
+
+/* ************************************************************************* */
+void saveTrace(const std::string& filename) {
+  std::ofstream os(filename.c_str());
+  if (!os)
+    throw std::invalid_argument("saveTrace: can not open " + filename);
+  std::vector<std::string> labels;
+  {
+    std::lock_guard<std::mutex> lock(ticTocIDs().mutex);
+    labels = ticTocIDs().labels;
+  }
+  const std::vector<ThreadTimings*> threads = allThreads();
+  int64_t origin = std::numeric_limits<int64_t>::max();
+  for (const ThreadTimings* timings : threads)
+    for (const TraceEvent& event : timings->trace)
+      origin = std::min(origin, event.start);
+
+  // Complete ("X") events, with timestamps in microseconds
+  os << "{\"traceEvents\":[";
+  bool first = true;
+  char buffer[64];
+  for (const ThreadTimings* timings : threads) {
+    for (const TraceEvent& event : timings->trace) {
+      std::string name = labels[event.id];
+      boost::replace_all(name, "\\", "\\\\");
+      boost::replace_all(name, "\"", "\\\"");
+      snprintf(buffer, sizeof(buffer), "\"ts\":%.3f,\"dur\":%.3f",
+               1e-3 * double(event.start - origin), 1e-3 * double(event.duration));
+      os << (first ? "\n" : ",\n") << "{\"name\":\"" << name
+         << "\",\"ph\":\"X\"," << buffer << ",\"pid\":0,\"tid\":"
+         << timings->index << "}";
+      first = false;
+    }
+  }
+  os << "\n],\"displayTimeUnit\":\"ms\"}\n";
+  if (!os)
+    throw std::runtime_error("saveTrace: error writing " + filename);
 }
 
 } // namespace internal
@@ -26,11 +26,13 @@
 #include <boost/version.hpp>
 
 #include <cstddef>
+#include <cstdint>
 #include <string>
 
 // This file contains the GTSAM timing instrumentation library, a low-overhead method for
-// learning at a medium-fine level how much time various components of an algorithm take
-// in CPU and wall time.
+// learning at a medium-fine level how much time various components of an algorithm take.
+// The "thread" time printed for a section is the steady-clock time spent in it, summed
+// over all threads that ran it, next to the wall time of the section.
 //
 // The output of this instrumentation is a call-tree-like printout containing statistics
 // about each instrumented code block.  To print this output at any time, call
@@ -133,20 +135,21 @@ namespace gtsam {
     // Generate/retrieve a unique global ID number that will be used to look up tic/toc statements
     GTSAM_EXPORT size_t getTicTocID(const char *description);
 
-    // Create new TimingOutline child for gCurrentTimer, make it gCurrentTimer, and call tic method
+    // Create new TimingOutline child for the current timer of this thread, make it current, and call tic method
     GTSAM_EXPORT void tic(size_t id, const char *label);
 
-    // Call toc on gCurrentTimer and then set gCurrentTimer to the parent of gCurrentTimer
+    // Call toc on the current timer of this thread and then make its parent current
     GTSAM_EXPORT void toc(size_t id, const char *label);
 
     /**
-     * Timing Entry, arranged in a tree
+     * Timing Entry, arranged in a tree. Every thread times into its own tree,
+     * and the trees of all threads are merged when printing.
      */
     class TimingOutline {
     protected:
       size_t id_;
-      size_t t_;
-      size_t tWall_;
+      size_t t_;      ///< self time of all calls, in nanoseconds
+      size_t tWall_;  ///< wall time of all calls, in nanoseconds
       double t2_ ; ///< cache the \sum t_i^2
       size_t tIt_;
       size_t tMax_;
@@ -157,39 +160,39 @@ namespace gtsam {
       std::string label_;
 
       // Tree structure
-      boost::weak_ptr<TimingOutline> parent_; ///< parent pointer
+      TimingOutline* parent_; ///< parent pointer, null for the root
       typedef FastMap<size_t, boost::shared_ptr<TimingOutline> > ChildMap;
       ChildMap children_; ///< subtrees
+      TimingOutline* lastChild_; ///< last child returned, as tics usually repeat
 
-#ifdef GTSAM_USING_NEW_BOOST_TIMERS
-      boost::timer::cpu_timer timer_;
-#else
-      boost::timer timer_;
-      gtsam::ValueWithDefault<bool,false> timerActive_;
-#endif
-#ifdef GTSAM_USE_TBB
-      tbb::tick_count tbbTimer_;
-#endif
-      void add(size_t usecs, size_t usecsWall);
+      int64_t start_; ///< steady clock at the last tic, in nanoseconds
+
+      void add(size_t nsecs, size_t nsecsWall);
+      TimingOutline* child(size_t child, const char* label);
 
     public:
       /// Constructor
       GTSAM_EXPORT TimingOutline(const std::string& label, size_t myId);
-      GTSAM_EXPORT size_t time() const; ///< time taken, including children
-      double secs() const { return double(time()) / 1000000.0;} ///< time taken, in seconds, including children
-      double self() const { return double(t_)     / 1000000.0;} ///< self time only, in seconds
-      double wall() const { return double(tWall_) / 1000000.0;} ///< wall time, in seconds
-      double min()  const { return double(tMin_)  / 1000000.0;} ///< min time, in seconds
-      double max()  const { return double(tMax_)  / 1000000.0;} ///< max time, in seconds
+      GTSAM_EXPORT size_t time() const; ///< time taken in nanoseconds, including children
+      double secs() const { return double(time()) / 1e9;} ///< time taken, in seconds, including children
+      double self() const { return double(t_)     / 1e9;} ///< self time only, in seconds
+      double wall() const { return double(tWall_) / 1e9;} ///< wall time, in seconds
+      double min()  const { return double(tMin_)  / 1e9;} ///< min time, in seconds
+      double max()  const { return double(tMax_)  / 1e9;} ///< max time, in seconds
       double mean() const { return self() / double(n_); } ///< mean self time, in seconds
       GTSAM_EXPORT void print(const std::string& outline = "") const;
       GTSAM_EXPORT void print2(const std::string& outline = "", const double parentTotal = -1.0) const;
       GTSAM_EXPORT const boost::shared_ptr<TimingOutline>&
-        child(size_t child, const std::string& label, const boost::weak_ptr<TimingOutline>& thisPtr);
+        child(size_t child, const std::string& label);
       GTSAM_EXPORT void tic();
-      GTSAM_EXPORT void toc();
+      GTSAM_EXPORT size_t toc(); ///< returns the elapsed time in nanoseconds
       GTSAM_EXPORT void finishedIteration();
 
+      /// Add the timings of another tree into this one, matching children by ID.
+      /// Self times add up, while wall times are the longest of the two.
+      GTSAM_EXPORT void merge(const TimingOutline& other);
+
+      GTSAM_EXPORT friend void tic(size_t id, const char *label);
       GTSAM_EXPORT friend void toc(size_t id, const char *label);
     }; // \TimingOutline
 
@@ -216,8 +219,25 @@ namespace gtsam {
       }
     };
 
-    GTSAM_EXTERN_EXPORT boost::shared_ptr<TimingOutline> gTimingRoot;
-    GTSAM_EXTERN_EXPORT boost::weak_ptr<TimingOutline> gCurrentTimer;
+    /// The timer of the innermost open gttic on the calling thread
+    GTSAM_EXPORT TimingOutline* currentTimer();
+
+    /// The timing trees of all threads merged into one, rooted at "Total".
+    /// Call only while no other thread is inside a timed section.
+    GTSAM_EXPORT boost::shared_ptr<TimingOutline> mergedTimings();
+
+    /// Finish the iteration on the timing trees of all threads
+    GTSAM_EXPORT void finishedIteration();
+
+    /// Clear the timing trees and recorded trace of all threads
+    GTSAM_EXPORT void resetTimings();
+
+    /// Start or stop recording every timed section for a trace
+    GTSAM_EXPORT void enableTrace(bool enable);
+
+    /// Write the recorded sections as a Chrome trace (chrome://tracing or
+    /// https://ui.perfetto.dev), one track per thread
+    GTSAM_EXPORT void saveTrace(const std::string& filename);
   }
 
 // Tic and toc functions that are always active (whether or not ENABLE_TIMING is defined)
@@ -225,6 +245,11 @@ namespace gtsam {
 // static variable is created for each tic/toc statement storing an integer ID, but the
 // integer ID is only looked up by string once when the static variable is initialized
 // as the program starts.
+//
+// Each thread times into its own tree, so gttic can be used inside parallel (e.g., TBB)
+// tasks. The trees are merged by tictoc_print_(), where sections that only ran on worker
+// threads appear at the top level. Printing, resetting and finishing iterations must not
+// overlap with timed sections running on other threads.
 
 // tic
 #define gttic_(label) \
@@ -247,26 +272,36 @@ namespace gtsam {
 
 // indicate iteration is finished
 inline void tictoc_finishedIteration_() {
-  ::gtsam::internal::gTimingRoot->finishedIteration(); }
+  ::gtsam::internal::finishedIteration(); }
 
 // print
 inline void tictoc_print_() {
-  ::gtsam::internal::gTimingRoot->print(); }
+  ::gtsam::internal::mergedTimings()->print(); }
 
 // print mean and standard deviation
 inline void tictoc_print2_() {
-  ::gtsam::internal::gTimingRoot->print2(); }
+  ::gtsam::internal::mergedTimings()->print2(); }
 
 // get a node by label and assign it to variable
 #define tictoc_getNode(variable, label) \
   static const size_t label##_id_getnode = ::gtsam::internal::getTicTocID(#label); \
   const boost::shared_ptr<const ::gtsam::internal::TimingOutline> variable = \
-  ::gtsam::internal::gCurrentTimer.lock()->child(label##_id_getnode, #label, ::gtsam::internal::gCurrentTimer);
+  ::gtsam::internal::currentTimer()->child(label##_id_getnode, std::string(#label));
 
-// reset
+// reset the timings of all threads. The per-thread timing trees themselves are
+// never freed, not even those of threads that have exited, so that their
+// timings can still be printed: a program that keeps creating new threads
+// keeps a small record for every one of them.
 inline void tictoc_reset_() {
-  ::gtsam::internal::gTimingRoot.reset(new ::gtsam::internal::TimingOutline("Total", ::gtsam::internal::getTicTocID("Total")));
-  ::gtsam::internal::gCurrentTimer = ::gtsam::internal::gTimingRoot; }
+  ::gtsam::internal::resetTimings(); }
+
+// record every timed section from now on, for tictoc_saveTrace_
+inline void tictoc_enableTrace_(bool enable = true) {
+  ::gtsam::internal::enableTrace(enable); }
+
+// save the recorded sections as a Chrome trace JSON file
+inline void tictoc_saveTrace_(const std::string& filename) {
+  ::gtsam::internal::saveTrace(filename); }
 
 #ifdef ENABLE_TIMING
 #define gttic(label) gttic_(label)
@@ -276,6 +311,8 @@ inline void tictoc_reset_() {
 #define tictoc_finishedIteration tictoc_finishedIteration_
 #define tictoc_print tictoc_print_
 #define tictoc_reset tictoc_reset_
+#define tictoc_enableTrace tictoc_enableTrace_
+#define tictoc_saveTrace tictoc_saveTrace_
 #else
 #define gttic(label) ((void)0)
 #define gttoc(label) ((void)0)
@@ -284,6 +321,8 @@ inline void tictoc_reset_() {
 #define tictoc_finishedIteration() ((void)0)
 #define tictoc_print() ((void)0)
 #define tictoc_reset() ((void)0)
+#define tictoc_enableTrace(...) ((void)0)
+#define tictoc_saveTrace(filename) ((void)0)
 #endif
 
 }
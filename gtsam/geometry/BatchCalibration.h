@@ -0,0 +1,180 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file   BatchCalibration.h
+ * @brief  Vectorized undistortion (calibrate) of many image points at once,
+ *         with an optional precomputed lookup grid
+ * @date   October 2026
+ */
+
+#pragma once
+
+#include <gtsam/geometry/BatchProjection.h>
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace gtsam {
+
+namespace internal {
+
+/// Initial guess for calibrate: invert the pinhole part of the model
+template <class CALIBRATION>
+struct BatchCalibrateInit {
+  static void Run(const CALIBRATION& K, const BatchProjection::Array& u,
+                  const BatchProjection::Array& v, BatchProjection::Array& x,
+                  BatchProjection::Array& y) {
+    const Matrix3 Kinv = K.K().inverse();
+    x = Kinv(0, 0) * u + Kinv(0, 1) * v + Kinv(0, 2);
+    y = Kinv(1, 1) * v + Kinv(1, 2);
+  }
+};
+
+/// Cal3Unified calibrates to the unit sphere: map the guess there too
+template <>
+struct BatchCalibrateInit<Cal3Unified> {
+  static void Run(const Cal3Unified& K, const BatchProjection::Array& u,
+                  const BatchProjection::Array& v, BatchProjection::Array& x,
+                  BatchProjection::Array& y) {
+    typedef BatchProjection::Array Array;
+    const Matrix3 Kinv = K.K().inverse();
+    x = Kinv(0, 0) * u + Kinv(0, 1) * v + Kinv(0, 2);
+    y = Kinv(1, 1) * v + Kinv(1, 2);
+
+    // Vectorized Cal3Unified::nPlaneToSpace
+    const double xi = K.xi();
+    const Array xy2 = x.square() + y.square();
+    const Array sq_xy = (xi + (1.0 + (1.0 - xi * xi) * xy2).sqrt()) / (xy2 + 1.0);
+    const Array scale = sq_xy / (sq_xy - xi);
+    x *= scale;
+    y *= scale;
+  }
+};
+
+/**
+ * Newton's method on uncalibrate(x, y) = (u, v) for all points at once,
+ * starting from the given (x, y). Points stop moving once their pixel error
+ * is below tol; throws std::runtime_error if some point has not converged
+ * after maxIterations.
+ */
+template <class CALIBRATION>
+void BatchNewtonCalibrate(const CALIBRATION& K, const BatchProjection::Array& u,
+                          const BatchProjection::Array& v,
+                          BatchProjection::Array& x, BatchProjection::Array& y,
+                          double tol, int maxIterations) {
+  typedef BatchProjection::Array Array;
+  const Eigen::Index N = u.size();
+  Array uHat(N), vHat(N);
+  Matrix Dcal(0, 2 * traits<CALIBRATION>::dimension), Dp(N, 4);
+  for (int iteration = 0; iteration <= maxIterations; ++iteration) {
+    BatchUncalibrate<CALIBRATION>::Run(K, x, y, uHat, vHat, Dcal, Dp);
+    const Array eu = uHat - u, ev = vHat - v;
+    const auto converged = (eu.square() + ev.square()) < tol * tol;
+    if (converged.all()) return;
+    if (iteration == maxIterations) break;
+
+    // Solve the 2x2 systems Dp * delta = e in closed form
+    const Array Dp0 = Dp.col(0).array(), Dp1 = Dp.col(1).array(),
+                Dp2 = Dp.col(2).array(), Dp3 = Dp.col(3).array();
+    const Array det = Dp0 * Dp3 - Dp1 * Dp2;
+    x = converged.select(x, x - (Dp3 * eu - Dp1 * ev) / det);
+    y = converged.select(y, y - (Dp0 * ev - Dp2 * eu) / det);
+  }
+  throw std::runtime_error(
+      "calibrateBatch fails to converge. need a better initialization");
+}
+
+}  // namespace internal
+
+/**
+ * Batch counterpart of CALIBRATION::calibrate: maps N image points (u, v) to
+ * intrinsic coordinates (x, y). All points run Newton's method together from
+ * the pinhole inverse, using the vectorized uncalibrate models of
+ * BatchProjection.h, until their pixel error is below tol. Where the scalar
+ * calibrate converges, the results agree to within that tolerance. Newton
+ * also converges for strongly distorted pixels, e.g. in image corners, where
+ * the fixed-point iteration of the scalar Cal3DS2 and Cal3Unified calibrate
+ * throws. Throws std::runtime_error if some point does not converge.
+ */
+template <class CALIBRATION>
+void calibrateBatch(const CALIBRATION& K, const BatchProjection::Array& u,
+                    const BatchProjection::Array& v, BatchProjection::Array& x,
+                    BatchProjection::Array& y, double tol = 1e-5,
+                    int maxIterations = 20) {
+  internal::BatchCalibrateInit<CALIBRATION>::Run(K, u, v, x, y);
+  internal::BatchNewtonCalibrate(K, u, v, x, y, tol, maxIterations);
+}
+
+/**
+ * Precomputed undistortion of an image region: calibrate is solved once on a
+ * regular grid of pixels, and lookups interpolate bilinearly in the grid cell
+ * and then refine with Newton's method, which typically needs only one or two
+ * iterations. Pixels outside the grid are extrapolated from the border cells.
+ */
+template <class CALIBRATION>
+class UndistortionGrid {
+ public:
+  typedef BatchProjection::Array Array;
+
+ private:
+  CALIBRATION K_;
+  double step_;
+  Eigen::Index cols_, rows_;
+  Array x_, y_;  ///< calibrated grid nodes, row-major
+
+ public:
+  /**
+   * Solve calibrate for pixels (i * step, j * step) covering the image
+   * [0, width] x [0, height].
+   */
+  UndistortionGrid(const CALIBRATION& K, double width, double height,
+                   double step = 8.0)
+      : K_(K),
+        step_(step),
+        cols_(static_cast<Eigen::Index>(std::ceil(width / step)) + 1),
+        rows_(static_cast<Eigen::Index>(std::ceil(height / step)) + 1) {
+    Array u(rows_ * cols_), v(rows_ * cols_);
+    for (Eigen::Index r = 0; r < rows_; r++) {
+      u.segment(r * cols_, cols_) = Array::LinSpaced(cols_, 0, (cols_ - 1) * step);
+      v.segment(r * cols_, cols_).setConstant(r * step);
+    }
+    calibrateBatch(K_, u, v, x_, y_, 1e-8);
+  }
+
+  /// Calibration the grid was built for
+  const CALIBRATION& calibration() const { return K_; }
+
+  /// Calibrate N pixels, see calibrateBatch
+  void calibrate(const Array& u, const Array& v, Array& x, Array& y,
+                 double tol = 1e-5, int maxIterations = 20) const {
+    const Eigen::Index N = u.size();
+    x.resize(N);
+    y.resize(N);
+    for (Eigen::Index k = 0; k < N; k++) {
+      const double cu = u[k] / step_, cv = v[k] / step_;
+      const Eigen::Index c = std::min<Eigen::Index>(
+          std::max<Eigen::Index>(static_cast<Eigen::Index>(cu), 0), cols_ - 2);
+      const Eigen::Index r = std::min<Eigen::Index>(
+          std::max<Eigen::Index>(static_cast<Eigen::Index>(cv), 0), rows_ - 2);
+      const double a = cu - c, b = cv - r;
+      const Eigen::Index i00 = r * cols_ + c, i10 = i00 + cols_;
+      x[k] = (1 - b) * ((1 - a) * x_[i00] + a * x_[i00 + 1]) +
+             b * ((1 - a) * x_[i10] + a * x_[i10 + 1]);
+      y[k] = (1 - b) * ((1 - a) * y_[i00] + a * y_[i00 + 1]) +
+             b * ((1 - a) * y_[i10] + a * y_[i10 + 1]);
+    }
+    internal::BatchNewtonCalibrate(K_, u, v, x, y, tol, maxIterations);
+  }
+};
+
+}  // namespace gtsam
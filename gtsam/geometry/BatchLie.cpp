@@ -0,0 +1,197 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file   BatchLie.cpp
+ * @brief  Expmap and Logmap of Rot3 and Pose3 for many elements at once
+ * @date   October 2026
+ */
+
+#include <gtsam/geometry/BatchLie.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace gtsam {
+
+namespace {
+
+/// theta^2 below which the coefficients use their Taylor expansions
+constexpr double kTaylorBand = 1e-2;
+
+/**
+ * Coefficients of the closed forms in omega, with W = omega^ and theta =
+ * |omega|, all of them smooth in theta^2:
+ *   Exp(W) = I + A W + B W^2, right Jacobian = I - B W + C W^2,
+ *   c2 and d appear in Q of Pose3::ComputeQforExpmapDerivative.
+ * Both the closed form and the series are evaluated, and the result selected,
+ * so the computation does not branch on the angle.
+ */
+struct ExpCoefficients {
+  double A, B, C, c2, d;
+
+  explicit ExpCoefficients(double theta2) {
+    const double theta = std::sqrt(theta2), s = std::sin(theta),
+                 c = std::cos(theta);
+    const double t2 = theta2, t4 = t2 * t2, t6 = t4 * t2;
+    const bool taylor = theta2 < kTaylorBand;
+    A = taylor ? 1.0 - t2 / 6.0 + t4 / 120.0 - t6 / 5040.0 : s / theta;
+    B = taylor ? 0.5 - t2 / 24.0 + t4 / 720.0 - t6 / 40320.0 : (1.0 - c) / t2;
+    C = taylor ? 1.0 / 6.0 - t2 / 120.0 + t4 / 5040.0 - t6 / 362880.0
+               : (theta - s) / (t2 * theta);
+    // (1 - theta^2/2 - cos) / theta^4 and (theta - sin - theta^3/6) / theta^5
+    c2 = taylor ? -1.0 / 24.0 + t2 / 720.0 - t4 / 40320.0 + t6 / 3628800.0
+                : (1.0 - 0.5 * t2 - c) / t4;
+    d = taylor ? -1.0 / 120.0 + t2 / 5040.0 - t4 / 362880.0 + t6 / 39916800.0
+               : (theta - s - t2 * theta / 6.0) / (t4 * theta);
+  }
+};
+
+/// Coefficient D of the inverse right Jacobian I + W/2 + D W^2
+inline double logCoefficient(double theta2) {
+  const double theta = std::sqrt(theta2);
+  const double t2 = theta2, t4 = t2 * t2, t6 = t4 * t2;
+  return theta2 < kTaylorBand
+             ? 1.0 / 12.0 + t2 / 720.0 + t4 / 30240.0 + t6 / 1209600.0
+             : 1.0 / t2 - (1.0 + std::cos(theta)) /
+                              (2.0 * theta * std::sin(theta));
+}
+
+/// W^2 = omega omega' - theta^2 I, cheaper than the matrix product
+inline Matrix3 hatSquared(const Vector3& w, double theta2) {
+  return w * w.transpose() - theta2 * I_3x3;
+}
+
+/// Q of Pose3::ComputeQforExpmapDerivative, Barfoot14tro eq. (102)
+inline Matrix3 expmapQ(const Matrix3& W, const Matrix3& V,
+                       const ExpCoefficients& k) {
+  const Matrix3 WV = W * V, VW = V * W, WVW = WV * W;
+  return -0.5 * V + k.C * (WV + VW - WVW) +
+         k.c2 * (W * WV + VW * W - 3.0 * WVW) -
+         0.5 * (k.c2 - 3.0 * k.d) * (WVW * W + W * WVW);
+}
+
+/// Rot3::Logmap of the rotation matrix M, and theta^2 of the result
+inline Vector3 logmapRotation(const Matrix3& M, double& theta2) {
+  const double tr = M.trace();
+  Vector3 omega;
+  if (tr + 1.0 < 1e-10) {
+    // theta near pi: rare, and handled by the scalar code
+    omega = SO3::Logmap(SO3(M));
+  } else {
+    const double tr_3 = tr - 3.0;
+    const double theta = std::acos(std::min(1.0, std::max(-1.0, 0.5 * (tr - 1.0))));
+    // theta / (2 sin(theta)), with theta^2 ~ 3 - tr near zero
+    const double magnitude = tr_3 < -1e-7 ? theta / (2.0 * std::sin(theta))
+                                          : 0.5 - tr_3 / 12.0;
+    omega = magnitude *
+            Vector3(M(2, 1) - M(1, 2), M(0, 2) - M(2, 0), M(1, 0) - M(0, 1));
+  }
+  theta2 = omega.dot(omega);
+  return omega;
+}
+
+template <bool DERIVATIVES>
+void expmapRot3(const Matrix3X& omegas, Rot3* R, Matrix3* H) {
+  for (Eigen::Index i = 0; i < omegas.cols(); i++) {
+    const Vector3 w = omegas.col(i);
+    const double theta2 = w.dot(w);
+    const ExpCoefficients k(theta2);
+    const Matrix3 W = skewSymmetric(w), WW = hatSquared(w, theta2);
+    R[i] = Rot3(Matrix3(I_3x3 + k.A * W + k.B * WW));
+    if (DERIVATIVES) H[i] = I_3x3 - k.B * W + k.C * WW;
+  }
+}
+
+template <bool DERIVATIVES>
+void expmapPose3(const Matrix6X& xis, Pose3* T, Matrix6* H) {
+  for (Eigen::Index i = 0; i < xis.cols(); i++) {
+    const Vector3 w = xis.col(i).head<3>(), v = xis.col(i).tail<3>();
+    const double theta2 = w.dot(w);
+    const ExpCoefficients k(theta2);
+    const Matrix3 W = skewSymmetric(w), WW = hatSquared(w, theta2);
+    const Matrix3 R = I_3x3 + k.A * W + k.B * WW;
+    const Point3 t = v + k.B * (W * v) + k.C * (WW * v);
+    T[i] = Pose3(Rot3(R), t);
+    if (DERIVATIVES) {
+      const Matrix3 Jw = I_3x3 - k.B * W + k.C * WW;
+      H[i] << Jw, Z_3x3, expmapQ(W, skewSymmetric(v), k), Jw;
+    }
+  }
+}
+
+template <bool DERIVATIVES>
+void logmapRot3(const Rot3* R, size_t n, Matrix3X& omegas, Matrix3* H) {
+  for (size_t i = 0; i < n; i++) {
+    double theta2;
+    const Vector3 w = logmapRotation(R[i].matrix(), theta2);
+    omegas.col(i) = w;
+    if (DERIVATIVES)
+      H[i] = I_3x3 + 0.5 * skewSymmetric(w) +
+             logCoefficient(theta2) * hatSquared(w, theta2);
+  }
+}
+
+template <bool DERIVATIVES>
+void logmapPose3(const Pose3* T, size_t n, Matrix6X& xis, Matrix6* H) {
+  for (size_t i = 0; i < n; i++) {
+    double theta2;
+    const Vector3 w = logmapRotation(T[i].rotation().matrix(), theta2);
+    const Vector3& t = T[i].translation();
+    const Matrix3 W = skewSymmetric(w), WW = hatSquared(w, theta2);
+    const double D = logCoefficient(theta2);
+    const Vector3 u = t - 0.5 * (W * t) + D * (WW * t);
+    xis.col(i) << w, u;
+    if (DERIVATIVES) {
+      const Matrix3 Jw = I_3x3 + 0.5 * W + D * WW;
+      const Matrix3 Q = expmapQ(W, skewSymmetric(u), ExpCoefficients(theta2));
+      H[i] << Jw, Z_3x3, -Jw * Q * Jw, Jw;
+    }
+  }
+}
+
+}  // namespace
+
+/* ************************************************************************* */
+void expmapBatch(const Matrix3X& omegas, Rot3* R, Matrix3* H) {
+  if (H)
+    expmapRot3<true>(omegas, R, H);
+  else
+    expmapRot3<false>(omegas, R, nullptr);
+}
+
+/* ************************************************************************* */
+void expmapBatch(const Matrix6X& xis, Pose3* T, Matrix6* H) {
+  if (H)
+    expmapPose3<true>(xis, T, H);
+  else
+    expmapPose3<false>(xis, T, nullptr);
+}
+
+/* ************************************************************************* */
+void logmapBatch(const Rot3* R, size_t n, Matrix3X& omegas, Matrix3* H) {
+  omegas.resize(3, n);
+  if (H)
+    logmapRot3<true>(R, n, omegas, H);
+  else
+    logmapRot3<false>(R, n, omegas, nullptr);
+}
+
+/* ************************************************************************* */
+void logmapBatch(const Pose3* T, size_t n, Matrix6X& xis, Matrix6* H) {
+  xis.resize(6, n);
+  if (H)
+    logmapPose3<true>(T, n, xis, H);
+  else
+    logmapPose3<false>(T, n, xis, nullptr);
+}
+
+}  // namespace gtsam
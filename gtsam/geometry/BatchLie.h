@@ -0,0 +1,57 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file   BatchLie.h
+ * @brief  Expmap and Logmap of Rot3 and Pose3 for many elements at once
+ * @date   October 2026
+ */
+
+#pragma once
+
+#include <gtsam/geometry/Pose3.h>
+
+namespace gtsam {
+
+/**
+ * Batch counterparts of Rot3/Pose3::Expmap and Logmap and their derivatives.
+ * Tangent vectors are passed as the columns of a Matrix3X for Rot3, or of a
+ * Matrix6X with (omega, v) for Pose3.
+ *
+ * Each element goes through the same straight-line kernel: the trigonometric
+ * coefficients are selected between their closed form and a Taylor expansion
+ * instead of branching on the angle, and whether derivatives are computed is
+ * decided once per call at compile time rather than per element. Results and
+ * Jacobians are written into caller-provided arrays of n entries, so repeated
+ * calls do not allocate. Pass nullptr for H to skip the Jacobians.
+ *
+ * Values agree with the scalar functions up to rounding, except for angles
+ * with theta^2 below machine epsilon, where the scalar versions truncate the
+ * series after the first order term and these keep the next ones.
+ */
+
+/// Rot3::Expmap of every column of omegas, H[i] = Rot3::ExpmapDerivative
+GTSAM_EXPORT void expmapBatch(const Matrix3X& omegas, Rot3* R,
+                              Matrix3* H = nullptr);
+
+/// Pose3::Expmap of every column of xis, H[i] = Pose3::ExpmapDerivative
+GTSAM_EXPORT void expmapBatch(const Matrix6X& xis, Pose3* T,
+                              Matrix6* H = nullptr);
+
+/// Rot3::Logmap of R[0..n), resizes omegas to 3*n if needed
+GTSAM_EXPORT void logmapBatch(const Rot3* R, size_t n, Matrix3X& omegas,
+                              Matrix3* H = nullptr);
+
+/// Pose3::Logmap of T[0..n), resizes xis to 6*n if needed
+GTSAM_EXPORT void logmapBatch(const Pose3* T, size_t n, Matrix6X& xis,
+                              Matrix6* H = nullptr);
+
+}  // namespace gtsam
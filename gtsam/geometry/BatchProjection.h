@@ -0,0 +1,475 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file   BatchProjection.h
+ * @brief  Structure-of-arrays projection of many points into many cameras
+ * @date   October 2026
+ */
+
+#pragma once
+
+#include <gtsam/geometry/Cal3Bundler.h>
+#include <gtsam/geometry/Cal3DS2.h>
+#include <gtsam/geometry/Cal3Fisheye.h>
+#include <gtsam/geometry/Cal3Unified.h>
+#include <gtsam/geometry/Cal3_S2.h>
+#include <gtsam/geometry/CameraSet.h>
+#include <gtsam/geometry/Pose3.h>
+#include <gtsam/base/parallelFor.h>
+
+#include <vector>
+
+namespace gtsam {
+
+/**
+ * Result of BatchProjector::project for M cameras and N points, in
+ * structure-of-arrays layout: entry k = i * N + j of every array belongs to
+ * point j in camera i, and every entry of a derivative is a column, so that
+ * all arrays are filled with Eigen packet operations.
+ */
+struct BatchProjection {
+  typedef Eigen::Array<double, Eigen::Dynamic, 1> Array;
+
+  size_t nrCameras = 0, nrPoints = 0;
+  Array u, v;  ///< predicted image coordinates
+  Eigen::Array<bool, Eigen::Dynamic, 1> valid;  ///< point in front of camera
+  Eigen::Matrix<double, Eigen::Dynamic, 12> Dpose;  ///< row-major 2x6 per entry
+  Eigen::Matrix<double, Eigen::Dynamic, 6> Dpoint;  ///< row-major 2x3 per entry
+  Matrix Dcal;  ///< row-major 2xDimK per entry
+
+  /// Index of point j in camera i
+  size_t index(size_t i, size_t j) const { return i * nrPoints + j; }
+
+  /// Projection of point j in camera i
+  Point2 measured(size_t i, size_t j) const {
+    const size_t k = index(i, j);
+    return Point2(u[k], v[k]);
+  }
+
+  /// Derivative of the projection of point j in camera i wrt the pose
+  Matrix26 poseJacobian(size_t i, size_t j) const {
+    return Eigen::Map<const Eigen::Matrix<double, 2, 6, Eigen::RowMajor>>(
+        Eigen::Matrix<double, 1, 12>(Dpose.row(index(i, j))).data());
+  }
+
+  /// Derivative of the projection of point j in camera i wrt the point
+  Matrix23 pointJacobian(size_t i, size_t j) const {
+    return Eigen::Map<const Eigen::Matrix<double, 2, 3, Eigen::RowMajor>>(
+        Eigen::Matrix<double, 1, 6>(Dpoint.row(index(i, j))).data());
+  }
+
+  /// Derivative of the projection of point j in camera i wrt the calibration
+  Matrix calibrationJacobian(size_t i, size_t j) const {
+    const Vector row = Dcal.row(index(i, j)).transpose();
+    return Eigen::Map<const Eigen::Matrix<double, Eigen::Dynamic,
+                                          Eigen::Dynamic, Eigen::RowMajor>>(
+        row.data(), 2, Dcal.cols() / 2);
+  }
+};
+
+namespace internal {
+
+/**
+ * Uncalibrate N intrinsic points (x, y) with one calibration, writing image
+ * points (u, v). If Dcal is not empty, the row-major 2xDimK calibration
+ * derivative is written in its columns, and if Dp is not empty, the row-major
+ * 2x2 derivative wrt (x, y). The generic version calls the scalar
+ * uncalibrate, the specializations below are vectorized.
+ */
+template <class CALIBRATION>
+struct BatchUncalibrate {
+  static void Run(const CALIBRATION& K, const BatchProjection::Array& x,
+                  const BatchProjection::Array& y, BatchProjection::Array& u,
+                  BatchProjection::Array& v, Eigen::Ref<Matrix> Dcal,
+                  Eigen::Ref<Matrix> Dp) {
+    static const int DimK = traits<CALIBRATION>::dimension;
+    const bool withDcal = Dcal.size() > 0, withDp = Dp.size() > 0;
+    Eigen::Matrix<double, 2, DimK, Eigen::RowMajor> H1;
+    Eigen::Matrix<double, 2, 2, Eigen::RowMajor> H2;
+    for (Eigen::Index j = 0; j < x.size(); j++) {
+      Eigen::Matrix<double, 2, DimK> Hcal;
+      Matrix2 Hp;
+      const Point2 z = K.uncalibrate(Point2(x[j], y[j]),
+                                     withDcal ? &Hcal : nullptr,
+                                     withDp ? &Hp : nullptr);
+      u[j] = z.x();
+      v[j] = z.y();
+      if (withDcal) {
+        H1 = Hcal;
+        Dcal.row(j) = Eigen::Map<const Eigen::Matrix<double, 1, 2 * DimK>>(H1.data());
+      }
+      if (withDp) {
+        H2 = Hp;
+        Dp.row(j) = Eigen::Map<const Eigen::Matrix<double, 1, 4>>(H2.data());
+      }
+    }
+  }
+};
+
+/// Vectorized Cal3_S2 uncalibrate
+template <>
+struct BatchUncalibrate<Cal3_S2> {
+  static void Run(const Cal3_S2& K, const BatchProjection::Array& x,
+                  const BatchProjection::Array& y, BatchProjection::Array& u,
+                  BatchProjection::Array& v, Eigen::Ref<Matrix> Dcal,
+                  Eigen::Ref<Matrix> Dp) {
+    u = K.fx() * x + K.skew() * y + K.px();
+    v = K.fy() * y + K.py();
+    if (Dcal.size() > 0) {
+      // Dcal = [x 0 y 1 0; 0 y 0 0 1]
+      Dcal.setZero();
+      Dcal.col(0) = x.matrix();
+      Dcal.col(2) = y.matrix();
+      Dcal.col(3).setOnes();
+      Dcal.col(6) = y.matrix();
+      Dcal.col(9).setOnes();
+    }
+    if (Dp.size() > 0) {
+      Dp.col(0).setConstant(K.fx());
+      Dp.col(1).setConstant(K.skew());
+      Dp.col(2).setZero();
+      Dp.col(3).setConstant(K.fy());
+    }
+  }
+};
+
+/// Vectorized Cal3Bundler uncalibrate
+template <>
+struct BatchUncalibrate<Cal3Bundler> {
+  static void Run(const Cal3Bundler& K, const BatchProjection::Array& x,
+                  const BatchProjection::Array& y, BatchProjection::Array& u,
+                  BatchProjection::Array& v, Eigen::Ref<Matrix> Dcal,
+                  Eigen::Ref<Matrix> Dp) {
+    typedef BatchProjection::Array Array;
+    const double f = K.fx(), k1 = K.k1(), k2 = K.k2();
+    const Array r = x.square() + y.square();
+    const Array g = 1.0 + (k1 + k2 * r) * r;
+    u = K.u0() + f * g * x;
+    v = K.v0() + f * g * y;
+    if (Dcal.size() > 0) {
+      // Dcal = [g*x f*r*x f*r*r*x; g*y f*r*y f*r*r*y]
+      Dcal.col(0) = (g * x).matrix();
+      Dcal.col(1) = (f * r * x).matrix();
+      Dcal.col(2) = (f * r * r * x).matrix();
+      Dcal.col(3) = (g * y).matrix();
+      Dcal.col(4) = (f * r * y).matrix();
+      Dcal.col(5) = (f * r * r * y).matrix();
+    }
+    if (Dp.size() > 0) {
+      const Array a = 2.0 * (k1 + 2.0 * k2 * r);
+      Dp.col(0) = (f * (g + a * x * x)).matrix();
+      Dp.col(1) = (f * a * x * y).matrix();
+      Dp.col(2) = Dp.col(1);
+      Dp.col(3) = (f * (g + a * y * y)).matrix();
+    }
+  }
+};
+
+/// Vectorized Cal3DS2_Base uncalibrate, also used by Cal3Unified
+template <class CALIBRATION>
+struct BatchUncalibrateDS2 {
+  static void Run(const CALIBRATION& K, const BatchProjection::Array& x,
+                  const BatchProjection::Array& y, BatchProjection::Array& u,
+                  BatchProjection::Array& v, Eigen::Ref<Matrix> Dcal,
+                  Eigen::Ref<Matrix> Dp) {
+    typedef BatchProjection::Array Array;
+    const double fx = K.fx(), fy = K.fy(), s = K.skew();
+    const double k1 = K.k1(), k2 = K.k2(), p1 = K.p1(), p2 = K.p2();
+    const Array xy = x * y, xx = x.square(), yy = y.square();
+    const Array rr = xx + yy, r4 = rr.square();
+    const Array g = 1.0 + k1 * rr + k2 * r4;
+    const Array pnx = g * x + 2.0 * p1 * xy + p2 * (rr + 2.0 * xx);
+    const Array pny = g * y + 2.0 * p2 * xy + p1 * (rr + 2.0 * yy);
+    u = fx * pnx + s * pny + K.px();
+    v = fy * pny + K.py();
+
+    if (Dcal.size() > 0) {
+      // Dcal = [DR1, DK * DR2], see Cal3DS2_Base::uncalibrate
+      Dcal.col(0) = pnx.matrix();
+      Dcal.col(1).setZero();
+      Dcal.col(2) = pny.matrix();
+      Dcal.col(3).setOnes();
+      Dcal.col(4).setZero();
+      Dcal.col(9).setZero();
+      Dcal.col(10) = pny.matrix();
+      Dcal.col(11).setZero();
+      Dcal.col(12).setZero();
+      Dcal.col(13).setOnes();
+      const Array xrr = x * rr, yrr = y * rr, xr4 = x * r4, yr4 = y * r4;
+      const Array xy2 = 2.0 * xy, rrxx = rr + 2.0 * xx, rryy = rr + 2.0 * yy;
+      Dcal.col(5) = (fx * xrr + s * yrr).matrix();
+      Dcal.col(6) = (fx * xr4 + s * yr4).matrix();
+      Dcal.col(7) = (fx * xy2 + s * rryy).matrix();
+      Dcal.col(8) = (fx * rrxx + s * xy2).matrix();
+      Dcal.col(14) = (fy * yrr).matrix();
+      Dcal.col(15) = (fy * yr4).matrix();
+      Dcal.col(16) = (fy * rryy).matrix();
+      Dcal.col(17) = (fy * xy2).matrix();
+    }
+
+    if (Dp.size() > 0) {
+      // Dp = DK * DR, see D2dintrinsic in Cal3DS2_Base.cpp
+      const Array dgdx = 2.0 * x * (k1 + 2.0 * k2 * rr);
+      const Array dgdy = 2.0 * y * (k1 + 2.0 * k2 * rr);
+      const Array DR00 = g + x * dgdx + 2.0 * p1 * y + 6.0 * p2 * x;
+      const Array DR01 = x * dgdy + 2.0 * p1 * x + 2.0 * p2 * y;
+      const Array DR10 = y * dgdx + 2.0 * p2 * y + 2.0 * p1 * x;
+      const Array DR11 = g + y * dgdy + 2.0 * p2 * x + 6.0 * p1 * y;
+      Dp.col(0) = (fx * DR00 + s * DR10).matrix();
+      Dp.col(1) = (fx * DR01 + s * DR11).matrix();
+      Dp.col(2) = (fy * DR10).matrix();
+      Dp.col(3) = (fy * DR11).matrix();
+    }
+  }
+};
+
+template <>
+struct BatchUncalibrate<Cal3DS2> : BatchUncalibrateDS2<Cal3DS2> {};
+
+/// Vectorized Cal3Unified uncalibrate: unit sphere to normalized plane,
+/// followed by the Cal3DS2 model
+template <>
+struct BatchUncalibrate<Cal3Unified> {
+  static void Run(const Cal3Unified& K, const BatchProjection::Array& x,
+                  const BatchProjection::Array& y, BatchProjection::Array& u,
+                  BatchProjection::Array& v, Eigen::Ref<Matrix> Dcal,
+                  Eigen::Ref<Matrix> Dp) {
+    typedef BatchProjection::Array Array;
+    const double xi = K.xi();
+    const Array sqrt_nx = (x.square() + y.square() + 1.0).sqrt();
+    const Array xi_sqrt_nx = (1.0 + xi * sqrt_nx).inverse();
+    const Array xi_sqrt_nx2 = xi_sqrt_nx.square();
+    const Array xn = x * xi_sqrt_nx, yn = y * xi_sqrt_nx;
+
+    const bool withDcal = Dcal.size() > 0, withDp = Dp.size() > 0;
+    const Eigen::Index N = x.size();
+    Matrix DcalBase(withDcal ? N : 0, 18), DpBase(withDcal || withDp ? N : 0, 4);
+    BatchUncalibrateDS2<Cal3Unified>::Run(K, xn, yn, u, v, DcalBase, DpBase);
+
+    if (withDcal) {
+      // Dcal = [DcalBase, DpBase * DU], see Cal3Unified::uncalibrate
+      const Array DU0 = -x * sqrt_nx * xi_sqrt_nx2;
+      const Array DU1 = -y * sqrt_nx * xi_sqrt_nx2;
+      Dcal.leftCols(9) = DcalBase.leftCols(9);
+      Dcal.col(9) = (DpBase.col(0).array() * DU0 + DpBase.col(1).array() * DU1).matrix();
+      Dcal.middleCols(10, 9) = DcalBase.rightCols(9);
+      Dcal.col(19) = (DpBase.col(2).array() * DU0 + DpBase.col(3).array() * DU1).matrix();
+    }
+
+    if (withDp) {
+      // Dp = DpBase * DU
+      const Array denom = xi_sqrt_nx2 / sqrt_nx;
+      const Array mid = -(xi * x * y) * denom;
+      const Array DU00 = (sqrt_nx + xi * (y.square() + 1.0)) * denom;
+      const Array DU11 = (sqrt_nx + xi * (x.square() + 1.0)) * denom;
+      for (int r = 0; r < 2; r++) {
+        const Array H0 = DpBase.col(2 * r).array(), H1 = DpBase.col(2 * r + 1).array();
+        Dp.col(2 * r) = (H0 * DU00 + H1 * mid).matrix();
+        Dp.col(2 * r + 1) = (H0 * mid + H1 * DU11).matrix();
+      }
+    }
+  }
+};
+
+/// Vectorized Cal3Fisheye uncalibrate
+template <>
+struct BatchUncalibrate<Cal3Fisheye> {
+  static void Run(const Cal3Fisheye& K, const BatchProjection::Array& x,
+                  const BatchProjection::Array& y, BatchProjection::Array& u,
+                  BatchProjection::Array& v, Eigen::Ref<Matrix> Dcal,
+                  Eigen::Ref<Matrix> Dp) {
+    typedef BatchProjection::Array Array;
+    const double fx = K.fx(), fy = K.fy(), sk = K.skew();
+    const double k1 = K.k1(), k2 = K.k2(), k3 = K.k3(), k4 = K.k4();
+    static const double threshold = 1e-8;  // as in Cal3Fisheye::Scaling
+
+    const Array r2 = x.square() + y.square(), r = r2.sqrt(), t = r.atan();
+    const Array t2 = t.square(), t4 = t2.square(), t6 = t2 * t4, t8 = t4.square();
+    const Array poly = 1.0 + k1 * t2 + k2 * t4 + k3 * t6 + k4 * t8;
+    const Array scaling = (r > threshold).select(
+        t / r, 1.0 - r2 / 3.0 + r2.square() / 5.0);
+    const Array xd = scaling * poly * x, yd = scaling * poly * y;
+    u = fx * xd + sk * yd + K.px();
+    v = fy * yd + K.py();
+
+    if (Dcal.size() > 0) {
+      // Dcal = [DR1, DK * scaling * DR2], see Cal3Fisheye::uncalibrate
+      Dcal.col(0) = xd.matrix();
+      Dcal.col(1).setZero();
+      Dcal.col(2) = yd.matrix();
+      Dcal.col(3).setOnes();
+      Dcal.col(4).setZero();
+      Dcal.col(9).setZero();
+      Dcal.col(10) = yd.matrix();
+      Dcal.col(11).setZero();
+      Dcal.col(12).setZero();
+      Dcal.col(13).setOnes();
+      const Array sx = scaling * x, sy = scaling * y;
+      const Array* T[4] = {&t2, &t4, &t6, &t8};
+      for (int c = 0; c < 4; c++) {
+        Dcal.col(5 + c) = ((fx * sx + sk * sy) * *T[c]).matrix();
+        Dcal.col(14 + c) = (fy * sy * *T[c]).matrix();
+      }
+    }
+
+    if (Dp.size() > 0) {
+      // DR as in Cal3Fisheye::uncalibrate, the identity at the center
+      const Array dtd_dt =
+          1.0 + 3.0 * k1 * t2 + 5.0 * k2 * t4 + 7.0 * k3 * t6 + 9.0 * k4 * t8;
+      const Array dt_dr = (1.0 + r2).inverse();
+      const Array rinv = (r > threshold).select(r, 1.0).inverse();
+      const Array dr_dxi = x * rinv, dr_dyi = y * rinv;
+      const Array dtd_dxi = dtd_dt * dt_dr * dr_dxi;
+      const Array dtd_dyi = dtd_dt * dt_dr * dr_dyi;
+      const Array td = t * poly, rrinv = rinv.square();
+      const auto center = r <= threshold;
+      const Array DR00 = center.select(
+          1.0, dtd_dxi * dr_dxi + td * rinv - td * x * rrinv * dr_dxi);
+      const Array DR01 =
+          center.select(0.0, dtd_dyi * dr_dxi - td * x * rrinv * dr_dyi);
+      const Array DR10 =
+          center.select(0.0, dtd_dxi * dr_dyi - td * y * rrinv * dr_dxi);
+      const Array DR11 = center.select(
+          1.0, dtd_dyi * dr_dyi + td * rinv - td * y * rrinv * dr_dyi);
+      Dp.col(0) = (fx * DR00 + sk * DR10).matrix();
+      Dp.col(1) = (fx * DR01 + sk * DR11).matrix();
+      Dp.col(2) = (fy * DR10).matrix();
+      Dp.col(3) = (fy * DR11).matrix();
+    }
+  }
+};
+
+}  // namespace internal
+
+/**
+ * Projects N points into M cameras with a shared calibration model, the batch
+ * counterpart of CameraSet::project2 and PinholeCamera::project. Instead of
+ * one call per measurement, every camera transforms and projects all points
+ * at once in structure-of-arrays layout, so the arithmetic runs on Eigen
+ * packets (SSE/AVX, depending on the build flags), and cameras are processed
+ * in parallel when TBB is available. Cal3_S2, Cal3Bundler, Cal3DS2,
+ * Cal3Unified and Cal3Fisheye have vectorized calibration models; other
+ * calibrations fall back to their scalar uncalibrate per point.
+ *
+ * Points behind a camera do not throw a CheiralityException, but are marked
+ * in BatchProjection::valid; their projections are not meaningful.
+ */
+template <class CALIBRATION>
+class BatchProjector {
+ public:
+  static const int DimK = traits<CALIBRATION>::dimension;
+
+  /// N points, one column per coordinate
+  typedef Eigen::Matrix<double, Eigen::Dynamic, 3> Points;
+
+ private:
+  std::vector<Pose3> poses_;
+  std::vector<CALIBRATION> calibrations_;
+
+ public:
+  /// Empty projector, add cameras with add
+  BatchProjector() {}
+
+  /// Projector for all cameras in a CameraSet, e.g., of a smart factor
+  template <class CAMERA>
+  explicit BatchProjector(const CameraSet<CAMERA>& cameras) {
+    for (const CAMERA& camera : cameras)
+      add(camera.pose(), camera.calibration());
+  }
+
+  /// Add a camera
+  void add(const Pose3& pose, const CALIBRATION& K) {
+    poses_.push_back(pose);
+    calibrations_.push_back(K);
+  }
+
+  /// Number of cameras
+  size_t size() const { return poses_.size(); }
+
+  /// Stack points in structure-of-arrays layout
+  static Points Stack(const std::vector<Point3>& points) {
+    Points result(points.size(), 3);
+    for (size_t j = 0; j < points.size(); j++) result.row(j) = points[j];
+    return result;
+  }
+
+  /**
+   * Project all points into all cameras. The result is resized as needed;
+   * each camera also allocates temporaries of N entries for its arrays.
+   */
+  void project(const Points& points, BatchProjection& result,
+               bool derivatives = true) const {
+    typedef BatchProjection::Array Array;
+    const size_t M = size(), N = points.rows();
+    result.nrCameras = M;
+    result.nrPoints = N;
+    result.u.resize(M * N);
+    result.v.resize(M * N);
+    result.valid.resize(M * N);
+    result.Dpose.resize(derivatives ? M * N : 0, 12);
+    result.Dpoint.resize(derivatives ? M * N : 0, 6);
+    result.Dcal.resize(derivatives ? M * N : 0, 2 * DimK);
+
+    const auto px = points.col(0).array(), py = points.col(1).array(),
+               pz = points.col(2).array();
+
+    parallelFor(M, [&](size_t i) {
+      const Matrix3 R = poses_[i].rotation().matrix();
+      const Point3& t = poses_[i].translation();
+      const size_t offset = i * N;
+
+      // Transform to camera frame, q = R' * (p - t)
+      const Array dx = px - t.x(), dy = py - t.y(), dz = pz - t.z();
+      const Array qx = R(0, 0) * dx + R(1, 0) * dy + R(2, 0) * dz;
+      const Array qy = R(0, 1) * dx + R(1, 1) * dy + R(2, 1) * dz;
+      const Array qz = R(0, 2) * dx + R(1, 2) * dy + R(2, 2) * dz;
+      result.valid.segment(offset, N) = qz > 0.0;
+
+      // Intrinsic coordinates
+      const Array d = qz.inverse();
+      const Array x = qx * d, y = qy * d;
+
+      Array u(N), v(N);
+      Eigen::Matrix<double, Eigen::Dynamic, 4> Dp(derivatives ? N : 0, 4);
+      internal::BatchUncalibrate<CALIBRATION>::Run(
+          calibrations_[i], x, y, u, v,
+          result.Dcal.middleRows(derivatives ? offset : 0, derivatives ? N : 0),
+          Dp);
+      result.u.segment(offset, N) = u;
+      result.v.segment(offset, N) = v;
+      if (!derivatives) return;
+
+      // Chain rule with the intrinsic derivatives, see PinholeBase::Dpose and
+      // PinholeBase::Dpoint: D = Dp * Dpn
+      const Array xy = x * y;
+      const Array Dpn_pose[2][6] = {
+          {xy, -1.0 - x.square(), y, -d, Array::Zero(N), d * x},
+          {1.0 + y.square(), -xy, -x, Array::Zero(N), -d, d * y}};
+      const Array Dpn_point[2][3] = {
+          {d * (R(0, 0) - x * R(0, 2)), d * (R(1, 0) - x * R(1, 2)),
+           d * (R(2, 0) - x * R(2, 2))},
+          {d * (R(0, 1) - y * R(0, 2)), d * (R(1, 1) - y * R(1, 2)),
+           d * (R(2, 1) - y * R(2, 2))}};
+      for (int r = 0; r < 2; r++) {
+        const Array Dp0 = Dp.col(2 * r).array(), Dp1 = Dp.col(2 * r + 1).array();
+        for (int c = 0; c < 6; c++)
+          result.Dpose.col(6 * r + c).segment(offset, N) =
+              (Dp0 * Dpn_pose[0][c] + Dp1 * Dpn_pose[1][c]).matrix();
+        for (int c = 0; c < 3; c++)
+          result.Dpoint.col(3 * r + c).segment(offset, N) =
+              (Dp0 * Dpn_point[0][c] + Dp1 * Dpn_point[1][c]).matrix();
+      }
+    });
+  }
+};
+
+}  // namespace gtsam
@@ -189,6 +189,74 @@ public:
     return augmentedHessian;
   }
 
+  /**
+   * Whitened Jacobian [F E | b] of a Point3 in fixed-size blocks, one per
+   * camera, so that the Schur complement below needs no dynamic matrices.
+   * Keeping an instance around reuses its storage across linearizations.
+   */
+  struct SchurBlocks {
+    typedef Eigen::Matrix<double, ZDim, 3> MatrixZ3;
+    typedef Eigen::Matrix<double, 3, D> Matrix3D;
+    typedef Eigen::Matrix<double, ZDim, 1> VectorZ;
+    FBlocks F;
+    std::vector<MatrixZ3, Eigen::aligned_allocator<MatrixZ3> > E;
+    std::vector<VectorZ, Eigen::aligned_allocator<VectorZ> > b;
+    std::vector<Matrix3D, Eigen::aligned_allocator<Matrix3D> > EtF; ///< scratch
+
+    /// Make room for m cameras, keeping the capacity
+    void resize(size_t m) {
+      F.resize(m);
+      E.resize(m);
+      b.resize(m);
+      EtF.resize(m);
+    }
+  };
+
+  /**
+   * Schur complement of the fixed-size blocks, with lambda damping as in
+   * ComputePointCovariance, written into an augmentedHessian that already has
+   * m blocks of size D and one of size 1. Same result as the dynamic version,
+   * but with E' * F formed once per camera:
+   * G_ij = F_i' * F_i * [i==j] - (E_i' * F_i)' * P * (E_j' * F_j)
+   * g_i = F_i' * b_i - (E_i' * F_i)' * P * E' * b
+   */
+  static void SchurComplement(SchurBlocks& blocks, double lambda,
+      bool diagonalDamping, SymmetricBlockMatrix& augmentedHessian) {
+    typedef typename SchurBlocks::Matrix3D Matrix3D;
+    const size_t m = blocks.F.size();
+    assert(augmentedHessian.nBlocks() == DenseIndex(m + 1));
+
+    Matrix3 EtE = Matrix3::Zero();
+    Vector3 Etb = Vector3::Zero();
+    double bb = 0.0;
+    for (size_t i = 0; i < m; i++) {
+      EtE.noalias() += blocks.E[i].transpose() * blocks.E[i];
+      Etb.noalias() += blocks.E[i].transpose() * blocks.b[i];
+      blocks.EtF[i].noalias() = blocks.E[i].transpose() * blocks.F[i];
+      bb += blocks.b[i].squaredNorm();
+    }
+    if (diagonalDamping)
+      EtE.diagonal() += lambda * EtE.diagonal();
+    else
+      EtE.diagonal().array() += lambda;
+    const Matrix3 P = EtE.inverse();
+    const Vector3 PEtb = P * Etb;
+
+    for (size_t i = 0; i < m; i++) {
+      const MatrixZD& Fi = blocks.F[i];
+      const Matrix3D& EtFi = blocks.EtF[i];
+      const Matrix3D PEtFi = P * EtFi;
+      augmentedHessian.setOffDiagonalBlock(i, m,
+          Fi.transpose() * blocks.b[i] - EtFi.transpose() * PEtb);
+      augmentedHessian.setDiagonalBlock(i,
+          (Fi.transpose() * Fi - EtFi.transpose() * PEtFi).eval());
+      for (size_t j = i + 1; j < m; j++)
+        augmentedHessian.setOffDiagonalBlock(i, j,
+            -PEtFi.transpose() * blocks.EtF[j]);
+    }
+    augmentedHessian.diagonalBlock(m)(0, 0) = bb;
+  }
+
   /// Computes Point Covariance P, with lambda parameter
   template<int N> // N = 2 or 3
   static void ComputePointCovariance(Eigen::Matrix<double, N, N>& P,
@@ -21,11 +21,11 @@
 
 #include <gtsam/geometry/Unit3.h>
 #include <gtsam/geometry/Point2.h>
-#include <gtsam/config.h>  // for GTSAM_USE_TBB
 
 #include <iostream>
 #include <limits>
 #include <cmath>
+#include <thread>  // yield
 #include <vector>
 
 using namespace std;
@@ -73,22 +73,29 @@ static Point3 CalculateBestAxis(const Point3& n) {
 }
 
 /* ************************************************************************* */
-const Matrix32& Unit3::basis(OptionalJacobian<6, 2> H) const {
-#ifdef GTSAM_USE_TBB
-  // NOTE(hayk): At some point it seemed like this reproducably resulted in
-  // deadlock. However, I don't know why and I can no longer reproduce it.
-  // It either was a red herring or there is still a latent bug left to debug.
-  std::unique_lock<std::mutex> lock(B_mutex_);
-#endif
-
-  const bool cachedBasis = static_cast<bool>(B_);
-  const bool cachedJacobian = static_cast<bool>(H_B_);
+bool Unit3::claimCache(std::atomic<unsigned char>& state) {
+  // A thread that finds the cache busy waits for the one filling it, which
+  // takes less than a microsecond, so no lock is ever held.
+  unsigned char s = state.load(std::memory_order_acquire);
+  while (s != kReady) {
+    if (s == kEmpty &&
+        state.compare_exchange_weak(s, kBusy, std::memory_order_acquire,
+                                    std::memory_order_acquire))
+      return true;
+    if (s == kBusy) {
+      std::this_thread::yield();
+      s = state.load(std::memory_order_acquire);
+    }
+  }
+  return false;
+}
 
+/* ************************************************************************* */
+const Matrix32& Unit3::basis(OptionalJacobian<6, 2> H) const {
   if (H) {
-    if (!cachedJacobian) {
-      // Compute Jacobian. Recomputes B_
+    if (claimCache(H_B_state_)) {
+      // Compute Jacobian, and the basis as a by-product
       Matrix32 B;
-      Matrix62 jacobian;
       Matrix33 H_B1_n, H_b1_B1, H_b2_n, H_b2_b1;
 
       // Choose the direction of the first basis vector b1 in the tangent plane
@@ -104,32 +111,34 @@ const Matrix32& Unit3::basis(OptionalJacobian<6, 2> H) const {
 
       // Chain rule tomfoolery to compute the jacobian.
       const Matrix32& H_n_p = B;
-      jacobian.block<3, 2>(0, 0) = H_b1_B1 * H_B1_n * H_n_p;
-      auto H_b1_p = jacobian.block<3, 2>(0, 0);
-      jacobian.block<3, 2>(3, 0) = H_b2_n * H_n_p + H_b2_b1 * H_b1_p;
-
-      // Cache the result and jacobian
-      H_B_.reset(jacobian);
-      B_.reset(B);
+      H_B_.block<3, 2>(0, 0) = H_b1_B1 * H_B1_n * H_n_p;
+      auto H_b1_p = H_B_.block<3, 2>(0, 0);
+      H_B_.block<3, 2>(3, 0) = H_b2_n * H_n_p + H_b2_b1 * H_b1_p;
+      H_B_state_.store(kReady, std::memory_order_release);
+
+      // Cache the basis too, unless another thread got there first
+      if (claimCache(B_state_)) {
+        B_ = B;
+        B_state_.store(kReady, std::memory_order_release);
+      }
     }
 
     // Return cached jacobian, possibly computed just above
-    *H = *H_B_;
+    *H = H_B_;
   }
 
-  if (!cachedBasis) {
+  if (claimCache(B_state_)) {
     // Same calculation as above, without derivatives.
-    // Done after H block, as that possibly computes B_ for the first time
     Matrix32 B;
-
     const Point3 n(p_), axis = CalculateBestAxis(n);
     const Point3 B1 = gtsam::cross(n, axis);
     B.col(0) = normalize(B1);
     B.col(1) = gtsam::cross(n, B.col(0));
-    B_.reset(B);
+    B_ = B;
+    B_state_.store(kReady, std::memory_order_release);
   }
 
-  return *B_;
+  return B_;
 }
 
 /* ************************************************************************* */
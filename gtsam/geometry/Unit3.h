@@ -29,13 +29,10 @@
 #include <boost/optional.hpp>
 #include <boost/serialization/nvp.hpp>
 
+#include <atomic>
 #include <random>
 #include <string>
 
-#ifdef GTSAM_USE_TBB
-#include <mutex> // std::mutex
-#endif
-
 namespace gtsam {
 
 /// Represents a 3D point on a unit sphere.
@@ -43,13 +40,30 @@ class Unit3 {
 
 private:
 
-  Vector3 p_; ///< The location of the point on the unit sphere
-  mutable boost::optional<Matrix32> B_; ///< Cached basis
-  mutable boost::optional<Matrix62> H_B_; ///< Cached basis derivative
+  /// State of a cached value: a thread claims an empty cache by setting it
+  /// busy, fills it, and then publishes it as ready.
+  enum CacheState : unsigned char { kEmpty = 0, kBusy, kReady };
 
-#ifdef GTSAM_USE_TBB
-  mutable std::mutex B_mutex_; ///< Mutex to protect the cached basis.
-#endif
+  Vector3 p_; ///< The location of the point on the unit sphere
+  mutable Matrix32 B_; ///< Cached basis
+  mutable Matrix62 H_B_; ///< Cached basis derivative
+  mutable std::atomic<unsigned char> B_state_{kEmpty}; ///< State of B_
+  mutable std::atomic<unsigned char> H_B_state_{kEmpty}; ///< State of H_B_
+
+  /// Returns true if the caller claimed an empty cache and has to fill it,
+  /// and false once it is ready.
+  static bool claimCache(std::atomic<unsigned char>& state);
+
+  /// Copy the cached basis and derivative of u, if computed
+  void copyCache(const Unit3& u) {
+    const bool cachedBasis = u.B_state_.load(std::memory_order_acquire) == kReady;
+    const bool cachedJacobian =
+        u.H_B_state_.load(std::memory_order_acquire) == kReady;
+    if (cachedBasis) B_ = u.B_;
+    if (cachedJacobian) H_B_ = u.H_B_;
+    B_state_.store(cachedBasis ? kReady : kEmpty, std::memory_order_release);
+    H_B_state_.store(cachedJacobian ? kReady : kEmpty, std::memory_order_release);
+  }
 
 public:
 
@@ -83,15 +97,14 @@ public:
   }
 
   /// Copy constructor
-  Unit3(const Unit3& u) {
-    p_ = u.p_;
+  Unit3(const Unit3& u) : p_(u.p_) {
+    copyCache(u);
   }
 
   /// Copy assignment
   Unit3& operator=(const Unit3 & u) {
     p_ = u.p_;
-    B_ = u.B_;
-    H_B_ = u.H_B_;
+    copyCache(u);
     return *this;
   }
 
@@ -131,6 +144,8 @@ public:
    * It is a 3*2 matrix [b1 b2] composed of two orthogonal directions
    * tangent to the sphere at the current direction.
    * Provides derivatives of the basis with the two basis vectors stacked up as a 6x1.
+   * Both are computed once and cached without locks, so concurrent calls on
+   * the same object are safe and cheap once the cache is filled.
    */
   GTSAM_EXPORT const Matrix32& basis(OptionalJacobian<6, 2> H = boost::none) const;
 
@@ -211,6 +226,10 @@ private:
   template<class ARCHIVE>
   void serialize(ARCHIVE & ar, const unsigned int /*version*/) {
     ar & BOOST_SERIALIZATION_NVP(p_);
+    if (ARCHIVE::is_loading::value) {  // the cached bases belong to the old p_
+      B_state_ = kEmpty;
+      H_B_state_ = kEmpty;
+    }
   }
 
   /// @}
@@ -0,0 +1,117 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ *  @file   testBatchCalibration.cpp
+ *  @brief  Unit tests for vectorized undistortion and the UndistortionGrid
+ */
+
+#include <gtsam/geometry/BatchCalibration.h>
+#include <gtsam/base/TestableAssertions.h>
+
+#include <CppUnitLite/TestHarness.h>
+
+#include <stdexcept>
+
+using namespace std;
+using namespace gtsam;
+
+typedef BatchProjection::Array Array;
+
+/* ************************************************************************* */
+// Pixels spread over a 640x480 image, including the corners
+static void pixels(Array& u, Array& v) {
+  u.resize(99);
+  v.resize(99);
+  for (int k = 0; k < 99; k++) {
+    u[k] = 640.0 * (k % 11) / 10;
+    v[k] = 480.0 * (k / 11) / 8;
+  }
+}
+
+/// Compare calibrateBatch and the grid with the scalar calibrate where the
+/// scalar fixed-point iteration converges, and check the round trip anyway
+template <class CALIBRATION>
+static bool checkAgainstScalar(const CALIBRATION& K) {
+  Array u, v, x, y;
+  pixels(u, v);
+  calibrateBatch(K, u, v, x, y);
+
+  const UndistortionGrid<CALIBRATION> grid(K, 640, 480, 16);
+  Array gx, gy;
+  grid.calibrate(u, v, gx, gy);
+
+  bool ok = true;
+  size_t nrCompared = 0;
+  for (Eigen::Index k = 0; k < u.size(); k++) {
+    ok = ok && assert_equal(Point2(u[k], v[k]),
+                            K.uncalibrate(Point2(x[k], y[k])), 1e-5);
+    ok = ok && assert_equal(Point2(u[k], v[k]),
+                            K.uncalibrate(Point2(gx[k], gy[k])), 1e-5);
+    Point2 expected;
+    try {
+      expected = K.calibrate(Point2(u[k], v[k]));
+    } catch (const std::runtime_error&) {
+      continue;
+    }
+    // The scalar Cal3DS2 iteration stops at a squared pixel error of tol
+    ok = ok && assert_equal(expected, Point2(x[k], y[k]), 1e-5);
+    ok = ok && assert_equal(expected, Point2(gx[k], gy[k]), 1e-5);
+    nrCompared++;
+  }
+  return ok && nrCompared > size_t(u.size()) / 2;
+}
+
+/* ************************************************************************* */
+TEST(BatchCalibration, Cal3_S2) {
+  EXPECT(checkAgainstScalar(Cal3_S2(500, 480, 0.1, 320, 240)));
+}
+
+/* ************************************************************************* */
+TEST(BatchCalibration, Cal3Bundler) {
+  EXPECT(checkAgainstScalar(Cal3Bundler(500, 0.1, 0.01, 320, 240)));
+}
+
+/* ************************************************************************* */
+TEST(BatchCalibration, Cal3DS2) {
+  EXPECT(checkAgainstScalar(
+      Cal3DS2(500, 480, 0.1, 320, 240, -0.2, 0.05, 1e-3, -2e-3)));
+}
+
+/* ************************************************************************* */
+TEST(BatchCalibration, Cal3Unified) {
+  EXPECT(checkAgainstScalar(
+      Cal3Unified(500, 480, 0.1, 320, 240, -0.2, 0.05, 1e-3, -2e-3, 0.5)));
+}
+
+/* ************************************************************************* */
+TEST(BatchCalibration, Cal3Fisheye) {
+  EXPECT(checkAgainstScalar(
+      Cal3Fisheye(300, 300, 0.0, 320, 240, -0.01, 4e-3, -2e-3, 1e-3)));
+}
+
+/* ************************************************************************* */
+TEST(BatchCalibration, Grid) {
+  // Newton from the interpolated grid needs fewer iterations than from the
+  // pinhole guess, so it succeeds where a single iteration is not enough
+  const Cal3DS2 K(500, 480, 0.1, 320, 240, -0.2, 0.05, 1e-3, -2e-3);
+  const UndistortionGrid<Cal3DS2> grid(K, 640, 480, 4);
+  Array u, v, x, y;
+  pixels(u, v);
+  CHECK_EXCEPTION(calibrateBatch(K, u, v, x, y, 1e-5, 1), std::runtime_error);
+  grid.calibrate(u, v, x, y, 1e-5, 1);
+  for (Eigen::Index k = 0; k < u.size(); k++)
+    EXPECT(assert_equal(Point2(u[k], v[k]), K.uncalibrate(Point2(x[k], y[k])), 1e-5));
+}
+
+/* ************************************************************************* */
+int main() { TestResult tr; return TestRegistry::runAllTests(tr); }
+/* ************************************************************************* */
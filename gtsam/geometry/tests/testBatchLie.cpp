@@ -0,0 +1,128 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ *  @file   testBatchLie.cpp
+ *  @brief  Unit tests for batch Expmap and Logmap of Rot3 and Pose3
+ */
+
+#include <gtsam/geometry/BatchLie.h>
+#include <gtsam/base/TestableAssertions.h>
+
+#include <CppUnitLite/TestHarness.h>
+
+#include <random>
+
+using namespace std;
+using namespace gtsam;
+
+/* ************************************************************************* */
+// Random tangent vectors, plus the corner cases of the closed forms: zero,
+// tiny angles on both sides of the Taylor band, and angles close to pi
+static Matrix6X tangents() {
+  const vector<Vector6> special{
+      Vector6::Zero(),
+      (Vector6() << 1e-6, -2e-6, 3e-7, 0.1, -0.2, 0.3).finished(),
+      (Vector6() << 0.05, 0.07, -0.02, 1.0, 2.0, -1.0).finished(),
+      (Vector6() << 0.1, 0.0, 0.0, 0.0, 0.0, 1.0).finished(),
+      (Vector6() << 0.0, 0.0, M_PI - 1e-4, 1.0, 0.5, 0.0).finished(),
+      (Vector6() << M_PI, 0.0, 0.0, 0.2, 0.0, 0.3).finished()};
+  std::mt19937 rng(42);
+  std::uniform_real_distribution<double> uniform(-1.5, 1.5);
+  Matrix6X xis(6, special.size() + 20);
+  for (size_t i = 0; i < special.size(); i++) xis.col(i) = special[i];
+  for (Eigen::Index i = special.size(); i < xis.cols(); i++)
+    for (int j = 0; j < 6; j++) xis(j, i) = uniform(rng);
+  return xis;
+}
+
+/* ************************************************************************* */
+TEST(BatchLie, Rot3Expmap) {
+  const Matrix3X omegas = tangents().topRows<3>();
+  const size_t n = omegas.cols();
+  vector<Rot3> R(n);
+  vector<Matrix3> H(n);
+  expmapBatch(omegas, R.data(), H.data());
+  for (size_t i = 0; i < n; i++) {
+    Matrix3 expectedH;
+    const Rot3 expected = Rot3::Expmap(omegas.col(i), expectedH);
+    EXPECT(assert_equal(expected, R[i], 1e-9));
+    EXPECT(assert_equal(expectedH, H[i], 1e-9));
+  }
+
+  // Without derivatives
+  vector<Rot3> R2(n);
+  expmapBatch(omegas, R2.data());
+  for (size_t i = 0; i < n; i++) EXPECT(assert_equal(R[i], R2[i]));
+}
+
+/* ************************************************************************* */
+TEST(BatchLie, Rot3Logmap) {
+  const Matrix3X omegas = tangents().topRows<3>();
+  const size_t n = omegas.cols();
+  vector<Rot3> R;
+  for (size_t i = 0; i < n; i++) R.push_back(Rot3::Expmap(omegas.col(i)));
+  Matrix3X actual;
+  vector<Matrix3> H(n);
+  logmapBatch(R.data(), n, actual, H.data());
+  EXPECT_LONGS_EQUAL(n, actual.cols());
+  for (size_t i = 0; i < n; i++) {
+    Matrix3 expectedH;
+    const Vector3 expected = Rot3::Logmap(R[i], expectedH);
+    EXPECT(assert_equal(expected, Vector3(actual.col(i)), 1e-9));
+    EXPECT(assert_equal(expectedH, H[i], 1e-6 * expectedH.norm()));
+  }
+}
+
+/* ************************************************************************* */
+TEST(BatchLie, Pose3Expmap) {
+  const Matrix6X xis = tangents();
+  const size_t n = xis.cols();
+  vector<Pose3> T(n);
+  vector<Matrix6, Eigen::aligned_allocator<Matrix6>> H(n);
+  expmapBatch(xis, T.data(), H.data());
+  for (size_t i = 0; i < n; i++) {
+    Matrix6 expectedH;
+    const Pose3 expected = Pose3::Expmap(xis.col(i), expectedH);
+    EXPECT(assert_equal(expected, T[i], 1e-9));
+    EXPECT(assert_equal(expectedH, H[i], 1e-9));
+  }
+}
+
+/* ************************************************************************* */
+TEST(BatchLie, Pose3Logmap) {
+  const Matrix6X xis = tangents();
+  const size_t n = xis.cols();
+  vector<Pose3> T;
+  for (size_t i = 0; i < n; i++) T.push_back(Pose3::Expmap(xis.col(i)));
+  Matrix6X actual;
+  vector<Matrix6, Eigen::aligned_allocator<Matrix6>> H(n);
+  logmapBatch(T.data(), n, actual, H.data());
+  for (size_t i = 0; i < n; i++) {
+    Matrix6 expectedH;
+    const Vector6 expected = Pose3::Logmap(T[i], expectedH);
+    EXPECT(assert_equal(expected, Vector6(actual.col(i)), 1e-9));
+    EXPECT(assert_equal(expectedH, H[i], 1e-6 * expectedH.norm()));
+  }
+
+  // Round trip, which near theta = pi loses accuracy in the scalar functions
+  // as well
+  vector<Pose3> T2(n);
+  expmapBatch(actual, T2.data());
+  for (size_t i = 0; i < n; i++) {
+    EXPECT(assert_equal(Pose3::Expmap(Pose3::Logmap(T[i])), T2[i], 1e-9));
+    EXPECT(assert_equal(T[i], T2[i], 1e-7));
+  }
+}
+
+/* ************************************************************************* */
+int main() { TestResult tr; return TestRegistry::runAllTests(tr); }
+/* ************************************************************************* */
@@ -0,0 +1,109 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ *  @file   testBatchProjection.cpp
+ *  @brief  Unit tests for the structure-of-arrays BatchProjector
+ */
+
+#include <gtsam/geometry/BatchProjection.h>
+#include <gtsam/geometry/PinholeCamera.h>
+#include <gtsam/base/TestableAssertions.h>
+
+#include <CppUnitLite/TestHarness.h>
+
+using namespace std;
+using namespace gtsam;
+
+/* ************************************************************************* */
+// Three cameras looking at the origin, and points around it
+static const vector<Pose3> kPoses{
+    PinholeBase::LookatPose(Point3(0, -10, 1), Point3(0, 0, 0), Point3(0, 0, 1)),
+    PinholeBase::LookatPose(Point3(8, -6, 2), Point3(0, 0, 0), Point3(0, 0, 1)),
+    PinholeBase::LookatPose(Point3(-7, -7, 0), Point3(0, 1, 0), Point3(0, 0, 1))};
+
+static vector<Point3> points() {
+  vector<Point3> result;
+  for (int j = 0; j < 11; j++)
+    result.emplace_back(0.3 * j - 1.5, 0.1 * j, 0.5 - 0.1 * j);
+  result.emplace_back(0, -20, 0);  // behind all cameras but the third
+  return result;
+}
+
+/// Compare batch projections of all points with PinholeCamera::project
+template <class CALIBRATION>
+static bool checkAgainstScalar(const CALIBRATION& K) {
+  typedef PinholeCamera<CALIBRATION> Camera;
+  CameraSet<Camera> cameras;
+  for (const Pose3& pose : kPoses) cameras.emplace_back(pose, K);
+  const vector<Point3> ps = points();
+
+  const BatchProjector<CALIBRATION> projector(cameras);
+  BatchProjection result;
+  projector.project(BatchProjector<CALIBRATION>::Stack(ps), result);
+
+  bool ok = true;
+  for (size_t i = 0; i < cameras.size(); i++) {
+    for (size_t j = 0; j < ps.size(); j++) {
+      const Point3 q = cameras[i].pose().transformTo(ps[j]);
+      ok = ok && (result.valid[result.index(i, j)] == (q.z() > 0));
+      if (q.z() <= 0) continue;
+      Eigen::Matrix<double, 2, 6> Dpose;
+      Eigen::Matrix<double, 2, 3> Dpoint;
+      Eigen::Matrix<double, 2, traits<CALIBRATION>::dimension> Dcal;
+      const Point2 expected =
+          cameras[i].project(ps[j], Dpose, Dpoint, Dcal);
+      ok = ok && assert_equal(expected, result.measured(i, j), 1e-9);
+      ok = ok && assert_equal(Matrix(Dpose), Matrix(result.poseJacobian(i, j)), 1e-9);
+      ok = ok && assert_equal(Matrix(Dpoint), Matrix(result.pointJacobian(i, j)), 1e-9);
+      ok = ok && assert_equal(Matrix(Dcal), result.calibrationJacobian(i, j), 1e-9);
+    }
+  }
+
+  // Without derivatives, only the projections are filled
+  BatchProjection projections;
+  projector.project(BatchProjector<CALIBRATION>::Stack(ps), projections, false);
+  ok = ok && projections.Dpose.rows() == 0;
+  ok = ok && assert_equal(Vector(result.u), Vector(projections.u));
+  return ok;
+}
+
+/* ************************************************************************* */
+TEST(BatchProjection, Cal3_S2) {
+  EXPECT(checkAgainstScalar(Cal3_S2(500, 480, 0.1, 320, 240)));
+}
+
+/* ************************************************************************* */
+TEST(BatchProjection, Cal3Bundler) {
+  EXPECT(checkAgainstScalar(Cal3Bundler(500, 1e-3, 2e-3, 320, 240)));
+}
+
+/* ************************************************************************* */
+TEST(BatchProjection, Cal3DS2) {
+  EXPECT(checkAgainstScalar(
+      Cal3DS2(500, 480, 0.1, 320, 240, 1e-3, 2e-3, 3e-3, 4e-3)));
+}
+
+/* ************************************************************************* */
+TEST(BatchProjection, Cal3Unified) {
+  EXPECT(checkAgainstScalar(
+      Cal3Unified(500, 480, 0.1, 320, 240, 1e-3, 2e-3, 3e-3, 4e-3, 0.1)));
+}
+
+/* ************************************************************************* */
+TEST(BatchProjection, Cal3Fisheye) {
+  EXPECT(checkAgainstScalar(
+      Cal3Fisheye(500, 480, 0.1, 320, 240, -0.01, 4e-3, -2e-3, 1e-3)));
+}
+
+/* ************************************************************************* */
+int main() { TestResult tr; return TestRegistry::runAllTests(tr); }
+/* ************************************************************************* */
@@ -432,6 +432,75 @@ TEST( triangulation, StereotriangulateNonlinear ) {
   }
 }
 
+//******************************************************************************
+TEST( triangulation, batch) {
+  Cal3_S2 K1(1500, 1200, 0, 640, 480), K2(1600, 1300, 0, 650, 440),
+      K3(700, 500, 0, 640, 480);
+  const Pose3 pose3 =
+      pose1 * Pose3(Rot3::Ypr(0.1, 0.2, 0.1), Point3(0.1, -2, -.1));
+  CameraSet<PinholeCamera<Cal3_S2> > cameras;
+  cameras += PinholeCamera<Cal3_S2>(pose1, K1), PinholeCamera<Cal3_S2>(pose2, K2),
+      PinholeCamera<Cal3_S2>(pose3, K3);
+
+  // Behind all cameras: project without the cheirality check
+  const Point3 behind(-5, 0.5, 1.2);
+  Point2Vector behindMeasured;
+  for (const auto& camera : cameras) {
+    const Point3 q = camera.pose().transformTo(behind);
+    behindMeasured.push_back(
+        camera.calibration().uncalibrate(PinholeBase::Project(q)));
+  }
+
+  const Point2 noise(0.5, -0.3);
+  TriangulationTracks tracks;
+  tracks.add({0, 1}, {cameras[0].project(landmark), cameras[1].project(landmark)});
+  tracks.add({0, 1, 2}, {cameras[0].project(landmark) + noise,
+                         cameras[1].project(landmark) - noise,
+                         cameras[2].project(landmark) + 2.0 * noise});
+  tracks.add({1}, {cameras[1].project(landmark)});
+  tracks.add({0, 0}, {cameras[0].project(landmark), cameras[0].project(landmark)});
+  tracks.add({0, 1}, behindMeasured);
+  tracks.add({0, 1, 2}, {cameras[0].project(landmark), cameras[1].project(landmark),
+                         cameras[2].project(landmark) + Point2(10, -10)});
+  EXPECT_LONGS_EQUAL(6, tracks.size());
+  EXPECT_LONGS_EQUAL(3, tracks.length(1));
+
+  const TriangulationParameters params(1.0, true, 10, 5);
+  const vector<TriangulationResult> results =
+      triangulateBatch(cameras, tracks, params);
+  EXPECT_LONGS_EQUAL(6, results.size());
+  EXPECT(results[0].valid());
+  EXPECT(assert_equal(landmark, *results[0], 1e-7));
+  EXPECT(results[1].valid());
+  EXPECT(results[2].degenerate());
+  EXPECT(results[3].degenerate());
+  EXPECT(results[4].behindCamera());
+  EXPECT(results[5].outlier());
+
+  // Same answers as triangulateSafe, which refines with LM
+  for (size_t j : {0, 1, 2, 3, 5}) {
+    CameraSet<PinholeCamera<Cal3_S2> > trackCameras;
+    Point2Vector measured;
+    for (size_t k = tracks.offsets[j]; k < tracks.offsets[j + 1]; k++) {
+      trackCameras.push_back(cameras[tracks.cameras[k]]);
+      measured.push_back(tracks.measurements[k]);
+    }
+    const TriangulationResult expected =
+        triangulateSafe(trackCameras, measured, params);
+    EXPECT(expected.valid() == results[j].valid());
+    if (expected.valid())
+      EXPECT(assert_equal(*expected, *results[j], 1e-6));
+  }
+
+  // Far points, and no refinement
+  const vector<TriangulationResult> far =
+      triangulateBatch(cameras, tracks, TriangulationParameters(1.0, false, 4));
+  EXPECT(far[0].farPoint());
+  EXPECT(assert_equal(landmark, *triangulateBatch(cameras, tracks,
+                                                  TriangulationParameters())[0],
+                      1e-7));
+}
+
 //******************************************************************************
 int main() {
   TestResult tr;
@@ -36,6 +36,7 @@
 
 #include <cmath>
 #include <random>
+#include <thread>
 
 using namespace boost::assign;
 using namespace gtsam;
@@ -493,6 +494,30 @@ TEST(Unit3, CopyAssign) {
   EXPECT(p.error(p).isZero());
 }
 
+/* ************************************************************************* */
+TEST(Unit3, basisConcurrent) {
+  const Unit3 expected(0.1, -0.4, 0.8);
+  Matrix62 expectedH;
+  const Matrix32 expectedB = expected.basis(expectedH);
+
+  // All threads race to fill the same caches
+  const Unit3 p(0.1, -0.4, 0.8);
+  std::vector<Matrix32> B(8);
+  std::vector<Matrix62> H(8);
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < 8; i++)
+    threads.emplace_back([&, i] { B[i] = p.basis(i % 2 ? &H[i] : nullptr); });
+  for (auto& thread : threads) thread.join();
+  for (size_t i = 0; i < 8; i++) {
+    EXPECT(assert_equal(expectedB, B[i]));
+    if (i % 2) EXPECT(assert_equal(expectedH, H[i]));
+  }
+
+  // Copies share the filled caches
+  const Unit3 copy(p);
+  EXPECT(assert_equal(expectedB, copy.basis()));
+}
+
 /* ************************************************************************* */
 TEST(actualH, Serialization) {
   Unit3 p(0, 1, 0);
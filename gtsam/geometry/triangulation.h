@@ -21,6 +21,7 @@
 #include <gtsam/geometry/PinholeCamera.h>
 #include <gtsam/geometry/CameraSet.h>
 #include <gtsam/geometry/Pose2.h>
+#include <gtsam/base/parallelFor.h>
 #include <gtsam/slam/TriangulationFactor.h>
 #include <gtsam/nonlinear/NonlinearFactorGraph.h>
 #include <gtsam/inference/Symbol.h>
@@ -494,5 +495,170 @@ TriangulationResult triangulateSafe(const CameraSet<CAMERA>& cameras,
     }
 }
 
+/**
+ * Observations of many landmarks in one set of cameras, stored flat so that
+ * triangulating them does not allocate per track: observation k of track j
+ * is (cameras[offsets[j] + k], measurements[offsets[j] + k]).
+ */
+struct TriangulationTracks {
+  std::vector<size_t> offsets{0};  ///< start of every track, then the end
+  std::vector<size_t> cameras;     ///< camera index of every observation
+  Point2Vector measurements;       ///< measurement of every observation
+
+  /// Number of tracks
+  size_t size() const { return offsets.size() - 1; }
+
+  /// Number of observations of track j
+  size_t length(size_t j) const { return offsets[j + 1] - offsets[j]; }
+
+  /// Add an observation to the track under construction, see endTrack
+  void addObservation(size_t camera, const Point2& measured) {
+    cameras.push_back(camera);
+    measurements.push_back(measured);
+  }
+
+  /// Close the track under construction
+  void endTrack() { offsets.push_back(cameras.size()); }
+
+  /// Add a whole track
+  void add(const std::vector<size_t>& trackCameras,
+           const Point2Vector& trackMeasurements) {
+    assert(trackCameras.size() == trackMeasurements.size());
+    for (size_t k = 0; k < trackCameras.size(); k++)
+      addObservation(trackCameras[k], trackMeasurements[k]);
+    endTrack();
+  }
+};
+
+namespace internal {
+
+/**
+ * DLT for one track, on the 4*4 triangular factor of the DLT matrix, which is
+ * updated two rows at a time so that the track length needs no allocation.
+ * Returns false if the rank is below 3.
+ */
+template <class PROJECTIONS>
+bool triangulateTrackDLT(const PROJECTIONS& projections,
+                         const TriangulationTracks& tracks, size_t j,
+                         double rankTolerance, Point3& point) {
+  Eigen::Matrix<double, 6, 4> stacked;
+  stacked.topRows<4>().setZero();
+  for (size_t k = tracks.offsets[j]; k < tracks.offsets[j + 1]; k++) {
+    const Matrix34& P = projections[tracks.cameras[k]];
+    const Point2& p = tracks.measurements[k];
+    stacked.row(4) = p.x() * P.row(2) - P.row(0);
+    stacked.row(5) = p.y() * P.row(2) - P.row(1);
+    const Eigen::HouseholderQR<Eigen::Matrix<double, 6, 4>> qr(stacked);
+    stacked.topRows<4>() =
+        qr.matrixQR().topRows<4>().triangularView<Eigen::Upper>();
+  }
+  const Eigen::JacobiSVD<Matrix4> svd(stacked.topRows<4>(),
+                                      Eigen::ComputeFullV);
+  const Vector4& s = svd.singularValues();
+  if ((s.array() > rankTolerance).count() < 3) return false;
+  const Vector4 v = svd.matrixV().col(3);
+  point = v.head<3>() / v[3];
+  return true;
+}
+
+}  // namespace internal
+
+/**
+ * Triangulate all tracks, in parallel when GTSAM is built with TBB. This is
+ * the batch version of triangulateSafe for monocular cameras: each track
+ * runs the DLT and, if params.enableEPI is set, at most maxIterations of
+ * Gauss-Newton on the reprojection error, with fixed-size 3*3 normal
+ * equations instead of a factor graph. The same checks as triangulateSafe
+ * decide the status of each result, except that cheirality is always
+ * checked, regardless of GTSAM_THROW_CHEIRALITY_EXCEPTION.
+ * @param cameras all cameras, indexed by tracks.cameras
+ * @param tracks observations of the landmarks
+ * @param params rank tolerance, refinement and rejection thresholds
+ * @param maxIterations maximum number of Gauss-Newton iterations
+ * @return one TriangulationResult per track
+ */
+template <class CAMERA>
+std::vector<TriangulationResult> triangulateBatch(
+    const CameraSet<CAMERA>& cameras, const TriangulationTracks& tracks,
+    const TriangulationParameters& params, size_t maxIterations = 10) {
+  std::vector<Matrix34, Eigen::aligned_allocator<Matrix34>> projections(
+      cameras.size());
+  parallelFor(cameras.size(), [&](size_t i) {
+    projections[i] = CameraProjectionMatrix<typename CAMERA::CalibrationType>(
+        cameras[i].calibration())(cameras[i].pose());
+  });
+
+  std::vector<TriangulationResult> results(tracks.size());
+  parallelFor(tracks.size(), [&](size_t j) {
+    const size_t begin = tracks.offsets[j], end = tracks.offsets[j + 1];
+    Point3 point;
+    if (end - begin < 2 || !internal::triangulateTrackDLT(
+                               projections, tracks, j, params.rankTolerance,
+                               point)) {
+      results[j] = TriangulationResult::Degenerate();
+      return;
+    }
+
+    // Cheirality, then squared reprojection error and normal equations
+    Matrix3 H;
+    Vector3 g;
+    double error;
+    auto linearize = [&](const Point3& p) {
+      H.setZero();
+      g.setZero();
+      error = 0.0;
+      for (size_t k = begin; k < end; k++) {
+        const CAMERA& camera = cameras[tracks.cameras[k]];
+        if (camera.pose().transformTo(p).z() <= 0) return false;
+        Eigen::Matrix<double, 2, 3> D;
+        const Vector2 e =
+            camera.project2(p, boost::none, D) - tracks.measurements[k];
+        H.noalias() += D.transpose() * D;
+        g.noalias() += D.transpose() * e;
+        error += e.squaredNorm();
+      }
+      return true;
+    };
+    if (!linearize(point)) {
+      results[j] = TriangulationResult::BehindCamera();
+      return;
+    }
+
+    // Gauss-Newton, stopping when the error no longer decreases
+    if (params.enableEPI) {
+      for (size_t iteration = 0; iteration < maxIterations; iteration++) {
+        const Vector3 delta = H.ldlt().solve(g);
+        const Point3 candidate = point - delta;
+        const double previous = error;
+        if (!linearize(candidate) || error > previous) break;
+        point = candidate;
+        if (delta.norm() < 1e-9 * (1.0 + point.norm())) break;
+      }
+    }
+
+    // Far points and outliers, as in triangulateSafe
+    double maxReprojError = 0.0;
+    for (size_t k = begin; k < end; k++) {
+      const CAMERA& camera = cameras[tracks.cameras[k]];
+      if (params.landmarkDistanceThreshold > 0 &&
+          distance3(camera.pose().translation(), point) >
+              params.landmarkDistanceThreshold) {
+        results[j] = TriangulationResult::FarPoint();
+        return;
+      }
+      if (params.dynamicOutlierRejectionThreshold > 0)
+        maxReprojError = std::max(
+            maxReprojError,
+            (camera.project2(point) - tracks.measurements[k]).norm());
+    }
+    if (params.dynamicOutlierRejectionThreshold > 0 &&
+        maxReprojError > params.dynamicOutlierRejectionThreshold)
+      results[j] = TriangulationResult::Outlier();
+    else
+      results[j] = TriangulationResult(point);
+  });
+  return results;
+}
+
 } // \namespace gtsam
 
@@ -27,6 +27,10 @@
  *     - Specify by-value (not reference) return types, even if C++ method returns reference
  *     - Must start with a letter (upper or lowercase)
  *     - Overloads are supported
+ *     - Prefix with [[release_gil]] to release the Python GIL for the duration of a long
+ *       call in the Python wrapper, e.g. "[[release_gil]] gtsam::Values optimize();".
+ *       Only use it for calls which never call back into Python or touch Python objects.
+ *       The wrapped object must not be used from another thread while the call runs.
  *   Static methods
  *     - Must start with a letter (upper or lowercase) and use the "static" keyword
  *     - The first letter will be made uppercase in the generated MATLAB interface
@@ -2341,13 +2345,13 @@ virtual class DoglegParams : gtsam::NonlinearOptimizerParams {
 
 #include <gtsam/nonlinear/NonlinearOptimizer.h>
 virtual class NonlinearOptimizer {
-  gtsam::Values optimize();
-  gtsam::Values optimizeSafely();
+  [[release_gil]] gtsam::Values optimize();
+  [[release_gil]] gtsam::Values optimizeSafely();
   double error() const;
   int iterations() const;
   gtsam::Values values() const;
   gtsam::NonlinearFactorGraph graph() const;
-  gtsam::GaussianFactorGraph* iterate() const;
+  [[release_gil]] gtsam::GaussianFactorGraph* iterate() const;
 };
 
 #include <gtsam/nonlinear/GaussNewtonOptimizer.h>
@@ -2477,13 +2481,13 @@ class ISAM2 {
   void printStats() const;
   void saveGraph(string s) const;
 
-  gtsam::ISAM2Result update();
-  gtsam::ISAM2Result update(const gtsam::NonlinearFactorGraph& newFactors, const gtsam::Values& newTheta);
-  gtsam::ISAM2Result update(const gtsam::NonlinearFactorGraph& newFactors, const gtsam::Values& newTheta, const gtsam::FactorIndices& removeFactorIndices);
-  gtsam::ISAM2Result update(const gtsam::NonlinearFactorGraph& newFactors, const gtsam::Values& newTheta, const gtsam::FactorIndices& removeFactorIndices, const gtsam::KeyGroupMap& constrainedKeys);
-  gtsam::ISAM2Result update(const gtsam::NonlinearFactorGraph& newFactors, const gtsam::Values& newTheta, const gtsam::FactorIndices& removeFactorIndices, gtsam::KeyGroupMap& constrainedKeys, const gtsam::KeyList& noRelinKeys);
-  gtsam::ISAM2Result update(const gtsam::NonlinearFactorGraph& newFactors, const gtsam::Values& newTheta, const gtsam::FactorIndices& removeFactorIndices, gtsam::KeyGroupMap& constrainedKeys, const gtsam::KeyList& noRelinKeys, const gtsam::KeyList& extraReelimKeys);
-  gtsam::ISAM2Result update(const gtsam::NonlinearFactorGraph& newFactors, const gtsam::Values& newTheta, const gtsam::FactorIndices& removeFactorIndices, gtsam::KeyGroupMap& constrainedKeys, const gtsam::KeyList& noRelinKeys, const gtsam::KeyList& extraReelimKeys, bool force_relinearize);
+  [[release_gil]] gtsam::ISAM2Result update();
+  [[release_gil]] gtsam::ISAM2Result update(const gtsam::NonlinearFactorGraph& newFactors, const gtsam::Values& newTheta);
+  [[release_gil]] gtsam::ISAM2Result update(const gtsam::NonlinearFactorGraph& newFactors, const gtsam::Values& newTheta, const gtsam::FactorIndices& removeFactorIndices);
+  [[release_gil]] gtsam::ISAM2Result update(const gtsam::NonlinearFactorGraph& newFactors, const gtsam::Values& newTheta, const gtsam::FactorIndices& removeFactorIndices, const gtsam::KeyGroupMap& constrainedKeys);
+  [[release_gil]] gtsam::ISAM2Result update(const gtsam::NonlinearFactorGraph& newFactors, const gtsam::Values& newTheta, const gtsam::FactorIndices& removeFactorIndices, gtsam::KeyGroupMap& constrainedKeys, const gtsam::KeyList& noRelinKeys);
+  [[release_gil]] gtsam::ISAM2Result update(const gtsam::NonlinearFactorGraph& newFactors, const gtsam::Values& newTheta, const gtsam::FactorIndices& removeFactorIndices, gtsam::KeyGroupMap& constrainedKeys, const gtsam::KeyList& noRelinKeys, const gtsam::KeyList& extraReelimKeys);
+  [[release_gil]] gtsam::ISAM2Result update(const gtsam::NonlinearFactorGraph& newFactors, const gtsam::Values& newTheta, const gtsam::FactorIndices& removeFactorIndices, gtsam::KeyGroupMap& constrainedKeys, const gtsam::KeyList& noRelinKeys, const gtsam::KeyList& extraReelimKeys, bool force_relinearize);
 
   gtsam::Values getLinearizationPoint() const;
   gtsam::Values calculateEstimate() const;
@@ -2511,7 +2515,7 @@ class NonlinearISAM {
   Matrix marginalCovariance(size_t key) const;
   int reorderInterval() const;
   int reorderCounter() const;
-  void update(const gtsam::NonlinearFactorGraph& newFactors, const gtsam::Values& initialValues);
+  [[release_gil]] void update(const gtsam::NonlinearFactorGraph& newFactors, const gtsam::Values& initialValues);
   void reorder_relinearize();
 
   // These might be expensive as instead of a reference the wrapper will make a copy
@@ -2971,7 +2975,7 @@ class ShonanAveraging2 {
   // Basic API
   double cost(const gtsam::Values& values) const;
   gtsam::Values initializeRandomly() const;
-  pair<gtsam::Values, double> run(const gtsam::Values& initial, size_t min_p, size_t max_p) const;
+  [[release_gil]] pair<gtsam::Values, double> run(const gtsam::Values& initial, size_t min_p, size_t max_p) const;
 };
 
 class ShonanAveraging3 {
@@ -3016,7 +3020,7 @@ class ShonanAveraging3 {
   // Basic API
   double cost(const gtsam::Values& values) const;
   gtsam::Values initializeRandomly() const;
-  pair<gtsam::Values, double> run(const gtsam::Values& initial, size_t min_p, size_t max_p) const;
+  [[release_gil]] pair<gtsam::Values, double> run(const gtsam::Values& initial, size_t min_p, size_t max_p) const;
 };
 
 #include <gtsam/sfm/MFAS.h>
@@ -3408,6 +3412,15 @@ namespace utilities {
   Matrix extractPose2(const gtsam::Values& values);
   gtsam::Values allPose3s(gtsam::Values& values);
   Matrix extractPose3(const gtsam::Values& values);
+  Matrix extractPose3Matrices(const gtsam::Values& values);
+  void insertPoint2s(gtsam::Values& values, const gtsam::KeyVector& keys, Matrix points);
+  void insertPoint3s(gtsam::Values& values, const gtsam::KeyVector& keys, Matrix points);
+  void insertPose2s(gtsam::Values& values, const gtsam::KeyVector& keys, Matrix poses);
+  void insertPose3s(gtsam::Values& values, const gtsam::KeyVector& keys, Matrix poses);
+  void insertBetweenFactorPose2s(gtsam::NonlinearFactorGraph& graph, const gtsam::KeyVector& keys1, const gtsam::KeyVector& keys2, Matrix measured, const gtsam::noiseModel::Base* model);
+  void insertBetweenFactorPose3s(gtsam::NonlinearFactorGraph& graph, const gtsam::KeyVector& keys1, const gtsam::KeyVector& keys2, Matrix measured, const gtsam::noiseModel::Base* model);
+  gtsam::VectorValues createVectorValues(const gtsam::KeyVector& keys, Matrix X);
+  Matrix extractVectors(const gtsam::VectorValues& x, const gtsam::KeyVector& keys);
   void perturbPoint2(gtsam::Values& values, double sigma, int seed);
   void perturbPose2 (gtsam::Values& values, double sigmaT, double sigmaR, int seed);
   void perturbPoint3(gtsam::Values& values, double sigma, int seed);
@@ -12,6 +12,7 @@
 #include <gtsam/inference/ClusterTree.h>
 #include <gtsam/inference/BayesTree.h>
 #include <gtsam/inference/Ordering.h>
+#include <gtsam/base/Metrics.h>
 #include <gtsam/base/timing.h>
 #include <gtsam/base/treeTraversal-inst.h>
 
@@ -215,11 +216,55 @@ EliminatableClusterTree<BAYESTREE, GRAPH>& EliminatableClusterTree<BAYESTREE, GR
   return *this;
 }
 
+/* ************************************************************************* */
+namespace internal {
+// Scalar dimension of a variable of a Gaussian conditional
+template <class CONDITIONAL>
+auto variableDim(const CONDITIONAL& conditional,
+                 typename CONDITIONAL::const_iterator variable, int)
+    -> decltype(static_cast<size_t>(conditional.getDim(variable))) {
+  return conditional.getDim(variable);
+}
+
+// Discrete and symbolic variables count as one
+template <class CONDITIONAL>
+size_t variableDim(const CONDITIONAL&, typename CONDITIONAL::const_iterator,
+                   long) {
+  return 1;
+}
+
+// Report clique statistics of a freshly eliminated Bayes tree
+template <class BAYESTREE>
+void recordEliminationMetrics(MetricsSink* sink, const BAYESTREE& bayesTree) {
+  size_t nrCliques = 0, maxCliqueDim = 0;
+  double flops = 0;
+  for (const auto& node : bayesTree.nodes()) {
+    const auto& conditional = *node.second->conditional();
+    if (conditional.frontals().front() != node.first) continue;
+    size_t frontalDim = 0, separatorDim = 0;
+    for (auto it = conditional.beginFrontals(); it != conditional.endFrontals(); ++it)
+      frontalDim += variableDim(conditional, it, 0);
+    for (auto it = conditional.beginParents(); it != conditional.endParents(); ++it)
+      separatorDim += variableDim(conditional, it, 0);
+    // Dense partial factorization of a frontal x (frontal + separator) front
+    const double f = frontalDim, s = separatorDim;
+    flops += f * f * f / 3 + f * f * s + f * s * s;
+    maxCliqueDim = std::max(maxCliqueDim, frontalDim + separatorDim);
+    ++nrCliques;
+  }
+  static const char* const source = "EliminatableClusterTree";
+  sink->record(source, 0, "cliques", nrCliques);
+  sink->record(source, 0, "max_clique_dim", maxCliqueDim);
+  sink->record(source, 0, "flops", flops);
+}
+}  // namespace internal
+
 /* ************************************************************************* */
 template <class BAYESTREE, class GRAPH>
 std::pair<boost::shared_ptr<BAYESTREE>, boost::shared_ptr<GRAPH> >
 EliminatableClusterTree<BAYESTREE, GRAPH>::eliminate(const Eliminate& function) const {
   gttic(ClusterTree_eliminate);
+  MetricsTimer timer("EliminatableClusterTree", 0, "eliminate_seconds");
   // Do elimination (depth-first traversal).  The rootsContainer stores a 'dummy' BayesTree node
   // that contains all of the roots as its children.  rootsContainer also stores the remaining
   // un-eliminated factors passed up from the roots.
@@ -248,6 +293,10 @@ EliminatableClusterTree<BAYESTREE, GRAPH>::eliminate(const Eliminate& function)
       remaining->push_back(factor);
   }
 
+  timer.stop();
+  if (MetricsSink* sink = metricsSink())
+    internal::recordEliminationMetrics(sink, *result);
+
   // Return result
   return std::make_pair(result, remaining);
 }
@@ -0,0 +1,232 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file   BayesTreeSnapshot.cpp
+ * @brief  Compact binary snapshots of Gaussian Bayes trees
+ * @date   October 2026
+ */
+
+#include <gtsam/linear/BayesTreeSnapshot.h>
+#include <gtsam/base/MappedFile.h>
+#include <gtsam/base/parallelFor.h>
+
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+using namespace std;
+
+namespace gtsam {
+
+namespace {
+
+const char kMagic[8] = {'G', 'T', 'S', 'A', 'M', 'B', 'T', '\0'};
+const size_t kHeaderSize = 64;
+
+void requireLittleEndian(const string& caller) {
+  const uint16_t one = 1;
+  unsigned char first;
+  memcpy(&first, &one, 1);
+  if (first != 1)
+    throw runtime_error(caller + ": snapshots need a little-endian host");
+}
+
+template <typename T>
+void writeColumn(const vector<T>& column, ostream& os) {
+  static const char padding[8] = {0};
+  const size_t bytes = column.size() * sizeof(T);
+  os.write(reinterpret_cast<const char*>(column.data()), bytes);
+  os.write(padding, (8 - bytes % 8) % 8);
+}
+
+// Hands out the columns following the header, checking they are in the file
+class ColumnReader {
+ public:
+  ColumnReader(const char* begin, const char* end) : p_(begin), end_(end) {}
+
+  template <typename T>
+  const T* take(size_t n) {
+    const size_t bytes = (n * sizeof(T) + 7) & ~size_t(7);
+    if (n > size_t(end_ - p_) / sizeof(T) || bytes > size_t(end_ - p_))
+      throw invalid_argument("readBayesTreeSnapshot: truncated file");
+    const T* column = reinterpret_cast<const T*>(p_);
+    p_ += bytes;
+    return column;
+  }
+
+ private:
+  const char *p_, *end_;
+};
+
+BayesTreeSnapshotModel modelType(const SharedDiagonal& model) {
+  typedef BayesTreeSnapshotModel M;
+  if (!model) return M::NONE;
+  const noiseModel::Diagonal& m = *model;
+  const type_info& type = typeid(m);
+  if (type == typeid(noiseModel::Unit)) return M::UNIT;
+  if (type == typeid(noiseModel::Isotropic)) return M::ISOTROPIC;
+  if (type == typeid(noiseModel::Constrained)) return M::CONSTRAINED;
+  if (type == typeid(noiseModel::Diagonal)) return M::DIAGONAL;
+  throw invalid_argument("writeBayesTreeSnapshot: unsupported noise model");
+}
+
+SharedDiagonal createModel(BayesTreeSnapshotModel type, const double* sigmas,
+                           size_t rows) {
+  typedef BayesTreeSnapshotModel M;
+  const Eigen::Map<const Vector> s(sigmas, rows);
+  switch (type) {
+    case M::UNIT: return noiseModel::Unit::Create(rows);
+    case M::ISOTROPIC: return noiseModel::Isotropic::Sigma(rows, s(0), false);
+    case M::CONSTRAINED: return noiseModel::Constrained::MixedSigmas(s);
+    case M::DIAGONAL: return noiseModel::Diagonal::Sigmas(s, false);
+    default: return SharedDiagonal();
+  }
+}
+
+}  // namespace
+
+/* ************************************************************************* */
+void internal::writeBayesTreeSnapshot(
+    const vector<const GaussianConditional*>& conditionals,
+    const vector<int64_t>& parents, const string& filename) {
+  requireLittleEndian("writeBayesTreeSnapshot");
+  const size_t n = conditionals.size();
+  vector<uint64_t> keyOffsets(1, 0), keys, dataOffsets(1, 0);
+  vector<uint32_t> nrFrontals, rows, models, dims;
+  nrFrontals.reserve(n);
+  rows.reserve(n);
+  models.reserve(n);
+  keyOffsets.reserve(n + 1);
+  dataOffsets.reserve(n + 1);
+  for (const GaussianConditional* conditional : conditionals) {
+    const VerticalBlockMatrix& Ab = conditional->matrixObject();
+    keys.insert(keys.end(), conditional->begin(), conditional->end());
+    for (size_t k = 0; k < conditional->size(); k++)
+      dims.push_back(uint32_t(Ab(k).cols()));
+    keyOffsets.push_back(keys.size());
+    nrFrontals.push_back(uint32_t(conditional->nrFrontals()));
+    rows.push_back(uint32_t(Ab.rows()));
+    const BayesTreeSnapshotModel model = modelType(conditional->get_model());
+    models.push_back(uint32_t(model));
+    dataOffsets.push_back(dataOffsets.back() + Ab.rows() * Ab.cols() +
+                          (model == BayesTreeSnapshotModel::NONE ? 0 : Ab.rows()));
+  }
+
+  ofstream os(filename.c_str(), ios::binary);
+  if (!os)
+    throw invalid_argument("writeBayesTreeSnapshot: can not open " + filename);
+  char header[kHeaderSize] = {0};
+  memcpy(header, kMagic, sizeof(kMagic));
+  const uint32_t version = kBayesTreeSnapshotVersion;
+  const uint64_t counts[3] = {n, keys.size(), dataOffsets.back()};
+  memcpy(header + 8, &version, sizeof(version));
+  memcpy(header + 16, counts, sizeof(counts));
+  os.write(header, kHeaderSize);
+  writeColumn(parents, os);
+  writeColumn(keyOffsets, os);
+  writeColumn(nrFrontals, os);
+  writeColumn(rows, os);
+  writeColumn(models, os);
+  writeColumn(keys, os);
+  writeColumn(dims, os);
+  writeColumn(dataOffsets, os);
+
+  // The matrices are written one clique at a time rather than gathered first
+  vector<double> data;
+  for (const GaussianConditional* conditional : conditionals) {
+    const auto Ab = conditional->matrixObject().full();
+    data.resize(Ab.size());
+    Eigen::Map<Matrix>(data.data(), Ab.rows(), Ab.cols()) = Ab;
+    if (const SharedDiagonal& model = conditional->get_model()) {
+      const Vector sigmas = model->sigmas();
+      data.insert(data.end(), sigmas.data(), sigmas.data() + sigmas.size());
+    }
+    os.write(reinterpret_cast<const char*>(data.data()),
+             data.size() * sizeof(double));
+  }
+  if (!os)
+    throw runtime_error("writeBayesTreeSnapshot: error writing " + filename);
+}
+
+/* ************************************************************************* */
+GaussianBayesTree readBayesTreeSnapshot(const string& filename) {
+  requireLittleEndian("readBayesTreeSnapshot");
+  const MappedFile file(filename);
+  const char* base = file.begin();
+  if (file.size() < kHeaderSize || memcmp(base, kMagic, sizeof(kMagic)) != 0)
+    throw invalid_argument("readBayesTreeSnapshot: " + filename +
+                           " is not a Bayes tree snapshot");
+  uint32_t version;
+  uint64_t counts[3];
+  memcpy(&version, base + 8, sizeof(version));
+  memcpy(counts, base + 16, sizeof(counts));
+  if (version == 0 || version > kBayesTreeSnapshotVersion)
+    throw invalid_argument("readBayesTreeSnapshot: " + filename +
+                           " has unsupported version " + to_string(version));
+  const size_t n = counts[0], m = counts[1], nrDoubles = counts[2];
+
+  ColumnReader reader(base + kHeaderSize, file.end());
+  const int64_t* parents = reader.take<int64_t>(n);
+  const uint64_t* keyOffsets = reader.take<uint64_t>(n + 1);
+  const uint32_t* nrFrontals = reader.take<uint32_t>(n);
+  const uint32_t* rows = reader.take<uint32_t>(n);
+  const uint32_t* models = reader.take<uint32_t>(n);
+  const uint64_t* keys = reader.take<uint64_t>(m);
+  const uint32_t* dims = reader.take<uint32_t>(m);
+  const uint64_t* dataOffsets = reader.take<uint64_t>(n + 1);
+  const double* data = reader.take<double>(nrDoubles);
+
+  // Check everything the parallel loop below relies on
+  if (keyOffsets[0] != 0 || keyOffsets[n] != m || dataOffsets[0] != 0 ||
+      dataOffsets[n] != nrDoubles)
+    throw invalid_argument("readBayesTreeSnapshot: invalid offsets");
+  for (size_t i = 0; i < n; i++) {
+    if (parents[i] >= int64_t(i) || parents[i] < -1 ||
+        keyOffsets[i + 1] < keyOffsets[i] ||
+        nrFrontals[i] > keyOffsets[i + 1] - keyOffsets[i] ||
+        models[i] > uint32_t(BayesTreeSnapshotModel::UNIT))
+      throw invalid_argument("readBayesTreeSnapshot: invalid clique " +
+                             to_string(i));
+    uint64_t cols = 1;
+    for (uint64_t k = keyOffsets[i]; k < keyOffsets[i + 1]; k++) cols += dims[k];
+    const uint64_t expected =
+        rows[i] * (cols + (models[i] == 0 ? 0 : 1));
+    if (dataOffsets[i + 1] < dataOffsets[i] ||
+        dataOffsets[i + 1] - dataOffsets[i] != expected)
+      throw invalid_argument("readBayesTreeSnapshot: invalid clique " +
+                             to_string(i));
+  }
+
+  vector<GaussianBayesTreeClique::shared_ptr> cliques(n);
+  parallelFor(n, [&](size_t i) {
+    const KeyVector cliqueKeys(keys + keyOffsets[i], keys + keyOffsets[i + 1]);
+    const uint32_t* first = dims + keyOffsets[i];
+    VerticalBlockMatrix Ab(first, first + cliqueKeys.size(), rows[i], true);
+    const double* d = data + dataOffsets[i];
+    Ab.matrix() = Eigen::Map<const Matrix>(d, Ab.rows(), Ab.cols());
+    const SharedDiagonal model = createModel(BayesTreeSnapshotModel(models[i]),
+                                             d + Ab.rows() * Ab.cols(), rows[i]);
+    cliques[i] = boost::make_shared<GaussianBayesTreeClique>(
+        boost::make_shared<GaussianConditional>(cliqueKeys, nrFrontals[i], Ab,
+                                                model));
+  });
+
+  // Pre-order puts every parent before its children, in their original order
+  GaussianBayesTree bayesTree;
+  for (size_t i = 0; i < n; i++)
+    bayesTree.addClique(cliques[i], parents[i] < 0
+                                        ? GaussianBayesTreeClique::shared_ptr()
+                                        : cliques[parents[i]]);
+  return bayesTree;
+}
+
+}  // namespace gtsam
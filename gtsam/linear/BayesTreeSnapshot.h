@@ -0,0 +1,98 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file   BayesTreeSnapshot.h
+ * @brief  Compact binary snapshots of Gaussian Bayes trees
+ * @date   October 2026
+ *
+ * A snapshot stores the cliques of a Bayes tree in pre-order, with the tree
+ * topology as an array of parent indices and the augmented matrices of all
+ * conditionals back to back in one column-major array, instead of boost
+ * serialization's tracked clique pointers. Layout, all little-endian:
+ *
+ *   header, 64 bytes:
+ *     char[8] magic "GTSAMBT\0", uint32 version, uint32 reserved,
+ *     uint64 number of cliques n, uint64 number of keys m,
+ *     uint64 number of doubles, zero padding
+ *   columns, each padded to a multiple of 8 bytes:
+ *     int64 parent[n]              parent index, -1 for roots
+ *     uint64 keyOffset[n+1]        keys of clique i are [keyOffset[i], keyOffset[i+1])
+ *     uint32 nrFrontals[n], uint32 rows[n]
+ *     uint32 model[n]              BayesTreeSnapshotModel of the conditional
+ *     uint64 key[m], uint32 dim[m]
+ *     uint64 dataOffset[n+1]
+ *     double data[]                per clique: [R S d] column-major, then the
+ *                                  rows sigmas of the noise model, if any
+ */
+
+#pragma once
+
+#include <gtsam/linear/GaussianBayesTree.h>
+#include <gtsam/linear/GaussianConditional.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace gtsam {
+
+/// Version written by writeBayesTreeSnapshot
+static const uint32_t kBayesTreeSnapshotVersion = 1;
+
+/// Noise models of the conditionals in a snapshot
+enum class BayesTreeSnapshotModel : uint32_t {
+  NONE = 0, DIAGONAL = 1, CONSTRAINED = 2, ISOTROPIC = 3, UNIT = 4
+};
+
+namespace internal {
+/// Write conditionals in pre-order, with the index of each parent or -1
+GTSAM_EXPORT void writeBayesTreeSnapshot(
+    const std::vector<const GaussianConditional*>& conditionals,
+    const std::vector<int64_t>& parents, const std::string& filename);
+}  // namespace internal
+
+/**
+ * Write a snapshot of a Bayes tree whose cliques hold GaussianConditionals,
+ * e.g. a GaussianBayesTree or the Bayes tree of an ISAM2 instance. Only the
+ * conditionals and topology are stored; clique caches such as the ISAM2
+ * gradient contributions are not.
+ */
+template <class CLIQUE>
+void writeBayesTreeSnapshot(const BayesTree<CLIQUE>& bayesTree,
+                            const std::string& filename) {
+  std::vector<const GaussianConditional*> conditionals;
+  std::vector<int64_t> parents;
+  std::vector<std::pair<const CLIQUE*, int64_t>> stack;
+  for (auto root = bayesTree.roots().rbegin(); root != bayesTree.roots().rend();
+       ++root)
+    stack.emplace_back(root->get(), -1);
+  while (!stack.empty()) {
+    const CLIQUE* clique = stack.back().first;
+    parents.push_back(stack.back().second);
+    stack.pop_back();
+    const int64_t index = conditionals.size();
+    conditionals.push_back(clique->conditional().get());
+    for (auto child = clique->children.rbegin(); child != clique->children.rend();
+         ++child)
+      stack.emplace_back(child->get(), index);
+  }
+  internal::writeBayesTreeSnapshot(conditionals, parents, filename);
+}
+
+/**
+ * Read a snapshot written by writeBayesTreeSnapshot. The conditionals are
+ * created in parallel straight from the memory-mapped file, then linked.
+ * Throws std::invalid_argument if the file is not a valid snapshot.
+ */
+GTSAM_EXPORT GaussianBayesTree readBayesTreeSnapshot(const std::string& filename);
+
+}  // namespace gtsam
@@ -41,6 +41,7 @@ public:
   /* Matrix Operation Kernel */
   enum BLASKernel {
     GTSAM = 0,        ///< Jacobian Factor Graph of GTSAM
+    PACKED,           ///< Matrix-free packed operator, see JacobianOperator and ImplicitSchurOperator
   } blas_kernel_ ;
 
   ConjugateGradientParameters()
@@ -54,7 +55,7 @@ public:
 
   ConjugateGradientParameters(const ConjugateGradientParameters &p)
     : Base(p), minIterations_(p.minIterations_), maxIterations_(p.maxIterations_), reset_(p.reset_),
-               epsilon_rel_(p.epsilon_rel_), epsilon_abs_(p.epsilon_abs_), blas_kernel_(GTSAM) {}
+               epsilon_rel_(p.epsilon_rel_), epsilon_abs_(p.epsilon_abs_), blas_kernel_(p.blas_kernel_) {}
 
   /* general interface */
   inline size_t minIterations() const { return minIterations_; }
@@ -63,6 +64,7 @@ public:
   inline double epsilon() const { return epsilon_rel_; }
   inline double epsilon_rel() const { return epsilon_rel_; }
   inline double epsilon_abs() const { return epsilon_abs_; }
+  inline BLASKernel blasKernel() const { return blas_kernel_; }
 
   inline size_t getMinIterations() const { return minIterations_; }
   inline size_t getMaxIterations() const { return maxIterations_; }
@@ -77,6 +79,7 @@ public:
   inline void setEpsilon(double value) { epsilon_rel_ = value; }
   inline void setEpsilon_rel(double value) { epsilon_rel_ = value; }
   inline void setEpsilon_abs(double value) { epsilon_abs_ = value; }
+  inline void setBlasKernel(BLASKernel value) { blas_kernel_ = value; }
 
 
   void print() const { Base::print(); }
@@ -183,7 +183,9 @@ namespace gtsam {
     /**
      * Return vector of i, j, and s to generate an m-by-n sparse Jacobian matrix,
      * where i(k) and j(k) are the base 0 row and column indices, s(k) a double.
-     * The standard deviations are baked into A and b
+     * The standard deviations are baked into A and b.
+     * See sparseJacobianEigen and SparseEigenBuilder in SparseEigen.h for a
+     * parallel export to Eigen::SparseMatrix.
      */
     std::vector<boost::tuple<size_t, size_t, double> > sparseJacobian() const;
 
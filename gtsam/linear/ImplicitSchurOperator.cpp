@@ -0,0 +1,238 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file   ImplicitSchurOperator.cpp
+ * @brief  Matrix-free reduced camera system of implicit Schur factors, for PCG
+ * @date   October 2026
+ */
+
+#include <gtsam/linear/ImplicitSchurOperator.h>
+#include <gtsam/linear/GaussianFactorGraph.h>
+#include <gtsam/base/parallelFor.h>
+#include <gtsam/base/timing.h>
+
+#include <boost/make_shared.hpp>
+
+#include <cassert>
+#include <stdexcept>
+
+using namespace std;
+
+namespace gtsam {
+
+/* ************************************************************************* */
+ImplicitSchurOperator::ImplicitSchurOperator(const GaussianFactorGraph& gfg,
+                                             const KeyInfo& keyInfo)
+    : keyInfo_(keyInfo), zDim_(0), cameraDim_(0) {
+  gttic(ImplicitSchurOperator_initialize);
+
+  // Split the graph into implicit Schur factors and the rest
+  vector<pair<const GaussianFactor*, const ImplicitSchurBlocks*> > implicit;
+  GaussianFactorGraph rest;
+  for (const auto& factor : gfg) {
+    if (!factor) continue;
+    const auto blocks = dynamic_cast<const ImplicitSchurBlocks*>(factor.get());
+    if (!blocks) {
+      rest.push_back(factor);
+      continue;
+    }
+    if (implicit.empty()) {
+      zDim_ = blocks->zDim();
+      cameraDim_ = blocks->cameraDim();
+    } else if (blocks->zDim() != zDim_ || blocks->cameraDim() != cameraDim_) {
+      throw invalid_argument(
+          "ImplicitSchurOperator: all implicit Schur factors need the same "
+          "measurement and camera dimensions");
+    }
+    implicit.emplace_back(factor.get(), blocks);
+  }
+
+  // Observation layout, and a slot for every camera in order of appearance
+  vector<int> slot(keyInfo_.size(), -1);
+  obsPtr_.assign(1, 0);
+  for (const auto& item : implicit) {
+    for (Key key : item.first->keys()) {
+      const auto entry = keyInfo_.find(key);
+      if (entry == keyInfo_.end())
+        throw invalid_argument("ImplicitSchurOperator: factor key not in KeyInfo");
+      obsCol_.push_back(entry->second.start);
+      if (slot[entry->second.index] < 0) {
+        slot[entry->second.index] = camVar_.size();
+        camVar_.push_back(entry->second.index);
+        camCol_.push_back(entry->second.start);
+      }
+    }
+    obsPtr_.push_back(obsCol_.size());
+  }
+
+  // Pack all blocks, in parallel over landmarks
+  const size_t nrObs = obsCol_.size(), ZD = zDim_ * cameraDim_;
+  F_.resize(nrObs * ZD);
+  E_.resize(nrObs * zDim_ * 3);
+  P_.resize(implicit.size() * 9);
+  b_.resize(nrObs * zDim_);
+  parallelFor(implicit.size(), [&](size_t l) {
+    const size_t o = obsPtr_[l];
+    implicit[l].second->packBlocks(F_.data() + o * ZD, E_.data() + o * zDim_ * 3,
+                                   P_.data() + l * 9, b_.data() + o * zDim_);
+  });
+
+  // Camera-major index by counting sort on cameras
+  camPtr_.assign(camVar_.size() + 1, 0);
+  vector<size_t> obsCamera(nrObs);
+  for (size_t l = 0, o = 0; l < implicit.size(); ++l)
+    for (Key key : implicit[l].first->keys()) {
+      obsCamera[o] = slot[keyInfo_.at(key).index];
+      ++camPtr_[obsCamera[o++] + 1];
+    }
+  for (size_t c = 0; c < camVar_.size(); ++c) camPtr_[c + 1] += camPtr_[c];
+  camObs_.resize(nrObs);
+  vector<size_t> next(camPtr_.begin(), camPtr_.end() - 1);
+  for (size_t o = 0; o < nrObs; ++o) camObs_[next[obsCamera[o]]++] = o;
+
+  if (!rest.empty()) rest_ = boost::make_shared<JacobianOperator>(rest, keyInfo_);
+
+  // Right-hand side, from b
+  workspace_.resize(nrObs * zDim_);
+  rhs_ = Vector::Zero(keyInfo_.numCols());
+  if (zDim_ == 2 && cameraDim_ == 6)
+    schurProduct<2, 6>(1.0, nullptr, rhs_);
+  else if (zDim_ == 2 && cameraDim_ == 9)
+    schurProduct<2, 9>(1.0, nullptr, rhs_);
+  else if (zDim_ == 2 && cameraDim_ == 11)
+    schurProduct<2, 11>(1.0, nullptr, rhs_);
+  else if (zDim_ == 3 && cameraDim_ == 6)
+    schurProduct<3, 6>(1.0, nullptr, rhs_);
+  else if (nrObs > 0)
+    schurProduct<Eigen::Dynamic, Eigen::Dynamic>(1.0, nullptr, rhs_);
+  if (rest_) rest_->transposeMultiplyAdd(1.0, rest_->b(), rhs_);
+}
+
+/* ************************************************************************* */
+bool ImplicitSchurOperator::Applies(const GaussianFactorGraph& gfg) {
+  for (const auto& factor : gfg)
+    if (dynamic_cast<const ImplicitSchurBlocks*>(factor.get())) return true;
+  return false;
+}
+
+/* ************************************************************************* */
+template <int Z, int D>
+void ImplicitSchurOperator::schurProduct(double alpha, const double* x,
+                                         Vector& y) const {
+  typedef Eigen::Matrix<double, Z, D> MatrixZD;
+  typedef Eigen::Matrix<double, Z, 3> MatrixZ3;
+  typedef Eigen::Matrix<double, Z, 1> VectorZ;
+  typedef Eigen::Matrix<double, D, 1> VectorD;
+  const DenseIndex z = zDim_, d = cameraDim_, ZD = z * d;
+  double* e = workspace_.data();
+
+  // e = (I - E*P*E')*(F*x or b), in place, one landmark at a time
+  parallelFor(nrLandmarks(), [&](size_t l) {
+    Vector3 Ete = Vector3::Zero();
+    for (size_t o = obsPtr_[l]; o < obsPtr_[l + 1]; ++o) {
+      Eigen::Map<VectorZ> eo(e + o * z, z);
+      if (x)
+        eo.noalias() = Eigen::Map<const MatrixZD>(F_.data() + o * ZD, z, d) *
+                       Eigen::Map<const VectorD>(x + obsCol_[o], d);
+      else
+        eo = Eigen::Map<const VectorZ>(b_.data() + o * z, z);
+      Ete.noalias() +=
+          Eigen::Map<const MatrixZ3>(E_.data() + o * z * 3, z, 3).transpose() * eo;
+    }
+    const Vector3 PEte = Eigen::Map<const Matrix3>(P_.data() + l * 9) * Ete;
+    for (size_t o = obsPtr_[l]; o < obsPtr_[l + 1]; ++o)
+      Eigen::Map<VectorZ>(e + o * z, z).noalias() -=
+          Eigen::Map<const MatrixZ3>(E_.data() + o * z * 3, z, 3) * PEte;
+  });
+
+  // y += alpha*F'*e, one camera at a time
+  parallelFor(nrCameras(), [&](size_t c) {
+    Eigen::Map<VectorD> yc(y.data() + camCol_[c], d);
+    for (size_t k = camPtr_[c]; k < camPtr_[c + 1]; ++k) {
+      const size_t o = camObs_[k];
+      yc.noalias() +=
+          alpha * Eigen::Map<const MatrixZD>(F_.data() + o * ZD, z, d).transpose() *
+          Eigen::Map<const VectorZ>(e + o * z, z);
+    }
+  });
+}
+
+/* ************************************************************************* */
+void ImplicitSchurOperator::multiplyHessianAdd(double alpha, const Vector& x,
+                                               Vector& y) const {
+  assert(x.size() == (DenseIndex)cols() && y.size() == (DenseIndex)cols());
+  if (zDim_ == 2 && cameraDim_ == 6)
+    schurProduct<2, 6>(alpha, x.data(), y);
+  else if (zDim_ == 2 && cameraDim_ == 9)
+    schurProduct<2, 9>(alpha, x.data(), y);
+  else if (zDim_ == 2 && cameraDim_ == 11)
+    schurProduct<2, 11>(alpha, x.data(), y);
+  else if (zDim_ == 3 && cameraDim_ == 6)
+    schurProduct<3, 6>(alpha, x.data(), y);
+  else if (nrObservations() > 0)
+    schurProduct<Eigen::Dynamic, Eigen::Dynamic>(alpha, x.data(), y);
+  if (rest_) rest_->multiplyHessianAdd(alpha, x, y);
+}
+
+/* ************************************************************************* */
+template <int Z, int D>
+void ImplicitSchurOperator::schurBlockDiagonal(vector<Matrix>& blocks) const {
+  typedef Eigen::Matrix<double, Z, D> MatrixZD;
+  typedef Eigen::Matrix<double, Z, 3> MatrixZ3;
+  typedef Eigen::Matrix<double, D, 3> MatrixD3;
+  const DenseIndex z = zDim_, d = cameraDim_, ZD = z * d;
+
+  // Landmark of every observation
+  vector<size_t> landmark(nrObservations());
+  for (size_t l = 0; l < nrLandmarks(); ++l)
+    for (size_t o = obsPtr_[l]; o < obsPtr_[l + 1]; ++o) landmark[o] = l;
+
+  // F'*F - (F'*E)*P*(E'*F) summed over the observations of every camera
+  parallelFor(nrCameras(), [&](size_t c) {
+    Matrix& H = blocks[camVar_[c]];
+    for (size_t k = camPtr_[c]; k < camPtr_[c + 1]; ++k) {
+      const size_t o = camObs_[k];
+      const Eigen::Map<const MatrixZD> F(F_.data() + o * ZD, z, d);
+      const MatrixD3 FtE =
+          F.transpose() * Eigen::Map<const MatrixZ3>(E_.data() + o * z * 3, z, 3);
+      H.noalias() += F.transpose() * F;
+      H.noalias() -=
+          FtE * Eigen::Map<const Matrix3>(P_.data() + landmark[o] * 9) *
+          FtE.transpose();
+    }
+  });
+}
+
+/* ************************************************************************* */
+vector<Matrix> ImplicitSchurOperator::blockDiagonal() const {
+  gttic(ImplicitSchurOperator_blockDiagonal);
+  vector<Matrix> blocks;
+  if (rest_) {
+    blocks = rest_->blockDiagonal();
+  } else {
+    blocks.reserve(keyInfo_.size());
+    for (size_t dim : keyInfo_.colSpec()) blocks.push_back(Matrix::Zero(dim, dim));
+  }
+  if (zDim_ == 2 && cameraDim_ == 6)
+    schurBlockDiagonal<2, 6>(blocks);
+  else if (zDim_ == 2 && cameraDim_ == 9)
+    schurBlockDiagonal<2, 9>(blocks);
+  else if (zDim_ == 2 && cameraDim_ == 11)
+    schurBlockDiagonal<2, 11>(blocks);
+  else if (zDim_ == 3 && cameraDim_ == 6)
+    schurBlockDiagonal<3, 6>(blocks);
+  else if (nrObservations() > 0)
+    schurBlockDiagonal<Eigen::Dynamic, Eigen::Dynamic>(blocks);
+  return blocks;
+}
+
+}  // namespace gtsam
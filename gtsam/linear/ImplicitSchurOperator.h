@@ -0,0 +1,144 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file   ImplicitSchurOperator.h
+ * @brief  Matrix-free reduced camera system of implicit Schur factors, for PCG
+ * @date   October 2026
+ */
+
+#pragma once
+
+#include <gtsam/linear/IterativeSolver.h>
+#include <gtsam/linear/JacobianOperator.h>
+#include <gtsam/base/Matrix.h>
+#include <gtsam/base/Vector.h>
+
+#include <vector>
+
+namespace gtsam {
+
+// Forward declarations
+class GaussianFactorGraph;
+
+/**
+ * Interface of linear factors that represent the Schur complement
+ * F'*(I - E*P*E')*F of a single landmark without forming it, such as
+ * RegularImplicitSchurFactor. F has one zDim x cameraDim block per camera, E
+ * one zDim x 3 block per camera, P = inv(E'*E) is 3x3, and b has zDim entries
+ * per camera. ImplicitSchurOperator packs such factors through this interface.
+ */
+class GTSAM_EXPORT ImplicitSchurBlocks {
+ public:
+  virtual ~ImplicitSchurBlocks() {}
+
+  /// Dimension of a single measurement
+  virtual int zDim() const = 0;
+
+  /// Dimension of a camera
+  virtual int cameraDim() const = 0;
+
+  /**
+   * Copy the blocks, all column-major, into the given buffers: m F blocks of
+   * size zDim*cameraDim, m E blocks of size zDim*3, P of size 9, and b of
+   * size zDim*m, where m is the number of cameras.
+   */
+  virtual void packBlocks(double* F, double* E, double* P, double* b) const = 0;
+};
+
+/**
+ * The Hessian H = sum F'*(I - E*P*E')*F of all ImplicitSchurBlocks factors in
+ * a GaussianFactorGraph, i.e., the reduced camera system, plus A'*A of the
+ * remaining factors (camera priors, Levenberg-Marquardt damping, ...), applied
+ * without ever forming H. The blocks of all implicit factors are packed once
+ * into flat arrays, and the remaining factors go into a JacobianOperator.
+ *
+ * H*x is computed in two parallel passes: over landmarks, which project
+ * F*x onto the complement of E in place, and over cameras, which gather F'*e
+ * over their observations, so there are no write conflicts. The common
+ * (zDim, cameraDim) combinations use fixed-size kernels. Products do not
+ * allocate; they use an internal workspace and therefore must not be called
+ * concurrently on the same object. Column offsets of the variables are given by
+ * a KeyInfo, so the flat vectors are compatible with PCGSolver.
+ */
+class GTSAM_EXPORT ImplicitSchurOperator {
+ public:
+  typedef boost::shared_ptr<ImplicitSchurOperator> shared_ptr;
+
+ protected:
+  KeyInfo keyInfo_;                  ///< column offset and dimension of every variable
+  int zDim_, cameraDim_;             ///< sizes shared by all implicit factors
+
+  // Landmark-major storage: observations of landmark l are obsPtr_[l]..obsPtr_[l+1]
+  std::vector<size_t> obsPtr_;
+  std::vector<size_t> obsCol_;       ///< scalar column offset of the camera of every observation
+  std::vector<double> F_, E_, P_, b_;
+
+  // Camera-major index: observations of camera c are camObs_[camPtr_[c]..camPtr_[c+1]]
+  std::vector<size_t> camVar_;       ///< index in the ordering of every camera
+  std::vector<size_t> camCol_;       ///< scalar column offset of every camera
+  std::vector<size_t> camPtr_;
+  std::vector<size_t> camObs_;
+
+  JacobianOperator::shared_ptr rest_;  ///< all other factors, if any
+  Vector rhs_;                       ///< F'*(I - E*P*E')*b + A'*b of the rest
+  mutable Vector workspace_;         ///< zDim entries per observation
+
+ public:
+  /// Pack the implicit Schur factors of a graph, and the rest, laid out by keyInfo
+  ImplicitSchurOperator(const GaussianFactorGraph& gfg, const KeyInfo& keyInfo);
+
+  /// Whether the graph contains any ImplicitSchurBlocks factors
+  static bool Applies(const GaussianFactorGraph& gfg);
+
+  /// @name Standard interface
+  /// @{
+
+  /// Number of scalar columns
+  size_t cols() const { return keyInfo_.numCols(); }
+
+  /// Number of implicit Schur factors, i.e., landmarks
+  size_t nrLandmarks() const { return obsPtr_.size() - 1; }
+
+  /// Number of observations, over all landmarks
+  size_t nrObservations() const { return obsCol_.size(); }
+
+  /// Number of cameras seen by some landmark
+  size_t nrCameras() const { return camCol_.size(); }
+
+  /// Column layout
+  const KeyInfo& keyInfo() const { return keyInfo_; }
+
+  /// Right-hand side of the normal equations, i.e., the negative gradient at zero
+  const Vector& rhs() const { return rhs_; }
+
+  /// y += alpha*H*x, all vectors must have the right size
+  void multiplyHessianAdd(double alpha, const Vector& x, Vector& y) const;
+
+  /**
+   * The diagonal blocks of H, one per variable in the ordering of keyInfo,
+   * e.g., for a camera-block Jacobi preconditioner.
+   */
+  std::vector<Matrix> blockDiagonal() const;
+
+  /// @}
+
+ private:
+  /// y += alpha*F'*(I - E*P*E')*e, with e = F*x, or e = b if x is null
+  template <int Z, int D>
+  void schurProduct(double alpha, const double* x, Vector& y) const;
+
+  /// Add F'*(I - E*P*E')*F to the diagonal blocks of the cameras
+  template <int Z, int D>
+  void schurBlockDiagonal(std::vector<Matrix>& blocks) const;
+};
+
+}  // namespace gtsam
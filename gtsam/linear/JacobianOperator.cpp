@@ -0,0 +1,199 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file   JacobianOperator.cpp
+ * @brief  Matrix-free, packed block-sparse operator for a GaussianFactorGraph
+ * @date   October 2026
+ */
+
+#include <gtsam/linear/JacobianOperator.h>
+#include <gtsam/linear/GaussianFactorGraph.h>
+#include <gtsam/linear/PCGSolver.h> // for buildVectorValues
+#include <gtsam/linear/VectorValues.h>
+#include <gtsam/base/parallelFor.h>
+#include <gtsam/base/timing.h>
+
+#include <cassert>
+#include <stdexcept>
+
+using namespace std;
+
+namespace gtsam {
+
+/* ************************************************************************* */
+JacobianOperator::JacobianOperator(const GaussianFactorGraph& gfg)
+    : keyInfo_(gfg) {
+  initialize(gfg);
+}
+
+/* ************************************************************************* */
+JacobianOperator::JacobianOperator(const GaussianFactorGraph& gfg,
+                                   const KeyInfo& keyInfo)
+    : keyInfo_(keyInfo) {
+  initialize(gfg);
+}
+
+/* ************************************************************************* */
+void JacobianOperator::initialize(const GaussianFactorGraph& gfg) {
+  gttic(JacobianOperator_initialize);
+
+  // Column layout, in ordering
+  const Ordering& ordering = keyInfo_.ordering();
+  colOffsets_.resize(ordering.size() + 1);
+  colOffsets_[0] = 0;
+  for (size_t j = 0; j < ordering.size(); ++j)
+    colOffsets_[j + 1] = colOffsets_[j] + keyInfo_.at(ordering[j]).dim;
+
+  // Whitened Jacobians of all non-empty factors
+  std::vector<pair<Matrix, Vector> > jacobians(gfg.size());
+  parallelFor(gfg.size(), [&](size_t i) {
+    if (gfg[i] && !gfg[i]->empty()) jacobians[i] = gfg[i]->jacobian();
+  });
+
+  // First pass: count rows, blocks and values
+  size_t nrRows = 0, nrBlocks = 0, nrValues = 0;
+  rowOffsets_.assign(1, 0);
+  rowPtr_.assign(1, 0);
+  for (size_t i = 0; i < gfg.size(); ++i) {
+    const Matrix& A = jacobians[i].first;
+    if (A.rows() == 0) continue;
+    nrRows += A.rows();
+    nrBlocks += gfg[i]->size();
+    nrValues += A.size();
+    rowOffsets_.push_back(nrRows);
+    rowPtr_.push_back(nrBlocks);
+  }
+
+  // Second pass: pack blocks and right-hand side
+  blockCol_.resize(nrBlocks);
+  blockData_.resize(nrBlocks);
+  blockRow_.resize(nrBlocks);
+  values_.resize(nrValues);
+  b_.resize(nrRows);
+  colPtr_.assign(ordering.size() + 1, 0);
+  size_t row = 0, block = 0, value = 0;
+  for (size_t i = 0; i < gfg.size(); ++i) {
+    const Matrix& A = jacobians[i].first;
+    if (A.rows() == 0) continue;
+    const GaussianFactor& factor = *gfg[i];
+    b_.segment(rowOffsets_[row], A.rows()) = jacobians[i].second;
+    DenseIndex startCol = 0;
+    for (GaussianFactor::const_iterator key = factor.begin(); key != factor.end();
+         ++key) {
+      const auto entry = keyInfo_.find(*key);
+      if (entry == keyInfo_.end())
+        throw invalid_argument("JacobianOperator: factor key not in KeyInfo");
+      const DenseIndex dim = factor.getDim(key);
+      Eigen::Map<Matrix>(values_.data() + value, A.rows(), dim) =
+          A.middleCols(startCol, dim);
+      blockCol_[block] = entry->second.index;
+      blockData_[block] = value;
+      blockRow_[block] = row;
+      ++colPtr_[entry->second.index + 1];
+      value += A.rows() * dim;
+      startCol += dim;
+      ++block;
+    }
+    ++row;
+  }
+
+  // Build the block-CSC index by counting sort on block columns
+  for (size_t j = 0; j < ordering.size(); ++j) colPtr_[j + 1] += colPtr_[j];
+  colBlocks_.resize(nrBlocks);
+  std::vector<size_t> next(colPtr_.begin(), colPtr_.end() - 1);
+  for (size_t k = 0; k < nrBlocks; ++k) colBlocks_[next[blockCol_[k]]++] = k;
+
+  workspace_.resize(nrRows);
+}
+
+/* ************************************************************************* */
+Vector JacobianOperator::vector(const VectorValues& x) const {
+  return x.vector(keyInfo_.ordering());
+}
+
+/* ************************************************************************* */
+VectorValues JacobianOperator::vectorValues(const Vector& x) const {
+  return buildVectorValues(x, keyInfo_);
+}
+
+/* ************************************************************************* */
+void JacobianOperator::multiply(const Vector& x, Vector& e) const {
+  assert(x.size() == (DenseIndex)cols() && e.size() == (DenseIndex)rows());
+  parallelFor(nrBlockRows(), [&](size_t i) {
+    const DenseIndex m = rowOffsets_[i + 1] - rowOffsets_[i];
+    auto ei = e.segment(rowOffsets_[i], m);
+    ei.setZero();
+    for (size_t k = rowPtr_[i]; k < rowPtr_[i + 1]; ++k) {
+      const size_t j = blockCol_[k];
+      const DenseIndex n = colOffsets_[j + 1] - colOffsets_[j];
+      const Eigen::Map<const Matrix> Aij(values_.data() + blockData_[k], m, n);
+      ei.noalias() += Aij * x.segment(colOffsets_[j], n);
+    }
+  });
+}
+
+/* ************************************************************************* */
+void JacobianOperator::transposeMultiply(const Vector& e, Vector& x) const {
+  x.setZero();
+  transposeMultiplyAdd(1.0, e, x);
+}
+
+/* ************************************************************************* */
+void JacobianOperator::transposeMultiplyAdd(double alpha, const Vector& e,
+                                            Vector& x) const {
+  assert(x.size() == (DenseIndex)cols() && e.size() == (DenseIndex)rows());
+  parallelFor(colPtr_.size() - 1, [&](size_t j) {
+    const DenseIndex n = colOffsets_[j + 1] - colOffsets_[j];
+    auto xj = x.segment(colOffsets_[j], n);
+    for (size_t c = colPtr_[j]; c < colPtr_[j + 1]; ++c) {
+      const size_t k = colBlocks_[c], i = blockRow_[k];
+      const DenseIndex m = rowOffsets_[i + 1] - rowOffsets_[i];
+      const Eigen::Map<const Matrix> Aij(values_.data() + blockData_[k], m, n);
+      xj.noalias() += alpha * Aij.transpose() * e.segment(rowOffsets_[i], m);
+    }
+  });
+}
+
+/* ************************************************************************* */
+void JacobianOperator::multiplyHessianAdd(double alpha, const Vector& x,
+                                          Vector& y) const {
+  multiply(x, workspace_);
+  transposeMultiplyAdd(alpha, workspace_, y);
+}
+
+/* ************************************************************************* */
+std::vector<Matrix> JacobianOperator::blockDiagonal() const {
+  std::vector<Matrix> blocks(colPtr_.size() - 1);
+  parallelFor(blocks.size(), [&](size_t j) {
+    const DenseIndex n = colOffsets_[j + 1] - colOffsets_[j];
+    blocks[j] = Matrix::Zero(n, n);
+    for (size_t c = colPtr_[j]; c < colPtr_[j + 1]; ++c) {
+      const size_t k = colBlocks_[c], i = blockRow_[k];
+      const DenseIndex m = rowOffsets_[i + 1] - rowOffsets_[i];
+      const Eigen::Map<const Matrix> Aij(values_.data() + blockData_[k], m, n);
+      blocks[j].noalias() += Aij.transpose() * Aij;
+    }
+  });
+  return blocks;
+}
+
+/* ************************************************************************* */
+Vector JacobianOperator::gradient(const Vector& x) const {
+  Vector e(rows());
+  multiply(x, e);
+  e -= b_;
+  Vector g(cols());
+  transposeMultiply(e, g);
+  return g;
+}
+
+}  // namespace gtsam
@@ -0,0 +1,152 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file   JacobianOperator.h
+ * @brief  Matrix-free, packed block-sparse operator for a GaussianFactorGraph
+ * @date   October 2026
+ */
+
+#pragma once
+
+#include <gtsam/linear/IterativeSolver.h>
+#include <gtsam/base/Matrix.h>
+#include <gtsam/base/Vector.h>
+
+#include <vector>
+
+namespace gtsam {
+
+// Forward declarations
+class GaussianFactorGraph;
+class VectorValues;
+
+/**
+ * A compiled, matrix-free representation of the whitened Jacobian [A b] of a
+ * GaussianFactorGraph. All Jacobian blocks are packed once into contiguous
+ * block-CSR storage (one block row per factor), with a block-CSC index on top
+ * so that both A*x and A'*e can be computed in parallel without write
+ * conflicts. Column offsets of the variables are given by a KeyInfo, so the
+ * flat vectors used here are compatible with PCGSolver.
+ *
+ * The products do not allocate, with the exception of the convenience
+ * operator* and gradient, which return new vectors. multiplyHessianAdd uses an
+ * internal workspace and therefore must not be called concurrently on the same
+ * object.
+ *
+ * HessianFactors are converted to Jacobian form with a Cholesky factorization.
+ * JacobianOperator also satisfies the "System" concept of conjugateGradients in
+ * iterative-inl.h, with V = E = Vector.
+ */
+class GTSAM_EXPORT JacobianOperator {
+ public:
+  typedef boost::shared_ptr<JacobianOperator> shared_ptr;
+
+ protected:
+  KeyInfo keyInfo_;                ///< column offset and dimension of every variable
+  std::vector<size_t> colOffsets_; ///< scalar offset of every block column, in ordering
+  std::vector<size_t> rowOffsets_; ///< scalar offset of every block row (size nrBlockRows+1)
+
+  // block-CSR: blocks in block row i are rowPtr_[i]..rowPtr_[i+1]
+  std::vector<size_t> rowPtr_;
+  std::vector<size_t> blockCol_;   ///< block column of every block
+  std::vector<size_t> blockData_;  ///< offset of every (column-major) block in values_
+
+  // block-CSC index: blocks in block column j are colBlocks_[colPtr_[j]..colPtr_[j+1]]
+  std::vector<size_t> colPtr_;
+  std::vector<size_t> colBlocks_;
+  std::vector<size_t> blockRow_;   ///< block row of every block
+
+  std::vector<double> values_;     ///< packed Jacobian blocks
+  Vector b_;                       ///< whitened right-hand side
+
+  mutable Vector workspace_;       ///< holds A*x in multiplyHessianAdd
+
+ public:
+  /// Pack a graph, with columns in natural (sorted key) ordering
+  explicit JacobianOperator(const GaussianFactorGraph& gfg);
+
+  /// Pack a graph, with columns laid out as given by keyInfo
+  JacobianOperator(const GaussianFactorGraph& gfg, const KeyInfo& keyInfo);
+
+  /// @name Standard interface
+  /// @{
+
+  /// Number of scalar rows of A
+  size_t rows() const { return rowOffsets_.back(); }
+
+  /// Number of scalar columns of A
+  size_t cols() const { return colOffsets_.back(); }
+
+  /// Number of block rows (non-empty factors)
+  size_t nrBlockRows() const { return rowPtr_.size() - 1; }
+
+  /// Number of non-zero blocks
+  size_t nrBlocks() const { return blockCol_.size(); }
+
+  /// Column layout
+  const KeyInfo& keyInfo() const { return keyInfo_; }
+
+  /// Whitened right-hand side b
+  const Vector& b() const { return b_; }
+
+  /// Flatten a VectorValues into the column layout of this operator
+  Vector vector(const VectorValues& x) const;
+
+  /// Split a flat vector into VectorValues
+  VectorValues vectorValues(const Vector& x) const;
+
+  /// @}
+  /// @name Matrix-free products, all vectors must have the right size
+  /// @{
+
+  /// e = A*x
+  void multiply(const Vector& x, Vector& e) const;
+
+  /// x = A'*e
+  void transposeMultiply(const Vector& e, Vector& x) const;
+
+  /// x += alpha*A'*e
+  void transposeMultiplyAdd(double alpha, const Vector& e, Vector& x) const;
+
+  /// y += alpha*A'*A*x
+  void multiplyHessianAdd(double alpha, const Vector& x, Vector& y) const;
+
+  /// A'*b, i.e., the negative gradient at zero
+  void transposeB(Vector& x) const { transposeMultiply(b_, x); }
+
+  /// Diagonal blocks of A'*A, one per variable in the ordering of keyInfo
+  std::vector<Matrix> blockDiagonal() const;
+
+  /// @}
+  /// @name System interface for conjugateGradients
+  /// @{
+
+  /// Apply operator A
+  Vector operator*(const Vector& x) const {
+    Vector e(rows());
+    multiply(x, e);
+    return e;
+  }
+
+  /// Apply operator A in place: e = A*x
+  void multiplyInPlace(const Vector& x, Vector& e) const { multiply(x, e); }
+
+  /// Gradient of 0.5*|Ax-b|^2 at x, i.e. A'*(A*x-b)
+  Vector gradient(const Vector& x) const;
+
+  /// @}
+
+ private:
+  void initialize(const GaussianFactorGraph& gfg);
+};
+
+}  // namespace gtsam
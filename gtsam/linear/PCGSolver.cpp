@@ -19,6 +19,8 @@
 
 #include <gtsam/linear/PCGSolver.h>
 #include <gtsam/linear/GaussianFactorGraph.h>
+#include <gtsam/linear/ImplicitSchurOperator.h>
+#include <gtsam/linear/JacobianOperator.h>
 #include <gtsam/linear/Preconditioner.h>
 #include <gtsam/linear/VectorValues.h>
 
@@ -60,13 +62,31 @@ void PCGSolverParameters::print(const std::string &s) const {
 VectorValues PCGSolver::optimize(const GaussianFactorGraph &gfg,
     const KeyInfo &keyInfo, const std::map<Key, Vector> &lambda,
     const VectorValues &initial) {
-  /* build preconditioner */
-  preconditioner_->build(gfg, keyInfo, lambda);
-
   /* apply pcg */
-  GaussianFactorGraphSystem system(gfg, *preconditioner_, keyInfo, lambda);
   Vector x0 = initial.vector(keyInfo.ordering());
-  const Vector sol = preconditionedConjugateGradient(system, x0, parameters_);
+  Vector sol;
+  if (parameters_.blas_kernel_ == ConjugateGradientParameters::PACKED &&
+      ImplicitSchurOperator::Applies(gfg)) {
+    // Reduced camera system of implicit Schur factors, e.g. of smart factors
+    const ImplicitSchurOperator H(gfg, keyInfo);
+    auto jacobi =
+        boost::dynamic_pointer_cast<BlockJacobiPreconditioner>(preconditioner_);
+    if (jacobi)
+      jacobi->build(keyInfo, H.blockDiagonal());
+    else
+      preconditioner_->build(gfg, keyInfo, lambda);
+    GaussianFactorGraphSystem system(gfg, *preconditioner_, keyInfo, lambda, H);
+    sol = preconditionedConjugateGradient(system, x0, parameters_);
+  } else if (parameters_.blas_kernel_ == ConjugateGradientParameters::PACKED) {
+    preconditioner_->build(gfg, keyInfo, lambda);
+    const JacobianOperator A(gfg, keyInfo);
+    GaussianFactorGraphSystem system(gfg, *preconditioner_, keyInfo, lambda, A);
+    sol = preconditionedConjugateGradient(system, x0, parameters_);
+  } else {
+    preconditioner_->build(gfg, keyInfo, lambda);
+    GaussianFactorGraphSystem system(gfg, *preconditioner_, keyInfo, lambda);
+    sol = preconditionedConjugateGradient(system, x0, parameters_);
+  }
 
   return buildVectorValues(sol, keyInfo);
 }
@@ -76,7 +96,25 @@ GaussianFactorGraphSystem::GaussianFactorGraphSystem(
     const GaussianFactorGraph &gfg, const Preconditioner &preconditioner,
     const KeyInfo &keyInfo, const std::map<Key, Vector> &lambda) :
     gfg_(gfg), preconditioner_(preconditioner), keyInfo_(keyInfo), lambda_(
-        lambda) {
+        lambda), packed_(nullptr), implicit_(nullptr) {
+}
+
+/*****************************************************************************/
+GaussianFactorGraphSystem::GaussianFactorGraphSystem(
+    const GaussianFactorGraph &gfg, const Preconditioner &preconditioner,
+    const KeyInfo &keyInfo, const std::map<Key, Vector> &lambda,
+    const JacobianOperator &A) :
+    gfg_(gfg), preconditioner_(preconditioner), keyInfo_(keyInfo), lambda_(
+        lambda), packed_(&A), implicit_(nullptr) {
+}
+
+/*****************************************************************************/
+GaussianFactorGraphSystem::GaussianFactorGraphSystem(
+    const GaussianFactorGraph &gfg, const Preconditioner &preconditioner,
+    const KeyInfo &keyInfo, const std::map<Key, Vector> &lambda,
+    const ImplicitSchurOperator &H) :
+    gfg_(gfg), preconditioner_(preconditioner), keyInfo_(keyInfo), lambda_(
+        lambda), packed_(nullptr), implicit_(&H) {
 }
 
 /*****************************************************************************/
@@ -96,6 +134,18 @@ void GaussianFactorGraphSystem::residual(const Vector &x, Vector &r) const {
 void GaussianFactorGraphSystem::multiply(const Vector &x, Vector& AtAx) const {
   /* implement A^T*(A*x), assume x and AtAx are pre-allocated */
 
+  // The packed operator works on raw vectors directly
+  if (packed_) {
+    AtAx.setZero();
+    packed_->multiplyHessianAdd(1.0, x, AtAx);
+    return;
+  }
+  if (implicit_) {
+    AtAx.setZero();
+    implicit_->multiplyHessianAdd(1.0, x, AtAx);
+    return;
+  }
+
   // Build a VectorValues for Vector x
   VectorValues vvX = buildVectorValues(x, keyInfo_);
 
@@ -113,6 +163,15 @@ void GaussianFactorGraphSystem::multiply(const Vector &x, Vector& AtAx) const {
 void GaussianFactorGraphSystem::getb(Vector &b) const {
   /* compute rhs, assume b pre-allocated */
 
+  if (packed_) {
+    packed_->transposeB(b);
+    return;
+  }
+  if (implicit_) {
+    b = implicit_->rhs();
+    return;
+  }
+
   // Get whitened r.h.s (A^T * b) from each factor in the form of VectorValues
   VectorValues vvb = gfg_.gradientAtZero();
 
@@ -25,6 +25,8 @@
 namespace gtsam {
 
 class GaussianFactorGraph;
+class ImplicitSchurOperator;
+class JacobianOperator;
 class KeyInfo;
 class Preconditioner;
 class VectorValues;
@@ -93,10 +95,22 @@ public:
       const Preconditioner &preconditioner, const KeyInfo &info,
       const std::map<Key, Vector> &lambda);
 
+  /// Use the packed operator A, built from gfg with the same KeyInfo, for all products
+  GaussianFactorGraphSystem(const GaussianFactorGraph &gfg,
+      const Preconditioner &preconditioner, const KeyInfo &info,
+      const std::map<Key, Vector> &lambda, const JacobianOperator &A);
+
+  /// Use the reduced camera system H, built from gfg with the same KeyInfo, for all products
+  GaussianFactorGraphSystem(const GaussianFactorGraph &gfg,
+      const Preconditioner &preconditioner, const KeyInfo &info,
+      const std::map<Key, Vector> &lambda, const ImplicitSchurOperator &H);
+
   const GaussianFactorGraph &gfg_;
   const Preconditioner &preconditioner_;
   const KeyInfo &keyInfo_;
   const std::map<Key, Vector> &lambda_;
+  const JacobianOperator *packed_; ///< optional packed operator, see ConjugateGradientParameters::PACKED
+  const ImplicitSchurOperator *implicit_; ///< optional packed reduced camera system, idem
 
   void residual(const Vector &x, Vector &r) const;
   void multiply(const Vector &x, Vector& y) const;
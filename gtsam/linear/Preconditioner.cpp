@@ -12,10 +12,16 @@
 #include <gtsam/linear/Preconditioner.h>
 #include <gtsam/linear/SubgraphPreconditioner.h>
 #include <gtsam/linear/NoiseModel.h>
+#include <gtsam/linear/linearExceptions.h>
+#include <gtsam/base/parallelFor.h>
+#include <gtsam/base/timing.h>
 #include <boost/shared_ptr.hpp>
 #include <boost/algorithm/string.hpp>
 #include <boost/range/adaptor/map.hpp>
+#include <algorithm>
+#include <cmath>
 #include <iostream>
+#include <queue>
 #include <vector>
 
 using namespace std;
@@ -125,29 +131,33 @@ void BlockJacobiPreconditioner::transposeSolve(const Vector& y, Vector& x) const
 /***************************************************************************************/
 void BlockJacobiPreconditioner::build(
   const GaussianFactorGraph &gfg, const KeyInfo &keyInfo, const std::map<Key,Vector> &lambda)
+{
+  /* getting the block diagonals over the factors, in the KeyInfo ordering */
+  std::vector<Matrix> blocks(keyInfo.size());
+  std::map<Key, Matrix> hessianMap =gfg.hessianBlockDiagonal();
+  for (const auto& key_hessian: hessianMap)
+    blocks[keyInfo.at(key_hessian.first).index] = key_hessian.second;
+
+  build(keyInfo, blocks);
+}
+
+/***************************************************************************************/
+void BlockJacobiPreconditioner::build(const KeyInfo &keyInfo,
+                                      const std::vector<Matrix> &blocks)
 {
   // n is the number of keys
   const size_t n = keyInfo.size();
   // dims_ is a vector that contains the dimension of keys
   dims_ = keyInfo.colSpec();
 
-  /* prepare the buffer of block diagonals */
-  std::vector<Matrix> blocks; blocks.reserve(n);
-
   /* allocate memory for the factorization of block diagonals */
   size_t nnz = 0;
+  std::vector<size_t> offsets(n);
   for ( size_t i = 0 ; i < n ; ++i ) {
-    const size_t dim = dims_[i];
-    // blocks.push_back(Matrix::Zero(dim, dim));
-    // nnz += (((dim)*(dim+1)) >> 1); // d*(d+1) / 2  ;
-    nnz += dim*dim;
+    offsets[i] = nnz;
+    nnz += dims_[i]*dims_[i];
   }
 
-  /* getting the block diagonals over the factors */
-  std::map<Key, Matrix> hessianMap =gfg.hessianBlockDiagonal();
-  for (const Matrix& hessian: hessianMap | boost::adaptors::map_values)
-    blocks.push_back(hessian);
-
   /* if necessary, allocating the memory for cacheing the factorization results */
   if ( nnz > bufferSize_ ) {
     clean();
@@ -156,20 +166,13 @@ void BlockJacobiPreconditioner::build(
   }
   nnz_ = nnz;
 
-  /* factorizing the blocks respectively */
-  double *ptr = buffer_;
-  for ( size_t i = 0 ; i < n ; ++i ) {
+  /* factorizing the blocks respectively, in parallel */
+  parallelFor(n, [&](size_t i) {
     /* use eigen to decompose Di */
     /* It is same as L = chol(M,'lower') in MATLAB where M is full preconditioner */
-    const Matrix L = blocks[i].llt().matrixL();
-
-    /* store the data in the buffer */
-    size_t sz = dims_[i]*dims_[i] ;
-    std::copy(L.data(), L.data() + sz, ptr);
-
-    /* advance the pointer */
-    ptr += sz;
-  }
+    Eigen::Map<Matrix>(buffer_ + offsets[i], dims_[i], dims_[i]) =
+        blocks[i].llt().matrixL();
+  });
 }
 
 /*****************************************************************************/
@@ -182,6 +185,343 @@ void BlockJacobiPreconditioner::clean() {
   }
 }
 
+/***************************************************************************************/
+namespace {
+/// Augmented Hessian in the KeyInfo ordering, with lambda added to the diagonal
+SparseEigen assembleHessian(const GaussianFactorGraph &gfg, const KeyInfo &keyInfo,
+    const std::map<Key,Vector> &lambda) {
+  gttic(assembleHessian);
+  SparseEigen H;
+  SparseEigenBuilder(gfg, keyInfo.ordering()).augmentedHessian(gfg, H);
+  for (const auto& key_lambda : lambda) {
+    const auto entry = keyInfo.find(key_lambda.first);
+    if (entry == keyInfo.end()) continue;
+    for (size_t k = 0; k < entry->second.dim; ++k) {
+      const size_t j = entry->second.start + k;
+      H.coeffRef(j, j) += key_lambda.second(k);
+    }
+  }
+  return H;
+}
+}  // namespace
+
+/***************************************************************************************/
+void IncompleteCholeskyPreconditionerParameters::print(ostream &os) const {
+  Base::print(os);
+  os << "dropTolerance: " << dropTolerance << endl
+     << "maxFill:       " << maxFill << endl
+     << "initialShift:  " << initialShift << endl;
+}
+
+/***************************************************************************************/
+IncompleteCholeskyPreconditioner::IncompleteCholeskyPreconditioner(
+    const IncompleteCholeskyPreconditionerParameters &p)
+  : Base(), parameters_(p), shift_(0.0) {}
+
+/***************************************************************************************/
+void IncompleteCholeskyPreconditioner::solve(const Vector& y, Vector &x) const {
+  // x = L^{-1} S y
+  x = scaling_.cwiseProduct(y);
+  L_.triangularView<Eigen::Lower>().solveInPlace(x);
+}
+
+/***************************************************************************************/
+void IncompleteCholeskyPreconditioner::transposeSolve(const Vector& y, Vector& x) const {
+  // x = S L^{-T} y
+  x = y;
+  L_.transpose().triangularView<Eigen::Upper>().solveInPlace(x);
+  x = scaling_.cwiseProduct(x);
+}
+
+/***************************************************************************************/
+void IncompleteCholeskyPreconditioner::build(
+  const GaussianFactorGraph &gfg, const KeyInfo &keyInfo, const std::map<Key,Vector> &lambda)
+{
+  gttic(IncompleteCholeskyPreconditioner_build);
+  const SparseEigen H = assembleHessian(gfg, keyInfo, lambda);
+  const size_t n = keyInfo.numCols();
+
+  // Scale to unit diagonal
+  scaling_ = Vector::Ones(n);
+  for (size_t j = 0; j < n; ++j) {
+    const double d = H.coeff(j, j);
+    if (d > 0) scaling_(j) = 1.0 / std::sqrt(d);
+  }
+
+  // Lower triangle of the scaled Hessian, without the augmented row and column
+  std::vector<Eigen::Triplet<double> > entries;
+  entries.reserve(H.nonZeros() / 2 + n);
+  for (size_t j = 0; j < n; ++j)
+    for (SparseEigen::InnerIterator it(H, j); it; ++it)
+      if (size_t(it.row()) >= j && size_t(it.row()) < n)
+        entries.emplace_back(it.row(), j, scaling_(it.row()) * it.value() * scaling_(j));
+  SparseEigen A(n, n);
+  A.setFromTriplets(entries.begin(), entries.end());
+
+  // Factorize, with an increasing diagonal shift after every breakdown
+  shift_ = 0.0;
+  for (size_t attempt = 0; !factorize(A, shift_); ++attempt) {
+    if (attempt == 50)
+      throw IndeterminantLinearSystemException(keyInfo.ordering().front());
+    shift_ = (shift_ == 0.0) ? parameters_.initialShift : 2.0 * shift_;
+  }
+
+  if (parameters_.verbosity() >= PreconditionerParameters::COMPLEXITY)
+    cout << "IncompleteCholeskyPreconditioner: n = " << n
+         << ", nnz(L) = " << L_.nonZeros() << ", shift = " << shift_ << endl;
+}
+
+/***************************************************************************************/
+bool IncompleteCholeskyPreconditioner::factorize(const SparseEigen &A, double shift) {
+  const size_t n = A.cols();
+  const bool ict = parameters_.dropTolerance > 0.0;
+
+  // Columns of L, diagonal entry first and then sorted by row
+  std::vector<std::vector<int> > rows(n);
+  std::vector<std::vector<double> > values(n);
+
+  // Left-looking: rowList[j] holds the columns k < j with L(j,k) != 0, and
+  // next[k] the position in column k of the entry for the current row
+  std::vector<std::vector<size_t> > rowList(n);
+  std::vector<size_t> next(n, 0);
+
+  Vector w = Vector::Zero(n);              // dense work column
+  std::vector<size_t> stamp(n, n);         // stamp[i] == j if (i,j) is in the pattern of A
+  std::vector<size_t> touched;             // non-zero rows of w
+  std::vector<char> isTouched(n, 0);
+  std::vector<std::pair<double, size_t> > candidates;
+
+  for (size_t j = 0; j < n; ++j) {
+    // Scatter column j of A
+    double colNorm = 0.0;
+    size_t nnzA = 0;
+    for (SparseEigen::InnerIterator it(A, j); it; ++it) {
+      const size_t i = it.row();
+      w(i) = it.value();
+      stamp[i] = j;
+      touched.push_back(i);
+      isTouched[i] = 1;
+      colNorm += it.value() * it.value();
+      ++nnzA;
+    }
+    colNorm = std::sqrt(colNorm);
+    if (!isTouched[j]) {
+      touched.push_back(j);
+      isTouched[j] = 1;
+    }
+    w(j) += shift;
+
+    // Subtract L(j:n,k) * L(j,k) for all earlier columns k with L(j,k) != 0
+    for (size_t k : rowList[j]) {
+      const std::vector<int>& rowsK = rows[k];
+      const std::vector<double>& valuesK = values[k];
+      const double ljk = valuesK[next[k]];
+      for (size_t p = next[k]; p < rowsK.size(); ++p) {
+        const size_t i = rowsK[p];
+        w(i) -= valuesK[p] * ljk;
+        if (!isTouched[i]) {
+          touched.push_back(i);
+          isTouched[i] = 1;
+        }
+      }
+      if (++next[k] < rowsK.size()) rowList[rowsK[next[k]]].push_back(k);
+    }
+    std::vector<size_t>().swap(rowList[j]);
+
+    // Diagonal
+    const double d = w(j);
+    if (!(d > 0.0) || !std::isfinite(d)) {
+      for (size_t i : touched) { w(i) = 0.0; isTouched[i] = 0; }
+      touched.clear();
+      return false;
+    }
+    const double ljj = std::sqrt(d);
+
+    // Off-diagonal entries that survive dropping
+    candidates.clear();
+    for (size_t i : touched) {
+      if (i > j) {
+        const double lij = w(i) / ljj;
+        if (ict ? std::abs(lij) >= parameters_.dropTolerance * colNorm
+                : stamp[i] == j)
+          candidates.emplace_back(lij, i);
+      }
+      w(i) = 0.0;
+      isTouched[i] = 0;
+    }
+    touched.clear();
+    const size_t maxEntries = nnzA + parameters_.maxFill;
+    if (ict && candidates.size() > maxEntries) {
+      std::nth_element(candidates.begin(), candidates.begin() + maxEntries,
+          candidates.end(), [](const std::pair<double, size_t>& a,
+                               const std::pair<double, size_t>& b) {
+            return std::abs(a.first) > std::abs(b.first);
+          });
+      candidates.resize(maxEntries);
+    }
+    std::sort(candidates.begin(), candidates.end(),
+        [](const std::pair<double, size_t>& a, const std::pair<double, size_t>& b) {
+          return a.second < b.second;
+        });
+
+    // Store column j
+    rows[j].reserve(candidates.size() + 1);
+    values[j].reserve(candidates.size() + 1);
+    rows[j].push_back(int(j));
+    values[j].push_back(ljj);
+    for (const auto& candidate : candidates) {
+      rows[j].push_back(int(candidate.second));
+      values[j].push_back(candidate.first);
+    }
+    next[j] = 1;
+    if (rows[j].size() > 1) rowList[rows[j][1]].push_back(j);
+  }
+
+  // Compress into L_
+  size_t nnz = 0;
+  for (size_t j = 0; j < n; ++j) nnz += rows[j].size();
+  L_.resize(n, n);
+  L_.resizeNonZeros(nnz);
+  int* outer = L_.outerIndexPtr();
+  outer[0] = 0;
+  for (size_t j = 0; j < n; ++j) {
+    std::copy(rows[j].begin(), rows[j].end(), L_.innerIndexPtr() + outer[j]);
+    std::copy(values[j].begin(), values[j].end(), L_.valuePtr() + outer[j]);
+    outer[j + 1] = outer[j] + int(rows[j].size());
+  }
+  return true;
+}
+
+/***************************************************************************************/
+void ClusterJacobiPreconditionerParameters::print(ostream &os) const {
+  Base::print(os);
+  os << "maxClusterDim: " << maxClusterDim << endl;
+}
+
+/***************************************************************************************/
+ClusterJacobiPreconditioner::ClusterJacobiPreconditioner(
+    const ClusterJacobiPreconditionerParameters &p)
+  : Base(), parameters_(p), clusters_(1, 0), variables_(1, 0) {}
+
+/***************************************************************************************/
+void ClusterJacobiPreconditioner::solve(const Vector& y, Vector &x) const {
+  x.resize(y.size());
+  parallelFor(factors_.size(), [&](size_t c) {
+    const size_t begin = clusters_[c], d = clusters_[c + 1] - begin;
+    Vector v(d);
+    for (size_t k = 0; k < d; ++k) v(k) = y(indices_[begin + k]);
+    factors_[c].triangularView<Eigen::Lower>().solveInPlace(v);
+    for (size_t k = 0; k < d; ++k) x(indices_[begin + k]) = v(k);
+  });
+}
+
+/***************************************************************************************/
+void ClusterJacobiPreconditioner::transposeSolve(const Vector& y, Vector& x) const {
+  x.resize(y.size());
+  parallelFor(factors_.size(), [&](size_t c) {
+    const size_t begin = clusters_[c], d = clusters_[c + 1] - begin;
+    Vector v(d);
+    for (size_t k = 0; k < d; ++k) v(k) = y(indices_[begin + k]);
+    factors_[c].transpose().triangularView<Eigen::Upper>().solveInPlace(v);
+    for (size_t k = 0; k < d; ++k) x(indices_[begin + k]) = v(k);
+  });
+}
+
+/***************************************************************************************/
+void ClusterJacobiPreconditioner::build(
+  const GaussianFactorGraph &gfg, const KeyInfo &keyInfo, const std::map<Key,Vector> &lambda)
+{
+  gttic(ClusterJacobiPreconditioner_build);
+  const SparseEigen H = assembleHessian(gfg, keyInfo, lambda);
+  const size_t n = keyInfo.numCols(), nrVariables = keyInfo.size();
+  const std::vector<size_t> dims = keyInfo.colSpec();
+
+  // Variable of every scalar column
+  std::vector<size_t> starts(nrVariables + 1, 0), variable(n);
+  for (size_t v = 0; v < nrVariables; ++v) {
+    starts[v + 1] = starts[v] + dims[v];
+    std::fill(variable.begin() + starts[v], variable.begin() + starts[v + 1], v);
+  }
+
+  // Coupling strength |H_uv| (sum of absolute values) with all neighbors, in parallel
+  std::vector<std::vector<std::pair<double, size_t> > > neighbors(nrVariables);
+  parallelFor(nrVariables, [&](size_t v) {
+    std::map<size_t, double> strength;
+    for (size_t j = starts[v]; j < starts[v + 1]; ++j)
+      for (SparseEigen::InnerIterator it(H, j); it; ++it)
+        if (size_t(it.row()) < n && variable[it.row()] != v)
+          strength[variable[it.row()]] += std::abs(it.value());
+    for (const auto& u_s : strength) neighbors[v].emplace_back(u_s.second, u_s.first);
+    std::sort(neighbors[v].rbegin(), neighbors[v].rend());
+  });
+
+  // Greedy aggregation: a cluster grows from its seed by repeatedly taking
+  // the unassigned variable most strongly coupled to any of its members
+  std::vector<char> assigned(nrVariables, 0);
+  clusters_.assign(1, 0);
+  variables_.assign(1, 0);
+  indices_.clear();
+  variableList_.clear();
+  for (size_t seed = 0; seed < nrVariables; ++seed) {
+    if (assigned[seed]) continue;
+    size_t dim = dims[seed];
+    assigned[seed] = 1;
+    variableList_.push_back(seed);
+    std::priority_queue<std::pair<double, size_t> > frontier(
+        neighbors[seed].begin(), neighbors[seed].end());
+    while (!frontier.empty()) {
+      const size_t u = frontier.top().second;
+      frontier.pop();
+      if (assigned[u] || dim + dims[u] > parameters_.maxClusterDim) continue;
+      assigned[u] = 1;
+      dim += dims[u];
+      variableList_.push_back(u);
+      for (const auto& neighbor : neighbors[u])
+        if (!assigned[neighbor.second]) frontier.push(neighbor);
+    }
+    std::sort(variableList_.begin() + variables_.back(), variableList_.end());
+    for (size_t k = variables_.back(); k < variableList_.size(); ++k)
+      for (size_t j = starts[variableList_[k]]; j < starts[variableList_[k] + 1]; ++j)
+        indices_.push_back(j);
+    variables_.push_back(variableList_.size());
+    clusters_.push_back(indices_.size());
+  }
+
+  // Extract and factorize the dense block of every cluster, in parallel
+  const size_t nrClusters = clusters_.size() - 1;
+  std::vector<size_t> cluster(n), local(n);
+  for (size_t c = 0; c < nrClusters; ++c)
+    for (size_t k = clusters_[c]; k < clusters_[c + 1]; ++k) {
+      cluster[indices_[k]] = c;
+      local[indices_[k]] = k - clusters_[c];
+    }
+  factors_.resize(nrClusters);
+  parallelFor(nrClusters, [&](size_t c) {
+    const size_t begin = clusters_[c], d = clusters_[c + 1] - begin;
+    Matrix block = Matrix::Zero(d, d);
+    for (size_t k = 0; k < d; ++k)
+      for (SparseEigen::InnerIterator it(H, indices_[begin + k]); it; ++it)
+        if (size_t(it.row()) < n && cluster[it.row()] == c)
+          block(local[it.row()], k) = it.value();
+    // Shift the diagonal slightly if the block is only semi-definite
+    Eigen::LLT<Matrix> llt(block);
+    double shift = 1e-9 * std::max(block.diagonal().maxCoeff(), 1.0);
+    for (size_t attempt = 0; llt.info() != Eigen::Success && attempt < 20;
+         ++attempt, shift *= 10.0)
+      llt.compute(block + shift * Matrix::Identity(d, d));
+    factors_[c] = llt.matrixL();
+  });
+}
+
+/***************************************************************************************/
+std::vector<std::vector<size_t> > ClusterJacobiPreconditioner::clusters() const {
+  std::vector<std::vector<size_t> > result;
+  for (size_t c = 0; c + 1 < variables_.size(); ++c)
+    result.emplace_back(variableList_.begin() + variables_[c],
+                        variableList_.begin() + variables_[c + 1]);
+  return result;
+}
+
 /***************************************************************************************/
 boost::shared_ptr<Preconditioner> createPreconditioner(
     const boost::shared_ptr<PreconditionerParameters> params) {
@@ -191,6 +531,14 @@ boost::shared_ptr<Preconditioner> createPreconditioner(
   } else if (dynamic_pointer_cast<BlockJacobiPreconditionerParameters>(
                  params)) {
     return boost::make_shared<BlockJacobiPreconditioner>();
+  } else if (auto ic =
+                 dynamic_pointer_cast<IncompleteCholeskyPreconditionerParameters>(
+                     params)) {
+    return boost::make_shared<IncompleteCholeskyPreconditioner>(*ic);
+  } else if (auto cluster =
+                 dynamic_pointer_cast<ClusterJacobiPreconditionerParameters>(
+                     params)) {
+    return boost::make_shared<ClusterJacobiPreconditioner>(*cluster);
   } else if (auto subgraph =
                  dynamic_pointer_cast<SubgraphPreconditionerParameters>(
                      params)) {
@@ -8,6 +8,8 @@
 
 #pragma once
 
+#include <gtsam/linear/SparseEigen.h>
+#include <gtsam/base/Matrix.h>
 #include <gtsam/base/Vector.h>
 #include <boost/shared_ptr.hpp>
 #include <iosfwd>
@@ -143,6 +145,9 @@ public:
     const std::map<Key,Vector> &lambda
     ) override;
 
+  /// build from given diagonal blocks, one per variable in the ordering of info
+  void build(const KeyInfo &info, const std::vector<Matrix> &blocks);
+
 protected:
 
   void clean() ;
@@ -153,6 +158,118 @@ protected:
   size_t nnz_;
 };
 
+/*******************************************************************************************/
+/**
+ * Parameters for the incomplete Cholesky preconditioner. With the default
+ * dropTolerance of zero the factor keeps the sparsity pattern of the Hessian,
+ * i.e., IC(0). A positive dropTolerance enables fill-in (ICT): entries smaller
+ * than dropTolerance times the norm of their (scaled) column are dropped, and
+ * at most maxFill entries per column are kept beyond those of the Hessian.
+ */
+struct GTSAM_EXPORT IncompleteCholeskyPreconditionerParameters : public PreconditionerParameters {
+  typedef PreconditionerParameters Base;
+  double dropTolerance; ///< zero for IC(0), otherwise the ICT drop tolerance
+  size_t maxFill;       ///< ICT only: maximum extra entries per column
+  double initialShift;  ///< diagonal shift tried first if the factorization breaks down
+
+  IncompleteCholeskyPreconditionerParameters(double tolerance = 0.0, size_t fill = 10)
+      : Base(), dropTolerance(tolerance), maxFill(fill), initialShift(1e-3) {}
+  virtual ~IncompleteCholeskyPreconditionerParameters() {}
+  void print(std::ostream &os) const override;
+};
+
+/*******************************************************************************************/
+/**
+ * Incomplete Cholesky preconditioner M = S^{-1} L L^T S^{-1}, where S scales the
+ * Hessian to a unit diagonal. The Hessian is assembled in parallel with
+ * SparseEigenBuilder; the factorization itself is sequential (left-looking).
+ * If it breaks down, it is restarted with an increasing diagonal shift.
+ */
+class GTSAM_EXPORT IncompleteCholeskyPreconditioner : public Preconditioner {
+public:
+  typedef Preconditioner Base;
+  IncompleteCholeskyPreconditioner(const IncompleteCholeskyPreconditionerParameters &p =
+                                       IncompleteCholeskyPreconditionerParameters());
+  virtual ~IncompleteCholeskyPreconditioner() {}
+
+  /* Computation Interfaces for raw vector */
+  void solve(const Vector& y, Vector &x) const override;
+  void transposeSolve(const Vector& y, Vector& x) const override;
+  void build(
+    const GaussianFactorGraph &gfg,
+    const KeyInfo &info,
+    const std::map<Key,Vector> &lambda
+    ) override;
+
+  /// The incomplete factor L of the scaled Hessian
+  const SparseEigen& L() const { return L_; }
+
+  /// The diagonal shift that was needed to complete the factorization
+  double shift() const { return shift_; }
+
+protected:
+  /// Try to factorize the scaled lower triangle A + shift*I, return false on breakdown
+  bool factorize(const SparseEigen &A, double shift);
+
+  IncompleteCholeskyPreconditionerParameters parameters_;
+  SparseEigen L_;   ///< lower triangular incomplete factor
+  Vector scaling_;  ///< diagonal of S
+  double shift_;
+};
+
+/*******************************************************************************************/
+/**
+ * Parameters for the cluster-Jacobi preconditioner: starting from a seed,
+ * a cluster greedily takes the unassigned variable most strongly coupled to
+ * any of its members, until no more fit in maxClusterDim scalar dimensions.
+ */
+struct GTSAM_EXPORT ClusterJacobiPreconditionerParameters : public PreconditionerParameters {
+  typedef PreconditionerParameters Base;
+  size_t maxClusterDim; ///< maximum scalar dimension of a cluster
+
+  explicit ClusterJacobiPreconditionerParameters(size_t dim = 36)
+      : Base(), maxClusterDim(dim) {}
+  virtual ~ClusterJacobiPreconditionerParameters() {}
+  void print(std::ostream &os) const override;
+};
+
+/*******************************************************************************************/
+/**
+ * Block-Jacobi preconditioner over clusters of variables rather than single
+ * variables: the dense Hessian block of every cluster is extracted from the
+ * sparse Hessian and factorized, in parallel over clusters.
+ */
+class GTSAM_EXPORT ClusterJacobiPreconditioner : public Preconditioner {
+public:
+  typedef Preconditioner Base;
+  ClusterJacobiPreconditioner(const ClusterJacobiPreconditionerParameters &p =
+                                  ClusterJacobiPreconditionerParameters());
+  virtual ~ClusterJacobiPreconditioner() {}
+
+  /* Computation Interfaces for raw vector */
+  void solve(const Vector& y, Vector &x) const override;
+  void transposeSolve(const Vector& y, Vector& x) const override;
+  void build(
+    const GaussianFactorGraph &gfg,
+    const KeyInfo &info,
+    const std::map<Key,Vector> &lambda
+    ) override;
+
+  /// Number of clusters
+  size_t nrClusters() const { return clusters_.size() - 1; }
+
+  /// Variables (indices in the KeyInfo ordering) of every cluster
+  std::vector<std::vector<size_t> > clusters() const;
+
+protected:
+  ClusterJacobiPreconditionerParameters parameters_;
+  std::vector<size_t> clusters_;  ///< scalar indices of cluster c are indices_[clusters_[c]..clusters_[c+1]]
+  std::vector<size_t> indices_;
+  std::vector<size_t> variables_; ///< first variable of every cluster in variableList_
+  std::vector<size_t> variableList_;
+  std::vector<Matrix> factors_;   ///< lower Cholesky factor of every cluster block
+};
+
 /*********************************************************************************************/
 /* factory method to create preconditioners */
 boost::shared_ptr<Preconditioner> createPreconditioner(const boost::shared_ptr<PreconditionerParameters> parameters);
@@ -71,6 +71,15 @@ public:
     checkInvariants();
   }
 
+  /**
+   * Construct on the given keys, with the augmented information matrix
+   * allocated but not initialized, to be filled in through info()
+   */
+  explicit RegularHessianFactor(const KeyVector& keys) {
+    keys_ = keys;
+    info_ = SymmetricBlockMatrix(std::vector<DenseIndex>(keys.size(), D), true);
+  }
+
   /// Construct from RegularJacobianFactor
   RegularHessianFactor(const RegularJacobianFactor<D>& jf)
       : HessianFactor(jf) {}
@@ -0,0 +1,339 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file   SchurComplementSolver.cpp
+ * @brief  Linear solver for camera/point (bundle adjustment) structure
+ * @date   October 2026
+ */
+
+#include <gtsam/linear/SchurComplementSolver.h>
+#include <gtsam/linear/GaussianConditional.h>
+#include <gtsam/linear/GaussianFactorGraph.h>
+#include <gtsam/linear/HessianFactor.h>
+#include <gtsam/linear/VectorValues.h>
+#include <gtsam/linear/linearExceptions.h>
+#include <gtsam/base/SymmetricBlockMatrix.h>
+#include <gtsam/base/cholesky.h>
+#include <gtsam/base/timing.h>
+#include <gtsam/config.h> // for GTSAM_USE_TBB
+
+#ifdef GTSAM_USE_TBB
+#  include <tbb/blocked_range.h>
+#  include <tbb/parallel_for.h>
+#  include <tbb/parallel_reduce.h>
+#endif
+
+#include <boost/optional.hpp>
+
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+using namespace std;
+
+namespace gtsam {
+
+/* ************************************************************************* */
+void SchurComplementSolverParameters::print(const string& s) const {
+  cout << s << endl;
+  print(cout);
+}
+
+/* ************************************************************************* */
+void SchurComplementSolverParameters::print(ostream& os) const {
+  os << "SchurComplementSolverParameters:" << endl
+     << "pointDim:         " << pointDim << endl
+     << "explicit points:  " << points.size() << endl
+     << "reduced system:   " << (pcg ? "PCG" : "dense Cholesky") << endl;
+}
+
+/* ************************************************************************* */
+namespace {
+
+/// The factors involving a single point, eliminated together
+struct PointBlock {
+  Key point;
+  GaussianFactorGraph factors;
+};
+
+/// Add the augmented information of a factor on cameras only into the reduced
+/// camera system, where slots maps camera keys to block indices.
+void updateReducedSystem(const GaussianFactor& factor,
+                         const FastMap<Key, DenseIndex>& slots,
+                         SymmetricBlockMatrix* info) {
+  boost::optional<HessianFactor> converted;
+  const HessianFactor* hessian = dynamic_cast<const HessianFactor*>(&factor);
+  if (!hessian) {
+    converted = HessianFactor(factor);
+    hessian = converted.get_ptr();
+  }
+
+  const SymmetricBlockMatrix& factorInfo = hessian->info();
+  const DenseIndex n = hessian->size();
+  vector<DenseIndex> blocks(n + 1);
+  for (DenseIndex j = 0; j < n; ++j) blocks[j] = slots.at(hessian->keys()[j]);
+  blocks[n] = info->nBlocks() - 1;
+
+  for (DenseIndex j = 0; j <= n; ++j) {
+    info->updateDiagonalBlock(blocks[j], factorInfo.diagonalBlock(j));
+    for (DenseIndex i = 0; i < j; ++i)
+      info->updateOffDiagonalBlock(blocks[i], blocks[j],
+                                   factorInfo.aboveDiagonalBlock(i, j));
+  }
+}
+
+/// Eliminate a single point, returning the Schur complement on its cameras
+GaussianFactor::shared_ptr eliminatePoint(
+    const PointBlock& block, GaussianConditional::shared_ptr* conditional) {
+  Ordering frontal;
+  frontal.push_back(block.point);
+  const auto result = EliminatePreferCholesky(block.factors, frontal);
+  *conditional = result.first;
+  return result.second;
+}
+
+/// Eliminates points and accumulates their Schur complements in a private
+/// (thread-local when run through tbb::parallel_reduce) reduced camera system.
+class _EliminatePointsDense {
+  const vector<PointBlock>& blocks_;
+  const FastMap<Key, DenseIndex>& slots_;
+  vector<GaussianConditional::shared_ptr>& conditionals_;
+
+ public:
+  SymmetricBlockMatrix info;
+
+  _EliminatePointsDense(const vector<PointBlock>& blocks,
+                        const FastMap<Key, DenseIndex>& slots,
+                        const vector<size_t>& dims,
+                        vector<GaussianConditional::shared_ptr>& conditionals)
+      : blocks_(blocks), slots_(slots), conditionals_(conditionals),
+        info(dims, true) {
+    info.setZero();
+  }
+
+  /// Eliminate points [begin, end)
+  void eliminate(size_t begin, size_t end) {
+    for (size_t i = begin; i != end; ++i) {
+      const GaussianFactor::shared_ptr reduced =
+          eliminatePoint(blocks_[i], &conditionals_[i]);
+      if (reduced && !reduced->empty())
+        updateReducedSystem(*reduced, slots_, &info);
+    }
+  }
+
+  /// Add the reduced camera system accumulated by another thread
+  void add(const SymmetricBlockMatrix& other) {
+    for (DenseIndex J = 0; J < info.nBlocks(); ++J) {
+      if (J > 0)
+        info.aboveDiagonalRange(0, J, J, J + 1) +=
+            other.aboveDiagonalRange(0, J, J, J + 1);
+      info.updateDiagonalBlock(J, other.diagonalBlock(J));
+    }
+  }
+
+#ifdef GTSAM_USE_TBB
+  _EliminatePointsDense(_EliminatePointsDense& other, tbb::split)
+      : blocks_(other.blocks_), slots_(other.slots_),
+        conditionals_(other.conditionals_),
+        info(SymmetricBlockMatrix::LikeActiveViewOf(other.info)) {
+    info.setZero();
+  }
+
+  void operator()(const tbb::blocked_range<size_t>& range) {
+    eliminate(range.begin(), range.end());
+  }
+
+  void join(const _EliminatePointsDense& other) { add(other.info); }
+#endif
+};
+
+#ifdef GTSAM_USE_TBB
+/// Eliminates points, keeping their Schur complements as separate factors
+class _EliminatePointsSparse {
+  const vector<PointBlock>& blocks_;
+  vector<GaussianConditional::shared_ptr>& conditionals_;
+  vector<GaussianFactor::shared_ptr>& reduced_;
+
+ public:
+  _EliminatePointsSparse(const vector<PointBlock>& blocks,
+                         vector<GaussianConditional::shared_ptr>& conditionals,
+                         vector<GaussianFactor::shared_ptr>& reduced)
+      : blocks_(blocks), conditionals_(conditionals), reduced_(reduced) {}
+
+  void operator()(const tbb::blocked_range<size_t>& range) const {
+    for (size_t i = range.begin(); i != range.end(); ++i)
+      reduced_[i] = eliminatePoint(blocks_[i], &conditionals_[i]);
+  }
+};
+
+/// Back-substitutes points given the solution for the cameras
+class _BackSubstitutePoints {
+  const vector<GaussianConditional::shared_ptr>& conditionals_;
+  const VectorValues& cameras_;
+  vector<Vector>& points_;
+
+ public:
+  _BackSubstitutePoints(const vector<GaussianConditional::shared_ptr>& conditionals,
+                        const VectorValues& cameras, vector<Vector>& points)
+      : conditionals_(conditionals), cameras_(cameras), points_(points) {}
+
+  void operator()(const tbb::blocked_range<size_t>& range) const {
+    for (size_t i = range.begin(); i != range.end(); ++i)
+      points_[i] = conditionals_[i]->solve(cameras_).begin()->second;
+  }
+};
+#endif
+
+}  // namespace
+
+/* ************************************************************************* */
+KeySet SchurComplementSolver::DetectPoints(const GaussianFactorGraph& gfg,
+                                           size_t pointDim) {
+  KeySet candidates;
+  for (const auto& key_dim : gfg.getKeyDimMap())
+    if (key_dim.second == pointDim) candidates.insert(key_dim.first);
+
+  // Two candidates sharing a factor can not both be eliminated independently
+  KeySet rejected;
+  KeyVector inFactor;
+  for (const GaussianFactor::shared_ptr& factor : gfg) {
+    if (!factor) continue;
+    inFactor.clear();
+    for (Key key : *factor)
+      if (candidates.count(key)) inFactor.push_back(key);
+    if (inFactor.size() > 1) rejected.insert(inFactor.begin(), inFactor.end());
+  }
+
+  KeySet points;
+  for (Key key : candidates)
+    if (!rejected.count(key)) points.insert(key);
+  return points;
+}
+
+/* ************************************************************************* */
+VectorValues SchurComplementSolver::optimize(const GaussianFactorGraph& gfg) const {
+  gttic(SchurComplementSolver_optimize);
+
+  const KeySet points = parameters_.points.empty()
+                            ? DetectPoints(gfg, parameters_.pointDim)
+                            : parameters_.points;
+
+  // Partition the factors into per-point blocks and camera-only factors
+  gttic(partition);
+  FastMap<Key, size_t> pointIndex;
+  vector<PointBlock> blocks;
+  GaussianFactorGraph cameraFactors;
+  for (const GaussianFactor::shared_ptr& factor : gfg) {
+    if (!factor) continue;
+    boost::optional<Key> point;
+    for (Key key : *factor) {
+      if (!points.count(key)) continue;
+      if (point && *point != key)
+        throw invalid_argument(
+            "SchurComplementSolver: a factor involves more than one point");
+      point = key;
+    }
+    if (!point) {
+      cameraFactors.push_back(factor);
+      continue;
+    }
+    auto inserted = pointIndex.emplace(*point, blocks.size());
+    if (inserted.second) blocks.push_back(PointBlock{*point, GaussianFactorGraph()});
+    blocks[inserted.first->second].factors.push_back(factor);
+  }
+
+  // The remaining variables form the reduced camera system
+  KeyVector cameraKeys;
+  vector<size_t> cameraDims;
+  FastMap<Key, DenseIndex> slots;
+  for (const auto& key_dim : gfg.getKeyDimMap()) {
+    if (points.count(key_dim.first)) continue;
+    slots.emplace(key_dim.first, cameraKeys.size());
+    cameraKeys.push_back(key_dim.first);
+    cameraDims.push_back(key_dim.second);
+  }
+  gttoc(partition);
+
+  // Eliminate all points and solve the reduced camera system
+  vector<GaussianConditional::shared_ptr> conditionals(blocks.size());
+  VectorValues delta;
+  TbbOpenMPMixedScope threadLimiter; // Limits OpenMP threads since we're mixing TBB and OpenMP
+  if (parameters_.pcg) {
+    gttic(eliminate_points);
+    vector<GaussianFactor::shared_ptr> reduced(blocks.size());
+#ifdef GTSAM_USE_TBB
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, blocks.size()),
+                      _EliminatePointsSparse(blocks, conditionals, reduced));
+#else
+    for (size_t i = 0; i < blocks.size(); ++i)
+      reduced[i] = eliminatePoint(blocks[i], &conditionals[i]);
+#endif
+    gttoc(eliminate_points);
+
+    gttic(solve_cameras);
+    GaussianFactorGraph reducedGraph = cameraFactors;
+    for (const GaussianFactor::shared_ptr& factor : reduced)
+      if (factor && !factor->empty()) reducedGraph.push_back(factor);
+    if (!cameraKeys.empty())
+      delta = PCGSolver(*parameters_.pcg).optimize(reducedGraph);
+    gttoc(solve_cameras);
+  } else {
+    gttic(eliminate_points);
+    _EliminatePointsDense eliminator(blocks, slots, cameraDims, conditionals);
+#ifdef GTSAM_USE_TBB
+    tbb::parallel_reduce(tbb::blocked_range<size_t>(0, blocks.size()), eliminator);
+#else
+    eliminator.eliminate(0, blocks.size());
+#endif
+    SymmetricBlockMatrix& info = eliminator.info;
+    for (const GaussianFactor::shared_ptr& factor : cameraFactors)
+      updateReducedSystem(*factor, slots, &info);
+    gttoc(eliminate_points);
+
+    gttic(solve_cameras);
+    if (!cameraKeys.empty()) {
+      const DenseIndex n = cameraKeys.size();
+      try {
+        info.choleskyPartial(n);
+      } catch (const CholeskyFailed&) {
+        throw IndeterminantLinearSystemException(cameraKeys.front());
+      }
+      const Vector solution =
+          info.triangularView(0, n).solve(info.aboveDiagonalRange(0, n, n, n + 1));
+      DenseIndex offset = 0;
+      for (DenseIndex j = 0; j < n; ++j) {
+        const DenseIndex dim = info.getDim(j);
+        delta.emplace(cameraKeys[j], solution.segment(offset, dim));
+        offset += dim;
+      }
+    }
+    gttoc(solve_cameras);
+  }
+
+  // Back-substitute points
+  gttic(back_substitute);
+  vector<Vector> pointDeltas(blocks.size());
+#ifdef GTSAM_USE_TBB
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, blocks.size()),
+                    _BackSubstitutePoints(conditionals, delta, pointDeltas));
+#else
+  for (size_t i = 0; i < blocks.size(); ++i)
+    pointDeltas[i] = conditionals[i]->solve(delta).begin()->second;
+#endif
+  for (size_t i = 0; i < blocks.size(); ++i)
+    delta.emplace(blocks[i].point, pointDeltas[i]);
+  gttoc(back_substitute);
+
+  return delta;
+}
+
+}  // namespace gtsam
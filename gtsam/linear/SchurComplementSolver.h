@@ -0,0 +1,100 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file   SchurComplementSolver.h
+ * @brief  Linear solver for camera/point (bundle adjustment) structure
+ * @date   October 2026
+ */
+
+#pragma once
+
+#include <gtsam/linear/PCGSolver.h>
+#include <gtsam/inference/Key.h>
+
+#include <boost/shared_ptr.hpp>
+
+#include <iosfwd>
+#include <string>
+
+namespace gtsam {
+
+// Forward declarations
+class GaussianFactorGraph;
+class VectorValues;
+
+/**
+ * Parameters for the SchurComplementSolver.
+ * If no point keys are given, they are detected automatically: every variable
+ * of dimension pointDim that never shares a factor with another such variable
+ * is eliminated first.
+ */
+struct GTSAM_EXPORT SchurComplementSolverParameters {
+  typedef boost::shared_ptr<SchurComplementSolverParameters> shared_ptr;
+
+  size_t pointDim;  ///< Dimension of point variables when detecting them (default 3)
+  KeySet points;    ///< Explicit point keys, or empty to detect them automatically
+
+  /// If set, the reduced camera system is solved with PCG, otherwise with dense Cholesky
+  PCGSolverParameters::shared_ptr pcg;
+
+  SchurComplementSolverParameters() : pointDim(3) {}
+
+  void print(const std::string& s = "") const;
+  void print(std::ostream& os) const;
+};
+
+/**
+ * Solves a linear system with the classic bipartite camera/point structure of
+ * bundle adjustment by eliminating all points first.
+ *
+ * Every point is eliminated independently: its Schur complement onto the
+ * cameras it is observed by is accumulated in thread-local SymmetricBlockMatrix
+ * storage, and the per-thread results are summed into the reduced camera system.
+ * After solving the reduced system (dense or with PCG), the points are
+ * back-substituted in parallel. Factors that involve no point are added to the
+ * reduced camera system as-is.
+ *
+ * To use it in nonlinear optimization:
+ *
+ *  LevenbergMarquardtParams parameters;
+ *  parameters.linearSolverType = NonlinearOptimizerParams::SCHUR_COMPLEMENT;
+ *  LevenbergMarquardtOptimizer optimizer(graph, initialEstimate, parameters);
+ *  Values result = optimizer.optimize();
+ *
+ * Note that the dense reduced camera system is stored once per thread, so for
+ * large numbers of cameras the PCG variant should be preferred.
+ */
+class GTSAM_EXPORT SchurComplementSolver {
+ public:
+  typedef SchurComplementSolverParameters Parameters;
+
+ protected:
+  Parameters parameters_;
+
+ public:
+  explicit SchurComplementSolver(const Parameters& parameters = Parameters())
+      : parameters_(parameters) {}
+
+  /// Return the parameters
+  const Parameters& parameters() const { return parameters_; }
+
+  /**
+   * Detect point variables: variables of dimension pointDim that are not
+   * connected through a factor to any other variable of that dimension.
+   */
+  static KeySet DetectPoints(const GaussianFactorGraph& gfg, size_t pointDim);
+
+  /// Solve the linear system, returning the solution for all variables
+  VectorValues optimize(const GaussianFactorGraph& gfg) const;
+};
+
+}  // namespace gtsam
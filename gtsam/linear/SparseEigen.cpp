@@ -0,0 +1,366 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file   SparseEigen.cpp
+ * @brief  Export of the sparse Jacobian and Hessian of a GaussianFactorGraph
+ *         as Eigen::SparseMatrix, in CSC or CSR format
+ * @date   October 2026
+ */
+
+#include <gtsam/linear/SparseEigen.h>
+#include <gtsam/linear/GaussianFactorGraph.h>
+#include <gtsam/linear/JacobianFactor.h>
+#include <gtsam/base/FastMap.h>
+#include <gtsam/base/parallelFor.h>
+#include <gtsam/base/timing.h>
+
+#include <boost/tuple/tuple.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+using namespace std;
+
+namespace gtsam {
+
+/* ************************************************************************* */
+namespace {
+/// Number of Jacobian rows of a factor, see SparseEigenBuilder
+size_t factorRows(const GaussianFactor& factor) {
+  if (auto jacobian = dynamic_cast<const JacobianFactor*>(&factor))
+    return jacobian->rows();
+  size_t rows = 1;
+  for (GaussianFactor::const_iterator key = factor.begin(); key != factor.end(); ++key)
+    rows += factor.getDim(key);
+  return rows;
+}
+
+/// Whitened [A b] of a factor, zero-padded to the given number of rows
+Matrix augmentedJacobianOf(const GaussianFactor& factor, size_t rows) {
+  Matrix A;
+  Vector b;
+  boost::tie(A, b) = factor.jacobian();
+  Matrix Ab = Matrix::Zero(rows, A.cols() + 1);
+  Ab.topLeftCorner(A.rows(), A.cols()) = A;
+  Ab.col(A.cols()).head(b.size()) = b;
+  return Ab;
+}
+
+/// Append the outer index entries of count inner vectors with nnz entries each
+void appendOuter(std::vector<int>& outer, size_t count, size_t nnz) {
+  for (size_t k = 0; k < count; ++k) {
+    const size_t next = outer.back() + nnz;
+    if (next > size_t(numeric_limits<int>::max()))
+      throw runtime_error("SparseEigenBuilder: too many non-zeros for int indices");
+    outer.push_back(int(next));
+  }
+}
+
+/// Give S the outer index and size of the pattern, unless it has it already.
+/// Returns true if the inner indices still need to be filled.
+template <int OPTIONS>
+bool preparePattern(Eigen::SparseMatrix<double, OPTIONS, int>& S, size_t rows,
+                    size_t cols, const std::vector<int>& outer) {
+  if (size_t(S.rows()) == rows && size_t(S.cols()) == cols && S.isCompressed() &&
+      S.nonZeros() == outer.back() &&
+      equal(outer.begin(), outer.end(), S.outerIndexPtr()))
+    return false;
+  S.resize(rows, cols);
+  S.resizeNonZeros(outer.back());
+  copy(outer.begin(), outer.end(), S.outerIndexPtr());
+  return true;
+}
+}  // namespace
+
+/* ************************************************************************* */
+SparseEigenBuilder::SparseEigenBuilder(const GaussianFactorGraph& gfg,
+                                       const Ordering& ordering)
+    : ordering_(ordering) {
+  initialize(gfg);
+}
+
+/* ************************************************************************* */
+SparseEigenBuilder::SparseEigenBuilder(const GaussianFactorGraph& gfg)
+    : ordering_(Ordering::Natural(gfg)) {
+  initialize(gfg);
+}
+
+/* ************************************************************************* */
+void SparseEigenBuilder::initialize(const GaussianFactorGraph& gfg) {
+  gttic(SparseEigenBuilder_initialize);
+  const size_t nb = ordering_.size();  // block nb is b
+  FastMap<Key, size_t> blockIndex;
+  for (size_t j = 0; j < nb; ++j) blockIndex[ordering_[j]] = j;
+
+  // Slots of every factor, dimensions, and rows
+  dims_.assign(nb + 1, 0);
+  dims_[nb] = 1;
+  factorPtr_.assign(1, 0);
+  rowOffsets_.assign(1, 0);
+  for (size_t f = 0; f < gfg.size(); ++f) {
+    const GaussianFactorGraph::sharedFactor& factor = gfg[f];
+    if (factor) {
+      size_t offset = 0;
+      for (GaussianFactor::const_iterator key = factor->begin();
+           key != factor->end(); ++key) {
+        const auto entry = blockIndex.find(*key);
+        if (entry == blockIndex.end())
+          throw invalid_argument("SparseEigenBuilder: factor key not in ordering");
+        const size_t j = entry->second, dim = factor->getDim(key);
+        if (dims_[j] != 0 && dims_[j] != dim)
+          throw invalid_argument("SparseEigenBuilder: inconsistent variable dimensions");
+        dims_[j] = dim;
+        slotBlock_.push_back(j);
+        slotFactor_.push_back(f);
+        slotOffset_.push_back(offset);
+        offset += dim;
+      }
+      slotBlock_.push_back(nb);
+      slotFactor_.push_back(f);
+      slotOffset_.push_back(offset);
+    }
+    factorPtr_.push_back(slotBlock_.size());
+    rowOffsets_.push_back(rowOffsets_.back() + (factor ? factorRows(*factor) : 0));
+  }
+  const size_t nrFactors = gfg.size(), nrSlots = slotBlock_.size();
+
+  colOffsets_.assign(1, 0);
+  for (size_t j = 0; j <= nb; ++j) colOffsets_.push_back(colOffsets_.back() + dims_[j]);
+
+  // Slots in every block column, by counting sort, in factor order
+  blockSlotPtr_.assign(nb + 2, 0);
+  for (size_t s = 0; s < nrSlots; ++s) ++blockSlotPtr_[slotBlock_[s] + 1];
+  for (size_t j = 0; j <= nb; ++j) blockSlotPtr_[j + 1] += blockSlotPtr_[j];
+  blockSlots_.resize(nrSlots);
+  std::vector<size_t> next(blockSlotPtr_.begin(), blockSlotPtr_.end() - 1);
+  for (size_t s = 0; s < nrSlots; ++s) blockSlots_[next[slotBlock_[s]]++] = s;
+
+  // Jacobian CSC: rows in every block column, and where every slot starts in it
+  slotColRow_.resize(nrSlots);
+  jacobianColPtr_.assign(1, 0);
+  for (size_t j = 0; j <= nb; ++j) {
+    size_t colRows = 0;
+    for (size_t k = blockSlotPtr_[j]; k < blockSlotPtr_[j + 1]; ++k) {
+      const size_t s = blockSlots_[k], f = slotFactor_[s];
+      slotColRow_[s] = colRows;
+      colRows += rowOffsets_[f + 1] - rowOffsets_[f];
+    }
+    appendOuter(jacobianColPtr_, dims_[j], colRows);
+  }
+
+  // Jacobian CSR: entries in every row, and where every slot starts in it
+  slotRowCol_.resize(nrSlots);
+  jacobianRowPtr_.assign(1, 0);
+  std::vector<size_t> sorted;
+  for (size_t f = 0; f < nrFactors; ++f) {
+    sorted.assign(factorPtr_[f + 1] - factorPtr_[f], 0);
+    for (size_t k = 0; k < sorted.size(); ++k) sorted[k] = factorPtr_[f] + k;
+    sort(sorted.begin(), sorted.end(), [this](size_t s, size_t t) {
+      return slotBlock_[s] < slotBlock_[t];
+    });
+    size_t rowNnz = 0;
+    for (size_t s : sorted) {
+      slotRowCol_[s] = rowNnz;
+      rowNnz += dims_[slotBlock_[s]];
+    }
+    appendOuter(jacobianRowPtr_, rowOffsets_[f + 1] - rowOffsets_[f], rowNnz);
+  }
+
+  // Hessian: sorted block rows of every block column
+  std::vector<std::vector<size_t> > neighbors(nb + 1);
+  for (size_t f = 0; f < nrFactors; ++f)
+    for (size_t s = factorPtr_[f]; s < factorPtr_[f + 1]; ++s)
+      for (size_t t = factorPtr_[f]; t < factorPtr_[f + 1]; ++t)
+        neighbors[slotBlock_[s]].push_back(slotBlock_[t]);
+  hessianPtr_.assign(1, 0);
+  hessianBlocks_.clear();
+  hessianBlockOffset_.clear();
+  hessianColPtr_.assign(1, 0);
+  for (size_t j = 0; j <= nb; ++j) {
+    std::vector<size_t>& rows = neighbors[j];
+    sort(rows.begin(), rows.end());
+    rows.erase(unique(rows.begin(), rows.end()), rows.end());
+    size_t colNnz = 0;
+    for (size_t i : rows) {
+      hessianBlocks_.push_back(i);
+      hessianBlockOffset_.push_back(colNnz);
+      colNnz += dims_[i];
+    }
+    hessianPtr_.push_back(hessianBlocks_.size());
+    appendOuter(hessianColPtr_, dims_[j], colNnz);
+  }
+}
+
+/* ************************************************************************* */
+void SparseEigenBuilder::checkStructure(const GaussianFactorGraph& gfg) const {
+  static const invalid_argument changed(
+      "SparseEigenBuilder: graph structure differs from the one in the constructor");
+  if (gfg.size() != factorPtr_.size() - 1) throw changed;
+  for (size_t f = 0; f < gfg.size(); ++f) {
+    const GaussianFactorGraph::sharedFactor& factor = gfg[f];
+    const size_t nrSlots = factorPtr_[f + 1] - factorPtr_[f];
+    if (!factor) {
+      if (nrSlots != 0) throw changed;
+      continue;
+    }
+    if (nrSlots != factor->size() + 1 ||
+        factorRows(*factor) != rowOffsets_[f + 1] - rowOffsets_[f])
+      throw changed;
+    size_t s = factorPtr_[f];
+    for (GaussianFactor::const_iterator key = factor->begin();
+         key != factor->end(); ++key, ++s)
+      if (*key != ordering_[slotBlock_[s]] ||
+          size_t(factor->getDim(key)) != dims_[slotBlock_[s]])
+        throw changed;
+  }
+}
+
+/* ************************************************************************* */
+void SparseEigenBuilder::augmentedJacobian(const GaussianFactorGraph& gfg,
+                                           SparseEigen& Ab) const {
+  gttic(SparseEigenBuilder_augmentedJacobian);
+  checkStructure(gfg);
+  const bool fillPattern = preparePattern(Ab, rows(), cols(), jacobianColPtr_);
+  int* inner = Ab.innerIndexPtr();
+  double* values = Ab.valuePtr();
+  parallelFor(gfg.size(), [&](size_t f) {
+    if (factorPtr_[f] == factorPtr_[f + 1]) return;
+    const size_t m = rowOffsets_[f + 1] - rowOffsets_[f];
+    const Matrix Abf = augmentedJacobianOf(*gfg[f], m);
+    for (size_t s = factorPtr_[f]; s < factorPtr_[f + 1]; ++s) {
+      const size_t j = slotBlock_[s];
+      for (size_t c = 0; c < dims_[j]; ++c) {
+        const size_t start = jacobianColPtr_[colOffsets_[j] + c] + slotColRow_[s];
+        Eigen::Map<Vector>(values + start, m) = Abf.col(slotOffset_[s] + c);
+        if (fillPattern)
+          for (size_t r = 0; r < m; ++r) inner[start + r] = int(rowOffsets_[f] + r);
+      }
+    }
+  });
+}
+
+/* ************************************************************************* */
+void SparseEigenBuilder::augmentedJacobian(const GaussianFactorGraph& gfg,
+                                           SparseEigenRowMajor& Ab) const {
+  gttic(SparseEigenBuilder_augmentedJacobian);
+  checkStructure(gfg);
+  const bool fillPattern = preparePattern(Ab, rows(), cols(), jacobianRowPtr_);
+  int* inner = Ab.innerIndexPtr();
+  double* values = Ab.valuePtr();
+  parallelFor(gfg.size(), [&](size_t f) {
+    if (factorPtr_[f] == factorPtr_[f + 1]) return;
+    const size_t m = rowOffsets_[f + 1] - rowOffsets_[f];
+    const Matrix Abf = augmentedJacobianOf(*gfg[f], m);
+    for (size_t r = 0; r < m; ++r) {
+      const size_t rowStart = jacobianRowPtr_[rowOffsets_[f] + r];
+      for (size_t s = factorPtr_[f]; s < factorPtr_[f + 1]; ++s) {
+        const size_t j = slotBlock_[s], start = rowStart + slotRowCol_[s];
+        Eigen::Map<Vector>(values + start, dims_[j]) =
+            Abf.row(r).segment(slotOffset_[s], dims_[j]).transpose();
+        if (fillPattern)
+          for (size_t c = 0; c < dims_[j]; ++c)
+            inner[start + c] = int(colOffsets_[j] + c);
+      }
+    }
+  });
+}
+
+/* ************************************************************************* */
+void SparseEigenBuilder::fillHessian(const GaussianFactorGraph& gfg, int* inner,
+                                     double* values) const {
+  // Augmented information matrices of all factors, in factor key order
+  std::vector<Matrix> information(gfg.size());
+  parallelFor(gfg.size(), [&](size_t f) {
+    if (factorPtr_[f] != factorPtr_[f + 1])
+      information[f] = gfg[f]->augmentedInformation();
+  });
+
+  // Every block column only sums contributions of its own factors
+  parallelFor(dims_.size(), [&](size_t j) {
+    const size_t* rowsBegin = hessianBlocks_.data() + hessianPtr_[j];
+    const size_t* rowsEnd = hessianBlocks_.data() + hessianPtr_[j + 1];
+    for (size_t c = colOffsets_[j]; c < colOffsets_[j + 1]; ++c) {
+      size_t k = hessianColPtr_[c];
+      fill(values + k, values + hessianColPtr_[c + 1], 0.0);
+      if (inner)
+        for (const size_t* i = rowsBegin; i != rowsEnd; ++i)
+          for (size_t r = colOffsets_[*i]; r < colOffsets_[*i + 1]; ++r)
+            inner[k++] = int(r);
+    }
+    for (size_t k = blockSlotPtr_[j]; k < blockSlotPtr_[j + 1]; ++k) {
+      const size_t s = blockSlots_[k], f = slotFactor_[s];
+      const Matrix& info = information[f];
+      for (size_t t = factorPtr_[f]; t < factorPtr_[f + 1]; ++t) {
+        const size_t i = slotBlock_[t];
+        const size_t rowStart =
+            hessianBlockOffset_[lower_bound(rowsBegin, rowsEnd, i) -
+                                hessianBlocks_.data()];
+        for (size_t c = 0; c < dims_[j]; ++c)
+          Eigen::Map<Vector>(values + hessianColPtr_[colOffsets_[j] + c] + rowStart,
+                             dims_[i]) +=
+              info.block(slotOffset_[t], slotOffset_[s] + c, dims_[i], 1);
+      }
+    }
+  });
+}
+
+/* ************************************************************************* */
+void SparseEigenBuilder::augmentedHessian(const GaussianFactorGraph& gfg,
+                                          SparseEigen& H) const {
+  gttic(SparseEigenBuilder_augmentedHessian);
+  checkStructure(gfg);
+  const bool fillPattern = preparePattern(H, cols(), cols(), hessianColPtr_);
+  fillHessian(gfg, fillPattern ? H.innerIndexPtr() : nullptr, H.valuePtr());
+}
+
+/* ************************************************************************* */
+void SparseEigenBuilder::augmentedHessian(const GaussianFactorGraph& gfg,
+                                          SparseEigenRowMajor& H) const {
+  // The augmented Hessian is symmetric, so its CSR arrays equal the CSC ones
+  gttic(SparseEigenBuilder_augmentedHessian);
+  checkStructure(gfg);
+  const bool fillPattern = preparePattern(H, cols(), cols(), hessianColPtr_);
+  fillHessian(gfg, fillPattern ? H.innerIndexPtr() : nullptr, H.valuePtr());
+}
+
+/* ************************************************************************* */
+SparseEigen sparseJacobianEigen(const GaussianFactorGraph& gfg,
+                                const Ordering& ordering) {
+  SparseEigen Ab;
+  SparseEigenBuilder(gfg, ordering).augmentedJacobian(gfg, Ab);
+  return Ab;
+}
+
+/* ************************************************************************* */
+SparseEigen sparseJacobianEigen(const GaussianFactorGraph& gfg) {
+  SparseEigen Ab;
+  SparseEigenBuilder(gfg).augmentedJacobian(gfg, Ab);
+  return Ab;
+}
+
+/* ************************************************************************* */
+SparseEigen sparseHessianEigen(const GaussianFactorGraph& gfg,
+                               const Ordering& ordering) {
+  SparseEigen H;
+  SparseEigenBuilder(gfg, ordering).augmentedHessian(gfg, H);
+  return H;
+}
+
+/* ************************************************************************* */
+SparseEigen sparseHessianEigen(const GaussianFactorGraph& gfg) {
+  SparseEigen H;
+  SparseEigenBuilder(gfg).augmentedHessian(gfg, H);
+  return H;
+}
+
+}  // namespace gtsam
@@ -0,0 +1,142 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file   SparseEigen.h
+ * @brief  Export of the sparse Jacobian and Hessian of a GaussianFactorGraph
+ *         as Eigen::SparseMatrix, in CSC or CSR format
+ * @date   October 2026
+ */
+
+#pragma once
+
+#include <gtsam/inference/Ordering.h>
+#include <gtsam/dllexport.h>
+
+#include <Eigen/Sparse>
+
+#include <vector>
+
+namespace gtsam {
+
+// Forward declarations
+class GaussianFactorGraph;
+
+/// Compressed sparse column (CSC) matrix
+typedef Eigen::SparseMatrix<double, Eigen::ColMajor, int> SparseEigen;
+
+/// Compressed sparse row (CSR) matrix
+typedef Eigen::SparseMatrix<double, Eigen::RowMajor, int> SparseEigenRowMajor;
+
+/**
+ * Computes the sparsity pattern of the augmented Jacobian \f$ [A\;b] \f$ and
+ * the augmented Hessian \f$ [A\;b]^T [A\;b] \f$ of a GaussianFactorGraph once,
+ * and then fills Eigen sparse matrices with it, in parallel over factors
+ * (Jacobian) or block columns (Hessian) when TBB is available.
+ *
+ * The pattern only depends on the keys and dimensions of the factors, not on
+ * their values: all entries of the Jacobian blocks are stored, including zeros.
+ * When the output matrix already has the pattern from an earlier call, only
+ * its values are overwritten, so relinearized graphs with the same structure
+ * can be exported without reallocation. Calling with a graph whose structure
+ * differs from the one given in the constructor throws std::invalid_argument.
+ *
+ * Column layout follows the ordering, with b as the last column. Every factor
+ * contributes rows() rows to the Jacobian in graph order, except that
+ * HessianFactors are converted with a Cholesky factorization into dim+1 rows,
+ * zero-padded if the factor is rank-deficient. The noise models are baked
+ * into A and b. The augmented Hessian is stored completely (both triangles),
+ * so its CSC and CSR versions hold the same arrays.
+ */
+class GTSAM_EXPORT SparseEigenBuilder {
+ protected:
+  Ordering ordering_;
+  std::vector<size_t> dims_;        ///< dimension of every block column, b last
+  std::vector<size_t> colOffsets_;  ///< scalar offset of every block column
+  std::vector<size_t> rowOffsets_;  ///< scalar offset of every factor
+
+  // Blocks of factor f are slots factorPtr_[f]..factorPtr_[f+1], b last
+  std::vector<size_t> factorPtr_;
+  std::vector<size_t> slotBlock_;     ///< block column of every slot
+  std::vector<size_t> slotFactor_;    ///< factor of every slot
+  std::vector<size_t> slotOffset_;    ///< scalar column of every slot in its factor
+  std::vector<size_t> slotColRow_;    ///< first row of the slot within its CSC column
+  std::vector<size_t> slotRowCol_;    ///< first entry of the slot within its CSR row
+
+  // Slots in block column j are blockSlots_[blockSlotPtr_[j]..blockSlotPtr_[j+1]]
+  std::vector<size_t> blockSlotPtr_, blockSlots_;
+
+  // Hessian block rows in block column j are hessianBlocks_[hessianPtr_[j]..]
+  std::vector<size_t> hessianPtr_, hessianBlocks_, hessianBlockOffset_;
+
+  std::vector<int> jacobianColPtr_;  ///< CSC outer index of [A b]
+  std::vector<int> jacobianRowPtr_;  ///< CSR outer index of [A b]
+  std::vector<int> hessianColPtr_;   ///< outer index of the augmented Hessian
+
+ public:
+  /// Compute the sparsity pattern, with columns in the given ordering
+  SparseEigenBuilder(const GaussianFactorGraph& gfg, const Ordering& ordering);
+
+  /// Compute the sparsity pattern, with columns in natural (sorted key) ordering
+  explicit SparseEigenBuilder(const GaussianFactorGraph& gfg);
+
+  /// Column ordering
+  const Ordering& ordering() const { return ordering_; }
+
+  /// Number of rows of [A b]
+  size_t rows() const { return rowOffsets_.back(); }
+
+  /// Number of columns of [A b], i.e., of A plus one
+  size_t cols() const { return colOffsets_.back(); }
+
+  /// Number of stored entries in [A b]
+  size_t jacobianNonZeros() const { return jacobianColPtr_.back(); }
+
+  /// Number of stored entries in the augmented Hessian
+  size_t hessianNonZeros() const { return hessianColPtr_.back(); }
+
+  /// Fill the augmented Jacobian [A b] in CSC format
+  void augmentedJacobian(const GaussianFactorGraph& gfg, SparseEigen& Ab) const;
+
+  /// Fill the augmented Jacobian [A b] in CSR format
+  void augmentedJacobian(const GaussianFactorGraph& gfg,
+                         SparseEigenRowMajor& Ab) const;
+
+  /// Fill the augmented Hessian [A b]'[A b] in CSC format
+  void augmentedHessian(const GaussianFactorGraph& gfg, SparseEigen& H) const;
+
+  /// Fill the augmented Hessian [A b]'[A b] in CSR format
+  void augmentedHessian(const GaussianFactorGraph& gfg,
+                        SparseEigenRowMajor& H) const;
+
+ private:
+  void initialize(const GaussianFactorGraph& gfg);
+  void checkStructure(const GaussianFactorGraph& gfg) const;
+  /// Fill values, and inner indices unless inner is null
+  void fillHessian(const GaussianFactorGraph& gfg, int* inner,
+                   double* values) const;
+};
+
+/// Sparse augmented Jacobian [A b] in CSC format, see SparseEigenBuilder
+GTSAM_EXPORT SparseEigen sparseJacobianEigen(const GaussianFactorGraph& gfg,
+                                             const Ordering& ordering);
+
+/// Sparse augmented Jacobian [A b] in CSC format, in natural ordering
+GTSAM_EXPORT SparseEigen sparseJacobianEigen(const GaussianFactorGraph& gfg);
+
+/// Sparse augmented Hessian [A b]'[A b] in CSC format, see SparseEigenBuilder
+GTSAM_EXPORT SparseEigen sparseHessianEigen(const GaussianFactorGraph& gfg,
+                                            const Ordering& ordering);
+
+/// Sparse augmented Hessian [A b]'[A b] in CSC format, in natural ordering
+GTSAM_EXPORT SparseEigen sparseHessianEigen(const GaussianFactorGraph& gfg);
+
+}  // namespace gtsam
@@ -15,8 +15,8 @@
  * @author Frank Dellaert, Yong-Dian Jian
  */
 
-#include <gtsam/base/DSFVector.h>
 #include <gtsam/base/FastMap.h>
+#include <gtsam/base/parallelFor.h>
 #include <gtsam/base/WeightedSampler.h>
 #include <gtsam/inference/Ordering.h>
 #include <gtsam/inference/VariableIndex.h>
@@ -51,27 +51,120 @@ using std::vector;
 namespace gtsam {
 
 /*****************************************************************************/
-/* sort the container and return permutation index with default comparator */
-template <typename Container>
-static vector<size_t> sort_idx(const Container &src) {
-  typedef typename Container::value_type T;
-  const size_t n = src.size();
-  vector<std::pair<size_t, T> > tmp;
-  tmp.reserve(n);
-  for (size_t i = 0; i < n; i++) tmp.emplace_back(i, src[i]);
-
-  /* sort */
-  std::stable_sort(tmp.begin(), tmp.end());
-
-  /* copy back */
-  vector<size_t> idx;
-  idx.reserve(n);
-  for (size_t i = 0; i < n; i++) {
-    idx.push_back(tmp[i].first);
+namespace {
+
+/* binary factor as an edge between the variables u and v */
+struct WeightedEdge {
+  double weight;
+  size_t index, u, v;
+};
+
+/* heavier edges first, ties broken by factor index: as this is a strict total
+ * order, the maximum spanning tree is unique */
+inline bool heavier(const WeightedEdge &a, const WeightedEdge &b) {
+  return a.weight > b.weight || (a.weight == b.weight && a.index < b.index);
+}
+
+/* disjoint sets with path halving and union by size */
+class UnionFind {
+  vector<size_t> parent_, size_;
+
+ public:
+  explicit UnionFind(size_t n) : parent_(n), size_(n, 1) {
+    std::iota(parent_.begin(), parent_.end(), 0);
+  }
+
+  /* representative without changing the forest, safe to call concurrently */
+  size_t root(size_t i) const {
+    while (parent_[i] != i) i = parent_[i];
+    return i;
+  }
+
+  /* merge the sets of i and j, return false if they were the same set */
+  bool merge(size_t i, size_t j) {
+    i = find(i);
+    j = find(j);
+    if (i == j) return false;
+    if (size_[i] < size_[j]) std::swap(i, j);
+    parent_[j] = i;
+    size_[i] += size_[j];
+    return true;
   }
-  return idx;
+
+ private:
+  size_t find(size_t i) {
+    while (parent_[i] != i) {
+      parent_[i] = parent_[parent_[i]];
+      i = parent_[i];
+    }
+    return i;
+  }
+};
+
+/* below this many edges, filterKruskal sorts and runs plain Kruskal */
+const size_t kKruskalBaseSize = 4096;
+
+/* Filter-Kruskal (Osipov et al. 2009): split the edges at the median, solve
+ * the heavy half, then drop the light edges that would close a cycle before
+ * recursing on them. The filter is a parallel loop, and most light edges in
+ * large graphs never get sorted. Tree edges are appended to tree until it has
+ * target edges, heaviest first. */
+void filterKruskal(vector<WeightedEdge>::iterator first,
+                   vector<WeightedEdge>::iterator last, UnionFind &dsf,
+                   size_t target, vector<WeightedEdge> &tree) {
+  if (tree.size() >= target || first == last) return;
+  const size_t m = last - first;
+  if (m <= kKruskalBaseSize) {
+    std::sort(first, last, heavier);
+    for (auto it = first; it != last && tree.size() < target; ++it)
+      if (dsf.merge(it->u, it->v)) tree.push_back(*it);
+    return;
+  }
+
+  const auto middle = first + m / 2;
+  std::nth_element(first, middle, last, heavier);
+  filterKruskal(first, middle, dsf, target, tree);
+  if (tree.size() >= target) return;
+
+  const size_t nrLight = last - middle;
+  vector<char> keep(nrLight);
+  parallelFor(nrLight, [&](size_t i) {
+    keep[i] = dsf.root(middle[i].u) != dsf.root(middle[i].v);
+  });
+  auto kept = middle;
+  for (size_t i = 0; i < nrLight; i++)
+    if (keep[i]) *kept++ = middle[i];
+  filterKruskal(middle, kept, dsf, target, tree);
 }
 
+/* natural chain edges connect consecutive keys */
+bool isNaturalChainEdge(const GaussianFactor &gf) {
+  if (gf.size() != 2) return false;
+  const Key k0 = gf.keys()[0], k1 = gf.keys()[1];
+  return (k1 - k0) == 1 || (k0 - k1) == 1;
+}
+
+/* edges of all binary factors with index in [begin, gfg.size()) */
+vector<WeightedEdge> binaryEdges(const GaussianFactorGraph &gfg,
+                                 const FastMap<Key, size_t> &ordering,
+                                 const vector<double> &weights,
+                                 size_t begin = 0) {
+  vector<size_t> indices;
+  for (size_t index = begin; index < gfg.size(); index++)
+    if (gfg[index]->size() == 2) indices.push_back(index);
+
+  vector<WeightedEdge> edges(indices.size());
+  parallelFor(indices.size(), [&](size_t i) {
+    const size_t index = indices[i];
+    const KeyVector &keys = gfg[index]->keys();
+    edges[i] = WeightedEdge{weights[index], index, ordering.at(keys[0]),
+                            ordering.at(keys[1])};
+  });
+  return edges;
+}
+
+}  // namespace
+
 /****************************************************************************/
 Subgraph::Subgraph(const vector<size_t> &indices) {
   edges_.reserve(indices.size());
@@ -234,6 +327,30 @@ std::string SubgraphBuilderParameters::augmentationWeightTranslator(
     return "UNKNOWN";
 }
 
+/****************************************************************/
+void SpanningTreeCache::clear() {
+  skeletonType_ = skeletonWeight_ = -1;
+  nrFactors_ = 0;
+  tree_.clear();
+  keys_.clear();
+  weights_.clear();
+}
+
+/****************************************************************/
+bool SpanningTreeCache::isValidFor(const GaussianFactorGraph &gfg,
+                                   int skeletonType, int skeletonWeight) const {
+  if (empty() || skeletonType != skeletonType_ ||
+      skeletonWeight != skeletonWeight_ || gfg.size() < nrFactors_)
+    return false;
+  for (size_t j = 0; j < tree_.size(); j++) {
+    const GaussianFactor::shared_ptr &gf = gfg[tree_[j]];
+    if (!gf || gf->size() != 2 || gf->keys()[0] != keys_[2 * j] ||
+        gf->keys()[1] != keys_[2 * j + 1])
+      return false;
+  }
+  return true;
+}
+
 /****************************************************************/
 vector<size_t> SubgraphBuilder::buildTree(const GaussianFactorGraph &gfg,
                                           const FastMap<Key, size_t> &ordering,
@@ -275,10 +392,7 @@ vector<size_t> SubgraphBuilder::natural_chain(
   vector<size_t> chainFactorIndices;
   size_t index = 0;
   for (const GaussianFactor::shared_ptr &gf : gfg) {
-    if (gf->size() == 2) {
-      const Key k0 = gf->keys()[0], k1 = gf->keys()[1];
-      if ((k1 - k0) == 1 || (k0 - k1) == 1) chainFactorIndices.push_back(index);
-    }
+    if (isNaturalChainEdge(*gf)) chainFactorIndices.push_back(index);
     index++;
   }
   return chainFactorIndices;
@@ -325,33 +439,89 @@ vector<size_t> SubgraphBuilder::bfs(const GaussianFactorGraph &gfg) const {
 vector<size_t> SubgraphBuilder::kruskal(const GaussianFactorGraph &gfg,
                                         const FastMap<Key, size_t> &ordering,
                                         const vector<double> &weights) const {
-  const VariableIndex variableIndex(gfg);
-  const size_t n = variableIndex.size();
-  const vector<size_t> sortedIndices = sort_idx(weights);
+  const size_t n = ordering.size();
+  vector<WeightedEdge> edges = binaryEdges(gfg, ordering, weights);
+
+  vector<WeightedEdge> tree;
+  tree.reserve(n - 1);
+  UnionFind dsf(n);
+  filterKruskal(edges.begin(), edges.end(), dsf, n - 1, tree);
 
-  /* initialize buffer */
   vector<size_t> treeIndices;
-  treeIndices.reserve(n - 1);
-
-  // container for acsendingly sorted edges
-  DSFVector dsf(n);
-
-  size_t count = 0;
-  double sum = 0.0;
-  for (const size_t index : sortedIndices) {
-    const GaussianFactor &gf = *gfg[index];
-    const auto keys = gf.keys();
-    if (keys.size() != 2) continue;
-    const size_t u = ordering.find(keys[0])->second,
-                 v = ordering.find(keys[1])->second;
-    if (dsf.find(u) != dsf.find(v)) {
-      dsf.merge(u, v);
-      treeIndices.push_back(index);
-      sum += weights[index];
-      if (++count == n - 1) break;
+  treeIndices.reserve(tree.size());
+  for (const WeightedEdge &edge : tree) treeIndices.push_back(edge.index);
+  return treeIndices;
+}
+
+/****************************************************************/
+vector<size_t> SubgraphBuilder::cachedTree(const GaussianFactorGraph &gfg,
+                                           const FastMap<Key, size_t> &ordering,
+                                           const vector<double> &weights) const {
+  const auto &p = parameters_;
+  SpanningTreeCache &cache = *p.treeCache;
+  const size_t n = ordering.size(), m = gfg.size();
+
+  vector<size_t> tree;
+  vector<double> treeWeights;
+  if (!cache.isValidFor(gfg, p.skeletonType, p.skeletonWeight)) {
+    tree = buildTree(gfg, ordering, weights);
+    for (const size_t index : tree) treeWeights.push_back(weights[index]);
+    cache.nrRebuilds_++;
+  } else if (p.skeletonType == SubgraphBuilderParameters::NATURALCHAIN) {
+    tree = cache.tree_;
+    treeWeights = cache.weights_;
+    for (size_t index = cache.nrFactors_; index < m; index++) {
+      if (isNaturalChainEdge(*gfg[index])) {
+        tree.push_back(index);
+        treeWeights.push_back(weights[index]);
+      }
+    }
+    cache.nrUpdates_++;
+  } else {
+    // Candidates are the cached tree, with its cached weights, and the new
+    // binary factors. Every other old edge closes a cycle in the cached tree
+    // on which it is the lightest, so it cannot be in the new tree either.
+    vector<WeightedEdge> edges;
+    edges.reserve(cache.tree_.size());
+    for (size_t j = 0; j < cache.tree_.size(); j++)
+      edges.push_back(WeightedEdge{cache.weights_[j], cache.tree_[j],
+                                   ordering.at(cache.keys_[2 * j]),
+                                   ordering.at(cache.keys_[2 * j + 1])});
+    const vector<WeightedEdge> added =
+        binaryEdges(gfg, ordering, weights, cache.nrFactors_);
+    edges.insert(edges.end(), added.begin(), added.end());
+
+    vector<WeightedEdge> newTree;
+    UnionFind dsf(n);
+    if (p.skeletonType == SubgraphBuilderParameters::KRUSKAL) {
+      filterKruskal(edges.begin(), edges.end(), dsf, n - 1, newTree);
+    } else {
+      for (const WeightedEdge &edge : edges)
+        if (dsf.merge(edge.u, edge.v)) newTree.push_back(edge);
     }
+    for (const WeightedEdge &edge : newTree) {
+      tree.push_back(edge.index);
+      treeWeights.push_back(edge.weight);
+    }
+    cache.nrUpdates_++;
   }
-  return treeIndices;
+
+  cache.skeletonType_ = p.skeletonType;
+  cache.skeletonWeight_ = p.skeletonWeight;
+  cache.nrFactors_ = m;
+  cache.tree_ = tree;
+  cache.weights_ = treeWeights;
+  cache.keys_.clear();
+  cache.keys_.reserve(2 * tree.size());
+  for (const size_t index : tree) {
+    const KeyVector &keys = gfg[index]->keys();
+    if (keys.size() != 2) {  // BFS may use factors on more than two keys
+      cache.clear();
+      break;
+    }
+    cache.keys_.insert(cache.keys_.end(), keys.begin(), keys.end());
+  }
+  return tree;
 }
 
 /****************************************************************/
@@ -379,8 +549,16 @@ Subgraph SubgraphBuilder::operator()(const GaussianFactorGraph &gfg) const {
   // Calculate weights
   vector<double> weights = this->weights(gfg);
 
-  // Build spanning tree.
-  const vector<size_t> tree = buildTree(gfg, forward_ordering, weights);
+  // Build spanning tree, or extend the cached one. Random weights only drive
+  // the sampling of the extra edges: the tree is the one of equal weights,
+  // i.e., in factor order, whose subgraph is known to be well-posed.
+  const vector<double> skeletonWeights =
+      p.skeletonWeight == SubgraphBuilderParameters::RANDOM
+          ? vector<double>(m, 1.0)
+          : weights;
+  const vector<size_t> tree =
+      p.treeCache ? cachedTree(gfg, forward_ordering, skeletonWeights)
+                  : buildTree(gfg, forward_ordering, skeletonWeights);
   if (tree.size() != n - 1) {
     throw std::runtime_error(
         "SubgraphBuilder::operator() failure: tree.size() != n-1");
@@ -405,42 +583,46 @@ Subgraph SubgraphBuilder::operator()(const GaussianFactorGraph &gfg) const {
 SubgraphBuilder::Weights SubgraphBuilder::weights(
     const GaussianFactorGraph &gfg) const {
   const size_t m = gfg.size();
-  Weights weight;
-  weight.reserve(m);
+  Weights weight(m, 0.0);
 
-  for (const GaussianFactor::shared_ptr &gf : gfg) {
-    switch (parameters_.skeletonWeight) {
-      case SubgraphBuilderParameters::EQUAL:
-        weight.push_back(1.0);
-        break;
-      case SubgraphBuilderParameters::RHS_2NORM: {
+  switch (parameters_.skeletonWeight) {
+    case SubgraphBuilderParameters::EQUAL:
+      std::fill(weight.begin(), weight.end(), 1.0);
+      break;
+    case SubgraphBuilderParameters::RHS_2NORM:
+      parallelFor(m, [&](size_t i) {
+        const GaussianFactor::shared_ptr &gf = gfg[i];
         if (JacobianFactor::shared_ptr jf =
                 boost::dynamic_pointer_cast<JacobianFactor>(gf)) {
-          weight.push_back(jf->getb().norm());
+          weight[i] = jf->getb().norm();
         } else if (HessianFactor::shared_ptr hf =
                        boost::dynamic_pointer_cast<HessianFactor>(gf)) {
-          weight.push_back(hf->linearTerm().norm());
+          weight[i] = hf->linearTerm().norm();
         }
-      } break;
-      case SubgraphBuilderParameters::LHS_FNORM: {
+      });
+      break;
+    case SubgraphBuilderParameters::LHS_FNORM:
+      parallelFor(m, [&](size_t i) {
+        const GaussianFactor::shared_ptr &gf = gfg[i];
         if (JacobianFactor::shared_ptr jf =
                 boost::dynamic_pointer_cast<JacobianFactor>(gf)) {
-          weight.push_back(std::sqrt(jf->getA().squaredNorm()));
+          weight[i] = std::sqrt(jf->getA().squaredNorm());
         } else if (HessianFactor::shared_ptr hf =
                        boost::dynamic_pointer_cast<HessianFactor>(gf)) {
-          weight.push_back(std::sqrt(hf->information().squaredNorm()));
+          weight[i] = std::sqrt(hf->information().squaredNorm());
         }
-      } break;
+      });
+      break;
 
-      case SubgraphBuilderParameters::RANDOM:
-        weight.push_back(std::rand() % 100 + 1.0);
-        break;
+    // std::rand is not thread-safe, and the sequence should not depend on it
+    case SubgraphBuilderParameters::RANDOM:
+      for (size_t i = 0; i < m; i++) weight[i] = std::rand() % 100 + 1.0;
+      break;
 
-      default:
-        throw std::invalid_argument(
-            "SubgraphBuilder::weights: undefined weight scheme ");
-        break;
-    }
+    default:
+      throw std::invalid_argument(
+          "SubgraphBuilder::weights: undefined weight scheme ");
+      break;
   }
   return weight;
 }
@@ -36,6 +36,7 @@ namespace gtsam {
 
 // Forward declarations
 class GaussianFactorGraph;
+class SpanningTreeCache;
 struct PreconditionerParameters;
 
 /**************************************************************************/
@@ -106,7 +107,9 @@ struct GTSAM_EXPORT SubgraphBuilderParameters {
                         EQUAL = 0, /* every block edge has equal weight */
                         RHS_2NORM, /* use the 2-norm of the rhs */
                         LHS_FNORM, /* use the frobenius norm of the lhs */
-                        RANDOM,    /* bounded random edge weight */
+                        RANDOM,    /* bounded random edge weight, used for
+                                      the extra edges only, the tree is the
+                                      one of EQUAL weights */
   } skeletonWeight;
 
   enum AugmentationWeight {               /* how to weigh the graph edges */
@@ -121,6 +124,10 @@ struct GTSAM_EXPORT SubgraphBuilderParameters {
   /// factor multiplied with n, yields number of extra edges.
   double augmentationFactor; 
 
+  /// If set, the spanning tree is kept here and extended on the next call,
+  /// see SpanningTreeCache. Copies of the parameters share the cache.
+  boost::shared_ptr<SpanningTreeCache> treeCache;
+
   SubgraphBuilderParameters()
       : skeletonType(KRUSKAL),
         skeletonWeight(RANDOM),
@@ -142,6 +149,58 @@ struct GTSAM_EXPORT SubgraphBuilderParameters {
   static std::string augmentationWeightTranslator(AugmentationWeight w);
 };
 
+/*****************************************************************************/
+/**
+ * Spanning tree of a growing factor graph, kept between SubgraphBuilder calls
+ * so that incremental pipelines, which append factors to the same graph at
+ * every step, only pay for the new factors. The cached tree is reused when the
+ * skeleton parameters are unchanged, the graph has at least as many factors as
+ * before, and the tree factors still connect the same keys. It is then
+ * extended with the new binary factors: for KRUSKAL, the maximum spanning tree
+ * of the cached tree and the new edges is computed, which is the maximum
+ * spanning tree of the whole graph for the cached weights; for BFS, the tree
+ * is extended greedily in factor order; for NATURALCHAIN, new chain factors
+ * are appended. In all other cases, the tree is rebuilt from scratch.
+ */
+class GTSAM_EXPORT SpanningTreeCache {
+ public:
+  typedef boost::shared_ptr<SpanningTreeCache> shared_ptr;
+
+  SpanningTreeCache() : nrRebuilds_(0), nrUpdates_(0) { clear(); }
+
+  /// Forget the cached tree, the next call rebuilds it
+  void clear();
+
+  /// Whether a tree is cached
+  bool empty() const { return skeletonType_ < 0; }
+
+  /// Number of factors in the graph the cached tree was built for
+  size_t nrFactors() const { return nrFactors_; }
+
+  /// Factor indices of the cached tree edges
+  const std::vector<size_t> &tree() const { return tree_; }
+
+  /// Number of times the tree was built from scratch
+  size_t nrRebuilds() const { return nrRebuilds_; }
+
+  /// Number of times the cached tree was extended incrementally
+  size_t nrUpdates() const { return nrUpdates_; }
+
+ private:
+  friend class SubgraphBuilder;
+
+  int skeletonType_, skeletonWeight_;   ///< parameters used, -1 if empty
+  size_t nrFactors_;                    ///< size of the cached graph
+  std::vector<size_t> tree_;            ///< factor indices of the tree
+  std::vector<Key> keys_;               ///< two keys per tree factor
+  std::vector<double> weights_;         ///< weight of every tree factor
+  size_t nrRebuilds_, nrUpdates_;
+
+  /// Check whether the cached tree can be extended for gfg
+  bool isValidFor(const GaussianFactorGraph &gfg, int skeletonType,
+                  int skeletonWeight) const;
+};
+
 /*****************************************************************************/
 class GTSAM_EXPORT SubgraphBuilder {
  public:
@@ -164,6 +223,9 @@ class GTSAM_EXPORT SubgraphBuilder {
   std::vector<size_t> kruskal(const GaussianFactorGraph &gfg,
                               const FastMap<Key, size_t> &ordering,
                               const std::vector<double> &weights) const;
+  std::vector<size_t> cachedTree(const GaussianFactorGraph &gfg,
+                                 const FastMap<Key, size_t> &ordering,
+                                 const std::vector<double> &weights) const;
   std::vector<size_t> sample(const std::vector<double> &weights,
                              const size_t t) const;
   Weights weights(const GaussianFactorGraph &gfg) const;
@@ -21,6 +21,7 @@
 #include <gtsam/linear/GaussianFactorGraph.h>
 #include <gtsam/linear/GaussianBayesNet.h>
 #include <gtsam/linear/JacobianFactor.h>
+#include <gtsam/linear/JacobianOperator.h>
 #include <gtsam/base/types.h>
 #include <gtsam/base/Vector.h>
 
@@ -102,6 +103,13 @@ SubgraphPreconditioner::SubgraphPreconditioner(const sharedFG& Ab2,
         b2bar_(new Errors(-Ab2_->gaussianErrors(*xbar))), parameters_(p) {
 }
 
+/* ************************************************************************* */
+void SubgraphPreconditioner::packA2() {
+  A2_ = boost::make_shared<JacobianOperator>(*Ab2_);
+  x2_.resize(A2_->cols());
+  e2_.resize(A2_->rows());
+}
+
 /* ************************************************************************* */
 // x = xbar + inv(R1)*y
 VectorValues SubgraphPreconditioner::x(const VectorValues& y) const {
@@ -148,7 +156,28 @@ void SubgraphPreconditioner::multiplyInPlace(const VectorValues& y, Errors& e) c
 
   // Add A2 contribution
   VectorValues x = Rc1()->backSubstitute(y);      // x=inv(R1)*y
-  Ab2()->multiplyInPlace(x, ei);                  // use iterator version
+  if (!A2_) {
+    Ab2()->multiplyInPlace(x, ei);                // use iterator version
+    return;
+  }
+
+  // Packed version: gather x, multiply, and scatter into the A2 errors
+  const KeyInfo& keyInfo = A2_->keyInfo();
+  for (const auto& key_info : keyInfo)
+    x2_.segment(key_info.second.start, key_info.second.dim) = x.at(key_info.first);
+  A2_->multiply(x2_, e2_);
+  DenseIndex row = 0;
+  for (const auto& factor : *Ab2_) {
+    // all factors in Ab2_ were converted to JacobianFactor in the constructor
+    const auto& jf = static_cast<const JacobianFactor&>(*factor);
+    if (jf.empty()) {
+      *ei = Vector::Zero(jf.rows());
+    } else {
+      *ei = e2_.segment(row, jf.rows());
+      row += jf.rows();
+    }
+    ++ei;
+  }
 }
 
 /* ************************************************************************* */
@@ -184,6 +213,25 @@ void SubgraphPreconditioner::transposeMultiplyAdd
 void SubgraphPreconditioner::transposeMultiplyAdd2 (double alpha,
     Errors::const_iterator it, Errors::const_iterator end, VectorValues& y) const {
 
+  if (A2_) {
+    // Packed version: gather e2, multiply, and scatter into x
+    DenseIndex row = 0;
+    for (const auto& factor : *Ab2_) {
+      const auto& jf = static_cast<const JacobianFactor&>(*factor);
+      if (!jf.empty()) {
+        e2_.segment(row, jf.rows()) = *it;
+        row += jf.rows();
+      }
+      ++it;
+    }
+    A2_->transposeMultiply(e2_, x2_);
+    VectorValues x = VectorValues::Zero(y); // x = 0
+    for (const auto& key_info : A2_->keyInfo())
+      x.at(key_info.first) = x2_.segment(key_info.second.start, key_info.second.dim);
+    axpy(alpha, Rc1_->backSubstituteTranspose(x), y); // y += alpha*inv(R1')*x
+    return;
+  }
+
   // create e2 with what's left of e
   // TODO can we avoid creating e2 by passing iterator to transposeMultiplyAdd ?
   Errors e2;
@@ -33,6 +33,7 @@ namespace gtsam {
   // Forward declarations
   class GaussianBayesNet;
   class GaussianFactorGraph;
+  class JacobianOperator;
   class VectorValues;
 
   struct GTSAM_EXPORT SubgraphPreconditionerParameters : public PreconditionerParameters {
@@ -67,6 +68,9 @@ namespace gtsam {
     KeyInfo keyInfo_;
     SubgraphPreconditionerParameters parameters_;
 
+    boost::shared_ptr<JacobianOperator> A2_; ///< packed A2, see packA2
+    mutable Vector x2_, e2_;                 ///< flat workspaces for packed A2
+
   public:
 
     SubgraphPreconditioner(const SubgraphPreconditionerParameters &p = SubgraphPreconditionerParameters());
@@ -88,6 +92,16 @@ namespace gtsam {
     /** Access Ab2 */
     const sharedFG& Ab2() const { return Ab2_; }
 
+    /**
+     * Pack A2 into a matrix-free JacobianOperator, after which the A2 products
+     * in multiplyInPlace and transposeMultiplyAdd use the packed operator.
+     * The workspaces make those methods unsafe to call concurrently.
+     */
+    void packA2();
+
+    /** Whether A2 has been packed */
+    bool isPacked() const { return static_cast<bool>(A2_); }
+
     /** Access Rc1 */
     const sharedBayesNet& Rc1() const { return Rc1_; }
 
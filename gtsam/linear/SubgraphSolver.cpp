@@ -43,6 +43,8 @@ SubgraphSolver::SubgraphSolver(const GaussianFactorGraph &Ab,
   auto Rc1 = Ab1->eliminateSequential(ordering, EliminateQR);
   auto xbar = boost::make_shared<VectorValues>(Rc1->optimize());
   pc_ = boost::make_shared<SubgraphPreconditioner>(Ab2, Rc1, xbar);
+  if (parameters_.blasKernel() == ConjugateGradientParameters::PACKED)
+    pc_->packA2();
 }
 
 /**************************************************************************************************/
@@ -53,6 +55,8 @@ SubgraphSolver::SubgraphSolver(const GaussianBayesNet::shared_ptr &Rc1,
     : parameters_(parameters) {
   auto xbar = boost::make_shared<VectorValues>(Rc1->optimize());
   pc_ = boost::make_shared<SubgraphPreconditioner>(Ab2, Rc1, xbar);
+  if (parameters_.blasKernel() == ConjugateGradientParameters::PACKED)
+    pc_->packA2();
 }
 
 /**************************************************************************************************/
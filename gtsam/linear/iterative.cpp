@@ -21,6 +21,7 @@
 #include <gtsam/base/Matrix.h>
 #include <gtsam/linear/GaussianFactorGraph.h>
 #include <gtsam/linear/IterativeSolver.h>
+#include <gtsam/linear/JacobianOperator.h>
 
 #include <iostream>
 
@@ -60,15 +61,43 @@ namespace gtsam {
     return conjugateGradients<System, Vector, Vector>(Ab, x, parameters);
   }
 
+  /* ************************************************************************* */
+  Vector steepestDescent(const JacobianOperator& Ab, const Vector& x,
+      const ConjugateGradientParameters & parameters) {
+    return conjugateGradients<JacobianOperator, Vector, Vector>(Ab, x, parameters, true);
+  }
+
+  Vector conjugateGradientDescent(const JacobianOperator& Ab, const Vector& x,
+      const ConjugateGradientParameters & parameters) {
+    return conjugateGradients<JacobianOperator, Vector, Vector>(Ab, x, parameters);
+  }
+
+  /* ************************************************************************* */
+  // Run CG on the packed operator, for ConjugateGradientParameters::PACKED
+  static VectorValues packedConjugateGradients(const GaussianFactorGraph& fg,
+      const VectorValues& x, const ConjugateGradientParameters & parameters,
+      bool steepest) {
+    const JacobianOperator Ab(fg);
+    const Vector solution = conjugateGradients<JacobianOperator, Vector, Vector>(
+        Ab, Ab.vector(x), parameters, steepest);
+    VectorValues result = x;
+    result.update(Ab.vectorValues(solution));
+    return result;
+  }
+
   /* ************************************************************************* */
   VectorValues steepestDescent(const GaussianFactorGraph& fg,
       const VectorValues& x, const ConjugateGradientParameters & parameters) {
+    if (parameters.blas_kernel_ == ConjugateGradientParameters::PACKED)
+      return packedConjugateGradients(fg, x, parameters, true);
     return conjugateGradients<GaussianFactorGraph, VectorValues, Errors>(
         fg, x, parameters, true);
   }
 
   VectorValues conjugateGradientDescent(const GaussianFactorGraph& fg,
       const VectorValues& x, const ConjugateGradientParameters & parameters) {
+    if (parameters.blas_kernel_ == ConjugateGradientParameters::PACKED)
+      return packedConjugateGradients(fg, x, parameters, false);
     return conjugateGradients<GaussianFactorGraph, VectorValues, Errors>(
         fg, x, parameters);
   }
@@ -24,6 +24,9 @@
 
 namespace gtsam {
 
+  // Forward declarations
+  class JacobianOperator;
+
   /**
    * Method of conjugate gradients (CG) template
    * "System" class S needs gradient(S,v), e=S*v, v=S^e
@@ -127,7 +130,24 @@ namespace gtsam {
       const ConjugateGradientParameters & parameters);
 
   /**
-   * Method of steepest gradients, Gaussian Factor Graph version
+   * Method of steepest gradients, packed JacobianOperator version
+   */
+  GTSAM_EXPORT Vector steepestDescent(
+      const JacobianOperator& Ab,
+      const Vector& x,
+      const ConjugateGradientParameters & parameters);
+
+  /**
+   * Method of conjugate gradients (CG), packed JacobianOperator version
+   */
+  GTSAM_EXPORT Vector conjugateGradientDescent(
+      const JacobianOperator& Ab,
+      const Vector& x,
+      const ConjugateGradientParameters & parameters);
+
+  /**
+   * Method of steepest gradients, Gaussian Factor Graph version.
+   * Uses a JacobianOperator if parameters.blas_kernel_ is PACKED.
    */
   GTSAM_EXPORT VectorValues steepestDescent(
       const GaussianFactorGraph& fg,
@@ -135,7 +155,8 @@ namespace gtsam {
       const ConjugateGradientParameters & parameters);
 
   /**
-   * Method of conjugate gradients (CG), Gaussian Factor Graph version
+   * Method of conjugate gradients (CG), Gaussian Factor Graph version.
+   * Uses a JacobianOperator if parameters.blas_kernel_ is PACKED.
    */
   GTSAM_EXPORT VectorValues conjugateGradientDescent(
       const GaussianFactorGraph& fg,
@@ -0,0 +1,152 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file   testBayesTreeSnapshot.cpp
+ * @brief  Unit tests for binary Bayes tree snapshots
+ * @date   October 2026
+ */
+
+#include <gtsam/linear/BayesTreeSnapshot.h>
+#include <gtsam/linear/GaussianFactorGraph.h>
+#include <gtsam/linear/VectorValues.h>
+
+#include <CppUnitLite/TestHarness.h>
+
+#include <boost/assign/std/vector.hpp>
+#include <boost/filesystem/operations.hpp>
+
+#include <fstream>
+
+using namespace std;
+using namespace gtsam;
+using namespace boost::assign;
+
+namespace {
+const string filename =
+    (boost::filesystem::temp_directory_path() / "testBayesTreeSnapshot.bin")
+        .string();
+
+// 1D chain x2 - x1, x2 - x3, x3 - x4, x2 as the root clique
+GaussianBayesTree chainBayesTree() {
+  const SharedDiagonal chainNoise = noiseModel::Isotropic::Sigma(1, 0.5);
+  const Matrix I1 = I_1x1;
+  GaussianFactorGraph chain;
+  chain.add(2, I1, 1, I1, Vector1(1.0), chainNoise);
+  chain.add(2, I1, 3, I1, Vector1(1.0), chainNoise);
+  chain.add(3, I1, 4, I1, Vector1(2.0), chainNoise);
+  chain.add(4, I1, Vector1(1.0), chainNoise);
+  Ordering ordering;
+  ordering += Key(2), Key(1), Key(3), Key(4);
+  return *chain.eliminateMultifrontal(ordering);
+}
+
+// 2D grid of 2-dimensional variables, which gives cliques of several frontals
+GaussianBayesTree gridBayesTree(size_t n) {
+  const SharedDiagonal noise = noiseModel::Diagonal::Sigmas(Vector2(0.1, 0.2));
+  GaussianFactorGraph graph;
+  const auto key = [n](size_t i, size_t j) { return Key(i * n + j); };
+  const Matrix I = I_2x2;
+  graph.add(key(0, 0), I_2x2, Vector2(1, 2), noise);
+  for (size_t i = 0; i < n; i++)
+    for (size_t j = 0; j < n; j++) {
+      const Vector2 b = Vector2(i, j);
+      if (i + 1 < n)
+        graph.add(key(i, j), -I, key(i + 1, j), I, b, noise);
+      if (j + 1 < n)
+        graph.add(key(i, j), -I, key(i, j + 1), 2 * I, b, noise);
+    }
+  return *graph.eliminateMultifrontal();
+}
+}  // namespace
+
+/* ************************************************************************* */
+TEST(BayesTreeSnapshot, chain) {
+  const GaussianBayesTree expected = chainBayesTree();
+  writeBayesTreeSnapshot(expected, filename);
+  const GaussianBayesTree actual = readBayesTreeSnapshot(filename);
+  EXPECT(assert_equal(expected, actual));
+  EXPECT(assert_equal(expected.optimize(), actual.optimize()));
+}
+
+/* ************************************************************************* */
+TEST(BayesTreeSnapshot, grid) {
+  const GaussianBayesTree expected = gridBayesTree(10);
+  writeBayesTreeSnapshot(expected, filename);
+  const GaussianBayesTree actual = readBayesTreeSnapshot(filename);
+  EXPECT(assert_equal(expected, actual));
+  EXPECT_LONGS_EQUAL(expected.size(), actual.size());
+  EXPECT(assert_equal(expected.optimize(), actual.optimize()));
+
+  // Children keep their order, so the trees are traversed identically
+  const auto& expectedChildren = expected.roots().front()->children;
+  const auto& actualChildren = actual.roots().front()->children;
+  LONGS_EQUAL(expectedChildren.size(), actualChildren.size());
+  for (size_t i = 0; i < expectedChildren.size(); i++)
+    EXPECT(assert_equal(*expectedChildren[i]->conditional(),
+                        *actualChildren[i]->conditional()));
+}
+
+/* ************************************************************************* */
+TEST(BayesTreeSnapshot, noiseModels) {
+  // Conditionals built directly keep their noise model
+  GaussianBayesTree expected;
+  const auto root = boost::make_shared<GaussianBayesTreeClique>(
+      boost::make_shared<GaussianConditional>(
+          0, Vector2(1, 2), (Matrix2() << 1, 2, 0, 3).finished(),
+          noiseModel::Constrained::MixedSigmas(Vector2(0, 0.5))));
+  const auto child = boost::make_shared<GaussianBayesTreeClique>(
+      boost::make_shared<GaussianConditional>(
+          1, Vector1(3.0), I_1x1, 0, (Matrix12() << 1, 2).finished(),
+          noiseModel::Isotropic::Sigma(1, 0.25)));
+  expected.addClique(root);
+  expected.addClique(child, root);
+  writeBayesTreeSnapshot(expected, filename);
+  const GaussianBayesTree actual = readBayesTreeSnapshot(filename);
+  EXPECT(assert_equal(expected, actual));
+  EXPECT(assert_equal(*root->conditional()->get_model(),
+                      *actual[0]->conditional()->get_model()));
+  EXPECT(assert_equal(*child->conditional()->get_model(),
+                      *actual[1]->conditional()->get_model()));
+}
+
+/* ************************************************************************* */
+TEST(BayesTreeSnapshot, empty) {
+  writeBayesTreeSnapshot(GaussianBayesTree(), filename);
+  EXPECT_LONGS_EQUAL(0, readBayesTreeSnapshot(filename).size());
+}
+
+/* ************************************************************************* */
+TEST(BayesTreeSnapshot, invalid) {
+  writeBayesTreeSnapshot(gridBayesTree(3), filename);
+  const auto size = boost::filesystem::file_size(filename);
+
+  // Truncated
+  boost::filesystem::resize_file(filename, size - 8);
+  CHECK_EXCEPTION(readBayesTreeSnapshot(filename), std::invalid_argument);
+
+  // Not a snapshot
+  {
+    ofstream os(filename.c_str(), ios::binary);
+    os << string(128, 'x');
+  }
+  CHECK_EXCEPTION(readBayesTreeSnapshot(filename), std::invalid_argument);
+  boost::filesystem::remove(filename);
+}
+
+/* ************************************************************************* */
+int main() {
+  TestResult tr;
+  const int result = TestRegistry::runAllTests(tr);
+  boost::filesystem::remove(filename);
+  return result;
+}
+/* ************************************************************************* */
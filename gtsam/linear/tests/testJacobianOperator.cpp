@@ -0,0 +1,121 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ *  @file   testJacobianOperator.cpp
+ *  @brief  Unit tests for the packed matrix-free JacobianOperator
+ **/
+
+#include <gtsam/linear/JacobianOperator.h>
+#include <gtsam/linear/GaussianFactorGraph.h>
+#include <gtsam/linear/HessianFactor.h>
+#include <gtsam/linear/JacobianFactor.h>
+#include <gtsam/linear/PCGSolver.h>
+#include <gtsam/linear/Preconditioner.h>
+#include <gtsam/linear/VectorValues.h>
+#include <gtsam/linear/iterative.h>
+#include <gtsam/base/TestableAssertions.h>
+
+#include <CppUnitLite/TestHarness.h>
+
+#include <boost/make_shared.hpp>
+
+using namespace std;
+using namespace gtsam;
+
+/* ************************************************************************* */
+/// Factor graph with 4 factors on 3 2D variables, non-unit noise and a Hessian
+static GaussianFactorGraph createGraph() {
+  GaussianFactorGraph fg;
+  Key x1 = 2, x2 = 0, l1 = 1;
+  SharedDiagonal unit2 = noiseModel::Unit::Create(2);
+  SharedDiagonal sigmas = noiseModel::Diagonal::Sigmas(Vector2(0.5, 2.0));
+  fg += JacobianFactor(x1, 10 * I_2x2, -1.0 * Vector::Ones(2), unit2);
+  fg += JacobianFactor(x2, 10 * I_2x2, x1, -10 * I_2x2, Vector2(2.0, -1.0), sigmas);
+  fg += JacobianFactor(l1, 5 * I_2x2, x1, -5 * I_2x2, Vector2(0.0, 1.0), unit2);
+  fg += JacobianFactor(x2, -5 * I_2x2, l1, 5 * I_2x2, Vector2(-1.0, 1.5), sigmas);
+  fg += HessianFactor(l1, 4 * I_2x2, Vector2(1.0, 2.0), 3.0);
+  return fg;
+}
+
+/* ************************************************************************* */
+TEST(JacobianOperator, Products) {
+  const GaussianFactorGraph gfg = createGraph();
+  const JacobianOperator A(gfg);
+  EXPECT_LONGS_EQUAL(5, A.nrBlockRows());
+  EXPECT_LONGS_EQUAL(8, A.nrBlocks());
+  EXPECT_LONGS_EQUAL(6, A.cols());
+
+  // Dense whitened Jacobian in the same column ordering
+  Matrix Ad;
+  Vector bd;
+  boost::tie(Ad, bd) = gfg.jacobian(A.keyInfo().ordering());
+  EXPECT_LONGS_EQUAL(Ad.rows(), A.rows());
+  EXPECT(assert_equal(bd, A.b()));
+
+  Vector x(6);
+  x << 1, 2, 3, 4, 5, 6;
+  Vector e(A.rows());
+  A.multiply(x, e);
+  EXPECT(assert_equal(Vector(Ad * x), e));
+  EXPECT(assert_equal(Vector(Ad * x), A * x));
+
+  Vector y(6);
+  A.transposeMultiply(e, y);
+  EXPECT(assert_equal(Vector(Ad.transpose() * e), y));
+
+  // y += 2*A'*A*x, checked against the factor graph version
+  y.setZero();
+  A.multiplyHessianAdd(2.0, x, y);
+  VectorValues expected;
+  gfg.multiplyHessianAdd(2.0, A.vectorValues(x), expected);
+  EXPECT(assert_equal(expected, A.vectorValues(y), 1e-9));
+
+  // Gradient
+  EXPECT(assert_equal(gfg.gradient(A.vectorValues(x)),
+                      A.vectorValues(A.gradient(x)), 1e-9));
+}
+
+/* ************************************************************************* */
+TEST(JacobianOperator, ConjugateGradient) {
+  const GaussianFactorGraph gfg = createGraph();
+  const VectorValues expected = gfg.optimize();
+
+  ConjugateGradientParameters parameters;
+  parameters.setEpsilon_abs(1e-12);
+  parameters.setEpsilon_rel(1e-12);
+  parameters.setBlasKernel(ConjugateGradientParameters::PACKED);
+  const VectorValues zero = VectorValues::Zero(expected);
+  EXPECT(assert_equal(expected, conjugateGradientDescent(gfg, zero, parameters), 1e-7));
+
+  const JacobianOperator A(gfg);
+  const Vector actual = conjugateGradientDescent(A, A.vector(zero), parameters);
+  EXPECT(assert_equal(expected, A.vectorValues(actual), 1e-7));
+}
+
+/* ************************************************************************* */
+TEST(JacobianOperator, PCG) {
+  const GaussianFactorGraph gfg = createGraph();
+  const VectorValues expected = gfg.optimize();
+
+  auto parameters = boost::make_shared<PCGSolverParameters>();
+  parameters->preconditioner_ =
+      boost::make_shared<BlockJacobiPreconditionerParameters>();
+  parameters->setEpsilon_abs(1e-12);
+  parameters->setEpsilon_rel(1e-12);
+  parameters->setBlasKernel(ConjugateGradientParameters::PACKED);
+  PCGSolver solver(*parameters);
+  EXPECT(assert_equal(expected, solver.optimize(gfg), 1e-7));
+}
+
+/* ************************************************************************* */
+int main() { TestResult tr; return TestRegistry::runAllTests(tr); }
+/* ************************************************************************* */
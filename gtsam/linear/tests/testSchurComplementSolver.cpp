@@ -0,0 +1,117 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ *  @file   testSchurComplementSolver.cpp
+ *  @brief  Unit tests for the bundle adjustment Schur complement solver
+ **/
+
+#include <gtsam/linear/SchurComplementSolver.h>
+#include <gtsam/linear/GaussianFactorGraph.h>
+#include <gtsam/linear/HessianFactor.h>
+#include <gtsam/linear/JacobianFactor.h>
+#include <gtsam/linear/Preconditioner.h>
+#include <gtsam/linear/VectorValues.h>
+#include <gtsam/inference/Symbol.h>
+#include <gtsam/base/TestableAssertions.h>
+
+#include <CppUnitLite/TestHarness.h>
+
+#include <boost/make_shared.hpp>
+
+using namespace std;
+using namespace gtsam;
+using symbol_shorthand::L;
+using symbol_shorthand::X;
+
+/* ************************************************************************* */
+// Bipartite graph with 4 six-dimensional cameras and 6 three-dimensional
+// points, every point seen by 3 cameras, plus a prior on every camera.
+static GaussianFactorGraph createBundleAdjustmentGraph() {
+  srand(42);
+  const SharedDiagonal unit2 = noiseModel::Unit::Create(2);
+  GaussianFactorGraph gfg;
+  for (size_t i = 0; i < 4; i++)
+    gfg.add(X(i), 10 * I_6x6, Vector6::Random(), noiseModel::Unit::Create(6));
+  for (size_t j = 0; j < 6; j++) {
+    for (size_t k = 0; k < 3; k++) {
+      const size_t i = (j + k) % 4;
+      gfg.add(X(i), Matrix26::Random(), L(j), Matrix23::Random(),
+              Vector2::Random(), unit2);
+    }
+  }
+  // camera-camera factor, to check that such factors end up in the reduced system
+  gfg.add(X(0), I_6x6, X(1), -I_6x6, Vector6::Random(), noiseModel::Unit::Create(6));
+  return gfg;
+}
+
+/* ************************************************************************* */
+TEST(SchurComplementSolver, DetectPoints) {
+  GaussianFactorGraph gfg = createBundleAdjustmentGraph();
+  KeySet expected;
+  for (size_t j = 0; j < 6; j++) expected.insert(L(j));
+  EXPECT(assert_container_equality(
+      expected, SchurComplementSolver::DetectPoints(gfg, 3)));
+
+  // Two points in the same factor are no longer candidates
+  gfg.add(L(0), I_3x3, L(1), -I_3x3, Vector3::Zero(), noiseModel::Unit::Create(3));
+  expected.erase(L(0));
+  expected.erase(L(1));
+  EXPECT(assert_container_equality(
+      expected, SchurComplementSolver::DetectPoints(gfg, 3)));
+}
+
+/* ************************************************************************* */
+TEST(SchurComplementSolver, Dense) {
+  const GaussianFactorGraph gfg = createBundleAdjustmentGraph();
+  const VectorValues expected = gfg.optimize();
+
+  const VectorValues actual = SchurComplementSolver().optimize(gfg);
+  EXPECT(assert_equal(expected, actual, 1e-7));
+
+  // Same result with explicitly given points, and with a Hessian graph
+  SchurComplementSolverParameters parameters;
+  for (size_t j = 0; j < 6; j++) parameters.points.insert(L(j));
+  GaussianFactorGraph hessians;
+  for (const GaussianFactor::shared_ptr& factor : gfg)
+    hessians.push_back(boost::make_shared<HessianFactor>(*factor));
+  EXPECT(assert_equal(expected,
+                      SchurComplementSolver(parameters).optimize(hessians), 1e-7));
+}
+
+/* ************************************************************************* */
+TEST(SchurComplementSolver, PCG) {
+  const GaussianFactorGraph gfg = createBundleAdjustmentGraph();
+  const VectorValues expected = gfg.optimize();
+
+  SchurComplementSolverParameters parameters;
+  parameters.pcg = boost::make_shared<PCGSolverParameters>();
+  parameters.pcg->preconditioner_ =
+      boost::make_shared<BlockJacobiPreconditionerParameters>();
+  parameters.pcg->setEpsilon_abs(1e-12);
+  parameters.pcg->setEpsilon_rel(1e-12);
+  const VectorValues actual = SchurComplementSolver(parameters).optimize(gfg);
+  EXPECT(assert_equal(expected, actual, 1e-5));
+}
+
+/* ************************************************************************* */
+TEST(SchurComplementSolver, InvalidPoints) {
+  const GaussianFactorGraph gfg = createBundleAdjustmentGraph();
+  SchurComplementSolverParameters parameters;
+  parameters.points.insert(X(0));
+  parameters.points.insert(X(1));
+  CHECK_EXCEPTION(SchurComplementSolver(parameters).optimize(gfg),
+                  std::invalid_argument);
+}
+
+/* ************************************************************************* */
+int main() { TestResult tr; return TestRegistry::runAllTests(tr); }
+/* ************************************************************************* */
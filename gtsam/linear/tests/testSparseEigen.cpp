@@ -0,0 +1,119 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ *  @file   testSparseEigen.cpp
+ *  @brief  Unit tests for the Eigen::SparseMatrix export of a GaussianFactorGraph
+ **/
+
+#include <gtsam/linear/SparseEigen.h>
+#include <gtsam/linear/GaussianFactorGraph.h>
+#include <gtsam/linear/HessianFactor.h>
+#include <gtsam/linear/JacobianFactor.h>
+#include <gtsam/base/TestableAssertions.h>
+
+#include <CppUnitLite/TestHarness.h>
+
+using namespace std;
+using namespace gtsam;
+
+/* ************************************************************************* */
+/// Factor graph with 4 factors on 3 2D variables, scaled by s
+static GaussianFactorGraph createJacobianGraph(double s = 1.0) {
+  GaussianFactorGraph fg;
+  Key x1 = 2, x2 = 0, l1 = 1;
+  SharedDiagonal unit2 = noiseModel::Unit::Create(2);
+  SharedDiagonal sigmas = noiseModel::Diagonal::Sigmas(Vector2(0.5, 2.0));
+  fg += JacobianFactor(x1, 10 * s * I_2x2, -1.0 * Vector::Ones(2), unit2);
+  fg += JacobianFactor(x2, 10 * I_2x2, x1, -10 * s * I_2x2, Vector2(2.0, -1.0), sigmas);
+  fg += JacobianFactor(l1, 5 * I_2x2, x1, -5 * I_2x2, Vector2(0.0, s), unit2);
+  fg += JacobianFactor(x2, -5 * s * I_2x2, l1, 5 * I_2x2, Vector2(-1.0, 1.5), sigmas);
+  return fg;
+}
+
+/* ************************************************************************* */
+TEST(SparseEigen, Jacobian) {
+  const GaussianFactorGraph gfg = createJacobianGraph();
+  Ordering ordering;
+  ordering += 2, 1, 0;
+  const Matrix expected = gfg.augmentedJacobian(ordering);
+
+  SparseEigenBuilder builder(gfg, ordering);
+  EXPECT_LONGS_EQUAL(8, builder.rows());
+  EXPECT_LONGS_EQUAL(7, builder.cols());
+  EXPECT_LONGS_EQUAL(6 * 2 + 4 * 2 + 4 * 2 + 8, builder.jacobianNonZeros());
+
+  const SparseEigen csc = sparseJacobianEigen(gfg, ordering);
+  EXPECT(assert_equal(expected, Matrix(csc)));
+
+  SparseEigenRowMajor csr;
+  builder.augmentedJacobian(gfg, csr);
+  EXPECT(assert_equal(expected, Matrix(csr)));
+
+  // Natural ordering matches the triplets of sparseJacobian
+  Matrix triplets = Matrix::Zero(8, 7);
+  for (const auto& entry : gfg.sparseJacobian())
+    triplets(entry.get<0>(), entry.get<1>()) = entry.get<2>();
+  EXPECT(assert_equal(triplets, Matrix(sparseJacobianEigen(gfg))));
+}
+
+/* ************************************************************************* */
+TEST(SparseEigen, Hessian) {
+  GaussianFactorGraph gfg = createJacobianGraph();
+  gfg += HessianFactor(1, 2, 100 * I_2x2, Z_2x2, Vector2(0.0, 1.0), 400 * I_2x2,
+                       Vector2(1.0, 1.0), 3.0);
+  Ordering ordering;
+  ordering += 0, 2, 1;
+  const Matrix expected = gfg.augmentedHessian(ordering);
+
+  SparseEigenBuilder builder(gfg, ordering);
+  EXPECT_LONGS_EQUAL(7 * 7, builder.hessianNonZeros());
+  EXPECT(assert_equal(expected, Matrix(sparseHessianEigen(gfg, ordering)), 1e-9));
+
+  SparseEigenRowMajor csr;
+  builder.augmentedHessian(gfg, csr);
+  EXPECT(assert_equal(expected, Matrix(csr), 1e-9));
+
+  // The Hessian factor becomes a padded Cholesky factor in the Jacobian
+  SparseEigen Ab;
+  builder.augmentedJacobian(gfg, Ab);
+  EXPECT_LONGS_EQUAL(8 + 5, Ab.rows());
+  const Matrix dense(Ab);
+  EXPECT(assert_equal(expected, Matrix(dense.transpose() * dense), 1e-9));
+}
+
+/* ************************************************************************* */
+TEST(SparseEigen, ReusePattern) {
+  SparseEigenBuilder builder(createJacobianGraph());
+  SparseEigen Ab, H;
+  builder.augmentedJacobian(createJacobianGraph(), Ab);
+  builder.augmentedHessian(createJacobianGraph(), H);
+  const double* jacobianValues = Ab.valuePtr();
+  const double* hessianValues = H.valuePtr();
+
+  // Only values change, so the storage is reused
+  const GaussianFactorGraph scaled = createJacobianGraph(2.0);
+  builder.augmentedJacobian(scaled, Ab);
+  builder.augmentedHessian(scaled, H);
+  EXPECT(jacobianValues == Ab.valuePtr());
+  EXPECT(hessianValues == H.valuePtr());
+  EXPECT(assert_equal(scaled.augmentedJacobian(builder.ordering()), Matrix(Ab)));
+  EXPECT(assert_equal(scaled.augmentedHessian(builder.ordering()), Matrix(H), 1e-9));
+
+  // A different structure is rejected
+  GaussianFactorGraph changed = createJacobianGraph();
+  changed += JacobianFactor(0, I_2x2, Vector2::Zero());
+  CHECK_EXCEPTION(builder.augmentedJacobian(changed, Ab), std::invalid_argument);
+}
+
+/* ************************************************************************* */
+int main() { TestResult tr; return TestRegistry::runAllTests(tr); }
+/* ************************************************************************* */
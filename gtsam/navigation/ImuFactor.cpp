@@ -85,14 +85,43 @@ void PreintegratedImuMeasurements::integrateMeasurement(
 void PreintegratedImuMeasurements::integrateMeasurements(
     const Matrix& measuredAccs, const Matrix& measuredOmegas,
     const Matrix& dts) {
-  assert(
-      measuredAccs.rows() == 3 && measuredOmegas.rows() == 3 && dts.rows() == 1);
-  assert(dts.cols() >= 1);
-  assert(measuredAccs.cols() == dts.cols());
-  assert(measuredOmegas.cols() == dts.cols());
-  size_t n = static_cast<size_t>(dts.cols());
-  for (size_t j = 0; j < n; j++) {
-    integrateMeasurement(measuredAccs.col(j), measuredOmegas.col(j), dts(0, j));
+  const Eigen::Index n = dts.size();
+  if (measuredAccs.rows() != 3 || measuredOmegas.rows() != 3 ||
+      measuredAccs.cols() != n || measuredOmegas.cols() != n)
+    throw std::invalid_argument(
+        "PreintegratedImuMeasurements::integrateMeasurements: need one "
+        "acceleration and angular velocity column per dt");
+  if (n > 0 && dts.minCoeff() <= 0)
+    throw std::runtime_error(
+        "PreintegratedImuMeasurements::integrateMeasurements: dt <=0");
+
+  const Matrix3& aCov = p().accelerometerCovariance;
+  const Matrix3& wCov = p().gyroscopeCovariance;
+  const Matrix3& iCov = p().integrationCovariance;
+
+  // The rows of B for rotation are zero, and so are those of C for position
+  // and velocity unless the sensor is offset from the body origin
+  const bool omegaOnlyRotates = !p().body_P_sensor ||
+                                p().body_P_sensor->translation().isZero();
+
+  Matrix9 A;
+  Matrix93 B, C;
+  for (Eigen::Index j = 0; j < n; j++) {
+    const double dt = dts(j);
+    PreintegrationType::update(measuredAccs.col(j), measuredOmegas.col(j), dt,
+                               &A, &B, &C);
+    PropagateCovariance(A, &preintMeasCov_);
+    const auto B_tv = B.bottomRows<6>();
+    preintMeasCov_.bottomRightCorner<6, 6>().noalias() +=
+        B_tv * (aCov / dt) * B_tv.transpose();
+    if (omegaOnlyRotates) {
+      const auto C_R = C.topRows<3>();
+      preintMeasCov_.topLeftCorner<3, 3>().noalias() +=
+          C_R * (wCov / dt) * C_R.transpose();
+    } else {
+      preintMeasCov_.noalias() += C * (wCov / dt) * C.transpose();
+    }
+    preintMeasCov_.block<3, 3>(3, 3).noalias() += iCov * dt;
   }
 }
 
@@ -128,7 +128,15 @@ public:
   void integrateMeasurement(const Vector3& measuredAcc,
       const Vector3& measuredOmega, const double dt) override;
 
-  /// Add multiple measurements, in matrix columns
+  /**
+   * Add multiple measurements, in matrix columns, with the same result as
+   * calling integrateMeasurement on every column. The parameters are looked up
+   * once, and the covariance is propagated with PropagateCovariance and only
+   * the non-zero blocks of the noise Jacobians.
+   * @param measuredAccs Measured accelerations, 3 x n
+   * @param measuredOmegas Measured angular velocities, 3 x n
+   * @param dts Time intervals, 1 x n, all positive
+   */
   void integrateMeasurements(const Matrix& measuredAccs, const Matrix& measuredOmegas,
                              const Matrix& dts);
 
@@ -101,6 +101,36 @@ pair<Vector3, Vector3> PreintegrationBase::correctMeasurementsBySensorPose(
   return make_pair(correctedAcc, correctedOmega);
 }
 
+//------------------------------------------------------------------------------
+void PreintegrationBase::PropagateCovariance(const Matrix9& A, Matrix9* P) {
+  const auto M = A.block<3, 3>(0, 0), N = A.block<3, 3>(3, 0),
+             K = A.block<3, 3>(6, 0), Q = A.block<3, 3>(3, 3),
+             W = A.block<3, 3>(3, 6);
+
+  // AP = A*P, one block row at a time
+  Matrix9 AP;
+  const auto P_R = P->topRows<3>(), P_t = P->middleRows<3>(3),
+             P_v = P->bottomRows<3>();
+  AP.topRows<3>().noalias() = M * P_R;
+  AP.middleRows<3>(3).noalias() = N * P_R;
+  AP.middleRows<3>(3).noalias() += Q * P_t;
+  AP.middleRows<3>(3).noalias() += W * P_v;
+  AP.bottomRows<3>().noalias() = K * P_R;
+  AP.bottomRows<3>().noalias() += Q * P_v;
+
+  // P = AP*A', lower blocks only as the result is symmetric
+  const auto AP_R = AP.leftCols<3>(), AP_t = AP.middleCols<3>(3),
+             AP_v = AP.rightCols<3>();
+  P->leftCols<3>().noalias() = AP_R * M.transpose();
+  P->block<6, 3>(3, 3).noalias() = AP_R.bottomRows<6>() * N.transpose();
+  P->block<6, 3>(3, 3).noalias() += AP_t.bottomRows<6>() * Q.transpose();
+  P->block<6, 3>(3, 3).noalias() += AP_v.bottomRows<6>() * W.transpose();
+  P->block<3, 3>(6, 6).noalias() = AP_R.bottomRows<3>() * K.transpose();
+  P->block<3, 3>(6, 6).noalias() += AP_v.bottomRows<3>() * Q.transpose();
+  P->topRightCorner<3, 6>() = P->bottomLeftCorner<6, 3>().transpose();
+  P->block<3, 3>(3, 6) = P->block<3, 3>(6, 3).transpose();
+}
+
 //------------------------------------------------------------------------------
 void PreintegrationBase::integrateMeasurement(const Vector3& measuredAcc,
     const Vector3& measuredOmega, double dt) {
@@ -111,6 +141,13 @@ void PreintegrationBase::integrateMeasurement(const Vector3& measuredAcc,
   update(measuredAcc, measuredOmega, dt, &A, &B, &C);
 }
 
+//------------------------------------------------------------------------------
+bool PreintegrationBase::needsRepreintegration(
+    const imuBias::ConstantBias& bias_i) const {
+  return p().biasValidityRadius > 0 &&
+         (bias_i - biasHat_).vector().norm() > p().biasValidityRadius;
+}
+
 //------------------------------------------------------------------------------
 NavState PreintegrationBase::predict(const NavState& state_i,
     const imuBias::ConstantBias& bias_i, OptionalJacobian<9, 9> H1,
@@ -141,6 +141,14 @@ class GTSAM_EXPORT PreintegrationBase {
   virtual void update(const Vector3& measuredAcc, const Vector3& measuredOmega,
       const double dt, Matrix9* A, Matrix93* B, Matrix93* C) = 0;
 
+  /**
+   * Covariance propagation P <- A*P*A' through the Jacobian A of update.
+   * In both versions A = [M 0 0; N Q W; K 0 Q] in 3x3 blocks, as the position
+   * does not affect rotation and velocity, which is exploited here: the
+   * product costs about half of the dense one. P must be symmetric.
+   */
+  static void PropagateCovariance(const Matrix9& A, Matrix9* P);
+
   /// Version without derivatives
   virtual void integrateMeasurement(const Vector3& measuredAcc,
       const Vector3& measuredOmega, const double dt);
@@ -150,6 +158,14 @@ class GTSAM_EXPORT PreintegrationBase {
   virtual Vector9 biasCorrectedDelta(const imuBias::ConstantBias& bias_i,
       OptionalJacobian<9, 6> H = boost::none) const = 0;
 
+  /**
+   * Whether bias_i is so far from biasHat that the first-order bias correction
+   * is no longer valid, according to Params::biasValidityRadius. The caller
+   * should then integrate the measurements again after
+   * resetIntegrationAndSetBias(bias_i).
+   */
+  bool needsRepreintegration(const imuBias::ConstantBias& bias_i) const;
+
   /// Predict state at time j
   NavState predict(const NavState& state_i, const imuBias::ConstantBias& bias_i,
                    OptionalJacobian<9, 9> H1 = boost::none,
@@ -21,6 +21,8 @@
 
 #include "PreintegrationParams.h"
 
+#include <cmath>
+
 using namespace std;
 
 namespace gtsam {
@@ -36,6 +38,8 @@ void PreintegrationParams::print(const string& s) const {
     cout << "Using 2nd-order Coriolis" << endl;
   if (body_P_sensor) body_P_sensor->print("    ");
   cout << "n_gravity = (" << n_gravity.transpose() << ")" << endl;
+  if (biasValidityRadius > 0)
+    cout << "biasValidityRadius = " << biasValidityRadius << endl;
 }
 
 //------------------------------------------------------------------------------
@@ -48,7 +52,8 @@ bool PreintegrationParams::equals(const PreintegratedRotationParams& other,
                             tol) &&
          equal_with_abs_tol(integrationCovariance, e->integrationCovariance,
                             tol) &&
-         equal_with_abs_tol(n_gravity, e->n_gravity, tol);
+         equal_with_abs_tol(n_gravity, e->n_gravity, tol) &&
+         std::abs(biasValidityRadius - e->biasValidityRadius) < tol;
 }
 
 }  // namespace gtsam
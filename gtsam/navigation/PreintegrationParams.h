@@ -18,6 +18,7 @@
 
 #include <gtsam/navigation/PreintegratedRotation.h>
 #include <boost/make_shared.hpp>
+#include <boost/serialization/version.hpp>
 
 namespace gtsam {
 
@@ -28,6 +29,7 @@ struct GTSAM_EXPORT PreintegrationParams: PreintegratedRotationParams {
   Matrix3 integrationCovariance; ///< continuous-time "Covariance" describing integration uncertainty
   bool use2ndOrderCoriolis; ///< Whether to use second order Coriolis integration
   Vector3 n_gravity; ///< Gravity vector in nav frame
+  double biasValidityRadius; ///< Distance from biasHat beyond which to re-preintegrate, 0 disables
 
   /// Default constructor for serialization only
   PreintegrationParams()
@@ -35,7 +37,8 @@ struct GTSAM_EXPORT PreintegrationParams: PreintegratedRotationParams {
         accelerometerCovariance(I_3x3),
         integrationCovariance(I_3x3),
         use2ndOrderCoriolis(false),
-        n_gravity(0, 0, -1) {}
+        n_gravity(0, 0, -1),
+        biasValidityRadius(0) {}
 
   /// The Params constructor insists on getting the navigation frame gravity vector
   /// For convenience, two commonly used conventions are provided by named constructors below
@@ -44,7 +47,8 @@ struct GTSAM_EXPORT PreintegrationParams: PreintegratedRotationParams {
         accelerometerCovariance(I_3x3),
         integrationCovariance(I_3x3),
         use2ndOrderCoriolis(false),
-        n_gravity(n_gravity) {}
+        n_gravity(n_gravity),
+        biasValidityRadius(0) {}
 
   // Default Params for a Z-down navigation frame, such as NED: gravity points along positive Z-axis
   static boost::shared_ptr<PreintegrationParams> MakeSharedD(double g = 9.81) {
@@ -62,24 +66,30 @@ struct GTSAM_EXPORT PreintegrationParams: PreintegratedRotationParams {
   void setAccelerometerCovariance(const Matrix3& cov) { accelerometerCovariance = cov; }
   void setIntegrationCovariance(const Matrix3& cov)   { integrationCovariance = cov; }
   void setUse2ndOrderCoriolis(bool flag)              { use2ndOrderCoriolis = flag; }
+  void setBiasValidityRadius(double radius)           { biasValidityRadius = radius; }
 
   const Matrix3& getAccelerometerCovariance() const { return accelerometerCovariance; }
   const Matrix3& getIntegrationCovariance()   const { return integrationCovariance; }
   const Vector3& getGravity()   const { return n_gravity; }
   bool           getUse2ndOrderCoriolis()     const { return use2ndOrderCoriolis; }
+  double         getBiasValidityRadius()      const { return biasValidityRadius; }
 
 protected:
 
   /** Serialization function */
   friend class boost::serialization::access;
   template<class ARCHIVE>
-  void serialize(ARCHIVE & ar, const unsigned int /*version*/) {
+  void serialize(ARCHIVE & ar, const unsigned int version) {
     namespace bs = ::boost::serialization;
     ar & BOOST_SERIALIZATION_BASE_OBJECT_NVP(PreintegratedRotationParams);
     ar & BOOST_SERIALIZATION_NVP(accelerometerCovariance);
     ar & BOOST_SERIALIZATION_NVP(integrationCovariance);
     ar & BOOST_SERIALIZATION_NVP(use2ndOrderCoriolis);
     ar & BOOST_SERIALIZATION_NVP(n_gravity);
+    if (version >= 1)
+      ar & BOOST_SERIALIZATION_NVP(biasValidityRadius);
+    else
+      biasValidityRadius = 0;
   }
 
 #ifdef GTSAM_USE_QUATERNIONS
@@ -90,3 +100,5 @@ public:
 };
 
 } // namespace gtsam
+
+BOOST_CLASS_VERSION(gtsam::PreintegrationParams, 1)
@@ -0,0 +1,165 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file   SyntheticVio.cpp
+ * @brief  Seeded generator of long visual-inertial odometry problems
+ * @date   October 2026
+ */
+
+#include <gtsam/navigation/SyntheticVio.h>
+#include <gtsam/navigation/ImuFactor.h>
+#include <gtsam/slam/ProjectionFactor.h>
+#include <gtsam/geometry/PinholeCamera.h>
+#include <gtsam/inference/Symbol.h>
+
+#include <cmath>
+#include <map>
+#include <vector>
+
+using namespace std;
+
+namespace gtsam {
+
+using symbol_shorthand::B;
+using symbol_shorthand::L;
+using symbol_shorthand::V;
+using symbol_shorthand::X;
+
+/* ************************************************************************* */
+void generateSyntheticVio(const Scenario& scenario,
+                          const SyntheticVioParams& params,
+                          const SyntheticChunkCallback& chunk) {
+  typedef GenericProjectionFactor<Pose3, Point3, Cal3_S2> ProjectionFactor;
+  typedef PinholeCamera<Cal3_S2> Camera;
+
+  internal::SyntheticRandom random(params.seed);
+  const auto K = boost::make_shared<Cal3_S2>(params.calibration);
+  const auto camera = [&](size_t k) {
+    return Camera(scenario.pose(k * params.keyframeInterval) * params.body_P_camera,
+                  params.calibration);
+  };
+
+  // IMU model, noise and bias random walk
+  const auto imuParams = PreintegrationParams::MakeSharedU(params.gravity);
+  imuParams->setGyroscopeCovariance(I_3x3 * std::pow(params.gyroSigma, 2));
+  imuParams->setAccelerometerCovariance(I_3x3 * std::pow(params.accSigma, 2));
+  imuParams->setIntegrationCovariance(I_3x3 * 1e-8);
+  const size_t imuSteps =
+      std::max<size_t>(1, std::round(params.keyframeInterval * params.imuRate));
+  const double dt = params.keyframeInterval / imuSteps;
+  const double sqrtInterval = std::sqrt(params.keyframeInterval);
+  const SharedNoiseModel biasNoise = noiseModel::Diagonal::Sigmas(
+      (Vector6() << Vector3::Constant(params.accBiasSigma * sqrtInterval),
+       Vector3::Constant(params.gyroBiasSigma * sqrtInterval)).finished());
+
+  const SharedNoiseModel pixelNoise =
+      noiseModel::Isotropic::Sigma(2, params.pixelSigma);
+  const auto inImage = [&](const pair<Point2, bool>& projected) {
+    const Point2& p = projected.first;
+    return projected.second && p.x() >= 0 && p.y() >= 0 &&
+           p.x() < params.imageWidth && p.y() < params.imageHeight;
+  };
+
+  const Vector6 poseSigmas = Vector6::Constant(params.initialSigma);
+  const Vector3 sigmas3 = Vector3::Constant(params.initialSigma);
+
+  // Landmarks waiting for the keyframe that last sees them
+  struct Track {
+    Point3 point;
+    vector<pair<size_t, Point2>> measurements;
+  };
+  map<size_t, vector<Track>> pending;
+  size_t nrLandmarks = 0;
+
+  for (size_t k = 0; k < params.nrKeyframes; k++) {
+    const double t = k * params.keyframeInterval;
+    const Pose3 pose = scenario.pose(t);
+    const Vector3 velocity = scenario.velocity_n(t);
+    NonlinearFactorGraph factors;
+    Values values;
+
+    if (k == 0) {
+      factors.addPrior(X(0), pose, noiseModel::Isotropic::Sigma(6, 1e-3));
+      factors.addPrior(V(0), velocity, noiseModel::Isotropic::Sigma(3, 1e-3));
+      factors.addPrior(B(0), imuBias::ConstantBias(),
+                       noiseModel::Isotropic::Sigma(6, 0.1));
+    } else {
+      // Preintegrate noisy measurements since the previous keyframe
+      PreintegratedImuMeasurements pim(imuParams);
+      const double t0 = t - params.keyframeInterval;
+      for (size_t m = 0; m < imuSteps; m++) {
+        const double tm = t0 + m * dt;
+        const Rot3 nRb = scenario.rotation(tm);
+        const Vector3 omega = scenario.omega_b(tm) + params.bias.gyroscope() +
+                              params.gyroSigma / std::sqrt(dt) *
+                                  random.normal(Vector3(Vector3::Ones()));
+        const Vector3 acc = scenario.acceleration_b(tm) -
+                            nRb.transpose() * imuParams->n_gravity +
+                            params.bias.accelerometer() +
+                            params.accSigma / std::sqrt(dt) *
+                                random.normal(Vector3(Vector3::Ones()));
+        pim.integrateMeasurement(acc, omega, dt);
+      }
+      factors.emplace_shared<ImuFactor>(X(k - 1), V(k - 1), X(k), V(k),
+                                        B(k - 1), pim);
+      factors.emplace_shared<BetweenFactor<imuBias::ConstantBias>>(
+          B(k - 1), B(k), imuBias::ConstantBias(), biasNoise);
+    }
+
+    // New landmarks in view, tracked through the following keyframes
+    const Camera current = camera(k);
+    for (size_t n = 0; n < params.landmarksPerKeyframe; n++) {
+      const Point2 pixel(random.uniform(0, params.imageWidth),
+                         random.uniform(0, params.imageHeight));
+      Track track;
+      track.point = current.backproject(
+          pixel, random.uniform(params.minDepth, params.maxDepth));
+      for (size_t k2 = k; k2 < params.nrKeyframes &&
+                          k2 < k + params.maxTrackLength; k2++) {
+        const auto projected = camera(k2).projectSafe(track.point);
+        if (!inImage(projected)) break;
+        track.measurements.emplace_back(
+            k2, projected.first + params.pixelSigma *
+                                      random.normal(Vector2(Vector2::Ones())));
+      }
+      if (track.measurements.size() >= 2)
+        pending[track.measurements.back().first].push_back(std::move(track));
+    }
+
+    values.insert(X(k), pose.retract(random.normal(poseSigmas)));
+    values.insert(V(k), Vector3(velocity + random.normal(sigmas3)));
+    values.insert(B(k), imuBias::ConstantBias());
+    const auto done = pending.find(k);
+    if (done != pending.end()) {
+      for (const Track& track : done->second) {
+        const Key j = L(nrLandmarks++);
+        values.insert(j, Point3(track.point + random.normal(sigmas3)));
+        for (const auto& measurement : track.measurements)
+          factors.emplace_shared<ProjectionFactor>(
+              measurement.second, pixelNoise, X(measurement.first), j, K,
+              params.body_P_camera);
+      }
+      pending.erase(done);
+    }
+    chunk(factors, values);
+  }
+}
+
+/* ************************************************************************* */
+GraphAndValues generateSyntheticVio(const Scenario& scenario,
+                                    const SyntheticVioParams& params) {
+  SyntheticCollector collector;
+  generateSyntheticVio(scenario, params, std::ref(collector));
+  return collector.result();
+}
+
+}  // namespace gtsam
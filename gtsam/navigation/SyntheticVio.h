@@ -0,0 +1,80 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file   SyntheticVio.h
+ * @brief  Seeded generator of long visual-inertial odometry problems
+ * @date   October 2026
+ */
+
+#pragma once
+
+#include <gtsam/navigation/ImuBias.h>
+#include <gtsam/navigation/Scenario.h>
+#include <gtsam/slam/SyntheticProblems.h>
+#include <gtsam/geometry/Cal3_S2.h>
+
+namespace gtsam {
+
+/**
+ * Parameters of a visual-inertial problem along a Scenario, e.g. the circle
+ * ConstantTwistScenario(Vector3(0, 0, 0.1), Vector3(2, 0, 0)), which can be
+ * flown for as many keyframes as needed.
+ */
+struct GTSAM_EXPORT SyntheticVioParams {
+  size_t nrKeyframes = 1000;
+  double keyframeInterval = 0.1;  ///< seconds between keyframes
+  double imuRate = 200;           ///< IMU measurements per second
+  double gravity = 9.81;          ///< along the negative Z axis of the scenario
+  double gyroSigma = 1e-3;        ///< continuous-time noise, rad/s/sqrt(Hz)
+  double accSigma = 1e-2;         ///< continuous-time noise, m/s^2/sqrt(Hz)
+  double gyroBiasSigma = 1e-5;    ///< bias random walk, rad/s/sqrt(s)
+  double accBiasSigma = 1e-4;     ///< bias random walk, m/s^2/sqrt(s)
+  imuBias::ConstantBias bias;     ///< true bias of the measurements
+
+  /// New landmarks seen from each keyframe, then tracked for at most
+  /// maxTrackLength keyframes while they stay in the image
+  size_t landmarksPerKeyframe = 20;
+  size_t maxTrackLength = 10;
+  double minDepth = 5, maxDepth = 30;
+  Cal3_S2 calibration = Cal3_S2(500, 500, 0, 320, 240);
+  size_t imageWidth = 640, imageHeight = 480;
+  /// Camera in the body frame, by default looking forward along body X
+  Pose3 body_P_camera = Pose3(Rot3(Point3(0, -1, 0), Point3(0, 0, -1),
+                                   Point3(1, 0, 0)),
+                              Point3(0, 0, 0));
+  double pixelSigma = 1.0;
+
+  double initialSigma = 0.01;  ///< of poses, velocities and landmarks
+  uint64_t seed = 42;
+
+  GTSAM_MAKE_ALIGNED_OPERATOR_NEW
+};
+
+/**
+ * Generate a visual-inertial problem, calling chunk once per keyframe. Keys
+ * are X(k), V(k) and B(k) for the pose, velocity and IMU bias of keyframe k,
+ * and L(j) for landmarks. Consecutive keyframes are connected by an ImuFactor
+ * and a bias random walk BetweenFactor, landmarks by one
+ * GenericProjectionFactor<Pose3, Point3, Cal3_S2> per measurement, and the
+ * first keyframe has priors. A landmark is emitted with the keyframe that
+ * last sees it. Initial poses, velocities and landmarks are the ground truth
+ * perturbed by initialSigma, and initial biases are zero.
+ */
+GTSAM_EXPORT void generateSyntheticVio(const Scenario& scenario,
+                                       const SyntheticVioParams& params,
+                                       const SyntheticChunkCallback& chunk);
+
+/// Generate a visual-inertial problem
+GTSAM_EXPORT GraphAndValues generateSyntheticVio(
+    const Scenario& scenario, const SyntheticVioParams& params);
+
+}  // namespace gtsam
@@ -239,6 +239,52 @@ TEST(ImuFactor, MultipleMeasurements) {
   EXPECT(assert_equal(expected,actual));
 }
 
+/* ************************************************************************* */
+TEST(ImuFactor, MultipleMeasurementsBatch) {
+  // Varying measurements and time steps, with and without a sensor offset
+  const size_t n = 50;
+  Matrix acc(3, n), gyro(3, n), dts(1, n);
+  for (size_t j = 0; j < n; j++) {
+    acc.col(j) << 0.1 * sin(0.1 * j), 0.2, -9.6 + 0.05 * cos(0.3 * j);
+    gyro.col(j) << 0.3 * cos(0.2 * j), -0.1, 0.2 * sin(0.1 * j);
+    dts(0, j) = 0.005 + 0.0001 * (j % 7);
+  }
+  const Bias bias(Vector3(0.01, -0.02, 0.03), Vector3(-0.001, 0.002, 0.003));
+
+  for (const Point3& offset : {Point3(0, 0, 0), Point3(0.1, -0.2, 0.3)}) {
+    auto p = testing::Params();
+    p->body_P_sensor = Pose3(Rot3::Ypr(0.1, 0.2, 0.3), offset);
+    PreintegratedImuMeasurements expected(p, bias);
+    for (size_t j = 0; j < n; j++)
+      expected.integrateMeasurement(acc.col(j), gyro.col(j), dts(0, j));
+
+    PreintegratedImuMeasurements actual(p, bias);
+    actual.integrateMeasurements(acc, gyro, dts);
+    EXPECT(assert_equal(expected, actual, 1e-9));
+    EXPECT(assert_equal(expected.preintMeasCov(), actual.preintMeasCov(), 1e-12));
+  }
+
+  PreintegratedImuMeasurements pim(testing::Params(), bias);
+  dts(0, 3) = 0;
+  CHECK_EXCEPTION(pim.integrateMeasurements(acc, gyro, dts), std::runtime_error);
+}
+
+/* ************************************************************************* */
+TEST(ImuFactor, NeedsRepreintegration) {
+  using namespace common;
+  auto p = boost::make_shared<PreintegrationParams>(*testing::Params());
+  PreintegratedImuMeasurements pim(p, kZeroBiasHat);
+  pim.integrateMeasurement(measuredAcc, measuredOmega, 0.1);
+  const Bias far(Vector3(0.2, 0, 0), Vector3::Zero());
+  EXPECT(!pim.needsRepreintegration(far));
+
+  p->biasValidityRadius = 0.1;
+  EXPECT(!pim.needsRepreintegration(Bias(Vector3(0.05, 0, 0), Vector3::Zero())));
+  EXPECT(pim.needsRepreintegration(far));
+  pim.resetIntegrationAndSetBias(far);
+  EXPECT(!pim.needsRepreintegration(far));
+}
+
 /* ************************************************************************* */
 TEST(ImuFactor, ErrorAndJacobians) {
   using namespace common;
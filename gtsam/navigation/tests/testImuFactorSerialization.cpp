@@ -50,6 +50,7 @@ P getPreintegratedMeasurements() {
   p->accelerometerCovariance = 1e-7 * I_3x3;
   p->gyroscopeCovariance = 1e-8 * I_3x3;
   p->integrationCovariance = 1e-9 * I_3x3;
+  p->biasValidityRadius = 0.1;
 
   const double deltaT = 0.005;
 
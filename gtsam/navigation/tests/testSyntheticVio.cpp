@@ -0,0 +1,63 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file   testSyntheticVio.cpp
+ * @brief  Unit test for the synthetic visual-inertial problem generator
+ * @date   October 2026
+ */
+
+#include <gtsam/navigation/SyntheticVio.h>
+#include <gtsam/nonlinear/LevenbergMarquardtOptimizer.h>
+#include <gtsam/inference/Symbol.h>
+
+#include <CppUnitLite/TestHarness.h>
+
+using namespace std;
+using namespace gtsam;
+
+using symbol_shorthand::X;
+
+/* ************************************************************************* */
+TEST(SyntheticVio, circle) {
+  const ConstantTwistScenario scenario(Vector3(0, 0, 0.1), Vector3(2, 0, 0));
+  SyntheticVioParams params;
+  params.nrKeyframes = 20;
+  params.landmarksPerKeyframe = 10;
+
+  size_t nrChunks = 0;
+  generateSyntheticVio(scenario, params,
+                       [&](const NonlinearFactorGraph&, const Values& values) {
+                         EXPECT(values.exists(X(nrChunks)));
+                         nrChunks++;
+                       });
+  EXPECT_LONGS_EQUAL(20, nrChunks);
+
+  const GraphAndValues problem = generateSyntheticVio(scenario, params);
+  const NonlinearFactorGraph& graph = *problem.first;
+  const Values& initial = *problem.second;
+  // Three priors, two IMU related factors per interval, and projections
+  EXPECT(graph.size() > 3 + 2 * 19);
+  EXPECT(initial.size() > 3 * 20);
+
+  const Values result =
+      LevenbergMarquardtOptimizer(graph, initial).optimize();
+  EXPECT(graph.error(result) < graph.error(initial));
+  const Pose3 last = scenario.pose(19 * params.keyframeInterval);
+  EXPECT(assert_equal(last, result.at<Pose3>(X(19)), 0.05));
+}
+
+/* ************************************************************************* */
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
+/* ************************************************************************* */
@@ -23,6 +23,7 @@
 #include <gtsam/linear/GaussianBayesNet.h>
 #include <gtsam/linear/GaussianFactorGraph.h>
 #include <gtsam/linear/VectorValues.h>
+#include <gtsam/base/Metrics.h>
 
 #include <boost/algorithm/string.hpp>
 
@@ -82,9 +83,13 @@ double DoglegOptimizer::getDelta() const {
 
 /* ************************************************************************* */
 GaussianFactorGraph::shared_ptr DoglegOptimizer::iterate(void) {
+  static const char* const source = "DoglegOptimizer";
+  const size_t iteration = state_->iterations;
 
   // Linearize graph
+  MetricsTimer linearizeTimer(source, iteration, "linearize_seconds");
   GaussianFactorGraph::shared_ptr linear = graph_.linearize(state_->values);
+  linearizeTimer.stop();
 
   // Pull out parameters we'll use
   const bool dlVerbose = (params_.verbosityDL > DoglegParams::SILENT);
@@ -93,14 +98,20 @@ GaussianFactorGraph::shared_ptr DoglegOptimizer::iterate(void) {
   DoglegOptimizerImpl::IterationResult result;
 
   if ( params_.isMultifrontal() ) {
+    MetricsTimer eliminateTimer(source, iteration, "eliminate_seconds");
     GaussianBayesTree bt = *linear->eliminateMultifrontal(*params_.ordering, params_.getEliminationFunction());
+    eliminateTimer.stop();
+    MetricsTimer stepTimer(source, iteration, "step_seconds");
     VectorValues dx_u = bt.optimizeGradientSearch();
     VectorValues dx_n = bt.optimize();
     result = DoglegOptimizerImpl::Iterate(getDelta(), DoglegOptimizerImpl::ONE_STEP_PER_ITERATION,
       dx_u, dx_n, bt, graph_, state_->values, state_->error, dlVerbose);
   }
   else if ( params_.isSequential() ) {
+    MetricsTimer eliminateTimer(source, iteration, "eliminate_seconds");
     GaussianBayesNet bn = *linear->eliminateSequential(*params_.ordering, params_.getEliminationFunction());
+    eliminateTimer.stop();
+    MetricsTimer stepTimer(source, iteration, "step_seconds");
     VectorValues dx_u = bn.optimizeGradientSearch();
     VectorValues dx_n = bn.optimize();
     result = DoglegOptimizerImpl::Iterate(getDelta(), DoglegOptimizerImpl::ONE_STEP_PER_ITERATION,
@@ -113,6 +124,11 @@ GaussianFactorGraph::shared_ptr DoglegOptimizer::iterate(void) {
     throw std::runtime_error("Optimization parameter is invalid: DoglegParams::elimination");
   }
 
+  if (MetricsSink* sink = metricsSink()) {
+    sink->record(source, iteration, "error", result.f_error);
+    sink->record(source, iteration, "trust_region", result.delta);
+  }
+
   // Maybe show output
   if(params_.verbosity >= NonlinearOptimizerParams::DELTA) result.dx_d.print("delta");
 
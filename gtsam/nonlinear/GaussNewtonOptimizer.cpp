@@ -20,6 +20,7 @@
 #include <gtsam/nonlinear/internal/NonlinearOptimizerState.h>
 #include <gtsam/linear/GaussianFactorGraph.h>
 #include <gtsam/linear/VectorValues.h>
+#include <gtsam/base/Metrics.h>
 
 namespace gtsam {
 
@@ -43,15 +44,21 @@ GaussNewtonOptimizer::GaussNewtonOptimizer(const NonlinearFactorGraph& graph,
 /* ************************************************************************* */
 GaussianFactorGraph::shared_ptr GaussNewtonOptimizer::iterate() {
   gttic(GaussNewtonOptimizer_Iterate);
+  static const char* const source = "GaussNewtonOptimizer";
+  const size_t iteration = state_->iterations;
 
   // Linearize graph
   gttic(GaussNewtonOptimizer_Linearize);
+  MetricsTimer linearizeTimer(source, iteration, "linearize_seconds");
   GaussianFactorGraph::shared_ptr linear = graph_.linearize(state_->values);
+  linearizeTimer.stop();
   gttoc(GaussNewtonOptimizer_Linearize);
 
   // Solve Factor Graph
   gttic(GaussNewtonOptimizer_Solve);
+  MetricsTimer solveTimer(source, iteration, "solve_seconds");
   const VectorValues delta = solve(*linear, params_);
+  solveTimer.stop();
   gttoc(GaussNewtonOptimizer_Solve);
 
   // Maybe show output
@@ -59,8 +66,14 @@ GaussianFactorGraph::shared_ptr GaussNewtonOptimizer::iterate() {
     delta.print("delta");
 
   // Create new state with new values and new error
+  MetricsTimer retractTimer(source, iteration, "retract_seconds");
   Values newValues = state_->values.retract(delta);
-  state_.reset(new State(std::move(newValues), graph_.error(newValues), state_->iterations + 1));
+  retractTimer.stop();
+  MetricsTimer errorTimer(source, iteration, "error_seconds");
+  const double newError = graph_.error(newValues);
+  errorTimer.stop();
+  recordMetric(source, iteration, "error", newError);
+  state_.reset(new State(std::move(newValues), newError, iteration + 1));
 
   return linear;
 }
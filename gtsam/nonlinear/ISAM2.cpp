@@ -20,6 +20,7 @@
 #include <gtsam/nonlinear/ISAM2.h>
 #include <gtsam/nonlinear/ISAM2Result.h>
 
+#include <gtsam/base/Metrics.h>
 #include <gtsam/base/debug.h>
 #include <gtsam/base/timing.h>
 #include <gtsam/inference/BayesTree-inst.h>
@@ -416,6 +417,8 @@ ISAM2Result ISAM2::update(const NonlinearFactorGraph& newFactors,
                           const ISAM2UpdateParams& updateParams) {
   gttic(ISAM2_update);
   this->update_count_ += 1;
+  static const char* const source = "ISAM2";
+  MetricsTimer updateTimer(source, update_count_, "update_seconds");
   UpdateImpl::LogStartingUpdate(newFactors, *this);
   ISAM2Result result(params_.enableDetailedResults);
   UpdateImpl update(params_, updateParams);
@@ -437,6 +440,8 @@ ISAM2Result ISAM2::update(const NonlinearFactorGraph& newFactors,
   if (params_.evaluateNonlinearError)
     update.error(nonlinearFactors_, calculateEstimate(), &result.errorBefore);
 
+  const LinearizationCacheStats cacheBefore = LinearizationCacheStats::Global();
+
   // 3. Mark linear update
   update.gatherInvolvedKeys(newFactors, nonlinearFactors_,
                             result.keysWithRemovedFactors, &result.markedKeys);
@@ -445,6 +450,7 @@ ISAM2Result ISAM2::update(const NonlinearFactorGraph& newFactors,
   KeySet relinKeys;
   result.variablesRelinearized = 0;
   if (update.relinarizationNeeded(update_count_)) {
+    MetricsTimer relinearizeTimer(source, update_count_, "relinearize_seconds");
     // 4. Mark keys in \Delta above threshold \beta:
     relinKeys = update.gatherRelinearizeKeys(roots_, delta_, fixedVariables_,
                                              &result.markedKeys);
@@ -460,18 +466,37 @@ ISAM2Result ISAM2::update(const NonlinearFactorGraph& newFactors,
   }
 
   // 7. Linearize new factors
+  MetricsTimer linearizeTimer(source, update_count_, "linearize_seconds");
   update.linearizeNewFactors(newFactors, theta_, nonlinearFactors_.size(),
                              result.newFactorsIndices, &linearFactors_);
   update.augmentVariableIndex(newFactors, result.newFactorsIndices,
                               &variableIndex_);
 
+  linearizeTimer.stop();
+
   // 8. Redo top of Bayes tree and update data structures
+  MetricsTimer recalculateTimer(source, update_count_, "recalculate_seconds");
   recalculate(updateParams, relinKeys, &result);
+  recalculateTimer.stop();
+  result.linearizationCache = LinearizationCacheStats::Global() - cacheBefore;
   if (!result.unusedKeys.empty()) removeVariables(result.unusedKeys);
   result.cliques = this->nodes().size();
 
   if (params_.evaluateNonlinearError)
     update.error(nonlinearFactors_, calculateEstimate(), &result.errorAfter);
+
+  updateTimer.stop();
+  if (MetricsSink* sink = metricsSink()) {
+    sink->record(source, update_count_, "variables_relinearized",
+                 result.variablesRelinearized);
+    sink->record(source, update_count_, "variables_reeliminated",
+                 result.variablesReeliminated);
+    sink->record(source, update_count_, "factors_recalculated",
+                 result.factorsRecalculated);
+    sink->record(source, update_count_, "cliques", result.cliques);
+    if (result.errorAfter)
+      sink->record(source, update_count_, "error", *result.errorAfter);
+  }
   return result;
 }
 
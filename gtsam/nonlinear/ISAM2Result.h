@@ -25,6 +25,7 @@
 #include <gtsam/linear/GaussianBayesTree.h>
 #include <gtsam/nonlinear/DoglegOptimizerImpl.h>
 #include <gtsam/nonlinear/ISAM2Params.h>
+#include <gtsam/nonlinear/LinearizationCacheStats.h>
 #include <gtsam/nonlinear/NonlinearFactorGraph.h>
 
 #include <boost/variant.hpp>
@@ -110,6 +111,11 @@ struct ISAM2Result {
   /** All keys that were marked during the update process. */
   KeySet markedKeys;
 
+  /** How often factors that cache work across linearizations, e.g., smart
+   * factors, could skip retriangulation or reuse their previous linear factor
+   * while relinearizing during this update. See LinearizationCacheStats. */
+  LinearizationCacheStats linearizationCache;
+
   /**
    * A struct holding detailed results, which must be enabled with
    * ISAM2Params::enableDetailedResults.
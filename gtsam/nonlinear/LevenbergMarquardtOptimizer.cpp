@@ -25,6 +25,7 @@
 #include <gtsam/linear/GaussianFactorGraph.h>
 #include <gtsam/linear/linearExceptions.h>
 #include <gtsam/inference/Ordering.h>
+#include <gtsam/base/Metrics.h>
 #include <gtsam/base/Vector.h>
 #include <gtsam/base/timing.h>
 
@@ -143,9 +144,11 @@ bool LevenbergMarquardtOptimizer::tryLambda(const GaussianFactorGraph& linear,
   Values newValues;
   VectorValues delta;
 
+  static const char* const source = "LevenbergMarquardtOptimizer";
   bool systemSolvedSuccessfully;
   try {
     // ============ Solve is where most computation happens !! =================
+    MetricsTimer timer(source, currentState->iterations, "solve_seconds");
     delta = solve(dampedSystem, params_);
     systemSolvedSuccessfully = true;
   } catch (const IndeterminantLinearSystemException&) {
@@ -172,16 +175,20 @@ bool LevenbergMarquardtOptimizer::tryLambda(const GaussianFactorGraph& linear,
     if (linearizedCostChange >= 0) {  // step is valid
       // update values
       gttic(retract);
+      MetricsTimer retractTimer(source, currentState->iterations, "retract_seconds");
       // ============ This is where the solution is updated ====================
       newValues = currentState->values.retract(delta);
       // =======================================================================
+      retractTimer.stop();
       gttoc(retract);
 
       // compute new error
       gttic(compute_error);
+      MetricsTimer errorTimer(source, currentState->iterations, "error_seconds");
       if (verbose)
         cout << "calculating error:" << endl;
       newError = graph_.error(newValues);
+      errorTimer.stop();
       gttoc(compute_error);
 
       if (verbose)
@@ -229,6 +236,12 @@ bool LevenbergMarquardtOptimizer::tryLambda(const GaussianFactorGraph& linear,
                 iterationTime << endl;
   }
 
+  if (MetricsSink* sink = metricsSink()) {
+    sink->record(source, currentState->iterations, "lambda", currentState->lambda);
+    sink->record(source, currentState->iterations, "error", newError);
+    sink->record(source, currentState->iterations, "step_success", step_is_successful);
+  }
+
   if (step_is_successful) {
     // we have successfully decreased the cost and we have good modelFidelity
     // NOTE(frank): As we return immediately after this, we move the newValues
@@ -267,7 +280,10 @@ GaussianFactorGraph::shared_ptr LevenbergMarquardtOptimizer::iterate() {
   // Linearize graph
   if (params_.verbosityLM >= LevenbergMarquardtParams::DAMPED)
     cout << "linearizing = " << endl;
+  MetricsTimer linearizeTimer("LevenbergMarquardtOptimizer", currentState->iterations,
+                              "linearize_seconds");
   GaussianFactorGraph::shared_ptr linear = linearize();
+  linearizeTimer.stop();
 
   if(currentState->totalNumberInnerIterations==0) { // write initial error
     writeLogFile(currentState->error);
@@ -0,0 +1,74 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    LinearizationCacheStats.cpp
+ * @brief   Counters for factors that reuse work across linearizations
+ * @date    October 2026
+ */
+
+#include <gtsam/nonlinear/LinearizationCacheStats.h>
+
+#include <atomic>
+#include <iostream>
+
+using namespace std;
+
+namespace gtsam {
+
+namespace {
+atomic<size_t> gTriangulations(0), gTriangulationsReused(0),
+    gLinearizations(0), gLinearizationsReused(0);
+}  // namespace
+
+/* ************************************************************************* */
+LinearizationCacheStats LinearizationCacheStats::operator-(
+    const LinearizationCacheStats& other) const {
+  LinearizationCacheStats result;
+  result.triangulations = triangulations - other.triangulations;
+  result.triangulationsReused = triangulationsReused - other.triangulationsReused;
+  result.linearizations = linearizations - other.linearizations;
+  result.linearizationsReused = linearizationsReused - other.linearizationsReused;
+  return result;
+}
+
+/* ************************************************************************* */
+void LinearizationCacheStats::print(const string& s) const {
+  cout << s << "  Triangulations: " << triangulations << " computed, "
+       << triangulationsReused << " reused (" << 100 * triangulationHitRate()
+       << "%)  Linearizations: " << linearizations << " computed, "
+       << linearizationsReused << " reused (" << 100 * linearizationHitRate()
+       << "%)" << endl;
+}
+
+/* ************************************************************************* */
+LinearizationCacheStats LinearizationCacheStats::Global() {
+  LinearizationCacheStats result;
+  result.triangulations = gTriangulations.load(memory_order_relaxed);
+  result.triangulationsReused = gTriangulationsReused.load(memory_order_relaxed);
+  result.linearizations = gLinearizations.load(memory_order_relaxed);
+  result.linearizationsReused = gLinearizationsReused.load(memory_order_relaxed);
+  return result;
+}
+
+/* ************************************************************************* */
+void LinearizationCacheStats::RecordTriangulation(bool reused) {
+  (reused ? gTriangulationsReused : gTriangulations)
+      .fetch_add(1, memory_order_relaxed);
+}
+
+/* ************************************************************************* */
+void LinearizationCacheStats::RecordLinearization(bool reused) {
+  (reused ? gLinearizationsReused : gLinearizations)
+      .fetch_add(1, memory_order_relaxed);
+}
+
+}  // namespace gtsam
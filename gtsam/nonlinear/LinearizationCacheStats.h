@@ -0,0 +1,75 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    LinearizationCacheStats.h
+ * @brief   Counters for factors that reuse work across linearizations
+ * @date    October 2026
+ */
+
+#pragma once
+
+#include <gtsam/dllexport.h>
+
+#include <cstddef>
+#include <string>
+
+namespace gtsam {
+
+/**
+ * Counters of factors that reuse work from earlier linearizations, such as the
+ * smart factors, which skip retriangulation while their cameras do not move
+ * and may return their previous linear factor. The global counters are
+ * updated atomically by the factors; ISAM2 reports how much they grew during
+ * an update in ISAM2Result::linearizationCache. Counts of concurrent
+ * optimizations in other threads are included as well.
+ */
+struct GTSAM_EXPORT LinearizationCacheStats {
+  size_t triangulations;        ///< points triangulated anew
+  size_t triangulationsReused;  ///< points kept, as the cameras did not move
+  size_t linearizations;        ///< linear factors computed
+  size_t linearizationsReused;  ///< previous linear factors returned
+
+  LinearizationCacheStats()
+      : triangulations(0),
+        triangulationsReused(0),
+        linearizations(0),
+        linearizationsReused(0) {}
+
+  /// Fraction of triangulations served from the cache, 0 if there were none
+  double triangulationHitRate() const {
+    const size_t total = triangulations + triangulationsReused;
+    return total ? double(triangulationsReused) / total : 0.0;
+  }
+
+  /// Fraction of linearizations served from the cache, 0 if there were none
+  double linearizationHitRate() const {
+    const size_t total = linearizations + linearizationsReused;
+    return total ? double(linearizationsReused) / total : 0.0;
+  }
+
+  /// Difference of two snapshots of the global counters
+  LinearizationCacheStats operator-(const LinearizationCacheStats& other) const;
+
+  /// Print counts and hit rates
+  void print(const std::string& s = "") const;
+
+  /// Snapshot of the global counters
+  static LinearizationCacheStats Global();
+
+  /// Count a triangulation, computed or reused
+  static void RecordTriangulation(bool reused);
+
+  /// Count a linearization, computed or reused
+  static void RecordLinearization(bool reused);
+};
+
+}  // namespace gtsam
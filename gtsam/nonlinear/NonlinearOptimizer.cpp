@@ -22,6 +22,7 @@
 #include <gtsam/linear/VectorValues.h>
 #include <gtsam/linear/SubgraphSolver.h>
 #include <gtsam/linear/PCGSolver.h>
+#include <gtsam/linear/SchurComplementSolver.h>
 #include <gtsam/linear/GaussianFactorGraph.h>
 #include <gtsam/linear/VectorValues.h>
 
@@ -163,6 +164,12 @@ VectorValues NonlinearOptimizer::solve(const GaussianFactorGraph& gfg,
       throw std::runtime_error(
           "NonlinearOptimizer::solve: special cg parameter type is not handled in LM solver ...");
     }
+  } else if (params.isSchurComplement()) {
+    // Eliminate points in parallel, then solve the reduced camera system
+    if (params.schurParams)
+      delta = SchurComplementSolver(*params.schurParams).optimize(gfg);
+    else
+      delta = SchurComplementSolver().optimize(gfg);
   } else {
     throw std::runtime_error("NonlinearOptimizer::solve: Optimization parameter is invalid");
   }
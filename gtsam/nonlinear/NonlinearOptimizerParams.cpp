@@ -71,6 +71,12 @@ void NonlinearOptimizerParams::setIterativeParams(
   iterativeParams = params;
 }
 
+/* ************************************************************************* */
+void NonlinearOptimizerParams::setSchurParams(
+    const boost::shared_ptr<SchurComplementSolverParameters> params) {
+  schurParams = params;
+}
+
 /* ************************************************************************* */
 void NonlinearOptimizerParams::print(const std::string& str) const {
 
@@ -103,6 +109,9 @@ void NonlinearOptimizerParams::print(const std::string& str) const {
   case Iterative:
     std::cout << "         linear solver type: ITERATIVE\n";
     break;
+  case SCHUR_COMPLEMENT:
+    std::cout << "         linear solver type: SCHUR COMPLEMENT\n";
+    break;
   default:
     std::cout << "         linear solver type: (invalid)\n";
     break;
@@ -139,6 +148,8 @@ std::string NonlinearOptimizerParams::linearSolverTranslator(
     return "ITERATIVE";
   case CHOLMOD:
     return "CHOLMOD";
+  case SCHUR_COMPLEMENT:
+    return "SCHUR_COMPLEMENT";
   default:
     throw std::invalid_argument(
         "Unknown linear solver type in SuccessiveLinearizationOptimizer");
@@ -160,6 +171,8 @@ NonlinearOptimizerParams::LinearSolverType NonlinearOptimizerParams::linearSolve
     return Iterative;
   if (linearSolverType == "CHOLMOD")
     return CHOLMOD;
+  if (linearSolverType == "SCHUR_COMPLEMENT")
+    return SCHUR_COMPLEMENT;
   throw std::invalid_argument(
       "Unknown linear solver type in SuccessiveLinearizationOptimizer");
 }
@@ -23,6 +23,7 @@
 
 #include <gtsam/linear/GaussianFactorGraph.h>
 #include <gtsam/linear/SubgraphSolver.h>
+#include <gtsam/linear/SchurComplementSolver.h>
 #include <boost/optional.hpp>
 #include <string>
 
@@ -79,11 +80,13 @@ public:
     SEQUENTIAL_QR,
     Iterative, /* Experimental Flag */
     CHOLMOD, /* Experimental Flag */
+    SCHUR_COMPLEMENT, /* Eliminate points first, for bundle adjustment */
   };
 
   LinearSolverType linearSolverType; ///< The type of linear solver to use in the nonlinear optimizer
   boost::optional<Ordering> ordering; ///< The optional variable elimination ordering, or empty to use COLAMD (default: empty)
   IterativeOptimizationParameters::shared_ptr iterativeParams; ///< The container for iterativeOptimization parameters. used in CG Solvers.
+  SchurComplementSolverParameters::shared_ptr schurParams; ///< Optional parameters for the SCHUR_COMPLEMENT solver (default: detect 3-dimensional points, dense solve)
 
   inline bool isMultifrontal() const {
     return (linearSolverType == MULTIFRONTAL_CHOLESKY)
@@ -103,6 +106,10 @@ public:
     return (linearSolverType == Iterative);
   }
 
+  inline bool isSchurComplement() const {
+    return (linearSolverType == SCHUR_COMPLEMENT);
+  }
+
   GaussianFactorGraph::Eliminate getEliminationFunction() const {
     switch (linearSolverType) {
     case MULTIFRONTAL_CHOLESKY:
@@ -129,6 +136,8 @@ public:
 
   void setIterativeParams(const boost::shared_ptr<IterativeOptimizationParameters> params);
 
+  void setSchurParams(const boost::shared_ptr<SchurComplementSolverParameters> params);
+
   void setOrdering(const Ordering& ordering) {
     this->ordering = ordering;
     this->orderingType = Ordering::CUSTOM;
@@ -20,6 +20,8 @@
 #include <gtsam/inference/Symbol.h>
 #include <gtsam/slam/ProjectionFactor.h>
 #include <gtsam/linear/Sampler.h>
+#include <gtsam/linear/VectorValues.h>
+#include <gtsam/slam/BetweenFactor.h>
 #include <gtsam/nonlinear/NonlinearFactorGraph.h>
 #include <gtsam/nonlinear/NonlinearFactor.h>
 #include <gtsam/nonlinear/Values.h>
@@ -142,6 +144,114 @@ Matrix extractPose3(const Values& values) {
   return result;
 }
 
+/**
+ * Extract all Pose3 values as stacked 4*4 homogeneous matrices, in key order.
+ * Pose j occupies rows 4j..4j+3, so in Python the returned array can be viewed
+ * without a copy as an (N, 4, 4) array with reshape(-1, 4, 4).
+ */
+Matrix extractPose3Matrices(const Values& values) {
+  Values::ConstFiltered<Pose3> poses = values.filter<Pose3>();
+  Matrix result(4 * poses.size(), 4);
+  size_t j = 0;
+  for(const auto& key_value: poses) {
+    result.block<4, 4>(4 * j, 0) = key_value.value.matrix();
+    j++;
+  }
+  return result;
+}
+
+/// Check that a bulk array has one row (or block of rows) per key
+inline void checkBulkRows(const std::string& caller, size_t nrKeys,
+    const Matrix& M, size_t rowsPerKey, size_t cols) {
+  if (size_t(M.rows()) != rowsPerKey * nrKeys || size_t(M.cols()) != cols)
+    throw std::invalid_argument(caller + ": expected " +
+        std::to_string(rowsPerKey * nrKeys) + "*" + std::to_string(cols) +
+        " matrix for " + std::to_string(nrKeys) + " keys");
+}
+
+/// Insert Point2 values from the rows [x y] of an N*2 matrix
+void insertPoint2s(Values& values, const KeyVector& keys, const Matrix& points) {
+  checkBulkRows("insertPoint2s", keys.size(), points, 1, 2);
+  for (size_t j = 0; j < keys.size(); j++)
+    values.insert(keys[j], Point2(points(j, 0), points(j, 1)));
+}
+
+/// Insert Point3 values from the rows [x y z] of an N*3 matrix
+void insertPoint3s(Values& values, const KeyVector& keys, const Matrix& points) {
+  checkBulkRows("insertPoint3s", keys.size(), points, 1, 3);
+  for (size_t j = 0; j < keys.size(); j++)
+    values.insert(keys[j], Point3(points(j, 0), points(j, 1), points(j, 2)));
+}
+
+/// Insert Pose2 values from the rows [x y theta] of an N*3 matrix
+void insertPose2s(Values& values, const KeyVector& keys, const Matrix& poses) {
+  checkBulkRows("insertPose2s", keys.size(), poses, 1, 3);
+  for (size_t j = 0; j < keys.size(); j++)
+    values.insert(keys[j], Pose2(poses(j, 0), poses(j, 1), poses(j, 2)));
+}
+
+/// Insert Pose3 values from 4N*4 stacked homogeneous matrices, as returned by
+/// extractPose3Matrices
+void insertPose3s(Values& values, const KeyVector& keys, const Matrix& poses) {
+  checkBulkRows("insertPose3s", keys.size(), poses, 4, 4);
+  for (size_t j = 0; j < keys.size(); j++)
+    values.insert(keys[j], Pose3(Matrix4(poses.block<4, 4>(4 * j, 0))));
+}
+
+/// Add BetweenFactor<Pose2> factors keys1[k] -> keys2[k], with the measurements
+/// in the rows [x y theta] of an N*3 matrix
+void insertBetweenFactorPose2s(NonlinearFactorGraph& graph,
+    const KeyVector& keys1, const KeyVector& keys2, const Matrix& measured,
+    const SharedNoiseModel& model) {
+  if (keys1.size() != keys2.size())
+    throw std::invalid_argument(
+        "insertBetweenFactorPose2s: keys1 and keys2 must have the same size");
+  checkBulkRows("insertBetweenFactorPose2s", keys1.size(), measured, 1, 3);
+  graph.reserve(graph.size() + keys1.size());
+  for (size_t k = 0; k < keys1.size(); k++)
+    graph.emplace_shared<BetweenFactor<Pose2> >(keys1[k], keys2[k],
+        Pose2(measured(k, 0), measured(k, 1), measured(k, 2)), model);
+}
+
+/// Add BetweenFactor<Pose3> factors keys1[k] -> keys2[k], with the measurements
+/// as 4N*4 stacked homogeneous matrices
+void insertBetweenFactorPose3s(NonlinearFactorGraph& graph,
+    const KeyVector& keys1, const KeyVector& keys2, const Matrix& measured,
+    const SharedNoiseModel& model) {
+  if (keys1.size() != keys2.size())
+    throw std::invalid_argument(
+        "insertBetweenFactorPose3s: keys1 and keys2 must have the same size");
+  checkBulkRows("insertBetweenFactorPose3s", keys1.size(), measured, 4, 4);
+  graph.reserve(graph.size() + keys1.size());
+  for (size_t k = 0; k < keys1.size(); k++)
+    graph.emplace_shared<BetweenFactor<Pose3> >(keys1[k], keys2[k],
+        Pose3(Matrix4(measured.block<4, 4>(4 * k, 0))), model);
+}
+
+/// Create VectorValues with the vector for keys[j] in row j of an N*d matrix
+VectorValues createVectorValues(const KeyVector& keys, const Matrix& X) {
+  checkBulkRows("createVectorValues", keys.size(), X, 1, X.cols());
+  VectorValues result;
+  for (size_t j = 0; j < keys.size(); j++)
+    result.insert(keys[j], X.row(j).transpose());
+  return result;
+}
+
+/// Extract the vectors for the given keys, all of the same dimension, as the
+/// rows of an N*d matrix
+Matrix extractVectors(const VectorValues& x, const KeyVector& keys) {
+  const size_t d = keys.empty() ? 0 : x.dim(keys.front());
+  Matrix result(keys.size(), d);
+  for (size_t j = 0; j < keys.size(); j++) {
+    const Vector& v = x.at(keys[j]);
+    if (size_t(v.size()) != d)
+      throw std::invalid_argument(
+          "extractVectors: all vectors must have the same dimension");
+    result.row(j) = v.transpose();
+  }
+  return result;
+}
+
 /// Perturb all Point2 values using normally distributed noise
 void perturbPoint2(Values& values, double sigma, int32_t seed = 42u) {
   noiseModel::Isotropic::shared_ptr model = noiseModel::Isotropic::Sigma(2,
@@ -0,0 +1,769 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file   BinaryGraph.cpp
+ * @brief  Compact columnar binary file format for factor graphs and values
+ * @date   October 2026
+ */
+
+#include <gtsam/slam/BinaryGraph.h>
+
+#include <gtsam/slam/BetweenFactor.h>
+#include <gtsam/slam/GeneralSFMFactor.h>
+#include <gtsam/slam/ProjectionFactor.h>
+#include <gtsam/slam/SmartProjectionPoseFactor.h>
+#include <gtsam/nonlinear/PriorFactor.h>
+#include <gtsam/inference/Symbol.h>
+#include <gtsam/base/GenericValue.h>
+#include <gtsam/base/parallelFor.h>
+#include <gtsam/base/types.h>
+
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <stdexcept>
+#include <typeindex>
+#include <unordered_map>
+
+using namespace std;
+
+namespace gtsam {
+
+typedef GenericProjectionFactor<Pose3, Point3, Cal3_S2> ProjectionFactor;
+typedef GeneralSFMFactor<SfmCamera, Point3> SfmFactor;
+typedef SmartProjectionPoseFactor<Cal3_S2> SmartFactor;
+
+namespace {
+
+const char kMagic[8] = {'G', 'T', 'S', 'A', 'M', 'B', 'G', '\0'};
+const size_t kHeaderSize = 64, kTableEntrySize = 32, kSectionAlignment = 64;
+
+// The columns are read and written as they are in memory
+void requireLittleEndian(const string& caller) {
+  const uint16_t one = 1;
+  unsigned char first;
+  memcpy(&first, &one, 1);
+  if (first != 1)
+    throw runtime_error(caller + ": binary graph files need a little-endian host");
+}
+
+// Shape of the rows of a section kind
+struct Layout {
+  bool isFactor, isRagged;
+  size_t keysPerRow, doublesPerRow;
+};
+
+bool layoutOf(BinaryGraphSection kind, Layout* layout) {
+  typedef BinaryGraphSection S;
+  switch (kind) {
+    case S::POINT2_VALUES: *layout = {false, false, 1, 2}; return true;
+    case S::POINT3_VALUES: *layout = {false, false, 1, 3}; return true;
+    case S::POSE2_VALUES: *layout = {false, false, 1, 3}; return true;
+    case S::POSE3_VALUES: *layout = {false, false, 1, 12}; return true;
+    case S::SFM_CAMERA_VALUES: *layout = {false, false, 1, 17}; return true;
+    case S::PRIOR_POSE2: *layout = {true, false, 1, 3}; return true;
+    case S::PRIOR_POSE3: *layout = {true, false, 1, 12}; return true;
+    case S::BETWEEN_POSE2: *layout = {true, false, 2, 3}; return true;
+    case S::BETWEEN_POSE3: *layout = {true, false, 2, 12}; return true;
+    case S::PROJECTION: *layout = {true, false, 2, 19}; return true;
+    case S::SFM_PROJECTION: *layout = {true, false, 2, 2}; return true;
+    case S::SMART_PROJECTION: *layout = {true, true, 0, 21}; return true;
+    default: return false;
+  }
+}
+
+/* ************************************************************************* */
+// Conversion of the stored types to and from rows of doubles
+template <class T>
+struct Codec;
+
+template <>
+struct Codec<Point2> {
+  static void put(const Point2& p, vector<double>* d) {
+    d->insert(d->end(), {p.x(), p.y()});
+  }
+  static Point2 get(const double* d) { return Point2(d[0], d[1]); }
+};
+
+template <>
+struct Codec<Point3> {
+  static void put(const Point3& p, vector<double>* d) {
+    d->insert(d->end(), {p.x(), p.y(), p.z()});
+  }
+  static Point3 get(const double* d) { return Point3(d[0], d[1], d[2]); }
+};
+
+template <>
+struct Codec<Pose2> {
+  static void put(const Pose2& p, vector<double>* d) {
+    d->insert(d->end(), {p.x(), p.y(), p.theta()});
+  }
+  static Pose2 get(const double* d) { return Pose2(d[0], d[1], d[2]); }
+};
+
+template <>
+struct Codec<Pose3> {
+  static void put(const Pose3& p, vector<double>* d) {
+    const Matrix3 R = p.rotation().matrix();
+    for (size_t i = 0; i < 3; i++)
+      for (size_t j = 0; j < 3; j++) d->push_back(R(i, j));
+    d->insert(d->end(), {p.x(), p.y(), p.z()});
+  }
+  static Pose3 get(const double* d) {
+    Matrix3 R;
+    R << d[0], d[1], d[2], d[3], d[4], d[5], d[6], d[7], d[8];
+    return Pose3(Rot3(R), Point3(d[9], d[10], d[11]));
+  }
+};
+
+template <>
+struct Codec<Cal3_S2> {
+  static void put(const Cal3_S2& K, vector<double>* d) {
+    d->insert(d->end(), {K.fx(), K.fy(), K.skew(), K.px(), K.py()});
+  }
+  static Cal3_S2 get(const double* d) {
+    return Cal3_S2(d[0], d[1], d[2], d[3], d[4]);
+  }
+};
+
+template <>
+struct Codec<SfmCamera> {
+  static void put(const SfmCamera& camera, vector<double>* d) {
+    Codec<Pose3>::put(camera.pose(), d);
+    const Cal3Bundler& K = camera.calibration();
+    d->insert(d->end(), {K.fx(), K.k1(), K.k2(), K.u0(), K.v0()});
+  }
+  static SfmCamera get(const double* d) {
+    return SfmCamera(Codec<Pose3>::get(d),
+                     Cal3Bundler(d[12], d[13], d[14], d[15], d[16]));
+  }
+};
+
+// body_P_sensor takes 12 doubles, identity when absent
+void putBodyPose(const boost::optional<Pose3>& body_P_sensor, uint32_t* flags,
+                 vector<double>* d) {
+  if (body_P_sensor) *flags |= BINARY_HAS_BODY_P_SENSOR;
+  Codec<Pose3>::put(body_P_sensor ? *body_P_sensor : Pose3(), d);
+}
+
+boost::optional<Pose3> getBodyPose(uint32_t flags, const double* d) {
+  if (!(flags & BINARY_HAS_BODY_P_SENSOR)) return boost::none;
+  return Codec<Pose3>::get(d);
+}
+
+/* ************************************************************************* */
+// Columns of one section while writing
+struct SectionBuilder {
+  BinaryGraphSection kind;
+  Layout layout;
+  size_t count = 0;
+  vector<uint64_t> slots, offsets, keys;
+  vector<uint32_t> noise, flags;
+  vector<double> data, measured;
+
+  explicit SectionBuilder(BinaryGraphSection k) : kind(k) {
+    layoutOf(kind, &layout);
+    if (layout.isRagged) offsets.push_back(0);
+  }
+
+  // Start a factor row, the caller appends keys and data
+  void addFactor(uint64_t slot, uint32_t noiseIndex, uint32_t flagBits = 0) {
+    count++;
+    slots.push_back(slot);
+    noise.push_back(noiseIndex);
+    flags.push_back(flagBits);
+  }
+};
+
+// Noise models, each stored once however many factors share it
+class NoiseModelTable {
+ public:
+  NoiseModelTable() { offsets_.push_back(0); }
+
+  uint32_t add(const SharedNoiseModel& model) {
+    if (!model) return kNoBinaryNoiseModel;
+    auto it = index_.find(model.get());
+    if (it != index_.end()) return it->second;
+
+    const noiseModel::Base& m = *model;
+    const type_info& type = typeid(m);
+    if (type == typeid(noiseModel::Unit)) {
+      types_.push_back(uint32_t(BinaryNoiseModel::UNIT));
+    } else if (type == typeid(noiseModel::Isotropic)) {
+      types_.push_back(uint32_t(BinaryNoiseModel::ISOTROPIC));
+      data_.push_back(static_cast<const noiseModel::Isotropic&>(m).sigma());
+    } else if (type == typeid(noiseModel::Diagonal)) {
+      types_.push_back(uint32_t(BinaryNoiseModel::DIAGONAL));
+      const Vector sigmas = static_cast<const noiseModel::Diagonal&>(m).sigmas();
+      data_.insert(data_.end(), sigmas.data(), sigmas.data() + sigmas.size());
+    } else if (type == typeid(noiseModel::Gaussian)) {
+      types_.push_back(uint32_t(BinaryNoiseModel::GAUSSIAN));
+      const Matrix R = static_cast<const noiseModel::Gaussian&>(m).R();
+      for (Eigen::Index i = 0; i < R.rows(); i++)
+        for (Eigen::Index j = 0; j < R.cols(); j++) data_.push_back(R(i, j));
+    } else {
+      throw invalid_argument("writeBinaryGraph: unsupported noise model " +
+                             demangle(type.name()));
+    }
+    dims_.push_back(uint32_t(m.dim()));
+    offsets_.push_back(data_.size());
+    const uint32_t index = uint32_t(types_.size() - 1);
+    index_.emplace(model.get(), index);
+    return index;
+  }
+
+  size_t size() const { return types_.size(); }
+
+  friend string sectionBytes(const NoiseModelTable& table);
+
+ private:
+  unordered_map<const noiseModel::Base*, uint32_t> index_;
+  vector<uint64_t> offsets_;
+  vector<uint32_t> types_, dims_;
+  vector<double> data_;
+};
+
+// Append a column, padded to 8 bytes
+template <typename T>
+void appendColumn(const vector<T>& column, string* bytes) {
+  bytes->append(reinterpret_cast<const char*>(column.data()),
+                column.size() * sizeof(T));
+  bytes->resize((bytes->size() + 7) & ~size_t(7), '\0');
+}
+
+string sectionBytes(const SectionBuilder& section) {
+  string bytes;
+  if (section.layout.isFactor) appendColumn(section.slots, &bytes);
+  if (section.layout.isRagged) appendColumn(section.offsets, &bytes);
+  appendColumn(section.keys, &bytes);
+  if (section.layout.isFactor) {
+    appendColumn(section.noise, &bytes);
+    appendColumn(section.flags, &bytes);
+  }
+  appendColumn(section.data, &bytes);
+  if (section.layout.isRagged) appendColumn(section.measured, &bytes);
+  return bytes;
+}
+
+string sectionBytes(const NoiseModelTable& table) {
+  string bytes;
+  appendColumn(table.offsets_, &bytes);
+  appendColumn(table.types_, &bytes);
+  appendColumn(table.dims_, &bytes);
+  appendColumn(table.data_, &bytes);
+  return bytes;
+}
+
+/* ************************************************************************* */
+// Dispatch on the dynamic type of values and factors while writing
+typedef function<void(const Value&, Key, SectionBuilder*)> ValueWriter;
+typedef function<void(const NonlinearFactor&, uint64_t, NoiseModelTable*,
+                      SectionBuilder*)>
+    FactorWriter;
+
+template <class T>
+pair<BinaryGraphSection, ValueWriter> valueWriter(BinaryGraphSection kind) {
+  return make_pair(kind, [](const Value& value, Key key, SectionBuilder* s) {
+    s->count++;
+    s->keys.push_back(key);
+    Codec<T>::put(static_cast<const GenericValue<T>&>(value).value(), &s->data);
+  });
+}
+
+const unordered_map<type_index, pair<BinaryGraphSection, ValueWriter>>&
+valueWriters() {
+  typedef BinaryGraphSection S;
+  static const unordered_map<type_index, pair<S, ValueWriter>> writers = {
+      {typeid(GenericValue<Point2>), valueWriter<Point2>(S::POINT2_VALUES)},
+      {typeid(GenericValue<Point3>), valueWriter<Point3>(S::POINT3_VALUES)},
+      {typeid(GenericValue<Pose2>), valueWriter<Pose2>(S::POSE2_VALUES)},
+      {typeid(GenericValue<Pose3>), valueWriter<Pose3>(S::POSE3_VALUES)},
+      {typeid(GenericValue<SfmCamera>),
+       valueWriter<SfmCamera>(S::SFM_CAMERA_VALUES)}};
+  return writers;
+}
+
+template <class T>
+pair<BinaryGraphSection, FactorWriter> priorWriter(BinaryGraphSection kind) {
+  return make_pair(kind, [](const NonlinearFactor& factor, uint64_t slot,
+                            NoiseModelTable* noise, SectionBuilder* s) {
+    const auto& f = static_cast<const PriorFactor<T>&>(factor);
+    s->addFactor(slot, noise->add(f.noiseModel()));
+    s->keys.push_back(f.key());
+    Codec<T>::put(f.prior(), &s->data);
+  });
+}
+
+template <class T>
+pair<BinaryGraphSection, FactorWriter> betweenWriter(BinaryGraphSection kind) {
+  return make_pair(kind, [](const NonlinearFactor& factor, uint64_t slot,
+                            NoiseModelTable* noise, SectionBuilder* s) {
+    const auto& f = static_cast<const BetweenFactor<T>&>(factor);
+    s->addFactor(slot, noise->add(f.noiseModel()));
+    s->keys.insert(s->keys.end(), {f.key1(), f.key2()});
+    Codec<T>::put(f.measured(), &s->data);
+  });
+}
+
+void writeProjection(const NonlinearFactor& factor, uint64_t slot,
+                     NoiseModelTable* noise, SectionBuilder* s) {
+  const auto& f = static_cast<const ProjectionFactor&>(factor);
+  if (!f.calibration())
+    throw invalid_argument("writeBinaryGraph: projection factor without calibration");
+  uint32_t flags = (f.throwCheirality() ? BINARY_THROW_CHEIRALITY : 0) |
+                   (f.verboseCheirality() ? BINARY_VERBOSE_CHEIRALITY : 0);
+  Codec<Point2>::put(f.measured(), &s->data);
+  Codec<Cal3_S2>::put(*f.calibration(), &s->data);
+  putBodyPose(f.body_P_sensor(), &flags, &s->data);
+  s->addFactor(slot, noise->add(f.noiseModel()), flags);
+  s->keys.insert(s->keys.end(), {f.key1(), f.key2()});
+}
+
+void writeSfmProjection(const NonlinearFactor& factor, uint64_t slot,
+                        NoiseModelTable* noise, SectionBuilder* s) {
+  const auto& f = static_cast<const SfmFactor&>(factor);
+  s->addFactor(slot, noise->add(f.noiseModel()));
+  s->keys.insert(s->keys.end(), {f.key1(), f.key2()});
+  Codec<Point2>::put(f.measured(), &s->data);
+}
+
+void writeSmartProjection(const NonlinearFactor& factor, uint64_t slot,
+                          NoiseModelTable* noise, SectionBuilder* s) {
+  const auto& f = static_cast<const SmartFactor&>(factor);
+  if (!f.calibration())
+    throw invalid_argument("writeBinaryGraph: smart factor without calibration");
+  const SmartProjectionParams& params = f.params();
+  uint32_t flags =
+      (params.throwCheirality ? BINARY_THROW_CHEIRALITY : 0) |
+      (params.verboseCheirality ? BINARY_VERBOSE_CHEIRALITY : 0) |
+      (params.triangulation.enableEPI ? BINARY_ENABLE_EPI : 0) |
+      (params.reuseLinearization ? BINARY_REUSE_LINEARIZATION : 0) |
+      (uint32_t(params.linearizationMode) << 8) |
+      (uint32_t(params.degeneracyMode) << 16);
+  // An identity body_P_sensor is equivalent to none
+  const Pose3 body_P_sensor = f.body_P_sensor();
+  Codec<Cal3_S2>::put(*f.calibration(), &s->data);
+  putBodyPose(body_P_sensor.equals(Pose3(), 0)
+                  ? boost::optional<Pose3>()
+                  : boost::optional<Pose3>(body_P_sensor),
+              &flags, &s->data);
+  s->data.insert(s->data.end(),
+                 {params.retriangulationThreshold,
+                  params.triangulation.rankTolerance,
+                  params.triangulation.landmarkDistanceThreshold,
+                  params.triangulation.dynamicOutlierRejectionThreshold});
+  s->addFactor(slot, noise->add(f.noiseModel()), flags);
+  s->keys.insert(s->keys.end(), f.keys().begin(), f.keys().end());
+  s->offsets.push_back(s->keys.size());
+  for (const Point2& z : f.measured()) Codec<Point2>::put(z, &s->measured);
+}
+
+const unordered_map<type_index, pair<BinaryGraphSection, FactorWriter>>&
+factorWriters() {
+  typedef BinaryGraphSection S;
+  static const unordered_map<type_index, pair<S, FactorWriter>> writers = {
+      {typeid(PriorFactor<Pose2>), priorWriter<Pose2>(S::PRIOR_POSE2)},
+      {typeid(PriorFactor<Pose3>), priorWriter<Pose3>(S::PRIOR_POSE3)},
+      {typeid(BetweenFactor<Pose2>), betweenWriter<Pose2>(S::BETWEEN_POSE2)},
+      {typeid(BetweenFactor<Pose3>), betweenWriter<Pose3>(S::BETWEEN_POSE3)},
+      {typeid(ProjectionFactor), make_pair(S::PROJECTION, writeProjection)},
+      {typeid(SfmFactor), make_pair(S::SFM_PROJECTION, writeSfmProjection)},
+      {typeid(SmartFactor),
+       make_pair(S::SMART_PROJECTION, writeSmartProjection)}};
+  return writers;
+}
+
+/* ************************************************************************* */
+template <typename T>
+T readScalar(const char* p) {
+  T t;
+  memcpy(&t, p, sizeof(T));
+  return t;
+}
+
+template <typename T>
+void writeScalar(T t, char* p) {
+  memcpy(p, &t, sizeof(T));
+}
+
+// Hands out the columns of a section, checking they stay inside it
+class ColumnReader {
+ public:
+  ColumnReader(const char* begin, const char* end) : p_(begin), end_(end) {}
+
+  template <typename T>
+  const T* take(size_t n) {
+    const size_t bytes = (n * sizeof(T) + 7) & ~size_t(7);
+    if (n > size_t(end_ - p_) / sizeof(T) || bytes > size_t(end_ - p_))
+      throw invalid_argument("BinaryGraphFile: truncated section");
+    const T* column = reinterpret_cast<const T*>(p_);
+    p_ += bytes;
+    return column;
+  }
+
+ private:
+  const char *p_, *end_;
+};
+
+// Offsets of ragged rows must start at zero and be non-decreasing
+void checkOffsets(const uint64_t* offsets, size_t count) {
+  if (offsets[0] != 0)
+    throw invalid_argument("BinaryGraphFile: invalid row offsets");
+  for (size_t i = 0; i < count; i++)
+    if (offsets[i + 1] < offsets[i])
+      throw invalid_argument("BinaryGraphFile: invalid row offsets");
+}
+
+/* ************************************************************************* */
+SharedNoiseModel createNoiseModel(const BinaryNoiseModelColumns& columns,
+                                  size_t i) {
+  const size_t dim = columns.dims[i];
+  const double* d = columns.data + columns.offsets[i];
+  const size_t n = columns.offsets[i + 1] - columns.offsets[i];
+  switch (BinaryNoiseModel(columns.types[i])) {
+    case BinaryNoiseModel::UNIT:
+      return noiseModel::Unit::Create(dim);
+    case BinaryNoiseModel::ISOTROPIC:
+      if (n == 1) return noiseModel::Isotropic::Sigma(dim, d[0], false);
+      break;
+    case BinaryNoiseModel::DIAGONAL:
+      if (n == dim)
+        return noiseModel::Diagonal::Sigmas(Eigen::Map<const Vector>(d, dim),
+                                            false);
+      break;
+    case BinaryNoiseModel::GAUSSIAN:
+      if (n == dim * dim)
+        return noiseModel::Gaussian::SqrtInformation(
+            Eigen::Map<const Eigen::Matrix<double, Eigen::Dynamic,
+                                           Eigen::Dynamic, Eigen::RowMajor>>(
+                d, dim, dim),
+            false);
+      break;
+  }
+  throw invalid_argument("BinaryGraphFile: invalid noise model");
+}
+
+template <class T>
+void insertValues(const BinaryGraphColumns& s, Values* values) {
+  for (size_t i = 0; i < s.count; i++)
+    values->insert(s.keys[i], Codec<T>::get(s.rowData(i)));
+}
+
+// Create the factors of a section in parallel, each into its own slot
+template <typename MAKE>
+void createFactors(const BinaryGraphColumns& s, NonlinearFactorGraph* graph,
+                   const MAKE& make) {
+  parallelFor(s.count, [&](size_t i) { (*graph)[s.slots[i]] = make(i); });
+}
+
+// Calibrations shared by consecutive rows with the same values
+vector<boost::shared_ptr<Cal3_S2>> createCalibrations(
+    const BinaryGraphColumns& s, size_t column) {
+  vector<boost::shared_ptr<Cal3_S2>> calibrations(s.count);
+  for (size_t i = 0; i < s.count; i++) {
+    const double* d = s.rowData(i) + column;
+    if (i > 0 && memcmp(d, s.rowData(i - 1) + column, 5 * sizeof(double)) == 0)
+      calibrations[i] = calibrations[i - 1];
+    else
+      calibrations[i] = boost::make_shared<Cal3_S2>(Codec<Cal3_S2>::get(d));
+  }
+  return calibrations;
+}
+
+}  // namespace
+
+/* ************************************************************************* */
+BinaryGraphFile::BinaryGraphFile(const string& filename) : file_(filename) {
+  requireLittleEndian("BinaryGraphFile");
+  const char* base = file_.begin();
+  const size_t size = file_.size();
+  if (size < kHeaderSize || memcmp(base, kMagic, sizeof(kMagic)) != 0)
+    throw invalid_argument("BinaryGraphFile: " + filename +
+                           " is not a binary graph file");
+  version_ = readScalar<uint32_t>(base + 8);
+  if (version_ == 0 || version_ > kBinaryGraphVersion)
+    throw invalid_argument("BinaryGraphFile: " + filename + " has version " +
+                           to_string(version_) + ", this build reads up to " +
+                           to_string(kBinaryGraphVersion));
+  const size_t nrSections = readScalar<uint32_t>(base + 12);
+  nrFactors_ = readScalar<uint64_t>(base + 16);
+  const uint64_t tableOffset = readScalar<uint64_t>(base + 24);
+  if (tableOffset > size || nrSections > (size - tableOffset) / kTableEntrySize)
+    throw invalid_argument("BinaryGraphFile: truncated section table");
+
+  for (size_t k = 0; k < nrSections; k++) {
+    const char* entry = base + tableOffset + k * kTableEntrySize;
+    const BinaryGraphSection kind =
+        BinaryGraphSection(readScalar<uint32_t>(entry));
+    const uint64_t count = readScalar<uint64_t>(entry + 8);
+    const uint64_t offset = readScalar<uint64_t>(entry + 16);
+    const uint64_t bytes = readScalar<uint64_t>(entry + 24);
+    if (offset % 8 != 0 || offset > size || bytes > size - offset)
+      throw invalid_argument("BinaryGraphFile: section outside of file");
+    ColumnReader reader(base + offset, base + offset + bytes);
+
+    if (kind == BinaryGraphSection::NOISE_MODELS) {
+      noiseModels_.count = count;
+      noiseModels_.offsets = reader.take<uint64_t>(count + 1);
+      checkOffsets(noiseModels_.offsets, count);
+      noiseModels_.types = reader.take<uint32_t>(count);
+      noiseModels_.dims = reader.take<uint32_t>(count);
+      noiseModels_.data = reader.take<double>(noiseModels_.offsets[count]);
+      continue;
+    }
+
+    Layout layout;
+    if (!layoutOf(kind, &layout))
+      throw invalid_argument("BinaryGraphFile: unknown section kind " +
+                             to_string(uint32_t(kind)));
+    BinaryGraphColumns s;
+    s.kind = kind;
+    s.count = count;
+    s.keysPerRow = layout.keysPerRow;
+    s.doublesPerRow = layout.doublesPerRow;
+    if (layout.isFactor) s.slots = reader.take<uint64_t>(count);
+    size_t nrKeys = count * layout.keysPerRow;
+    if (layout.isRagged) {
+      s.offsets = reader.take<uint64_t>(count + 1);
+      checkOffsets(s.offsets, count);
+      nrKeys = s.offsets[count];
+    }
+    s.keys = reader.take<uint64_t>(nrKeys);
+    if (layout.isFactor) {
+      s.noise = reader.take<uint32_t>(count);
+      s.flags = reader.take<uint32_t>(count);
+    }
+    s.data = reader.take<double>(count * layout.doublesPerRow);
+    if (layout.isRagged) s.measured = reader.take<double>(2 * nrKeys);
+    sections_.push_back(s);
+  }
+
+  // Factors are created in parallel, so slots and noise indices are checked
+  // here rather than while loading
+  vector<bool> used(nrFactors_, false);
+  for (const BinaryGraphColumns& s : sections_) {
+    for (size_t i = 0; s.slots && i < s.count; i++) {
+      if (s.slots[i] >= nrFactors_ || used[s.slots[i]])
+        throw invalid_argument("BinaryGraphFile: invalid factor slot");
+      used[s.slots[i]] = true;
+      if (s.noise[i] != kNoBinaryNoiseModel && s.noise[i] >= noiseModels_.count)
+        throw invalid_argument("BinaryGraphFile: invalid noise model index");
+    }
+  }
+}
+
+/* ************************************************************************* */
+GraphAndValues BinaryGraphFile::load() const {
+  typedef BinaryGraphSection S;
+  vector<SharedNoiseModel> models(noiseModels_.count);
+  for (size_t i = 0; i < noiseModels_.count; i++)
+    models[i] = createNoiseModel(noiseModels_, i);
+
+  const auto graph = boost::make_shared<NonlinearFactorGraph>();
+  const auto values = boost::make_shared<Values>();
+  graph->resize(nrFactors_);
+  for (const BinaryGraphColumns& s : sections_) {
+    const auto model = [&](size_t i) {
+      return s.noise[i] == kNoBinaryNoiseModel ? SharedNoiseModel()
+                                               : models[s.noise[i]];
+    };
+    switch (s.kind) {
+      case S::POINT2_VALUES: insertValues<Point2>(s, values.get()); break;
+      case S::POINT3_VALUES: insertValues<Point3>(s, values.get()); break;
+      case S::POSE2_VALUES: insertValues<Pose2>(s, values.get()); break;
+      case S::POSE3_VALUES: insertValues<Pose3>(s, values.get()); break;
+      case S::SFM_CAMERA_VALUES: insertValues<SfmCamera>(s, values.get()); break;
+      case S::PRIOR_POSE2:
+        createFactors(s, graph.get(), [&](size_t i) {
+          return boost::make_shared<PriorFactor<Pose2>>(
+              s.keys[i], Codec<Pose2>::get(s.rowData(i)), model(i));
+        });
+        break;
+      case S::PRIOR_POSE3:
+        createFactors(s, graph.get(), [&](size_t i) {
+          return boost::make_shared<PriorFactor<Pose3>>(
+              s.keys[i], Codec<Pose3>::get(s.rowData(i)), model(i));
+        });
+        break;
+      case S::BETWEEN_POSE2:
+        createFactors(s, graph.get(), [&](size_t i) {
+          return boost::make_shared<BetweenFactor<Pose2>>(
+              s.keys[2 * i], s.keys[2 * i + 1], Codec<Pose2>::get(s.rowData(i)),
+              model(i));
+        });
+        break;
+      case S::BETWEEN_POSE3:
+        createFactors(s, graph.get(), [&](size_t i) {
+          return boost::make_shared<BetweenFactor<Pose3>>(
+              s.keys[2 * i], s.keys[2 * i + 1], Codec<Pose3>::get(s.rowData(i)),
+              model(i));
+        });
+        break;
+      case S::PROJECTION: {
+        const auto calibrations = createCalibrations(s, 2);
+        createFactors(s, graph.get(), [&](size_t i) {
+          const double* d = s.rowData(i);
+          return boost::make_shared<ProjectionFactor>(
+              Codec<Point2>::get(d), model(i), s.keys[2 * i], s.keys[2 * i + 1],
+              calibrations[i], (s.flags[i] & BINARY_THROW_CHEIRALITY) != 0,
+              (s.flags[i] & BINARY_VERBOSE_CHEIRALITY) != 0,
+              getBodyPose(s.flags[i], d + 7));
+        });
+        break;
+      }
+      case S::SFM_PROJECTION:
+        createFactors(s, graph.get(), [&](size_t i) {
+          return boost::make_shared<SfmFactor>(Codec<Point2>::get(s.rowData(i)),
+                                               model(i), s.keys[2 * i],
+                                               s.keys[2 * i + 1]);
+        });
+        break;
+      case S::SMART_PROJECTION: {
+        const auto calibrations = createCalibrations(s, 0);
+        createFactors(s, graph.get(), [&](size_t i) {
+          const double* d = s.rowData(i);
+          const uint32_t flags = s.flags[i];
+          SmartProjectionParams params(
+              LinearizationMode((flags >> 8) & 0xFF),
+              DegeneracyMode((flags >> 16) & 0xFF),
+              (flags & BINARY_THROW_CHEIRALITY) != 0,
+              (flags & BINARY_VERBOSE_CHEIRALITY) != 0, d[17]);
+          params.setRankTolerance(d[18]);
+          params.setEnableEPI((flags & BINARY_ENABLE_EPI) != 0);
+          params.setLandmarkDistanceThreshold(d[19]);
+          params.setDynamicOutlierRejectionThreshold(d[20]);
+          params.setReuseLinearization((flags & BINARY_REUSE_LINEARIZATION) != 0);
+          const auto factor = boost::make_shared<SmartFactor>(
+              model(i), calibrations[i], getBodyPose(flags, d + 5), params);
+          const uint64_t* keys = s.rowKeys(i);
+          for (size_t k = 0; k < s.nrKeys(i); k++)
+            factor->add(Codec<Point2>::get(s.measured + 2 * (s.offsets[i] + k)),
+                        keys[k]);
+          return factor;
+        });
+        break;
+      }
+      default:
+        break;
+    }
+  }
+  return make_pair(graph, values);
+}
+
+/* ************************************************************************* */
+void writeBinaryGraph(const NonlinearFactorGraph& graph, const Values& values,
+                      const string& filename) {
+  requireLittleEndian("writeBinaryGraph");
+
+  // Sort values and factors into sections by type
+  map<BinaryGraphSection, SectionBuilder> sections;
+  const auto builder = [&sections](BinaryGraphSection kind) {
+    return &sections.emplace(kind, SectionBuilder(kind)).first->second;
+  };
+  const auto& valueDispatch = valueWriters();
+  for (const auto& key_value : values) {
+    const Value& value = key_value.value;
+    const auto it = valueDispatch.find(typeid(value));
+    if (it == valueDispatch.end())
+      throw invalid_argument("writeBinaryGraph: unsupported value type " +
+                             demangle(typeid(value).name()));
+    it->second.second(value, key_value.key, builder(it->second.first));
+  }
+  NoiseModelTable noiseModels;
+  const auto& factorDispatch = factorWriters();
+  for (size_t slot = 0; slot < graph.size(); slot++) {
+    if (!graph[slot]) continue;
+    const NonlinearFactor& factor = *graph[slot];
+    const auto it = factorDispatch.find(typeid(factor));
+    if (it == factorDispatch.end())
+      throw invalid_argument("writeBinaryGraph: unsupported factor type " +
+                             demangle(typeid(factor).name()));
+    it->second.second(factor, slot, &noiseModels, builder(it->second.first));
+  }
+
+  // Section contents, then the header and table pointing at them
+  vector<pair<uint32_t, uint64_t>> kinds;  // kind and number of rows
+  vector<string> contents;
+  if (noiseModels.size() > 0) {
+    kinds.emplace_back(uint32_t(BinaryGraphSection::NOISE_MODELS),
+                       noiseModels.size());
+    contents.push_back(sectionBytes(noiseModels));
+  }
+  for (const auto& kind_section : sections) {
+    kinds.emplace_back(uint32_t(kind_section.first), kind_section.second.count);
+    contents.push_back(sectionBytes(kind_section.second));
+  }
+
+  const auto align = [](size_t n) {
+    return (n + kSectionAlignment - 1) / kSectionAlignment * kSectionAlignment;
+  };
+  string header(align(kHeaderSize + kTableEntrySize * kinds.size()), '\0');
+  memcpy(&header[0], kMagic, sizeof(kMagic));
+  writeScalar<uint32_t>(kBinaryGraphVersion, &header[8]);
+  writeScalar<uint32_t>(uint32_t(kinds.size()), &header[12]);
+  writeScalar<uint64_t>(graph.size(), &header[16]);
+  writeScalar<uint64_t>(kHeaderSize, &header[24]);
+  uint64_t offset = header.size();
+  for (size_t k = 0; k < kinds.size(); k++) {
+    char* entry = &header[kHeaderSize + k * kTableEntrySize];
+    writeScalar<uint32_t>(kinds[k].first, entry);
+    writeScalar<uint64_t>(kinds[k].second, entry + 8);
+    writeScalar<uint64_t>(offset, entry + 16);
+    writeScalar<uint64_t>(contents[k].size(), entry + 24);
+    offset = align(offset + contents[k].size());
+  }
+
+  ofstream os(filename.c_str(), ios::binary);
+  if (!os)
+    throw invalid_argument("writeBinaryGraph: can not open " + filename);
+  os.write(header.data(), header.size());
+  const string padding(kSectionAlignment, '\0');
+  for (const string& bytes : contents) {
+    os.write(bytes.data(), bytes.size());
+    os.write(padding.data(), align(bytes.size()) - bytes.size());
+  }
+  if (!os)
+    throw runtime_error("writeBinaryGraph: error writing " + filename);
+}
+
+/* ************************************************************************* */
+GraphAndValues readBinaryGraph(const string& filename) {
+  return BinaryGraphFile(filename).load();
+}
+
+/* ************************************************************************* */
+void convertG2oToBinaryGraph(const string& g2oFile, const string& binaryFile,
+                             bool is3D) {
+  const GraphAndValues graph_values = readG2o(g2oFile, is3D);
+  writeBinaryGraph(*graph_values.first, *graph_values.second, binaryFile);
+}
+
+/* ************************************************************************* */
+void convertBALToBinaryGraph(const string& balFile, const string& binaryFile) {
+  SfmData data;
+  if (!readBAL(balFile, data))
+    throw invalid_argument("convertBALToBinaryGraph: can not read " + balFile);
+  using symbol_shorthand::P;
+  NonlinearFactorGraph graph;
+  size_t nrMeasurements = 0;
+  for (const SfmTrack& track : data.tracks)
+    nrMeasurements += track.measurements.size();
+  graph.reserve(nrMeasurements);
+  const SharedNoiseModel noise = noiseModel::Isotropic::Sigma(2, 1.0);
+  for (size_t j = 0; j < data.tracks.size(); j++)
+    for (const SfmMeasurement& m : data.tracks[j].measurements)
+      graph.emplace_shared<SfmFactor>(m.second, noise, m.first, P(j));
+  writeBinaryGraph(graph, initialCamerasAndPointsEstimate(data), binaryFile);
+}
+
+}  // namespace gtsam
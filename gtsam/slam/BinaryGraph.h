@@ -0,0 +1,214 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file   BinaryGraph.h
+ * @brief  Compact columnar binary file format for factor graphs and values
+ * @date   October 2026
+ *
+ * A binary graph file stores a NonlinearFactorGraph and its Values as
+ * little-endian columns, grouped in one section per factor or value type.
+ * Because every column is a plain, aligned array, a file can be memory-mapped
+ * and its keys, measurements and noise models read in place, without parsing.
+ *
+ * Layout, all integers little-endian:
+ *
+ *   header, 64 bytes:
+ *     char[8]  magic "GTSAMBG\0"
+ *     uint32   format version
+ *     uint32   number of sections
+ *     uint64   number of factor slots in the graph (null factors leave holes)
+ *     uint64   byte offset of the section table
+ *     zero padding
+ *   section table, 32 bytes per section:
+ *     uint32 kind (BinaryGraphSection), uint32 reserved,
+ *     uint64 number of rows, uint64 byte offset, uint64 size in bytes
+ *   sections, each starting at a multiple of 64 bytes
+ *
+ * A section is a sequence of columns, each padded to a multiple of 8 bytes:
+ *
+ *   values:      uint64 key[n], double data[n][D]
+ *   factors:     uint64 slot[n], uint64 key[n][K], uint32 noise[n],
+ *                uint32 flags[n], double data[n][D]
+ *   smart:       uint64 slot[n], uint64 offset[n+1], uint64 key[offset[n]],
+ *                uint32 noise[n], uint32 flags[n], double data[n][D],
+ *                double measured[offset[n]][2]
+ *   noise:       uint64 offset[n+1], uint32 type[n], uint32 dim[n],
+ *                double data[offset[n]]
+ *
+ * The slot column gives the position of each factor in the graph, and the
+ * noise column indexes the noise model section, so noise models shared by
+ * many factors are stored, and recreated, once.
+ */
+
+#pragma once
+
+#include <gtsam/slam/dataset.h>
+#include <gtsam/base/MappedFile.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace gtsam {
+
+/// Version written by writeBinaryGraph, newer files are rejected on reading
+static const uint32_t kBinaryGraphVersion = 1;
+
+/// Kinds of section in a binary graph file
+enum class BinaryGraphSection : uint32_t {
+  NOISE_MODELS = 1,
+  POINT2_VALUES = 16,       ///< Point2: x, y
+  POINT3_VALUES = 17,       ///< Point3: x, y, z
+  POSE2_VALUES = 18,        ///< Pose2: x, y, theta
+  POSE3_VALUES = 19,        ///< Pose3: row-major R, t
+  SFM_CAMERA_VALUES = 20,   ///< SfmCamera: row-major R, t, f, k1, k2, u0, v0
+  PRIOR_POSE2 = 32,         ///< PriorFactor<Pose2>, prior as in POSE2_VALUES
+  PRIOR_POSE3 = 33,         ///< PriorFactor<Pose3>, prior as in POSE3_VALUES
+  BETWEEN_POSE2 = 34,       ///< BetweenFactor<Pose2>, measured as POSE2_VALUES
+  BETWEEN_POSE3 = 35,       ///< BetweenFactor<Pose3>, measured as POSE3_VALUES
+  /// GenericProjectionFactor<Pose3, Point3, Cal3_S2>: u, v, fx, fy, s, u0, v0,
+  /// row-major R and t of body_P_sensor
+  PROJECTION = 36,
+  /// GeneralSFMFactor<SfmCamera, Point3>: u, v
+  SFM_PROJECTION = 37,
+  /// SmartProjectionPoseFactor<Cal3_S2>: fx, fy, s, u0, v0, row-major R and t
+  /// of body_P_sensor, retriangulationThreshold, rankTolerance,
+  /// landmarkDistanceThreshold, dynamicOutlierRejectionThreshold
+  SMART_PROJECTION = 38
+};
+
+/// Types of noise model in the noise model section
+enum class BinaryNoiseModel : uint32_t {
+  GAUSSIAN = 0,   ///< data: row-major square root information matrix R
+  DIAGONAL = 1,   ///< data: sigmas
+  ISOTROPIC = 2,  ///< data: sigma
+  UNIT = 3        ///< no data
+};
+
+/// Noise index of factors without a noise model
+static const uint32_t kNoBinaryNoiseModel = 0xFFFFFFFF;
+
+/**
+ * Bits in the flags column. Projection factors use the cheirality and sensor
+ * bits, smart factors all of them, with the linearization and degeneracy
+ * modes in the second and third byte.
+ */
+enum BinaryGraphFlags : uint32_t {
+  BINARY_THROW_CHEIRALITY = 1,
+  BINARY_VERBOSE_CHEIRALITY = 2,
+  BINARY_HAS_BODY_P_SENSOR = 4,
+  BINARY_ENABLE_EPI = 8,
+  BINARY_REUSE_LINEARIZATION = 16
+};
+
+/**
+ * Zero-copy view of one section of a binary graph file. Columns that the
+ * section kind does not have are null.
+ */
+struct GTSAM_EXPORT BinaryGraphColumns {
+  BinaryGraphSection kind;
+  size_t count = 0;             ///< number of rows
+  size_t keysPerRow = 0;        ///< keys per row, 0 for ragged key columns
+  size_t doublesPerRow = 0;     ///< width of the data column
+  const uint64_t* slots = nullptr;    ///< factor slot in the graph
+  const uint64_t* offsets = nullptr;  ///< count+1 offsets of ragged rows
+  const uint64_t* keys = nullptr;
+  const uint32_t* noise = nullptr;    ///< index into the noise model section
+  const uint32_t* flags = nullptr;
+  const double* data = nullptr;
+  const double* measured = nullptr;   ///< 2 doubles per key of ragged rows
+
+  /// Number of keys in row i
+  size_t nrKeys(size_t i) const {
+    return offsets ? offsets[i + 1] - offsets[i] : keysPerRow;
+  }
+
+  /// Keys of row i
+  const uint64_t* rowKeys(size_t i) const {
+    return keys + (offsets ? offsets[i] : i * keysPerRow);
+  }
+
+  /// Data of row i
+  const double* rowData(size_t i) const { return data + i * doublesPerRow; }
+};
+
+/// Zero-copy view of the noise model section of a binary graph file
+struct GTSAM_EXPORT BinaryNoiseModelColumns {
+  size_t count = 0;
+  const uint64_t* offsets = nullptr;  ///< count+1 offsets into data
+  const uint32_t* types = nullptr;    ///< BinaryNoiseModel of each model
+  const uint32_t* dims = nullptr;
+  const double* data = nullptr;
+};
+
+/**
+ * A binary graph file, memory-mapped and validated on construction. The
+ * column views point into the mapping and stay valid for the lifetime of the
+ * object; load() turns them into a factor graph and values.
+ */
+class GTSAM_EXPORT BinaryGraphFile {
+ public:
+  /// Map and validate filename, throws std::invalid_argument if it is not a
+  /// binary graph file or has a newer version than this build can read
+  explicit BinaryGraphFile(const std::string& filename);
+
+  /// Format version of the file
+  uint32_t version() const { return version_; }
+
+  /// Number of factor slots in the stored graph
+  size_t nrFactors() const { return nrFactors_; }
+
+  /// All value and factor sections, in file order
+  const std::vector<BinaryGraphColumns>& sections() const { return sections_; }
+
+  /// The noise models referenced by the factor sections
+  const BinaryNoiseModelColumns& noiseModels() const { return noiseModels_; }
+
+  /// Create the noise models, factors and values. Factors are created in
+  /// parallel and land in the slot they were written from.
+  GraphAndValues load() const;
+
+ private:
+  MappedFile file_;
+  uint32_t version_ = 0;
+  size_t nrFactors_ = 0;
+  std::vector<BinaryGraphColumns> sections_;
+  BinaryNoiseModelColumns noiseModels_;
+};
+
+/**
+ * Write a graph and values as a binary graph file. Throws
+ * std::invalid_argument for factor, value or noise model types the format
+ * does not cover; null factors are kept as empty slots.
+ */
+GTSAM_EXPORT void writeBinaryGraph(const NonlinearFactorGraph& graph,
+                                   const Values& values,
+                                   const std::string& filename);
+
+/// Read a binary graph file written by writeBinaryGraph
+GTSAM_EXPORT GraphAndValues readBinaryGraph(const std::string& filename);
+
+/// Convert a g2o file, as read by readG2o, to a binary graph file
+GTSAM_EXPORT void convertG2oToBinaryGraph(const std::string& g2oFile,
+                                          const std::string& binaryFile,
+                                          bool is3D = false);
+
+/**
+ * Convert a BAL file to a binary graph file with one GeneralSFMFactor per
+ * measurement, isotropic with sigma one pixel, and the initial estimate of
+ * initialCamerasAndPointsEstimate. Gauge priors are left to the reader.
+ * Throws std::invalid_argument if the BAL file can not be read.
+ */
+GTSAM_EXPORT void convertBALToBinaryGraph(const std::string& balFile,
+                                          const std::string& binaryFile);
+
+}  // namespace gtsam
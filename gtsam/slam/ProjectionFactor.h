@@ -174,6 +174,9 @@ namespace gtsam {
     /** return flag for throwing cheirality exceptions */
     inline bool throwCheirality() const { return throwCheirality_; }
 
+    /** return the pose of the sensor in the body frame, if any */
+    inline const boost::optional<POSE>& body_P_sensor() const { return body_P_sensor_; }
+
   private:
 
     /// Serialization function
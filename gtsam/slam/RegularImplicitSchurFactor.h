@@ -8,9 +8,11 @@
 #pragma once
 
 #include <gtsam/geometry/CameraSet.h>
+#include <gtsam/linear/ImplicitSchurOperator.h>
 #include <gtsam/linear/JacobianFactor.h>
 #include <gtsam/linear/VectorValues.h>
 
+#include <algorithm>
 #include <iosfwd>
 #include <map>
 #include <string>
@@ -20,9 +22,12 @@ namespace gtsam {
 
 /**
  * RegularImplicitSchurFactor
+ * With PCGSolver and the PACKED kernel, all factors of this type in a graph are
+ * packed into a single ImplicitSchurOperator.
  */
 template<class CAMERA>
-class RegularImplicitSchurFactor: public GaussianFactor {
+class RegularImplicitSchurFactor: public GaussianFactor,
+                                  public ImplicitSchurBlocks {
 
 public:
   typedef RegularImplicitSchurFactor This; ///< Typedef to this class
@@ -112,6 +117,25 @@ public:
     return D;
   }
 
+  /// @name ImplicitSchurBlocks interface
+  /// @{
+
+  int zDim() const override { return ZDim; }
+
+  int cameraDim() const override { return D; }
+
+  void packBlocks(double* F, double* E, double* P, double* b) const override {
+    typedef Eigen::Matrix<double, ZDim, 3> MatrixZ3;
+    for (size_t k = 0; k < size(); ++k) {
+      Eigen::Map<MatrixZD>(F + k * ZDim * D) = FBlocks_[k];
+      Eigen::Map<MatrixZ3>(E + k * ZDim * 3) = E_.block<ZDim, 3>(ZDim * k, 0);
+    }
+    std::copy(PointCovariance_.data(), PointCovariance_.data() + 9, P);
+    std::copy(b_.data(), b_.data() + b_.size(), b);
+  }
+
+  /// @}
+
   void updateHessian(const KeyVector& keys,
                          SymmetricBlockMatrix* info) const override {
     throw std::runtime_error(
@@ -159,6 +159,11 @@ protected:
     return measured_;
   }
 
+  /** return the isotropic measurement noise model */
+  const SharedIsotropic& noiseModel() const {
+    return noiseModel_;
+  }
+
   /// Collect all cameras: important that in key order
   virtual Cameras cameras(const Values& values) const {
     Cameras cameras;
@@ -312,6 +317,67 @@ protected:
         augmentedHessian);
   }
 
+  /**
+   * Linearize to a whitened RegularHessianFactor with fixed-size kernels: the
+   * point Jacobians are kept as ZDim*3 blocks in a thread-local workspace
+   * instead of a dynamic E, and the Schur complement is written straight into
+   * the information matrix of the new factor. Same result as
+   * computeJacobians, whitenJacobians and Cameras::SchurComplement.
+   */
+  boost::shared_ptr<RegularHessianFactor<Dim> > createFixedHessianFactor(
+      const Cameras& cameras, const Point3& point, const double lambda = 0.0,
+      bool diagonalDamping = false) const {
+    static thread_local typename Cameras::SchurBlocks blocks;
+    const size_t m = cameras.size();
+    blocks.resize(m);
+
+    // Whitened F_i, E_i and b_i = z_i - h_i(x), see computeJacobians
+    const double invSigma = 1.0 / noiseModel_->sigma();
+    boost::optional<Pose3> sensor_P_body;
+    if (body_P_sensor_) sensor_P_body = body_P_sensor_->inverse();
+    bool missing = false;
+    for (size_t i = 0; i < m; i++) {
+      MatrixZD& Fi = blocks.F[i];
+      typename Cameras::SchurBlocks::MatrixZ3& Ei = blocks.E[i];
+      typename Cameras::SchurBlocks::VectorZ& bi = blocks.b[i];
+      bi = -traits<Z>::Local(measured_[i], cameras[i].project2(point, Fi, Ei));
+      if (body_P_sensor_) {
+        Eigen::Matrix<double, Dim, Dim> J = Eigen::Matrix<double, Dim, Dim>::Zero();
+        Matrix6 H;
+        (cameras[i].pose() * *sensor_P_body).compose(*body_P_sensor_, H);
+        J.template block<6, 6>(0, 0) = H;
+        Fi = (Fi * J).eval();
+      }
+      missing = missing || bi.hasNaN();
+    }
+
+    // Let derived factors drop missing measurements, on stacked copies of E
+    // and b, as correctForMissingMeasurements expects
+    if (missing) {
+      Vector ue(ZDim * m);
+      Matrix E(ZDim * m, 3);
+      for (size_t i = 0; i < m; i++) {
+        ue.template segment<ZDim>(ZDim * i) = blocks.b[i];
+        E.template block<ZDim, 3>(ZDim * i, 0) = blocks.E[i];
+      }
+      correctForMissingMeasurements(cameras, ue, blocks.F, E);
+      for (size_t i = 0; i < m; i++) {
+        blocks.b[i] = ue.template segment<ZDim>(ZDim * i);
+        blocks.E[i] = E.template block<ZDim, 3>(ZDim * i, 0);
+      }
+    }
+
+    for (size_t i = 0; i < m; i++) {
+      blocks.F[i] *= invSigma;
+      blocks.E[i] *= invSigma;
+      blocks.b[i] *= invSigma;
+    }
+
+    auto factor = boost::make_shared<RegularHessianFactor<Dim> >(keys_);
+    Cameras::SchurComplement(blocks, lambda, diagonalDamping, factor->info());
+    return factor;
+  }
+
   /**
    * Add the contribution of the smart factor to a pre-allocated Hessian,
    * using sparse linear algebra. More efficient than the creation of the
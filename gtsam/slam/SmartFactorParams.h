@@ -50,6 +50,13 @@ struct SmartProjectionParams {
   double retriangulationThreshold; ///< threshold to decide whether to re-triangulate
   /// @}
 
+  /// @name Parameters governing the reuse of linearizations
+  /// @{
+  /// If true, linearize returns the previous linear factor when all cameras
+  /// and the damping are unchanged, up to retriangulationThreshold
+  bool reuseLinearization;
+  /// @}
+
   /// @name Parameters governing how triangulation result is treated
   /// @{
   bool throwCheirality; ///< If true, re-throws Cheirality exceptions (default: false)
@@ -61,8 +68,8 @@ struct SmartProjectionParams {
       DegeneracyMode degMode = IGNORE_DEGENERACY, bool throwCheirality = false,
       bool verboseCheirality = false, double retriangulationTh = 1e-5) :
         linearizationMode(linMode), degeneracyMode(degMode), retriangulationThreshold(
-            retriangulationTh), throwCheirality(throwCheirality), verboseCheirality(
-                verboseCheirality) {
+            retriangulationTh), reuseLinearization(false), throwCheirality(
+                throwCheirality), verboseCheirality(verboseCheirality) {
   }
 
   virtual ~SmartProjectionParams() {
@@ -93,6 +100,9 @@ struct SmartProjectionParams {
   double getRetriangulationThreshold() const {
     return retriangulationThreshold;
   }
+  bool getReuseLinearization() const {
+    return reuseLinearization;
+  }
   // set class variables
   void setLinearizationMode(LinearizationMode linMode) {
     linearizationMode = linMode;
@@ -103,6 +113,9 @@ struct SmartProjectionParams {
   void setRetriangulationThreshold(double retriangulationTh) {
     retriangulationThreshold = retriangulationTh;
   }
+  void setReuseLinearization(bool reuse) {
+    reuseLinearization = reuse;
+  }
   void setRankTolerance(double rankTol) {
     triangulation.rankTolerance = rankTol;
   }
@@ -126,6 +139,7 @@ private:
     ar & BOOST_SERIALIZATION_NVP(degeneracyMode);
     ar & BOOST_SERIALIZATION_NVP(triangulation);
     ar & BOOST_SERIALIZATION_NVP(retriangulationThreshold);
+    ar & BOOST_SERIALIZATION_NVP(reuseLinearization);
     ar & BOOST_SERIALIZATION_NVP(throwCheirality);
     ar & BOOST_SERIALIZATION_NVP(verboseCheirality);
   }
@@ -24,6 +24,7 @@
 
 #include <gtsam/geometry/triangulation.h>
 #include <gtsam/inference/Symbol.h>
+#include <gtsam/nonlinear/LinearizationCacheStats.h>
 #include <gtsam/slam/dataset.h>
 
 #include <boost/optional.hpp>
@@ -64,6 +65,13 @@ protected:
   mutable std::vector<Pose3, Eigen::aligned_allocator<Pose3> > cameraPosesTriangulation_; ///< current triangulation poses
   /// @}
 
+  /// @name Caching linearization, see SmartProjectionParams::reuseLinearization
+  /// @{
+  mutable boost::shared_ptr<GaussianFactor> linearized_; ///< last linear factor
+  mutable CameraSet<CAMERA> camerasLinearization_; ///< cameras it was computed at
+  mutable double lambdaLinearization_; ///< damping it was computed with
+  /// @}
+
 public:
 
   /// shorthand for a smart pointer to a factor
@@ -87,12 +95,18 @@ public:
       const SmartProjectionParams& params = SmartProjectionParams())
       : Base(sharedNoiseModel),
         params_(params),
-        result_(TriangulationResult::Degenerate()) {}
+        result_(TriangulationResult::Degenerate()),
+        lambdaLinearization_(0.0) {}
 
   /** Virtual destructor */
   virtual ~SmartProjectionFactor() {
   }
 
+  /// return the parameters governing triangulation and linearization
+  const SmartProjectionParams& params() const {
+    return params_;
+  }
+
   /**
    * print
    * @param s optional string naming the factor
@@ -163,6 +177,7 @@ public:
     if (retriangulate)
       result_ = gtsam::triangulateSafe(cameras, this->measured_,
           params_.triangulation);
+    LinearizationCacheStats::RecordTriangulation(!retriangulate);
     return result_;
   }
 
@@ -199,6 +214,11 @@ public:
           Gs, gs, 0.0);
     }
 
+    // Valid point: fixed-size linearization into the factor storage
+    if (result_)
+      return Base::createFixedHessianFactor(cameras, *result_, lambda,
+                                            diagonalDamping);
+
     // Jacobian could be 3D Point3 OR 2D Unit3, difference is E.cols().
     std::vector<typename Base::MatrixZD, Eigen::aligned_allocator<typename Base::MatrixZD> > Fblocks;
     Matrix E;
@@ -277,19 +297,53 @@ public:
    */
   boost::shared_ptr<GaussianFactor> linearizeDamped(const Cameras& cameras,
       const double lambda = 0.0) const {
+    if (params_.reuseLinearization && sameLinearizationPoint(cameras, lambda)) {
+      LinearizationCacheStats::RecordLinearization(true);
+      return linearized_;
+    }
+
     // depending on flag set on construction we may linearize to different linear factors
+    boost::shared_ptr<GaussianFactor> linearized;
     switch (params_.linearizationMode) {
     case HESSIAN:
-      return createHessianFactor(cameras, lambda);
+      linearized = createHessianFactor(cameras, lambda);
+      break;
     case IMPLICIT_SCHUR:
-      return createRegularImplicitSchurFactor(cameras, lambda);
+      linearized = createRegularImplicitSchurFactor(cameras, lambda);
+      break;
     case JACOBIAN_SVD:
-      return createJacobianSVDFactor(cameras, lambda);
+      linearized = createJacobianSVDFactor(cameras, lambda);
+      break;
     case JACOBIAN_Q:
-      return createJacobianQFactor(cameras, lambda);
+      linearized = createJacobianQFactor(cameras, lambda);
+      break;
     default:
       throw std::runtime_error("SmartFactorlinearize: unknown mode");
     }
+    LinearizationCacheStats::RecordLinearization(false);
+
+    if (params_.reuseLinearization) {
+      linearized_ = linearized;
+      camerasLinearization_ = cameras;
+      lambdaLinearization_ = lambda;
+    }
+    return linearized;
+  }
+
+  /**
+   * Whether the last linear factor was computed for the same damping and for
+   * cameras equal to the given ones up to retriangulationThreshold. The
+   * linear factor is then returned again, shared, by linearizeDamped.
+   */
+  bool sameLinearizationPoint(const Cameras& cameras, double lambda) const {
+    if (camerasLinearization_.empty() || lambda != lambdaLinearization_
+        || cameras.size() != camerasLinearization_.size())
+      return false;
+    for (size_t i = 0; i < cameras.size(); i++)
+      if (!traits<CAMERA>::Equals(cameras[i], camerasLinearization_[i],
+          params_.retriangulationThreshold))
+        return false;
+    return true;
   }
 
   /**
@@ -0,0 +1,293 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file   SyntheticProblems.cpp
+ * @brief  Seeded generators of large pose graph and structure from motion
+ *         problems for stress tests and benchmarks
+ * @date   October 2026
+ */
+
+#include <gtsam/slam/SyntheticProblems.h>
+#include <gtsam/slam/GeneralSFMFactor.h>
+#include <gtsam/inference/Symbol.h>
+
+#include <map>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+using namespace std;
+
+namespace gtsam {
+
+using internal::SyntheticRandom;
+
+/* ************************************************************************* */
+void generateGridPoseGraph(const GridPoseGraphParams& params,
+                           const SyntheticChunkCallback& chunk) {
+  const size_t rows = params.rows, cols = params.cols;
+  const size_t perLayer = rows * cols, n = perLayer * params.layers;
+  // Boustrophedon visiting order: rows alternate within a layer, and layers
+  // alternate the order of the rows
+  const auto index = [=](size_t l, size_t r, size_t c) {
+    const size_t row = l % 2 ? rows - 1 - r : r;
+    return l * perLayer + row * cols + (row % 2 ? cols - 1 - c : c);
+  };
+  const auto position = [=](size_t i) {
+    const size_t l = i / perLayer, row = (i % perLayer) / cols;
+    const size_t c = row % 2 ? cols - 1 - i % cols : i % cols;
+    const size_t r = l % 2 ? rows - 1 - row : row;
+    return Point3(double(c), double(r), double(l));
+  };
+
+  // Face the direction of travel in the plane of the layer
+  const auto truePose = [=](size_t i) {
+    const Point3 t = position(i);
+    Point3 d(0, 0, 0);
+    if (i + 1 < n) d = position(i + 1) - t;
+    if (d.head<2>().isZero() && i > 0) d = t - position(i - 1);
+    return Pose3(Rot3::Yaw(d.head<2>().isZero() ? 0 : std::atan2(d.y(), d.x())), t);
+  };
+
+  SyntheticRandom random(params.seed);
+  const SharedNoiseModel model = noiseModel::Diagonal::Sigmas(params.sigmas);
+  const auto measure = [&](const Pose3& a, const Pose3& b) {
+    return a.between(b) * Pose3::Expmap(random.normal(params.sigmas));
+  };
+
+  Pose3 previous, estimate;
+  for (size_t i = 0; i < n; i++) {
+    const Pose3 pose = truePose(i);
+    NonlinearFactorGraph factors;
+    Values values;
+    if (i == 0) {
+      factors.addPrior<Pose3>(0, pose, model);
+      estimate = pose;
+    } else {
+      const Pose3 odometry = measure(previous, pose);
+      factors.emplace_shared<BetweenFactor<Pose3>>(i - 1, i, odometry, model);
+      estimate = estimate * odometry;
+
+      // Loop closures to lattice neighbors visited before the previous pose
+      const Point3& t = pose.translation();
+      const size_t l = t.z(), r = t.y(), c = t.x();
+      const size_t neighbors[3] = {r > 0 ? index(l, r - 1, c) : n,
+                                   r + 1 < rows ? index(l, r + 1, c) : n,
+                                   l > 0 ? index(l - 1, r, c) : n};
+      for (size_t j : neighbors)
+        if (j + 1 < i && random.bernoulli(params.loopClosureProbability))
+          factors.emplace_shared<BetweenFactor<Pose3>>(
+              j, i, measure(truePose(j), pose), model);
+    }
+    values.insert(i, estimate);
+    chunk(factors, values);
+    previous = pose;
+  }
+}
+
+/* ************************************************************************* */
+GraphAndValues generateGridPoseGraph(const GridPoseGraphParams& params) {
+  SyntheticCollector collector;
+  generateGridPoseGraph(params, std::ref(collector));
+  return collector.result();
+}
+
+/* ************************************************************************* */
+void generateManhattanWorld(const ManhattanWorldParams& params,
+                            const SyntheticChunkCallback& chunk) {
+  SyntheticRandom random(params.seed);
+  const SharedNoiseModel model = noiseModel::Diagonal::Sigmas(params.sigmas);
+  const auto measure = [&](const Pose2& a, const Pose2& b) {
+    return a.between(b) * Pose2::Expmap(random.normal(params.sigmas));
+  };
+
+  // Index and heading of the earlier visits of each grid cell
+  const auto cell = [](int x, int y) {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) |
+           static_cast<uint32_t>(y);
+  };
+  unordered_map<uint64_t, vector<pair<size_t, int>>> visits;
+
+  int x = 0, y = 0, heading = 0;
+  Pose2 previous, estimate;
+  for (size_t i = 0; i < params.nrPoses; i++) {
+    if (i > 0) {
+      if (random.bernoulli(params.turnProbability))
+        heading = (heading + (random.bernoulli(0.5) ? 1 : 3)) % 4;
+      static const int dx[4] = {1, 0, -1, 0}, dy[4] = {0, 1, 0, -1};
+      x += dx[heading];
+      y += dy[heading];
+    }
+    const Pose2 pose(x, y, heading * M_PI / 2);
+
+    NonlinearFactorGraph factors;
+    Values values;
+    if (i == 0) {
+      factors.addPrior<Pose2>(0, pose, model);
+      estimate = pose;
+    } else {
+      const Pose2 odometry = measure(previous, pose);
+      factors.emplace_shared<BetweenFactor<Pose2>>(i - 1, i, odometry, model);
+      estimate = estimate * odometry;
+    }
+
+    auto& earlier = visits[cell(x, y)];
+    if (!earlier.empty() && random.bernoulli(params.loopClosureProbability)) {
+      const auto& visit = earlier[random.integer(0, earlier.size() - 1)];
+      const Pose2 other(x, y, visit.second * M_PI / 2);
+      factors.emplace_shared<BetweenFactor<Pose2>>(visit.first, i,
+                                                   measure(other, pose), model);
+    }
+    earlier.emplace_back(i, heading);
+
+    values.insert(i, estimate);
+    chunk(factors, values);
+    previous = pose;
+  }
+}
+
+/* ************************************************************************* */
+GraphAndValues generateManhattanWorld(const ManhattanWorldParams& params) {
+  SyntheticCollector collector;
+  generateManhattanWorld(params, std::ref(collector));
+  return collector.result();
+}
+
+/* ************************************************************************* */
+void generateSyntheticSfm(const SyntheticSfmParams& params,
+                          const SyntheticChunkCallback& chunk) {
+  if (params.minTrackLength < 2 || params.minTrackLength > params.maxTrackLength)
+    throw std::invalid_argument(
+        "generateSyntheticSfm: need 2 <= minTrackLength <= maxTrackLength");
+  using symbol_shorthand::P;
+  typedef GeneralSFMFactor<SfmCamera, Point3> SfmFactor;
+
+  const size_t length = params.streetLength;
+  const size_t nrStreets = (params.nrCameras + length - 1) / length;
+  const double spacing = 2 * params.streetWidth;
+  const double eyeHeight = 1.5;
+
+  // Streets are parallel and driven in alternating directions, so that
+  // camera i is next to camera i + 1 even across the end of a street
+  const auto x = [=](size_t s, size_t k) {
+    return s % 2 ? double(length - 1 - k) : double(k);
+  };
+  const auto direction = [](size_t s) { return s % 2 ? -1.0 : 1.0; };
+  const auto exists = [&](size_t s, size_t k) {
+    return k < length && s * length + k < params.nrCameras;
+  };
+  const auto camera = [&](size_t s, size_t k) {
+    const Point3 eye(x(s, k), s * spacing, eyeHeight);
+    return SfmCamera::Lookat(eye, eye + Point3(direction(s), 0, 0),
+                             Point3(0, 0, 1), params.calibration);
+  };
+
+  SyntheticRandom random(params.seed);
+  const SharedNoiseModel model = noiseModel::Isotropic::Sigma(2, params.pixelSigma);
+  const Vector6 poseSigmas = Vector6::Constant(params.initialSigma);
+  const Vector3 pointSigmas = Vector3::Constant(params.initialSigma);
+
+  // Tracks waiting for their last camera
+  struct Track {
+    Point3 point;
+    vector<pair<size_t, Point2>> measurements;
+  };
+  map<size_t, vector<Track>> pending;
+  size_t nrPoints = 0;
+
+  for (size_t i = 0; i < params.nrCameras; i++) {
+    const size_t s = i / length, k = i % length;
+    const SfmCamera truth = camera(s, k);
+
+    for (size_t t = 0; t < params.pointsPerCamera; t++) {
+      const size_t trackLength =
+          random.integer(params.minTrackLength, params.maxTrackLength);
+      const double side = random.bernoulli(0.5) ? 1 : -1;
+      const double ahead =
+          direction(s) * random.uniform(params.minDepth, params.maxDepth);
+      const bool rooftop = random.bernoulli(params.crossStreetProbability);
+      Track track;
+      if (rooftop)
+        track.point = Point3(x(s, k) + ahead, s * spacing + side * spacing / 2,
+                             random.uniform(params.buildingHeight,
+                                            1.5 * params.buildingHeight));
+      else
+        track.point = Point3(x(s, k) + ahead,
+                             s * spacing + side * params.streetWidth / 2,
+                             random.uniform(0, params.buildingHeight));
+
+      // Observe from the cameras k2 in [begin, end) on street s2, in driving
+      // order, from the first one that sees the point until one that does
+      // not, or the track is long enough
+      const auto observe = [&](size_t s2, size_t begin, size_t end) {
+        bool seen = false;
+        for (size_t k2 = begin; k2 < end && exists(s2, k2) &&
+                                track.measurements.size() < trackLength;
+             k2++) {
+          const SfmCamera camera2 = camera(s2, k2);
+          const Point3 q = camera2.pose().transformTo(track.point);
+          if (q.z() <= 0 || std::abs(q.x()) > q.z() || std::abs(q.y()) > q.z()) {
+            if (seen) break;
+            continue;
+          }
+          seen = true;
+          const Point2 z = camera2.project(track.point) +
+                           params.pixelSigma * Point2(random.normal(), random.normal());
+          track.measurements.emplace_back(s2 * length + k2, z);
+        }
+      };
+      const size_t window = std::ceil(params.maxDepth + spacing);
+      observe(s, k, k + window);
+
+      // Rooftop landmarks are also seen by the neighboring street on that side
+      const size_t other = side > 0 ? s + 1 : s - 1;
+      if (rooftop && (side > 0 ? s + 1 < nrStreets : s > 0)) {
+        const double px = std::min(std::max(track.point.x(), 0.0), double(length - 1));
+        const size_t k0 = other % 2 ? length - 1 - size_t(px) : size_t(px);
+        observe(other, k0 > window ? k0 - window : 0, k0 + 1);
+      }
+      if (track.measurements.size() < params.minTrackLength) continue;
+
+      // Emitted with its last camera, or this one if the others came earlier
+      size_t last = i;
+      for (const auto& measurement : track.measurements)
+        last = std::max(last, measurement.first);
+      pending[last].push_back(std::move(track));
+    }
+
+    NonlinearFactorGraph factors;
+    Values values;
+    values.insert(i, SfmCamera(truth.pose().retract(random.normal(poseSigmas)),
+                               params.calibration));
+    const auto done = pending.find(i);
+    if (done != pending.end()) {
+      for (const Track& track : done->second) {
+        const Key j = P(nrPoints++);
+        values.insert(j, Point3(track.point + random.normal(pointSigmas)));
+        for (const auto& measurement : track.measurements)
+          factors.emplace_shared<SfmFactor>(measurement.second, model,
+                                            measurement.first, j);
+      }
+      pending.erase(done);
+    }
+    chunk(factors, values);
+  }
+}
+
+/* ************************************************************************* */
+GraphAndValues generateSyntheticSfm(const SyntheticSfmParams& params) {
+  SyntheticCollector collector;
+  generateSyntheticSfm(params, std::ref(collector));
+  return collector.result();
+}
+
+}  // namespace gtsam
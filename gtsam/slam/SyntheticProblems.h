@@ -0,0 +1,204 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file   SyntheticProblems.h
+ * @brief  Seeded generators of large pose graph and structure from motion
+ *         problems for stress tests and benchmarks
+ * @date   October 2026
+ *
+ * Every generator is deterministic given its seed, and produces the problem
+ * one pose or camera at a time: each chunk holds the new variables and the
+ * factors whose last variable is among them, so chunks can be fed to ISAM2
+ * updates, written out, or collected in a single graph without ever holding
+ * more than that. The collecting overloads return the whole problem, which
+ * can be saved with writeBinaryGraph.
+ */
+
+#pragma once
+
+#include <gtsam/slam/dataset.h>
+
+#include <boost/make_shared.hpp>
+
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <random>
+
+namespace gtsam {
+
+/// Receives the factors and initial values of one chunk of a problem
+typedef std::function<void(const NonlinearFactorGraph& factors,
+                           const Values& values)> SyntheticChunkCallback;
+
+/**
+ * Pose3 graph of a robot sweeping a rows x cols x layers lattice in
+ * boustrophedon order, one unit apart. Besides odometry, each pose is
+ * connected with probability loopClosureProbability to each of its lattice
+ * neighbors in the previous row and the previous layer. Pose keys are
+ * 0, 1, ... in visiting order, the first pose has a prior, and the initial
+ * estimate composes the noisy odometry.
+ */
+struct GTSAM_EXPORT GridPoseGraphParams {
+  size_t rows = 10, cols = 10, layers = 1;
+  double loopClosureProbability = 0.5;
+  /// Measurement noise, rotation then translation
+  Vector6 sigmas = (Vector6() << 0.01, 0.01, 0.01, 0.05, 0.05, 0.05).finished();
+  uint64_t seed = 42;
+
+  GTSAM_MAKE_ALIGNED_OPERATOR_NEW
+};
+
+/// Generate a grid pose graph, calling chunk once per pose
+GTSAM_EXPORT void generateGridPoseGraph(const GridPoseGraphParams& params,
+                                        const SyntheticChunkCallback& chunk);
+
+/// Generate a grid pose graph
+GTSAM_EXPORT GraphAndValues
+generateGridPoseGraph(const GridPoseGraphParams& params);
+
+/**
+ * Pose2 graph in the style of the Manhattan world data sets (M3500): the
+ * robot moves one unit per step on an integer grid, turning left or right
+ * with probability turnProbability. Whenever it returns to a grid cell it
+ * visited before, a loop closure to one earlier visit is added with
+ * probability loopClosureProbability. Pose keys are 0, 1, ..., the first
+ * pose has a prior, and the initial estimate composes the noisy odometry.
+ */
+struct GTSAM_EXPORT ManhattanWorldParams {
+  size_t nrPoses = 3500;
+  double turnProbability = 0.3;
+  double loopClosureProbability = 0.5;
+  /// Measurement noise: x, y, theta
+  Vector3 sigmas = Vector3(0.05, 0.05, 0.01);
+  uint64_t seed = 42;
+};
+
+/// Generate a Manhattan world pose graph, calling chunk once per pose
+GTSAM_EXPORT void generateManhattanWorld(const ManhattanWorldParams& params,
+                                         const SyntheticChunkCallback& chunk);
+
+/// Generate a Manhattan world pose graph
+GTSAM_EXPORT GraphAndValues
+generateManhattanWorld(const ManhattanWorldParams& params);
+
+/**
+ * Bundle adjustment problem laid out like a city, in the BAL conventions:
+ * cameras drive along parallel streets of streetLength cameras, spaced one
+ * unit and driven in alternating directions, looking ahead at the facades
+ * on both sides of the street. Each camera starts pointsPerCamera tracks
+ * between minDepth and maxDepth ahead, with a random length in
+ * [minTrackLength, maxTrackLength], seen by the following cameras while
+ * they stay within 45 degrees of the optical axis. With probability
+ * crossStreetProbability a track is a landmark on the roofs between two
+ * streets, also seen from the neighboring street, which connects the
+ * streets. Measurements get Gaussian pixel noise. Camera keys are 0, 1, ...,
+ * point keys P(j), with one GeneralSFMFactor<SfmCamera, Point3> per
+ * measurement and no gauge prior, as in convertBALToBinaryGraph. Initial
+ * cameras and points are the ground truth perturbed by initialSigma.
+ */
+struct GTSAM_EXPORT SyntheticSfmParams {
+  size_t nrCameras = 100;
+  size_t streetLength = 50;
+  size_t pointsPerCamera = 10;
+  size_t minTrackLength = 2, maxTrackLength = 10;
+  /// Probability that a track is a rooftop landmark seen from two streets
+  double crossStreetProbability = 0.3;
+  double minDepth = 10, maxDepth = 30;
+  /// Distance between facades, which is also the width of the blocks
+  double streetWidth = 10;
+  double buildingHeight = 10;
+  Cal3Bundler calibration = Cal3Bundler(500, 0, 0, 0, 0);
+  double pixelSigma = 1.0;
+  double initialSigma = 0.01;  ///< of rotations, translations and points
+  uint64_t seed = 42;
+};
+
+/// Generate a synthetic SfM problem, calling chunk once per camera
+GTSAM_EXPORT void generateSyntheticSfm(const SyntheticSfmParams& params,
+                                       const SyntheticChunkCallback& chunk);
+
+/// Generate a synthetic SfM problem
+GTSAM_EXPORT GraphAndValues
+generateSyntheticSfm(const SyntheticSfmParams& params);
+
+namespace internal {
+/**
+ * Random numbers from mt19937_64 with the distributions computed here rather
+ * than by <random>, whose distributions differ between standard libraries:
+ * the same seed gives the same problem on every platform.
+ */
+class SyntheticRandom {
+ public:
+  explicit SyntheticRandom(uint64_t seed) : engine_(seed) {}
+
+  /// Uniform in [0, 1)
+  double uniform() { return (engine_() >> 11) * (1.0 / 9007199254740992.0); }
+
+  /// Uniform in [a, b)
+  double uniform(double a, double b) { return a + (b - a) * uniform(); }
+
+  /// Uniform integer in [a, b]
+  size_t integer(size_t a, size_t b) {
+    return a + static_cast<size_t>(uniform() * (b - a + 1));
+  }
+
+  bool bernoulli(double p) { return uniform() < p; }
+
+  /// Standard normal, by the Box-Muller transform
+  double normal() {
+    if (hasSpare_) {
+      hasSpare_ = false;
+      return spare_;
+    }
+    const double r = std::sqrt(-2.0 * std::log(1.0 - uniform()));
+    const double theta = 2.0 * M_PI * uniform();
+    spare_ = r * std::sin(theta);
+    hasSpare_ = true;
+    return r * std::cos(theta);
+  }
+
+  /// Zero-mean Gaussian vector with the given sigmas
+  template <int N>
+  Eigen::Matrix<double, N, 1> normal(const Eigen::Matrix<double, N, 1>& sigmas) {
+    Eigen::Matrix<double, N, 1> x;
+    for (int i = 0; i < N; i++) x(i) = sigmas(i) * normal();
+    return x;
+  }
+
+ private:
+  std::mt19937_64 engine_;
+  double spare_ = 0;
+  bool hasSpare_ = false;
+};
+}  // namespace internal
+
+/// Collect the chunks of a generator in one graph and values
+class SyntheticCollector {
+ public:
+  SyntheticCollector()
+      : graph_(boost::make_shared<NonlinearFactorGraph>()),
+        values_(boost::make_shared<Values>()) {}
+
+  void operator()(const NonlinearFactorGraph& factors, const Values& values) {
+    graph_->push_back(factors);
+    values_->insert(values);
+  }
+
+  GraphAndValues result() const { return GraphAndValues(graph_, values_); }
+
+ private:
+  NonlinearFactorGraph::shared_ptr graph_;
+  Values::shared_ptr values_;
+};
+
+}  // namespace gtsam
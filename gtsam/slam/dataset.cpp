@@ -22,6 +22,7 @@
 #include <gtsam/slam/BetweenFactor.h>
 #include <gtsam/slam/dataset.h>
 
+#include <gtsam/geometry/BatchProjection.h>
 #include <gtsam/geometry/Point3.h>
 #include <gtsam/geometry/Pose2.h>
 #include <gtsam/geometry/Rot3.h>
@@ -36,9 +37,11 @@
 
 #include <gtsam/base/GenericValue.h>
 #include <gtsam/base/Lie.h>
+#include <gtsam/base/MappedFile.h>
 #include <gtsam/base/Matrix.h>
 #include <gtsam/base/Value.h>
 #include <gtsam/base/Vector.h>
+#include <gtsam/base/parallelFor.h>
 #include <gtsam/base/types.h>
 
 #include <boost/assign/list_inserter.hpp>
@@ -46,10 +49,22 @@
 #include <boost/filesystem/path.hpp>
 #include <boost/optional.hpp>
 
+#include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 #include <fstream>
+#include <functional>
 #include <iostream>
+#include <iterator>
+#include <limits>
+#include <memory>
 #include <stdexcept>
+#include <typeindex>
+#include <unordered_map>
 
 using namespace std;
 namespace fs = boost::filesystem;
@@ -164,6 +179,235 @@ static vector<T> parseToVector(const string &filename, Parser<T> parse) {
   return result;
 }
 
+/* ************************************************************************* */
+// The loaders below do not go through streams: the file is mapped into memory,
+// split into chunks at line boundaries, and the chunks are scanned in parallel.
+namespace {
+
+// A run of non-blank characters
+struct Token {
+  const char *begin = nullptr, *end = nullptr;
+
+  bool operator==(const char *s) const {
+    const size_t n = strlen(s);
+    return size_t(end - begin) == n && memcmp(begin, s, n) == 0;
+  }
+  bool operator!=(const char *s) const { return !(*this == s); }
+};
+
+// Sign, decimal mantissa of at most 19 significant digits and power of ten of
+// a number. Returns false unless the whole token is a plain decimal number;
+// truncated is set if nonzero digits beyond the 19th were dropped.
+bool scanDecimal(const Token &t, bool *negative, uint64_t *mantissa,
+                 int *exponent, bool *truncated) {
+  const char *p = t.begin;
+  *negative = false;
+  if (p < t.end && (*p == '-' || *p == '+')) *negative = (*p++ == '-');
+  *mantissa = 0;
+  *exponent = 0;
+  *truncated = false;
+  int nrDigits = 0;
+  bool anyDigit = false, fraction = false;
+  for (; p < t.end; ++p) {
+    if (*p == '.' && !fraction) {
+      fraction = true;
+      continue;
+    }
+    const unsigned d = unsigned(*p - '0');
+    if (d > 9) break;
+    anyDigit = true;
+    if (nrDigits < 19) {
+      *mantissa = 10 * *mantissa + d;
+      if (*mantissa) ++nrDigits;
+      if (fraction) --*exponent;
+    } else {
+      *truncated |= (d != 0);
+      if (!fraction) ++*exponent;
+    }
+  }
+  if (anyDigit && p < t.end && (*p == 'e' || *p == 'E')) {
+    const char *q = p + 1;
+    bool negativeExponent = false;
+    if (q < t.end && (*q == '-' || *q == '+')) negativeExponent = (*q++ == '-');
+    int e = 0;
+    const char *digits = q;
+    for (; q < t.end && unsigned(*q - '0') <= 9; ++q)
+      if (e < 100000) e = 10 * e + (*q - '0');
+    if (q > digits) {
+      *exponent += negativeExponent ? -e : e;
+      p = q;
+    }
+  }
+  return anyDigit && p == t.end;
+}
+
+// Decimal to double, rounded exactly like strtod: when the decimal mantissa and
+// the power of ten are both exact doubles, a single multiplication or division
+// is exactly rounded, and anything else goes to strtod.
+bool parseDouble(const Token &t, double *x) {
+  static const double kPowers[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,
+                                   1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                                   1e12, 1e13, 1e14, 1e15, 1e16, 1e17,
+                                   1e18, 1e19, 1e20, 1e21, 1e22};
+  bool negative, truncated;
+  uint64_t mantissa;
+  int exponent;
+  if (scanDecimal(t, &negative, &mantissa, &exponent, &truncated) &&
+      !truncated && mantissa <= (uint64_t(1) << 53) && exponent >= -22 &&
+      exponent <= 22) {
+    const double m = double(mantissa);
+    *x = exponent < 0 ? m / kPowers[-exponent] : m * kPowers[exponent];
+    if (negative) *x = -*x;
+    return true;
+  }
+
+  // Long mantissas, large exponents, nan and inf
+  const string s(t.begin, t.end);
+  char *stop;
+  *x = strtod(s.c_str(), &stop);
+  return !s.empty() && stop == s.c_str() + s.size();
+}
+
+// Decimal to float, rounded exactly like strtof, i.e., like extracting a float
+// from a stream. Going through a double instead would round twice.
+bool parseFloat(const Token &t, float *x) {
+  static const float kPowers[] = {1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f,
+                                  1e6f, 1e7f, 1e8f, 1e9f, 1e10f};
+  bool negative, truncated;
+  uint64_t mantissa;
+  int exponent;
+  if (scanDecimal(t, &negative, &mantissa, &exponent, &truncated) &&
+      !truncated && mantissa <= (uint64_t(1) << 24) && exponent >= -10 &&
+      exponent <= 10) {
+    const float m = float(mantissa);
+    *x = exponent < 0 ? m / kPowers[-exponent] : m * kPowers[exponent];
+    if (negative) *x = -*x;
+    return true;
+  }
+
+  const string s(t.begin, t.end);
+  char *stop;
+  *x = strtof(s.c_str(), &stop);
+  return !s.empty() && stop == s.c_str() + s.size();
+}
+
+// Unsigned decimal integer
+bool parseIndex(const Token &t, size_t *i) {
+  const char *p = t.begin;
+  if (p < t.end && *p == '+') ++p;
+  if (p == t.end) return false;
+  size_t value = 0;
+  for (; p < t.end; ++p) {
+    const unsigned d = unsigned(*p - '0');
+    if (d > 9 || value > (std::numeric_limits<size_t>::max() - d) / 10)
+      return false;
+    value = 10 * value + d;
+  }
+  *i = value;
+  return true;
+}
+
+// Scans the tokens of a single line, with stream-like extraction: a failed
+// extraction sets the fail state, which the scanner converts to.
+class LineScanner {
+ public:
+  LineScanner(const char *begin, const char *end) : p_(begin), end_(end) {}
+
+  // Next token, false at the end of the line
+  bool next(Token *t) {
+    while (p_ < end_ && isBlank(*p_)) ++p_;
+    if (p_ == end_) return false;
+    t->begin = p_;
+    while (p_ < end_ && !isBlank(*p_)) ++p_;
+    t->end = p_;
+    return true;
+  }
+
+  LineScanner &operator>>(double &x) {
+    Token t;
+    ok_ = ok_ && next(&t) && parseDouble(t, &x);
+    return *this;
+  }
+
+  LineScanner &operator>>(size_t &i) {
+    Token t;
+    ok_ = ok_ && next(&t) && parseIndex(t, &i);
+    return *this;
+  }
+
+  explicit operator bool() const { return ok_; }
+
+ private:
+  static bool isBlank(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+  }
+
+  const char *p_, *end_;
+  bool ok_ = true;
+};
+
+// Split [begin, end) into chunks of about 1MB that end at line boundaries
+vector<pair<const char *, const char *>> splitLines(const char *begin,
+                                                     const char *end) {
+  const ptrdiff_t kChunkSize = 1 << 20;
+  vector<pair<const char *, const char *>> chunks;
+  while (begin < end) {
+    const char *stop = end - begin > kChunkSize ? begin + kChunkSize : end;
+    stop = find(stop, end, '\n');
+    if (stop != end) ++stop;
+    chunks.emplace_back(begin, stop);
+    begin = stop;
+  }
+  return chunks;
+}
+
+// Call f(token) for every token in [begin, end), line by line
+template <typename F>
+void forEachToken(const char *begin, const char *end, const F &f) {
+  while (begin < end) {
+    const char *eol =
+        static_cast<const char *>(memchr(begin, '\n', end - begin));
+    if (!eol) eol = end;
+    LineScanner line(begin, eol);
+    Token t;
+    while (line.next(&t)) f(t);
+    begin = eol == end ? end : eol + 1;
+  }
+}
+
+// Parse a file in parallel chunks, by calling parseLine(line, tag, records)
+// for every non-blank line, where tag is the first token of the line and
+// line scans the remaining ones. The records added by all lines are returned
+// in file order.
+template <typename RECORD, typename PARSE>
+vector<RECORD> parseLinesParallel(const string &filename,
+                                  const PARSE &parseLine) {
+  const MappedFile file(filename);
+  const auto chunks = splitLines(file.begin(), file.end());
+  vector<vector<RECORD>> parsed(chunks.size());
+  parallelFor(chunks.size(), [&](size_t c) {
+    const char *p = chunks[c].first, *end = chunks[c].second;
+    while (p < end) {
+      const char *eol = static_cast<const char *>(memchr(p, '\n', end - p));
+      if (!eol) eol = end;
+      LineScanner line(p, eol);
+      Token tag;
+      if (line.next(&tag)) parseLine(line, tag, parsed[c]);
+      p = eol == end ? end : eol + 1;
+    }
+  });
+
+  size_t n = 0;
+  for (const auto &records : parsed) n += records.size();
+  vector<RECORD> result;
+  result.reserve(n);
+  for (auto &records : parsed)
+    move(records.begin(), records.end(), back_inserter(result));
+  return result;
+}
+
+}  // namespace
+
 /* ************************************************************************* */
 boost::optional<IndexedPose> parseVertexPose(istream &is, const string &tag) {
   if ((tag == "VERTEX2") || (tag == "VERTEX_SE2") || (tag == "VERTEX")) {
@@ -497,53 +741,122 @@ template <> struct ParseMeasurement<BearingRange2D> {
 };
 
 /* ************************************************************************* */
+namespace {
+// A line of a 2D dataset file that load2D acts upon
+struct Line2D {
+  enum Kind { POSE, LANDMARK, EDGE, BEARING_RANGE } kind;
+  size_t id1, id2;
+  Pose2 pose;          // vertex, or relative pose of an edge
+  Point2 point;        // landmark
+  double bearing, range;
+  SharedNoiseModel model;
+};
+}  // namespace
+
 GraphAndValues load2D(const string &filename, SharedNoiseModel model,
                       size_t maxIndex, bool addNoise, bool smart,
                       NoiseFormat noiseFormat,
                       KernelFunctionType kernelFunctionType) {
-
-  // Single pass for poses and landmarks.
-  auto initial = boost::make_shared<Values>();
-  Parser<int> insert = [maxIndex, &initial](istream &is, const string &tag) {
-    if (auto indexedPose = parseVertexPose(is, tag)) {
-      if (!maxIndex || indexedPose->first <= maxIndex)
-        initial->insert(indexedPose->first, indexedPose->second);
-    } else if (auto indexedLandmark = parseVertexLandmark(is, tag)) {
-      if (!maxIndex || indexedLandmark->first <= maxIndex)
-        initial->insert(L(indexedLandmark->first), indexedLandmark->second);
+  // Parse all lines in parallel, including the noise models of the edges
+  auto parseLine = [&](LineScanner &is, const Token &tag,
+                       vector<Line2D> &lines) {
+    Line2D line;
+    if (tag == "VERTEX2" || tag == "VERTEX_SE2" || tag == "VERTEX") {
+      double x, y, yaw;
+      if (!(is >> line.id1 >> x >> y >> yaw))
+        throw std::runtime_error("parseVertexPose encountered malformed line");
+      if (maxIndex && line.id1 > maxIndex) return;
+      line.kind = Line2D::POSE;
+      line.pose = Pose2(x, y, yaw);
+    } else if (tag == "VERTEX_XY") {
+      double x, y;
+      if (!(is >> line.id1 >> x >> y))
+        throw std::runtime_error(
+            "parseVertexLandmark encountered malformed line");
+      if (maxIndex && line.id1 > maxIndex) return;
+      line.kind = Line2D::LANDMARK;
+      line.point = Point2(x, y);
+    } else if (tag == "EDGE2" || tag == "EDGE" || tag == "EDGE_SE2" ||
+               tag == "ODOMETRY") {
+      double x, y, yaw;
+      Vector6 v;
+      if (!(is >> line.id1 >> line.id2 >> x >> y >> yaw >> v(0) >> v(1) >>
+            v(2) >> v(3) >> v(4) >> v(5)))
+        throw std::runtime_error("parseEdge encountered malformed line");
+      if (maxIndex && (line.id1 > maxIndex || line.id2 > maxIndex)) return;
+      line.kind = Line2D::EDGE;
+      line.pose = Pose2(x, y, yaw);
+      auto modelFromFile =
+          createNoiseModel(v, smart, noiseFormat, kernelFunctionType);
+      line.model = model ? model : modelFromFile;
+    } else if (tag == "BR" || tag == "LANDMARK") {
+      double bearing_std, range_std;
+      if (tag == "BR") {
+        if (!(is >> line.id1 >> line.id2 >> line.bearing >> line.range >>
+              bearing_std >> range_std))
+          throw std::runtime_error("load2D encountered malformed BR line");
+      } else {
+        // A landmark measurement, converted to bearing-range, see
+        // ParseMeasurement<BearingRange2D>
+        double lmx, lmy, v1, v2, v3;
+        if (!(is >> line.id1 >> line.id2 >> lmx >> lmy >> v1 >> v2 >> v3))
+          throw std::runtime_error("load2D encountered malformed LANDMARK line");
+        line.bearing = atan2(lmy, lmx);
+        line.range = sqrt(lmx * lmx + lmy * lmy);
+        if (std::abs(v1 - v3) < 1e-4) {
+          bearing_std = sqrt(v1 / 10.0);
+          range_std = sqrt(v1);
+        } else {
+          bearing_std = 1;
+          range_std = 1;
+        }
+      }
+      if (maxIndex && line.id1 > maxIndex) return;
+      line.kind = Line2D::BEARING_RANGE;
+      line.model = noiseModel::Diagonal::Sigmas(
+          (Vector(2) << bearing_std, range_std).finished());
+    } else {
+      return;
     }
-    return 0;
+    lines.push_back(line);
   };
-  parseLines(filename, insert);
-
-  // Single pass for Pose2 and bearing-range factors.
-  auto graph = boost::make_shared<NonlinearFactorGraph>();
-
-  // Instantiate factor parser
-  ParseFactor<Pose2> parseBetweenFactor(
-      {addNoise ? createSampler(model) : nullptr, maxIndex, smart, noiseFormat,
-       kernelFunctionType, model});
+  const vector<Line2D> lines = parseLinesParallel<Line2D>(filename, parseLine);
 
-  // Instantiate bearing-range parser
-  ParseMeasurement<BearingRange2D> parseBearingRange{maxIndex};
+  // Poses and landmarks first
+  auto initial = boost::make_shared<Values>();
+  size_t nrFactors = 0;
+  for (const Line2D &line : lines) {
+    if (line.kind == Line2D::POSE)
+      initial->insert(line.id1, line.pose);
+    else if (line.kind == Line2D::LANDMARK)
+      initial->insert(L(line.id1), line.point);
+    else
+      ++nrFactors;
+  }
 
-  // Combine in a single parser that adds factors to `graph`, but also inserts
-  // new variables into `initial` when needed.
-  Parser<int> parse = [&](istream &is, const string &tag) {
-    if (auto f = parseBetweenFactor(is, tag)) {
-      graph->push_back(*f);
+  // Then Pose2 and bearing-range factors, in file order as the noise sampler
+  // and the initialization of missing variables depend on it
+  auto graph = boost::make_shared<NonlinearFactorGraph>();
+  graph->reserve(nrFactors);
+  const auto sampler = addNoise ? createSampler(model) : nullptr;
+  for (const Line2D &line : lines) {
+    if (line.kind == Line2D::EDGE) {
+      Pose2 pose = line.pose;
+      if (sampler)
+        pose = pose.retract(sampler->sample());
+      graph->emplace_shared<BetweenFactor<Pose2>>(line.id1, line.id2, pose,
+                                                  line.model);
 
       // Insert vertices if pure odometry file
-      Key key1 = (*f)->key1(), key2 = (*f)->key2();
-      if (!initial->exists(key1))
-        initial->insert(key1, Pose2());
-      if (!initial->exists(key2))
-        initial->insert(key2, initial->at<Pose2>(key1) * (*f)->measured());
-    } else if (auto m = parseBearingRange(is, tag)) {
-      Key key1 = m->key1(), key2 = m->key2();
-      BearingRange2D br = m->measured();
+      if (!initial->exists(line.id1))
+        initial->insert(line.id1, Pose2());
+      if (!initial->exists(line.id2))
+        initial->insert(line.id2, initial->at<Pose2>(line.id1) * pose);
+    } else if (line.kind == Line2D::BEARING_RANGE) {
+      const Key key1 = line.id1, key2 = L(line.id2);
+      const BearingRange2D br(line.bearing, line.range);
       graph->emplace_shared<BearingRangeFactor<Pose2, Point2>>(key1, key2, br,
-                                                               m->noiseModel());
+                                                               line.model);
 
       // Insert poses or points if they do not exist yet
       if (!initial->exists(key1))
@@ -555,10 +868,7 @@ GraphAndValues load2D(const string &filename, SharedNoiseModel model,
         initial->insert(key2, global);
       }
     }
-    return 0;
-  };
-
-  parseLines(filename, parse);
+  }
 
   return make_pair(graph, initial);
 }
@@ -629,113 +939,203 @@ GraphAndValues readG2o(const string &g2oFile, const bool is3D,
 /* ************************************************************************* */
 void writeG2o(const NonlinearFactorGraph &graph, const Values &estimate,
               const string &filename) {
-  fstream stream(filename.c_str(), fstream::out);
+  G2oWriter writer(filename, 6);
+  writer.update(graph, estimate);
+}
 
-  // Use a lambda here to more easily modify behavior in future.
-  auto index = [](gtsam::Key key) { return Symbol(key).index(); };
+/* ************************************************************************* */
+// Formatting of g2o records into the G2oWriter buffer. The writers for each
+// value and factor type are found by type in the tables below.
+namespace {
+
+class G2oRecord {
+ public:
+  G2oRecord(const char *tag, int precision, string *buffer)
+      : precision_(precision), buffer_(buffer) {
+    buffer_->append(tag);
+  }
+  ~G2oRecord() { buffer_->push_back('\n'); }
+
+  // As in writeG2o, we write the *indices* and not the full Keys
+  G2oRecord &index(Key key) {
+    char text[24];
+    const int n = snprintf(text, sizeof(text), " %llu",
+                           static_cast<unsigned long long>(Symbol(key).index()));
+    buffer_->append(text, n);
+    return *this;
+  }
 
-  // save 2D poses
-  for (const auto key_value : estimate) {
-    auto p = dynamic_cast<const GenericValue<Pose2> *>(&key_value.value);
-    if (!p)
-      continue;
-    const Pose2 &pose = p->value();
-    stream << "VERTEX_SE2 " << index(key_value.key) << " " << pose.x() << " "
-           << pose.y() << " " << pose.theta() << endl;
+  // Same output as operator<< with the stream precision set to precision_
+  G2oRecord &operator<<(double x) {
+    char text[32];
+    const int n = snprintf(text, sizeof(text), " %.*g", precision_, x);
+    buffer_->append(text, n);
+    return *this;
   }
 
-  // save 3D poses
-  for (const auto key_value : estimate) {
-    auto p = dynamic_cast<const GenericValue<Pose3> *>(&key_value.value);
-    if (!p)
-      continue;
-    const Pose3 &pose = p->value();
-    const Point3 t = pose.translation();
-    const auto q = pose.rotation().toQuaternion();
-    stream << "VERTEX_SE3:QUAT " << index(key_value.key) << " " << t.x() << " "
-           << t.y() << " " << t.z() << " " << q.x() << " " << q.y() << " "
-           << q.z() << " " << q.w() << endl;
+  G2oRecord &quaternion(const Rot3 &R) {
+    const auto q = R.toQuaternion();
+    return *this << q.x() << q.y() << q.z() << q.w();
   }
 
-  // save 2D landmarks
-  for (const auto key_value : estimate) {
-    auto p = dynamic_cast<const GenericValue<Point2> *>(&key_value.value);
-    if (!p)
-      continue;
-    const Point2 &point = p->value();
-    stream << "VERTEX_XY " << index(key_value.key) << " " << point.x() << " "
-           << point.y() << endl;
+  // Upper triangle of the information matrix of a Gaussian noise model, after
+  // reordering it with reorder(info)
+  template <int N, typename REORDER>
+  G2oRecord &information(const SharedNoiseModel &model,
+                         const REORDER &reorder) {
+    auto gaussian = boost::dynamic_pointer_cast<noiseModel::Gaussian>(model);
+    if (!gaussian) {
+      model->print("model\n");
+      throw invalid_argument("writeG2o: invalid noise model!");
+    }
+    const Matrix R = gaussian->R();
+    const Eigen::Matrix<double, N, N> info = reorder(R.transpose() * R);
+    for (size_t i = 0; i < N; i++)
+      for (size_t j = i; j < N; j++) *this << info(i, j);
+    return *this;
   }
 
-  // save 3D landmarks
-  for (const auto key_value : estimate) {
-    auto p = dynamic_cast<const GenericValue<Point3> *>(&key_value.value);
-    if (!p)
-      continue;
-    const Point3 &point = p->value();
-    stream << "VERTEX_TRACKXYZ " << index(key_value.key) << " " << point.x()
-           << " " << point.y() << " " << point.z() << endl;
+  template <int N>
+  G2oRecord &information(const SharedNoiseModel &model) {
+    return information<N>(model, [](const Matrix &info) { return info; });
   }
 
-  // save edges (2D or 3D)
-  for (const auto &factor_ : graph) {
-    auto factor = boost::dynamic_pointer_cast<BetweenFactor<Pose2>>(factor_);
-    if (factor) {
-      SharedNoiseModel model = factor->noiseModel();
-      auto gaussianModel =
-          boost::dynamic_pointer_cast<noiseModel::Gaussian>(model);
-      if (!gaussianModel) {
-        model->print("model\n");
-        throw invalid_argument("writeG2o: invalid noise model!");
-      }
-      Matrix3 Info = gaussianModel->R().transpose() * gaussianModel->R();
-      Pose2 pose = factor->measured(); //.inverse();
-      stream << "EDGE_SE2 " << index(factor->key1()) << " "
-             << index(factor->key2()) << " " << pose.x() << " " << pose.y()
-             << " " << pose.theta();
-      for (size_t i = 0; i < 3; i++) {
-        for (size_t j = i; j < 3; j++) {
-          stream << " " << Info(i, j);
-        }
-      }
-      stream << endl;
-    }
+ private:
+  int precision_;
+  string *buffer_;
+};
 
-    auto factor3D = boost::dynamic_pointer_cast<BetweenFactor<Pose3>>(factor_);
+typedef void (*G2oValueWriter)(const Value &, Key, int, string *);
+typedef void (*G2oFactorWriter)(const NonlinearFactor &, int, string *);
 
-    if (factor3D) {
-      SharedNoiseModel model = factor3D->noiseModel();
+void writeVertexSE2(const Value &value, Key key, int precision, string *out) {
+  const Pose2 &pose = static_cast<const GenericValue<Pose2> &>(value).value();
+  G2oRecord("VERTEX_SE2", precision, out).index(key)
+      << pose.x() << pose.y() << pose.theta();
+}
 
-      boost::shared_ptr<noiseModel::Gaussian> gaussianModel =
-          boost::dynamic_pointer_cast<noiseModel::Gaussian>(model);
-      if (!gaussianModel) {
-        model->print("model\n");
-        throw invalid_argument("writeG2o: invalid noise model!");
-      }
-      Matrix6 Info = gaussianModel->R().transpose() * gaussianModel->R();
-      const Pose3 pose3D = factor3D->measured();
-      const Point3 p = pose3D.translation();
-      const auto q = pose3D.rotation().toQuaternion();
-      stream << "EDGE_SE3:QUAT " << index(factor3D->key1()) << " "
-             << index(factor3D->key2()) << " " << p.x() << " " << p.y() << " "
-             << p.z() << " " << q.x() << " " << q.y() << " " << q.z() << " "
-             << q.w();
-
-      Matrix6 InfoG2o = I_6x6;
-      InfoG2o.block<3, 3>(0, 0) = Info.block<3, 3>(3, 3); // cov translation
-      InfoG2o.block<3, 3>(3, 3) = Info.block<3, 3>(0, 0); // cov rotation
-      InfoG2o.block<3, 3>(0, 3) = Info.block<3, 3>(0, 3); // off diagonal
-      InfoG2o.block<3, 3>(3, 0) = Info.block<3, 3>(3, 0); // off diagonal
-
-      for (size_t i = 0; i < 6; i++) {
-        for (size_t j = i; j < 6; j++) {
-          stream << " " << InfoG2o(i, j);
-        }
+void writeVertexSE3(const Value &value, Key key, int precision, string *out) {
+  const Pose3 &pose = static_cast<const GenericValue<Pose3> &>(value).value();
+  (G2oRecord("VERTEX_SE3:QUAT", precision, out).index(key)
+   << pose.x() << pose.y() << pose.z())
+      .quaternion(pose.rotation());
+}
+
+void writeVertexXY(const Value &value, Key key, int precision, string *out) {
+  const Point2 &point = static_cast<const GenericValue<Point2> &>(value).value();
+  G2oRecord("VERTEX_XY", precision, out).index(key) << point.x() << point.y();
+}
+
+void writeVertexXYZ(const Value &value, Key key, int precision, string *out) {
+  const Point3 &point = static_cast<const GenericValue<Point3> &>(value).value();
+  G2oRecord("VERTEX_TRACKXYZ", precision, out).index(key)
+      << point.x() << point.y() << point.z();
+}
+
+void writeEdgeSE2(const NonlinearFactor &f, int precision, string *out) {
+  const auto &factor = static_cast<const BetweenFactor<Pose2> &>(f);
+  const Pose2 &pose = factor.measured();
+  (G2oRecord("EDGE_SE2", precision, out).index(factor.key1()).index(
+       factor.key2())
+   << pose.x() << pose.y() << pose.theta())
+      .information<3>(factor.noiseModel());
+}
+
+void writeEdgeSE3(const NonlinearFactor &f, int precision, string *out) {
+  const auto &factor = static_cast<const BetweenFactor<Pose3> &>(f);
+  const Pose3 &pose = factor.measured();
+  // g2o orders the information matrix as translation, then rotation
+  const auto toG2o = [](const Matrix &info) {
+    Matrix6 infoG2o;
+    infoG2o << info.block<3, 3>(3, 3), info.block<3, 3>(0, 3),
+        info.block<3, 3>(3, 0), info.block<3, 3>(0, 0);
+    return infoG2o;
+  };
+  (G2oRecord("EDGE_SE3:QUAT", precision, out).index(factor.key1()).index(
+       factor.key2())
+   << pose.x() << pose.y() << pose.z())
+      .quaternion(pose.rotation())
+      .information<6>(factor.noiseModel(), toG2o);
+}
+
+// Vertices are written grouped by type, in the order of this table
+const vector<pair<type_index, G2oValueWriter>> &g2oValueWriters() {
+  static const vector<pair<type_index, G2oValueWriter>> writers = {
+      {typeid(GenericValue<Pose2>), writeVertexSE2},
+      {typeid(GenericValue<Pose3>), writeVertexSE3},
+      {typeid(GenericValue<Point2>), writeVertexXY},
+      {typeid(GenericValue<Point3>), writeVertexXYZ}};
+  return writers;
+}
+
+const unordered_map<type_index, G2oFactorWriter> &g2oFactorWriters() {
+  static const unordered_map<type_index, G2oFactorWriter> writers = {
+      {typeid(BetweenFactor<Pose2>), writeEdgeSE2},
+      {typeid(BetweenFactor<Pose3>), writeEdgeSE3}};
+  return writers;
+}
+
+}  // namespace
+
+/* ************************************************************************* */
+G2oWriter::G2oWriter(const string &filename, int precision)
+    : stream_(new ofstream(filename.c_str(), ios::out)),
+      precision_(precision) {
+  if (!*stream_)
+    throw invalid_argument("G2oWriter: can not open " + filename);
+}
+
+/* ************************************************************************* */
+G2oWriter::~G2oWriter() { flush(); }
+
+/* ************************************************************************* */
+void G2oWriter::update(const NonlinearFactorGraph &graph,
+                       const Values &values) {
+  static const size_t kBufferSize = 1 << 20;
+  const auto drain = [this]() {
+    if (buffer_.size() >= kBufferSize) {
+      stream_->write(buffer_.data(), buffer_.size());
+      buffer_.clear();
+    }
+  };
+
+  // New values, grouped by type
+  const auto &valueWriters = g2oValueWriters();
+  vector<vector<Values::ConstKeyValuePair>> newValues(valueWriters.size());
+  for (const auto key_value : values) {
+    if (!exportedKeys_.insert(key_value.key).second) continue;
+    const type_index type = typeid(key_value.value);
+    for (size_t k = 0; k < valueWriters.size(); k++)
+      if (valueWriters[k].first == type) {
+        newValues[k].push_back(key_value);
+        break;
       }
-      stream << endl;
+  }
+  for (size_t k = 0; k < valueWriters.size(); k++)
+    for (const auto &key_value : newValues[k]) {
+      valueWriters[k].second(key_value.value, key_value.key, precision_,
+                             &buffer_);
+      drain();
     }
+
+  // Factors in new slots
+  const auto &factorWriters = g2oFactorWriters();
+  for (size_t i = nrFactorSlots_; i < graph.size(); i++) {
+    if (!graph[i]) continue;
+    const NonlinearFactor &factor = *graph[i];
+    const auto it = factorWriters.find(typeid(factor));
+    if (it == factorWriters.end()) continue;
+    it->second(factor, precision_, &buffer_);
+    drain();
   }
-  stream.close();
+  nrFactorSlots_ = max(nrFactorSlots_, graph.size());
+}
+
+/* ************************************************************************* */
+void G2oWriter::flush() {
+  stream_->write(buffer_.data(), buffer_.size());
+  stream_->flush();
+  buffer_.clear();
 }
 
 /* ************************************************************************* */
@@ -921,26 +1321,111 @@ parseFactors<Pose3>(const std::string &filename,
 }
 
 /* ************************************************************************* */
+namespace {
+// A line of a 3D dataset file that load3D acts upon
+struct Line3D {
+  enum Kind { POSE, POINT, FACTOR } kind;
+  size_t id;
+  Pose3 pose;
+  Point3 point;
+  NonlinearFactor::shared_ptr factor;
+};
+
+// Symmetric information matrix, of which the upper triangle is stored
+bool readInformation(LineScanner &is, Matrix6 *m) {
+  for (size_t i = 0; i < 6; i++)
+    for (size_t j = i; j < 6; j++) {
+      if (!(is >> (*m)(i, j))) return false;
+      (*m)(j, i) = (*m)(i, j);
+    }
+  return true;
+}
+
+// Unit quaternion from x, y, z, w
+bool readQuaternion(LineScanner &is, Quaternion *q) {
+  double x, y, z, w;
+  if (!(is >> x >> y >> z >> w)) return false;
+  const double norm = sqrt(w * w + x * x + y * y + z * z), f = 1.0 / norm;
+  *q = Quaternion(f * w, f * x, f * y, f * z);
+  return true;
+}
+}  // namespace
+
 GraphAndValues load3D(const string &filename) {
-  auto graph = boost::make_shared<NonlinearFactorGraph>();
-  auto initial = boost::make_shared<Values>();
+  // Parse all lines in parallel, including the factors and their noise models
+  auto parseLine = [](LineScanner &is, const Token &tag,
+                      vector<Line3D> &lines) {
+    Line3D line;
+    double x, y, z;
+    if (tag == "VERTEX3") {
+      double roll, pitch, yaw;
+      if (!(is >> line.id >> x >> y >> z >> roll >> pitch >> yaw))
+        throw std::runtime_error("load3D encountered malformed VERTEX3 line");
+      line.kind = Line3D::POSE;
+      line.pose = Pose3(Rot3::Ypr(yaw, pitch, roll), Point3(x, y, z));
+    } else if (tag == "VERTEX_SE3:QUAT") {
+      Quaternion q;
+      if (!(is >> line.id >> x >> y >> z) || !readQuaternion(is, &q))
+        throw std::runtime_error(
+            "load3D encountered malformed VERTEX_SE3:QUAT line");
+      line.kind = Line3D::POSE;
+      line.pose = Pose3(Rot3(q), Point3(x, y, z));
+    } else if (tag == "VERTEX_TRACKXYZ") {
+      if (!(is >> line.id >> x >> y >> z))
+        throw std::runtime_error(
+            "load3D encountered malformed VERTEX_TRACKXYZ line");
+      line.kind = Line3D::POINT;
+      line.point = Point3(x, y, z);
+    } else if (tag == "EDGE3") {
+      size_t id1, id2;
+      double roll, pitch, yaw;
+      Matrix6 m;
+      if (!(is >> id1 >> id2 >> x >> y >> z >> roll >> pitch >> yaw) ||
+          !readInformation(is, &m))
+        throw std::runtime_error("load3D encountered malformed EDGE3 line");
+      line.kind = Line3D::FACTOR;
+      line.factor = boost::make_shared<BetweenFactor<Pose3>>(
+          id1, id2, Pose3(Rot3::Ypr(yaw, pitch, roll), Point3(x, y, z)),
+          noiseModel::Gaussian::Information(m));
+    } else if (tag == "EDGE_SE3:QUAT") {
+      size_t id1, id2;
+      Quaternion q;
+      Matrix6 m;
+      if (!(is >> id1 >> id2 >> x >> y >> z) || !readQuaternion(is, &q) ||
+          !readInformation(is, &m))
+        throw std::runtime_error(
+            "load3D encountered malformed EDGE_SE3:QUAT line");
 
-  // Instantiate factor parser. maxIndex is always zero for load3D.
-  ParseFactor<Pose3> parseFactor({nullptr, 0});
-
-  // Single pass for variables and factors. Unlike 2D version, does *not* insert
-  // variables into `initial` if referenced but not present.
-  Parser<int> parse = [&](istream &is, const string &tag) {
-    if (auto indexedPose = parseVertexPose3(is, tag)) {
-      initial->insert(indexedPose->first, indexedPose->second);
-    } else if (auto indexedLandmark = parseVertexPoint3(is, tag)) {
-      initial->insert(L(indexedLandmark->first), indexedLandmark->second);
-    } else if (auto factor = parseFactor(is, tag)) {
-      graph->push_back(*factor);
+      // EDGE_SE3:QUAT stores information in t,R order, unlike GTSAM:
+      Matrix6 mgtsam;
+      mgtsam.block<3, 3>(0, 0) = m.block<3, 3>(3, 3);
+      mgtsam.block<3, 3>(3, 3) = m.block<3, 3>(0, 0);
+      mgtsam.block<3, 3>(0, 3) = m.block<3, 3>(0, 3);
+      mgtsam.block<3, 3>(3, 0) = m.block<3, 3>(3, 0);
+      line.kind = Line3D::FACTOR;
+      line.factor = boost::make_shared<BetweenFactor<Pose3>>(
+          id1, id2, Pose3(Rot3(q), Point3(x, y, z)),
+          noiseModel::Gaussian::Information(mgtsam));
+    } else {
+      return;
     }
-    return 0;
+    lines.push_back(line);
   };
-  parseLines(filename, parse);
+  const vector<Line3D> lines = parseLinesParallel<Line3D>(filename, parseLine);
+
+  // Unlike the 2D version, does *not* insert variables into `initial` if
+  // referenced but not present.
+  auto graph = boost::make_shared<NonlinearFactorGraph>();
+  auto initial = boost::make_shared<Values>();
+  graph->reserve(lines.size());
+  for (const Line3D &line : lines) {
+    if (line.kind == Line3D::POSE)
+      initial->insert(line.id, line.pose);
+    else if (line.kind == Line3D::POINT)
+      initial->insert(L(line.id), line.point);
+    else
+      graph->push_back(line.factor);
+  }
 
   return make_pair(graph, initial);
 }
@@ -982,6 +1467,36 @@ Pose3 gtsam2openGL(const Pose3 &PoseGTSAM) {
                       PoseGTSAM.z());
 }
 
+/* ************************************************************************* */
+double totalReprojectionError(const SfmData &data) {
+  // Group the measurements by camera, as (track, measured) pairs
+  const size_t M = data.number_cameras();
+  vector<vector<pair<size_t, Point2>>> seen(M);
+  for (size_t j = 0; j < data.number_tracks(); j++)
+    for (const SfmMeasurement &m : data.tracks[j].measurements)
+      seen.at(m.first).emplace_back(j, m.second);
+
+  // Project the points seen by each camera in one batch
+  vector<double> errors(M, 0.0);
+  parallelFor(M, [&](size_t i) {
+    const size_t N = seen[i].size();
+    BatchProjector<Cal3Bundler> projector;
+    projector.add(data.cameras[i].pose(), data.cameras[i].calibration());
+    BatchProjector<Cal3Bundler>::Points points(N, 3);
+    for (size_t k = 0; k < N; k++)
+      points.row(k) = data.tracks[seen[i][k].first].p;
+    BatchProjection projections;
+    projector.project(points, projections, false);
+    for (size_t k = 0; k < N; k++)
+      errors[i] +=
+          (projections.measured(0, k) - seen[i][k].second).squaredNorm();
+  });
+
+  double error = 0.0;
+  for (double e : errors) error += e;
+  return 0.5 * error;
+}
+
 /* ************************************************************************* */
 bool readBundler(const string &filename, SfmData &data) {
   // Load the data file
@@ -1071,61 +1586,112 @@ bool readBundler(const string &filename, SfmData &data) {
 
 /* ************************************************************************* */
 bool readBAL(const string &filename, SfmData &data) {
-  // Load the data file
-  ifstream is(filename.c_str(), ifstream::in);
-  if (!is) {
+  std::unique_ptr<MappedFile> file;
+  try {
+    file.reset(new MappedFile(filename));
+  } catch (const invalid_argument &) {
     cout << "Error in readBAL: can not find the file!!" << endl;
     return false;
   }
 
-  // Get the number of camera poses and 3D points
+  // Get the number of camera poses, 3D points and observations
+  const char *header = file->begin();
+  const char *eol = find(header, file->end(), '\n');
   size_t nrPoses, nrPoints, nrObservations;
-  is >> nrPoses >> nrPoints >> nrObservations;
-
-  data.tracks.resize(nrPoints);
-
-  // Get the information for the observations
-  for (size_t k = 0; k < nrObservations; k++) {
-    size_t i = 0, j = 0;
-    float u, v;
-    is >> i >> j >> u >> v;
-    data.tracks[j].measurements.emplace_back(i, Point2(u, -v));
+  if (!(LineScanner(header, eol) >> nrPoses >> nrPoints >> nrObservations)) {
+    cout << "Error in readBAL: missing header" << endl;
+    return false;
   }
 
-  // Get the information for the camera poses
-  for (size_t i = 0; i < nrPoses; i++) {
-    // Get the Rodrigues vector
-    float wx, wy, wz;
-    is >> wx >> wy >> wz;
-    Rot3 R = Rot3::Rodrigues(wx, wy, wz); // BAL-OpenGL rotation matrix
-
-    // Get the translation vector
-    float tx, ty, tz;
-    is >> tx >> ty >> tz;
-
-    Pose3 pose = openGL2gtsam(R, tx, ty, tz);
-
-    // Get the focal length and the radial distortion parameters
-    float f, k1, k2;
-    is >> f >> k1 >> k2;
-    Cal3Bundler K(f, k1, k2);
-
-    data.cameras.emplace_back(pose, K);
+  // Count the numbers in every chunk, in parallel, so that each number knows
+  // its place in the file before any of them is parsed
+  const auto chunks = splitLines(eol, file->end());
+  vector<size_t> offsets(chunks.size() + 1, 0);
+  parallelFor(chunks.size(), [&](size_t c) {
+    size_t n = 0;
+    forEachToken(chunks[c].first, chunks[c].second,
+                 [&n](const Token &) { ++n; });
+    offsets[c + 1] = n;
+  });
+  for (size_t c = 0; c < chunks.size(); c++) offsets[c + 1] += offsets[c];
+  const size_t total = offsets.back();
+  if (nrObservations > total / 4 || nrPoses > total / 9 ||
+      nrPoints > total / 3 ||
+      4 * nrObservations + 9 * nrPoses + 3 * nrPoints > total) {
+    cout << "Error in readBAL: file is truncated" << endl;
+    return false;
   }
 
-  // Get the information for the 3D points
+  // Parse every number straight into its destination, in parallel. Values
+  // are rounded to float, as in the original BAL reader.
+  struct Observation {
+    size_t camera, point;
+    float u, v;
+  };
+  vector<Observation> observations(nrObservations);
+  vector<float> poses(9 * nrPoses);
+  data.tracks.resize(nrPoints);
+  const size_t posesBegin = 4 * nrObservations,
+               pointsBegin = posesBegin + 9 * nrPoses,
+               pointsEnd = pointsBegin + 3 * nrPoints;
+  std::atomic<bool> malformed(false);
+  parallelFor(chunks.size(), [&](size_t c) {
+    size_t k = offsets[c];
+    forEachToken(chunks[c].first, chunks[c].second, [&](const Token &t) {
+      bool ok = true;
+      if (k < posesBegin) {
+        Observation &o = observations[k / 4];
+        switch (k % 4) {
+          case 0: ok = parseIndex(t, &o.camera); break;
+          case 1: ok = parseIndex(t, &o.point); break;
+          case 2: ok = parseFloat(t, &o.u); break;
+          default: ok = parseFloat(t, &o.v);
+        }
+      } else if (k < pointsBegin) {
+        ok = parseFloat(t, &poses[k - posesBegin]);
+      } else if (k < pointsEnd) {
+        float x;
+        ok = parseFloat(t, &x);
+        data.tracks[(k - pointsBegin) / 3].p((k - pointsBegin) % 3) = x;
+      }
+      if (!ok) malformed = true;
+      ++k;
+    });
+  });
+  if (malformed)
+    throw std::runtime_error("readBAL encountered malformed number");
+
+  // Add the observations to the tracks, reserving all tracks first
+  vector<size_t> trackLength(nrPoints, 0);
+  for (const Observation &o : observations) {
+    if (o.point >= nrPoints) {
+      cout << "Error in readBAL: point index out of range" << endl;
+      return false;
+    }
+    ++trackLength[o.point];
+  }
   for (size_t j = 0; j < nrPoints; j++) {
-    // Get the 3D position
-    float x, y, z;
-    is >> x >> y >> z;
     SfmTrack &track = data.tracks[j];
-    track.p = Point3(x, y, z);
+    track.measurements.reserve(track.measurements.size() + trackLength[j]);
     track.r = 0.4f;
     track.g = 0.4f;
     track.b = 0.4f;
   }
+  for (const Observation &o : observations)
+    data.tracks[o.point].measurements.emplace_back(o.camera, Point2(o.u, -o.v));
+
+  // Get the information for the camera poses, in parallel
+  const size_t firstCamera = data.cameras.size();
+  data.cameras.resize(firstCamera + nrPoses);
+  parallelFor(nrPoses, [&](size_t i) {
+    const float *c = poses.data() + 9 * i;
+
+    // Rodrigues vector, translation, focal length and radial distortion
+    Rot3 R = Rot3::Rodrigues(c[0], c[1], c[2]); // BAL-OpenGL rotation matrix
+    Pose3 pose = openGL2gtsam(R, c[3], c[4], c[5]);
+    data.cameras[firstCamera + i] = SfmCamera(pose, Cal3Bundler(c[6], c[7], c[8]));
+  });
 
-  is.close();
   return true;
 }
 
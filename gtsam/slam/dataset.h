@@ -37,6 +37,7 @@
 #include <vector>
 #include <iosfwd>
 #include <map>
+#include <memory>
 
 namespace gtsam {
 
@@ -156,6 +157,8 @@ GTSAM_EXPORT GraphAndValues load2D(
 
 /**
  * Load TORO/G2O style graph files
+ * The file is mapped into memory and its lines are parsed in parallel chunks,
+ * the graph is then assembled in file order.
  * @param filename
  * @param model optional noise model to use instead of one specified by file
  * @param maxIndex if non-zero cut out vertices >= maxIndex
@@ -205,7 +208,61 @@ GTSAM_EXPORT GraphAndValues readG2o(const std::string& g2oFile, const bool is3D
 GTSAM_EXPORT void writeG2o(const NonlinearFactorGraph& graph,
     const Values& estimate, const std::string& filename);
 
-/// Load TORO 3D Graph
+/**
+ * Append-only g2o exporter for a growing graph, e.g. the factors and
+ * linearization point of an ISAM2 instance. Each call to update writes only
+ * the values whose keys were not exported before and the factors in slots
+ * past the last exported one. Factors cost time proportional to what was
+ * added, but finding the new values takes a lookup of every key in values.
+ * Records are formatted as in writeG2o into an in-memory buffer that goes to
+ * the file when it fills up, on flush, and on destruction.
+ *
+ * Factors are identified by their slot in the graph: removed factors (null
+ * slots) are never written, and slots reused for new factors, as ISAM2 does
+ * with ISAM2Params::findUnusedFactorSlots, are not seen. Values are written
+ * once, with the estimate they have when first exported.
+ */
+class GTSAM_EXPORT G2oWriter {
+ public:
+  /**
+   * Create or truncate filename
+   * @param precision significant digits of the numbers written; writeG2o uses
+   * 6, the default of std::ostream
+   */
+  explicit G2oWriter(const std::string& filename, int precision = 17);
+
+  /// Flushes the buffered records
+  ~G2oWriter();
+
+  G2oWriter(const G2oWriter&) = delete;
+  G2oWriter& operator=(const G2oWriter&) = delete;
+
+  /**
+   * Format the values and factors added since the last update: vertices of
+   * types Pose2, Pose3, Point2 and Point3, in that order, then edges for
+   * BetweenFactor<Pose2> and BetweenFactor<Pose3> in graph order. Other types
+   * are skipped, as in writeG2o.
+   */
+  void update(const NonlinearFactorGraph& graph, const Values& values);
+
+  /// Write the buffered records to the file
+  void flush();
+
+  /// Number of graph slots exported so far
+  size_t nrFactorSlots() const { return nrFactorSlots_; }
+
+  /// Number of values exported so far
+  size_t nrValues() const { return exportedKeys_.size(); }
+
+ private:
+  std::unique_ptr<std::ofstream> stream_;
+  std::string buffer_;
+  int precision_;
+  size_t nrFactorSlots_ = 0;
+  KeySet exportedKeys_;
+};
+
+/// Load TORO 3D Graph, parsing the lines in parallel chunks as load2D does
 GTSAM_EXPORT GraphAndValues load3D(const std::string& filename);
 
 /// A measurement with its camera index
@@ -262,6 +319,15 @@ struct SfmData {
   }
 };
 
+/**
+ * @brief Sum of squared reprojection errors of all measurements in a SfmData
+ * structure, halved as in SmartFactorBase::totalReprojectionError. The points
+ * seen by each camera are projected in one batch with a BatchProjector.
+ * @param data SfM structure with cameras, points and measurements
+ * @return 0.5 * sum of |camera.project(p) - measured|^2
+ */
+GTSAM_EXPORT double totalReprojectionError(const SfmData &data);
+
 /**
  * @brief This function parses a bundler output file and stores the data into a
  * SfmData structure
@@ -273,7 +339,8 @@ GTSAM_EXPORT bool readBundler(const std::string& filename, SfmData &data);
 
 /**
  * @brief This function parses a "Bundle Adjustment in the Large" (BAL) file and stores the data into a
- * SfmData structure
+ * SfmData structure. The numbers are parsed in parallel chunks, and the
+ * cameras are then converted in parallel.
  * @param filename The name of the BAL file
  * @param data SfM structure where the data is stored
  * @return true if the parsing was successful, false otherwise
@@ -0,0 +1,226 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    testBinaryGraph.cpp
+ * @brief   Unit tests for the binary graph file format
+ * @date    October 2026
+ */
+
+#include <gtsam/slam/BinaryGraph.h>
+#include <gtsam/slam/BetweenFactor.h>
+#include <gtsam/slam/GeneralSFMFactor.h>
+#include <gtsam/slam/ProjectionFactor.h>
+#include <gtsam/slam/SmartProjectionPoseFactor.h>
+#include <gtsam/nonlinear/PriorFactor.h>
+#include <gtsam/inference/Symbol.h>
+#include <gtsam/base/TestableAssertions.h>
+
+#include <boost/filesystem/operations.hpp>
+
+#include <CppUnitLite/TestHarness.h>
+
+#include <fstream>
+
+using namespace std;
+using namespace gtsam;
+using symbol_shorthand::L;
+using symbol_shorthand::X;
+
+static string temporaryFile(const string& name) {
+  return (boost::filesystem::temp_directory_path() / name).string();
+}
+
+/* ************************************************************************* */
+TEST(BinaryGraph, g2oRoundTrip) {
+  for (bool is3D : {false, true}) {
+    const string g2oFile =
+        findExampleDataFile(is3D ? "pose3example.txt" : "noisyToyGraph.txt");
+    const string binaryFile = temporaryFile("testBinaryGraphG2o.bin");
+    convertG2oToBinaryGraph(g2oFile, binaryFile, is3D);
+
+    NonlinearFactorGraph::shared_ptr expectedGraph, actualGraph;
+    Values::shared_ptr expectedValues, actualValues;
+    boost::tie(expectedGraph, expectedValues) = readG2o(g2oFile, is3D);
+    boost::tie(actualGraph, actualValues) = readBinaryGraph(binaryFile);
+    EXPECT(assert_equal(*expectedValues, *actualValues));
+    EXPECT(assert_equal(*expectedGraph, *actualGraph, 1e-9));
+  }
+}
+
+/* ************************************************************************* */
+TEST(BinaryGraph, FactorTypes) {
+  const auto K = boost::make_shared<Cal3_S2>(500, 510, 0.1, 320, 240);
+  const Pose3 body_P_sensor(Rot3::Ypr(0.1, 0.2, 0.3), Point3(0.1, 0, 0.2));
+  const SharedNoiseModel pixel = noiseModel::Isotropic::Sigma(2, 1.5);
+  const SharedNoiseModel diagonal =
+      noiseModel::Diagonal::Sigmas(Vector3(0.1, 0.2, 0.3));
+  Matrix6 R = 10 * I_6x6;
+  R(0, 5) = 1;
+
+  NonlinearFactorGraph graph;
+  graph.emplace_shared<PriorFactor<Pose2>>(X(0), Pose2(1, 2, 0.3), diagonal);
+  graph.emplace_shared<BetweenFactor<Pose2>>(X(0), X(1), Pose2(1, 0, 0.1),
+                                             diagonal);
+  graph.push_back(NonlinearFactor::shared_ptr());  // null slot
+  graph.emplace_shared<PriorFactor<Pose3>>(
+      X(2), Pose3(), noiseModel::Gaussian::SqrtInformation(R, false));
+  graph.emplace_shared<BetweenFactor<Pose3>>(X(2), X(3), body_P_sensor,
+                                             noiseModel::Unit::Create(6));
+  graph.emplace_shared<GenericProjectionFactor<Pose3, Point3, Cal3_S2>>(
+      Point2(10, 20), pixel, X(2), L(0), K);
+  graph.emplace_shared<GenericProjectionFactor<Pose3, Point3, Cal3_S2>>(
+      Point2(30, 40), pixel, X(3), L(0), K, true, false, body_P_sensor);
+  graph.emplace_shared<GeneralSFMFactor<SfmCamera, Point3>>(Point2(1, 2), pixel,
+                                                            X(4), L(1));
+  SmartProjectionParams params(JACOBIAN_SVD, ZERO_ON_DEGENERACY, false, true,
+                               1e-3);
+  params.setRankTolerance(0.5);
+  params.setLandmarkDistanceThreshold(100);
+  const auto smart = boost::make_shared<SmartProjectionPoseFactor<Cal3_S2>>(
+      pixel, K, body_P_sensor, params);
+  smart->add(Point2(1, 2), X(2));
+  smart->add(Point2(3, 4), X(3));
+  smart->add(Point2(5, 6), X(5));
+  graph.push_back(smart);
+
+  Values values;
+  values.insert(X(0), Pose2(1, 2, 0.3));
+  values.insert(X(2), body_P_sensor);
+  values.insert(X(4), SfmCamera(body_P_sensor, Cal3Bundler(500, 1e-2, 1e-4)));
+  values.insert(L(0), Point3(1, 2, 3));
+  values.insert(L(1), Point2(4, 5));
+
+  const string filename = temporaryFile("testBinaryGraphTypes.bin");
+  writeBinaryGraph(graph, values, filename);
+  NonlinearFactorGraph::shared_ptr actualGraph;
+  Values::shared_ptr actualValues;
+  boost::tie(actualGraph, actualValues) = readBinaryGraph(filename);
+  EXPECT(assert_equal(values, *actualValues));
+  EXPECT(assert_equal(graph, *actualGraph, 1e-9));
+  CHECK(!(*actualGraph)[2]);
+
+  // Noise models and calibrations shared in the graph are shared after loading
+  const auto noiseOf = [&](size_t i) {
+    return boost::static_pointer_cast<NoiseModelFactor>((*actualGraph)[i])
+        ->noiseModel();
+  };
+  EXPECT(noiseOf(0) == noiseOf(1));
+  EXPECT(noiseOf(5) == noiseOf(6));
+  const auto projection =
+      boost::dynamic_pointer_cast<GenericProjectionFactor<Pose3, Point3, Cal3_S2>>(
+          (*actualGraph)[6]);
+  CHECK(projection);
+  EXPECT(projection->throwCheirality() && !projection->verboseCheirality());
+  EXPECT(assert_equal(body_P_sensor, *projection->body_P_sensor()));
+  EXPECT(assert_equal(*K, *projection->calibration()));
+
+  const auto actualSmart =
+      boost::dynamic_pointer_cast<SmartProjectionPoseFactor<Cal3_S2>>(
+          (*actualGraph)[8]);
+  CHECK(actualSmart);
+  EXPECT(assert_equal(body_P_sensor, actualSmart->body_P_sensor()));
+  EXPECT_LONGS_EQUAL(JACOBIAN_SVD, actualSmart->params().linearizationMode);
+  EXPECT_LONGS_EQUAL(ZERO_ON_DEGENERACY, actualSmart->params().degeneracyMode);
+  EXPECT(actualSmart->params().verboseCheirality);
+  EXPECT_DOUBLES_EQUAL(1e-3, actualSmart->params().retriangulationThreshold, 0);
+  EXPECT_DOUBLES_EQUAL(0.5, actualSmart->params().triangulation.rankTolerance, 0);
+  EXPECT_DOUBLES_EQUAL(
+      100, actualSmart->params().triangulation.landmarkDistanceThreshold, 0);
+}
+
+/* ************************************************************************* */
+TEST(BinaryGraph, Columns) {
+  NonlinearFactorGraph graph;
+  const SharedNoiseModel noise = noiseModel::Isotropic::Sigma(3, 0.1);
+  for (size_t i = 0; i < 10; i++)
+    graph.emplace_shared<BetweenFactor<Pose2>>(i, i + 1, Pose2(i, 0, 0), noise);
+  const string filename = temporaryFile("testBinaryGraphColumns.bin");
+  writeBinaryGraph(graph, Values(), filename);
+
+  // The columns can be read in place
+  const BinaryGraphFile file(filename);
+  EXPECT_LONGS_EQUAL(kBinaryGraphVersion, file.version());
+  EXPECT_LONGS_EQUAL(10, file.nrFactors());
+  EXPECT_LONGS_EQUAL(1, file.noiseModels().count);
+  EXPECT_DOUBLES_EQUAL(0.1, file.noiseModels().data[0], 0);
+  LONGS_EQUAL(1, file.sections().size());
+  const BinaryGraphColumns& between = file.sections()[0];
+  CHECK(between.kind == BinaryGraphSection::BETWEEN_POSE2);
+  LONGS_EQUAL(10, between.count);
+  for (size_t i = 0; i < 10; i++) {
+    EXPECT_LONGS_EQUAL(i, between.slots[i]);
+    EXPECT_LONGS_EQUAL(i + 1, between.rowKeys(i)[1]);
+    EXPECT_DOUBLES_EQUAL(i, between.rowData(i)[0], 0);
+    EXPECT_LONGS_EQUAL(0, between.noise[i]);
+  }
+}
+
+/* ************************************************************************* */
+TEST(BinaryGraph, BAL) {
+  const string balFile = findExampleDataFile("dubrovnik-3-7-pre");
+  const string binaryFile = temporaryFile("testBinaryGraphBAL.bin");
+  convertBALToBinaryGraph(balFile, binaryFile);
+
+  SfmData db;
+  CHECK(readBAL(balFile, db));
+  NonlinearFactorGraph::shared_ptr graph;
+  Values::shared_ptr values;
+  boost::tie(graph, values) = readBinaryGraph(binaryFile);
+  EXPECT(assert_equal(initialCamerasAndPointsEstimate(db), *values));
+  size_t nrMeasurements = 0;
+  for (const SfmTrack& track : db.tracks)
+    nrMeasurements += track.measurements.size();
+  LONGS_EQUAL(nrMeasurements, graph->size());
+  const auto factor =
+      boost::dynamic_pointer_cast<GeneralSFMFactor<SfmCamera, Point3>>(
+          graph->back());
+  CHECK(factor);
+  EXPECT(assert_equal(db.tracks.back().measurements.back().second,
+                      factor->measured()));
+}
+
+/* ************************************************************************* */
+TEST(BinaryGraph, Errors) {
+  // Types the format does not cover
+  NonlinearFactorGraph graph;
+  graph.emplace_shared<BetweenFactor<Point3>>(0, 1, Point3(1, 2, 3),
+                                              noiseModel::Unit::Create(3));
+  const string filename = temporaryFile("testBinaryGraphErrors.bin");
+  CHECK_EXCEPTION(writeBinaryGraph(graph, Values(), filename),
+                  std::invalid_argument);
+  graph.resize(0);
+  graph.emplace_shared<PriorFactor<Pose2>>(
+      0, Pose2(), noiseModel::Robust::Create(
+                      noiseModel::mEstimator::Huber::Create(1.0),
+                      noiseModel::Unit::Create(3)));
+  CHECK_EXCEPTION(writeBinaryGraph(graph, Values(), filename),
+                  std::invalid_argument);
+
+  // Files that are not binary graphs, or from a newer version
+  {
+    ofstream os(filename.c_str(), ios::binary);
+    os << "VERTEX_SE2 0 0 0 0\n";
+  }
+  CHECK_EXCEPTION(BinaryGraphFile file(filename), std::invalid_argument);
+  writeBinaryGraph(NonlinearFactorGraph(), Values(), filename);
+  {
+    fstream fs(filename.c_str(), ios::binary | ios::in | ios::out);
+    fs.seekp(8);
+    const uint32_t newer = kBinaryGraphVersion + 1;
+    fs.write(reinterpret_cast<const char*>(&newer), sizeof(newer));
+  }
+  CHECK_EXCEPTION(BinaryGraphFile file(filename), std::invalid_argument);
+}
+
+/* ************************************************************************* */
+int main() { TestResult tr; return TestRegistry::runAllTests(tr); }
+/* ************************************************************************* */
@@ -23,9 +23,11 @@
 #include <gtsam/base/TestableAssertions.h>
 
 #include <boost/algorithm/string.hpp>
+#include <boost/filesystem/operations.hpp>
 
 #include <CppUnitLite/TestHarness.h>
 
+#include <fstream>
 #include <iostream>
 #include <sstream>
 
@@ -405,6 +407,83 @@ TEST(dataSet, readG2oTukey) {
   EXPECT(assert_equal(expectedGraph(model), *actualGraph, 1e-5));
 }
 
+/* ************************************************************************* */
+// Write contents to a file in the temporary directory, and return its name
+static string writeTemporaryFile(const string &name, const string &contents) {
+  const string filename =
+      (boost::filesystem::temp_directory_path() / name).string();
+  ofstream os(filename.c_str(), ios::binary);
+  os << contents;
+  return filename;
+}
+
+/* ************************************************************************* */
+TEST(dataSet, readG2oFormatting) {
+  // Windows line endings, blank lines, unknown tags, signs and exponents, and
+  // no newline at the end
+  const string filename = writeTemporaryFile(
+      "testDatasetFormatting.g2o",
+      "VERTEX_SE2 0 0 0 0\r\n\n  \t\nUNKNOWN_TAG 1 2 3\n"
+      "VERTEX_SE2 +1 1.5e0 -2.5E-1 0.1\r\n"
+      "EDGE_SE2 0 1 1.5 -0.25 .1 1e2 0 0 100 0 100");
+  NonlinearFactorGraph::shared_ptr actualGraph;
+  Values::shared_ptr actualValues;
+  boost::tie(actualGraph, actualValues) = readG2o(filename);
+
+  Values expectedValues;
+  expectedValues.insert(0, Pose2());
+  expectedValues.insert(1, Pose2(1.5, -0.25, 0.1));
+  EXPECT(assert_equal(expectedValues, *actualValues));
+
+  NonlinearFactorGraph expectedGraph;
+  expectedGraph.emplace_shared<BetweenFactor<Pose2>>(
+      0, 1, Pose2(1.5, -0.25, 0.1),
+      noiseModel::Gaussian::Information(100 * I_3x3, true));
+  EXPECT(assert_equal(expectedGraph, *actualGraph));
+
+  const string malformed = writeTemporaryFile(
+      "testDatasetMalformed.g2o", "VERTEX_SE2 0 0 0 0\nVERTEX_SE2 1 1.0 x 0\n");
+  CHECK_EXCEPTION(readG2o(malformed), std::runtime_error);
+  boost::filesystem::remove(filename);
+  boost::filesystem::remove(malformed);
+}
+
+/* ************************************************************************* */
+TEST(dataSet, load3DChunks) {
+  // A file large enough to be parsed in several chunks
+  ostringstream os;
+  os.precision(17);
+  const size_t n = 4000;
+  for (size_t i = 0; i < n; i++)
+    os << "VERTEX_SE3:QUAT " << i << " " << i << " " << sin(0.1 * i) << " "
+       << cos(0.3 * i) << " " << 0.1 * sin(0.2 * i) << " 0.2 " << cos(i)
+       << " 1\n";
+  for (size_t i = 0; i + 1 < n; i++) {
+    os << "EDGE_SE3:QUAT " << i << " " << i + 1 << " 1 " << 1e-3 * i
+       << " -0.5 0 0 " << sin(0.1 * i) << " 1";
+    for (size_t k = 0; k < 21; k++)
+      os << " " << (k == 0 || k == 6 || k == 11 || k == 15 || k == 18 || k == 20
+                        ? 100.0 + i
+                        : 0.001 * k);
+    os << "\n";
+  }
+  const string filename = writeTemporaryFile("testDatasetChunks.g2o", os.str());
+
+  // Compare with the stream-based parsers
+  NonlinearFactorGraph::shared_ptr actualGraph;
+  Values::shared_ptr actualValues;
+  boost::tie(actualGraph, actualValues) = load3D(filename);
+  const auto expectedPoses = parseVariables<Pose3>(filename);
+  const auto expectedFactors = parseFactors<Pose3>(filename);
+  LONGS_EQUAL(n, actualValues->size());
+  LONGS_EQUAL(n - 1, actualGraph->size());
+  for (const auto &it : expectedPoses)
+    EXPECT(assert_equal(it.second, actualValues->at<Pose3>(it.first)));
+  for (size_t i = 0; i + 1 < n; i++)
+    EXPECT(expectedFactors[i]->equals(*actualGraph->at(i)));
+  boost::filesystem::remove(filename);
+}
+
 /* ************************************************************************* */
 TEST( dataSet, writeG2o)
 {
@@ -461,6 +540,47 @@ TEST( dataSet, writeG2o3DNonDiagonalNoise)
   EXPECT(assert_equal(*expectedGraph,*actualGraph,1e-4));
 }
 
+/* ************************************************************************* */
+TEST(dataSet, G2oWriter) {
+  const string g2oFile = findExampleDataFile("pose3example");
+  NonlinearFactorGraph::shared_ptr expectedGraph;
+  Values::shared_ptr expectedValues;
+  const bool is3D = true;
+  boost::tie(expectedGraph, expectedValues) = readG2o(g2oFile, is3D);
+
+  // Export a growing graph in two steps, with a removed factor in between
+  const string filename = createRewrittenFileName(g2oFile);
+  NonlinearFactorGraph graph;
+  Values values;
+  G2oWriter writer(filename);
+  graph.push_back((*expectedGraph)[0]);
+  values.insert(0, expectedValues->at<Pose3>(0));
+  values.insert(1, expectedValues->at<Pose3>(1));
+  writer.update(graph, values);
+  writer.flush();
+  EXPECT_LONGS_EQUAL(1, writer.nrFactorSlots());
+  EXPECT_LONGS_EQUAL(2, writer.nrValues());
+
+  NonlinearFactorGraph::shared_ptr actualGraph;
+  Values::shared_ptr actualValues;
+  boost::tie(actualGraph, actualValues) = readG2o(filename, is3D);
+  EXPECT(assert_equal(values, *actualValues, 1e-9));
+  EXPECT(assert_equal(graph, *actualGraph, 1e-9));
+
+  graph.push_back(NonlinearFactor::shared_ptr());
+  for (size_t i = 1; i < expectedGraph->size(); i++)
+    graph.push_back((*expectedGraph)[i]);
+  writer.update(graph, *expectedValues);
+  writer.flush();
+  EXPECT_LONGS_EQUAL(expectedGraph->size() + 1, writer.nrFactorSlots());
+  EXPECT_LONGS_EQUAL(expectedValues->size(), writer.nrValues());
+
+  // Each vertex and edge was written once
+  boost::tie(actualGraph, actualValues) = readG2o(filename, is3D);
+  EXPECT(assert_equal(*expectedValues, *actualValues, 1e-9));
+  EXPECT(assert_equal(*expectedGraph, *actualGraph, 1e-9));
+}
+
 /* ************************************************************************* */
 TEST( dataSet, readBAL_Dubrovnik)
 {
@@ -482,6 +602,81 @@ TEST( dataSet, readBAL_Dubrovnik)
   EXPECT(assert_equal(expected,actual,12));
 }
 
+/* ************************************************************************* */
+TEST(dataSet, totalReprojectionError) {
+  SfmData data;
+  CHECK(readBAL(findExampleDataFile("dubrovnik-3-7-pre"), data));
+
+  // Compare with projecting every measurement on its own
+  double expected = 0.0;
+  for (const SfmTrack &track : data.tracks)
+    for (const SfmMeasurement &m : track.measurements)
+      expected +=
+          (data.cameras[m.first].project(track.p) - m.second).squaredNorm();
+  EXPECT_DOUBLES_EQUAL(0.5 * expected, totalReprojectionError(data),
+                       1e-9 * expected);
+}
+
+/* ************************************************************************* */
+TEST(dataSet, readBALFormatting) {
+  // Numbers split over lines, long mantissas and large exponents, all of which
+  // have to be rounded to float exactly like extracting a float from a stream
+  const string numbers =
+      "0 0 -385.99 387.12\n0 1 0.1 1e-1\n0 1 16777217 0.30000001192092896\n"
+      "0.01 -0.02 0.03 1.5 -2.5\n3.4028234e38 500.5 1e-30 -2.0000001e-7\n"
+      "1.5 -2.25e-3\n7 0.1\n0.2 0.3";
+  const string filename =
+      writeTemporaryFile("testDatasetFormatting.bal", "1 2 3\n" + numbers);
+  SfmData data;
+  CHECK(readBAL(filename, data));
+  boost::filesystem::remove(filename);
+
+  istringstream is(numbers);
+  size_t camera, point;
+  float u, v;
+  vector<Point2> expectedMeasurements;
+  for (size_t k = 0; k < 3; k++) {
+    is >> camera >> point >> u >> v;
+    expectedMeasurements.emplace_back(u, -v);
+  }
+  float c[9], p[6];
+  for (float &x : c) is >> x;
+  for (float &x : p) is >> x;
+
+  LONGS_EQUAL(1, data.number_cameras());
+  LONGS_EQUAL(2, data.number_tracks());
+  LONGS_EQUAL(1, data.tracks[0].number_measurements());
+  LONGS_EQUAL(2, data.tracks[1].number_measurements());
+  EXPECT(expectedMeasurements[0] == data.tracks[0].measurements[0].second);
+  EXPECT(expectedMeasurements[1] == data.tracks[1].measurements[0].second);
+  EXPECT(expectedMeasurements[2] == data.tracks[1].measurements[1].second);
+  EXPECT(Point3(p[0], p[1], p[2]) == data.tracks[0].p);
+  EXPECT(Point3(p[3], p[4], p[5]) == data.tracks[1].p);
+  const Pose3 expectedPose =
+      openGL2gtsam(Rot3::Rodrigues(c[0], c[1], c[2]), c[3], c[4], c[5]);
+  EXPECT(assert_equal(expectedPose, data.cameras[0].pose(), 0));
+  EXPECT(assert_equal(Cal3Bundler(c[6], c[7], c[8]),
+                      data.cameras[0].calibration(), 0));
+}
+
+/* ************************************************************************* */
+TEST(dataSet, readBALMalformed) {
+  SfmData data;
+  // Counts that would overflow, or that the file does not have numbers for
+  const string overflow = writeTemporaryFile(
+      "testDatasetOverflow.bal", "99999999999999999999 1 1\n0 0 1 2\n");
+  EXPECT(!readBAL(overflow, data));
+  const string truncated = writeTemporaryFile(
+      "testDatasetTruncated.bal", "4611686018427387904 1 1\n0 0 1 2\n");
+  EXPECT(!readBAL(truncated, data));
+  const string malformed = writeTemporaryFile(
+      "testDatasetMalformed.bal", "0 1 1\n0 0 1 x\n1 2 3\n");
+  CHECK_EXCEPTION(readBAL(malformed, data), std::runtime_error);
+  boost::filesystem::remove(overflow);
+  boost::filesystem::remove(truncated);
+  boost::filesystem::remove(malformed);
+}
+
 /* ************************************************************************* */
 TEST( dataSet, openGL2gtsam)
 {
@@ -25,6 +25,10 @@
 #include <gtsam/linear/VectorValues.h>
 #include <gtsam/linear/NoiseModel.h>
 #include <gtsam/linear/GaussianFactor.h>
+#include <gtsam/linear/GaussianFactorGraph.h>
+#include <gtsam/linear/ImplicitSchurOperator.h>
+#include <gtsam/linear/PCGSolver.h>
+#include <gtsam/linear/Preconditioner.h>
 #include <gtsam/base/timing.h>
 
 #include <boost/assign/list_of.hpp>
@@ -278,6 +282,56 @@ TEST(regularImplicitSchurFactor, hessianDiagonal)
   EXPECT(assert_equal(actualBD[3],actualInfo2.block<6,6>(12,12)));
 }
 
+/* ************************************************************************* */
+TEST(regularImplicitSchurFactor, packedOperator) {
+  // Three landmarks seen by four cameras, and a weak prior on every camera
+  typedef RegularImplicitSchurFactor<CalibratedCamera> Factor;
+  const vector<KeyVector> tracks{{0, 1, 3}, {1, 2}, {3, 2, 0, 1}};
+  GaussianFactorGraph gfg;
+  for (const KeyVector& track : tracks) {
+    const size_t m = track.size();
+    vector<Matrix26, Eigen::aligned_allocator<Matrix26> > Fs;
+    for (size_t k = 0; k < m; k++) Fs.push_back(Matrix26::Random());
+    const Matrix E = Matrix::Random(2 * m, 3);
+    const Matrix3 P = (E.transpose() * E).inverse();
+    gfg.push_back(boost::make_shared<Factor>(track, Fs, E, P, Vector::Random(2 * m)));
+  }
+  for (Key j = 0; j < 4; j++)
+    gfg.add(j, 0.1 * I_6x6, Vector::Random(6));
+
+  const KeyInfo keyInfo(gfg);
+  EXPECT(ImplicitSchurOperator::Applies(gfg));
+  const ImplicitSchurOperator H(gfg, keyInfo);
+  EXPECT_LONGS_EQUAL(3, H.nrLandmarks());
+  EXPECT_LONGS_EQUAL(9, H.nrObservations());
+  EXPECT_LONGS_EQUAL(4, H.nrCameras());
+
+  // Products agree with the factors
+  const Vector x = Vector::Random(24);
+  VectorValues expected = keyInfo.x0();
+  gfg.multiplyHessianAdd(0.5, buildVectorValues(x, keyInfo), expected);
+  Vector actual = Vector::Zero(24);
+  H.multiplyHessianAdd(0.5, x, actual);
+  EXPECT(assert_equal(expected.vector(keyInfo.ordering()), actual, 1e-9));
+  EXPECT(assert_equal(
+      Vector(-gfg.gradientAtZero().vector(keyInfo.ordering())), H.rhs(), 1e-9));
+  const map<Key, Matrix> expectedBD = gfg.hessianBlockDiagonal();
+  const vector<Matrix> actualBD = H.blockDiagonal();
+  for (Key j = 0; j < 4; j++)
+    EXPECT(assert_equal(expectedBD.at(j), actualBD[keyInfo.at(j).index], 1e-9));
+
+  // PCG with the packed operator agrees with PCG on the factors
+  PCGSolverParameters params;
+  params.preconditioner_ = boost::make_shared<BlockJacobiPreconditionerParameters>();
+  params.setEpsilon_rel(1e-12);
+  params.setEpsilon_abs(1e-12);
+  params.setMaxIterations(100);
+  const VectorValues expectedDelta = PCGSolver(params).optimize(gfg);
+  params.setBlasKernel(ConjugateGradientParameters::PACKED);
+  const VectorValues actualDelta = PCGSolver(params).optimize(gfg);
+  EXPECT(assert_equal(expectedDelta, actualDelta, 1e-6));
+}
+
 /* ************************************************************************* */
 int main(void) {
   TestResult tr;
@@ -22,6 +22,7 @@
 #include "smartFactorScenarios.h"
 #include <gtsam/slam/ProjectionFactor.h>
 #include <gtsam/slam/PoseTranslationPrior.h>
+#include <gtsam/nonlinear/ISAM2.h>
 #include <gtsam/nonlinear/LevenbergMarquardtOptimizer.h>
 #include <gtsam/base/numericalDerivative.h>
 #include <gtsam/base/serializationTestHelpers.h>
@@ -1182,6 +1183,121 @@ TEST( SmartProjectionPoseFactor, HessianWithRotationDegenerate ) {
   EXPECT(assert_equal(factor->information(), factorRotTran->information(), 1e-7));
 }
 
+/* ************************************************************************* */
+TEST( SmartProjectionPoseFactor, FixedHessian ) {
+  using namespace vanillaPose;
+
+  // Body-sensor transform and perturbed poses, so no Jacobian is trivial
+  const Pose3 body_T_sensor(Rot3::Ypr(-M_PI / 2, 0., -M_PI / 2), Point3(1, 1, 1));
+  const Pose3 noise(Rot3::Ypr(0.01, -0.02, 0.01), Point3(0.05, -0.02, 0.03));
+  Point2Vector measurements;
+  projectToMultipleCameras(cam1, cam2, cam3, landmark1, measurements);
+
+  KeyVector views {x1, x2, x3};
+  SmartFactor smartFactor(model, sharedK, body_T_sensor);
+  smartFactor.add(measurements, views);
+  Values values;
+  values.insert(x1, cam1.pose() * body_T_sensor.inverse());
+  values.insert(x2, cam2.pose() * noise * body_T_sensor.inverse());
+  values.insert(x3, cam3.pose() * body_T_sensor.inverse() * noise);
+
+  const SmartFactor::Cameras cameras = smartFactor.cameras(values);
+  const TriangulationResult point = smartFactor.triangulateSafe(cameras);
+  CHECK(point.valid());
+
+  // Dynamic Schur complement on whitened Jacobians
+  for (bool diagonalDamping : {false, true}) {
+    const double lambda = 0.3;
+    SmartFactor::FBlocks Fs;
+    Matrix E;
+    Vector b;
+    smartFactor.computeJacobians(Fs, E, b, cameras, *point);
+    smartFactor.whitenJacobians(Fs, E, b);
+    const SymmetricBlockMatrix expected = SmartFactor::Cameras::SchurComplement(
+        Fs, E, b, lambda, diagonalDamping);
+
+    const auto actual = smartFactor.createFixedHessianFactor(
+        cameras, *point, lambda, diagonalDamping);
+    EXPECT(smartFactor.keys() == actual->keys());
+    EXPECT(assert_equal(Matrix(expected.selfadjointView()),
+                        Matrix(actual->info().selfadjointView()), 1e-6));
+  }
+
+  // linearize goes through the fixed-size path
+  const auto linear = boost::dynamic_pointer_cast<RegularHessianFactor<6> >(
+      smartFactor.linearize(values));
+  CHECK(linear);
+  EXPECT(assert_equal(
+      Matrix(smartFactor.createFixedHessianFactor(cameras, *point)->information()),
+      linear->information(), 1e-9));
+}
+
+/* ************************************************************************* */
+TEST( SmartProjectionPoseFactor, ReuseLinearization ) {
+  using namespace vanillaPose;
+
+  Point2Vector measurements_cam1, measurements_cam2;
+  projectToMultipleCameras(cam1, cam2, cam3, landmark1, measurements_cam1);
+  projectToMultipleCameras(cam1, cam2, cam3, landmark2, measurements_cam2);
+  KeyVector views {x1, x2, x3};
+
+  SmartProjectionParams params;
+  params.setReuseLinearization(true);
+  SmartFactor::shared_ptr smartFactor1(new SmartFactor(model, sharedK, params));
+  smartFactor1->add(measurements_cam1, views);
+  SmartFactor::shared_ptr smartFactor2(new SmartFactor(model, sharedK, params));
+  smartFactor2->add(measurements_cam2, views);
+
+  Values values;
+  values.insert(x1, cam1.pose());
+  values.insert(x2, cam2.pose());
+  values.insert(x3, cam3.pose() * Pose3(Rot3::Ypr(0.01, 0, 0), Point3(0.1, 0, 0)));
+
+  // Same cameras: the previous linear factor is returned
+  LinearizationCacheStats before = LinearizationCacheStats::Global();
+  const GaussianFactor::shared_ptr linear = smartFactor1->linearize(values);
+  EXPECT(linear == smartFactor1->linearize(values));
+  LinearizationCacheStats stats = LinearizationCacheStats::Global() - before;
+  EXPECT_LONGS_EQUAL(1, stats.linearizations);
+  EXPECT_LONGS_EQUAL(1, stats.linearizationsReused);
+  EXPECT_LONGS_EQUAL(1, stats.triangulations);
+  EXPECT_DOUBLES_EQUAL(0.5, stats.linearizationHitRate(), 1e-9);
+
+  // Moved camera: linearize and triangulate anew
+  Values moved = values;
+  moved.update(x2, cam2.pose() * Pose3(Rot3(), Point3(0, 0, 0.01)));
+  before = LinearizationCacheStats::Global();
+  const GaussianFactor::shared_ptr linear2 = smartFactor1->linearize(moved);
+  EXPECT(linear != linear2);
+  stats = LinearizationCacheStats::Global() - before;
+  EXPECT_LONGS_EQUAL(1, stats.linearizations);
+  EXPECT_LONGS_EQUAL(1, stats.triangulations);
+  SmartFactor fresh(model, sharedK);
+  fresh.add(measurements_cam1, views);
+  EXPECT(assert_equal(*fresh.linearize(moved), *linear2, 1e-9));
+
+  // In ISAM2, factors on cameras that were not relinearized reuse their
+  // linear factor when only new factors affect them. Two smart factors give
+  // x3 only four rows, so a weak prior makes the first update well-posed.
+  NonlinearFactorGraph graph;
+  graph.push_back(smartFactor1);
+  graph.push_back(smartFactor2);
+  graph.addPrior(x1, cam1.pose(), noiseModel::Isotropic::Sigma(6, 0.1));
+  graph.addPrior(x2, cam2.pose(), noiseModel::Isotropic::Sigma(6, 0.1));
+  graph.addPrior(x3, cam3.pose(), noiseModel::Isotropic::Sigma(6, 10.0));
+  ISAM2Params isamParams;
+  isamParams.cacheLinearizedFactors = false;
+  isamParams.relinearizeSkip = 1000;
+  ISAM2 isam(isamParams);
+  const ISAM2Result first = isam.update(graph, values);
+  EXPECT_LONGS_EQUAL(2, first.linearizationCache.linearizations);
+  NonlinearFactorGraph prior;
+  prior.addPrior(x3, cam3.pose(), noiseModel::Isotropic::Sigma(6, 0.1));
+  const ISAM2Result result = isam.update(prior);
+  EXPECT_LONGS_EQUAL(0, result.linearizationCache.linearizations);
+  EXPECT_LONGS_EQUAL(2, result.linearizationCache.linearizationsReused);
+}
+
 /* ************************************************************************* */
 TEST( SmartProjectionPoseFactor, ConstructorWithCal3Bundler) {
   using namespace bundlerPose;
@@ -0,0 +1,127 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file   testSyntheticProblems.cpp
+ * @brief  Unit tests for the synthetic problem generators
+ * @date   October 2026
+ */
+
+#include <gtsam/slam/SyntheticProblems.h>
+#include <gtsam/nonlinear/LevenbergMarquardtOptimizer.h>
+#include <gtsam/inference/Symbol.h>
+
+#include <CppUnitLite/TestHarness.h>
+
+#include <stdexcept>
+
+using namespace std;
+using namespace gtsam;
+
+/* ************************************************************************* */
+TEST(SyntheticProblems, gridPoseGraph) {
+  GridPoseGraphParams params;
+  params.rows = 4;
+  params.cols = 5;
+  params.layers = 2;
+  const GraphAndValues problem = generateGridPoseGraph(params);
+  const NonlinearFactorGraph& graph = *problem.first;
+  const Values& initial = *problem.second;
+  EXPECT_LONGS_EQUAL(40, initial.size());
+  // prior, odometry, and some loop closures
+  EXPECT(graph.size() > 40);
+
+  // Same seed, same problem
+  const GraphAndValues again = generateGridPoseGraph(params);
+  EXPECT(assert_equal(graph, *again.first));
+  EXPECT(assert_equal(initial, *again.second));
+
+  // Loop closures keep the noisy odometry close to the lattice, which ends
+  // at the corner above the start
+  const Values result =
+      LevenbergMarquardtOptimizer(graph, initial).optimize();
+  EXPECT(graph.error(result) < graph.error(initial));
+  EXPECT_DOUBLES_EQUAL(0, result.at<Pose3>(39).x(), 0.5);
+  EXPECT_DOUBLES_EQUAL(0, result.at<Pose3>(39).y(), 0.5);
+  EXPECT_DOUBLES_EQUAL(1, result.at<Pose3>(39).z(), 0.5);
+}
+
+/* ************************************************************************* */
+TEST(SyntheticProblems, chunks) {
+  GridPoseGraphParams params;
+  params.rows = 3;
+  params.cols = 3;
+  size_t nrChunks = 0, nrFactors = 0;
+  generateGridPoseGraph(params, [&](const NonlinearFactorGraph& factors,
+                                    const Values& values) {
+    // Each chunk adds one pose, and only refers to poses added before it
+    EXPECT_LONGS_EQUAL(1, values.size());
+    EXPECT_LONGS_EQUAL(nrChunks, values.keys().front());
+    for (const auto& factor : factors)
+      for (Key key : factor->keys()) EXPECT(key <= nrChunks);
+    nrFactors += factors.size();
+    nrChunks++;
+  });
+  EXPECT_LONGS_EQUAL(9, nrChunks);
+  EXPECT_LONGS_EQUAL(generateGridPoseGraph(params).first->size(), nrFactors);
+}
+
+/* ************************************************************************* */
+TEST(SyntheticProblems, manhattanWorld) {
+  ManhattanWorldParams params;
+  params.nrPoses = 500;
+  const GraphAndValues problem = generateManhattanWorld(params);
+  const NonlinearFactorGraph& graph = *problem.first;
+  EXPECT_LONGS_EQUAL(500, problem.second->size());
+  EXPECT(graph.size() > 500);
+
+  params.seed = 7;
+  EXPECT(!generateManhattanWorld(params).second->equals(*problem.second));
+
+  const Values result =
+      LevenbergMarquardtOptimizer(graph, *problem.second).optimize();
+  EXPECT(graph.error(result) < graph.error(*problem.second));
+}
+
+/* ************************************************************************* */
+TEST(SyntheticProblems, sfm) {
+  using symbol_shorthand::P;
+  SyntheticSfmParams params;
+  params.nrCameras = 40;
+  params.streetLength = 20;
+  params.pointsPerCamera = 5;
+  const GraphAndValues problem = generateSyntheticSfm(params);
+  const NonlinearFactorGraph& graph = *problem.first;
+  const Values& initial = *problem.second;
+
+  // Cameras, and points with at least two measurements each
+  size_t nrPoints = 0;
+  for (Key key : initial.keys())
+    if (Symbol(key).chr() == 'p') nrPoints++;
+  EXPECT_LONGS_EQUAL(40, initial.size() - nrPoints);
+  EXPECT(nrPoints > 0);
+  EXPECT(graph.size() >= 2 * nrPoints);
+
+  // Measurements are close to the projections of the perturbed truth
+  const double error = graph.error(initial);
+  EXPECT(std::isfinite(error));
+  EXPECT(error / graph.size() < 1e4);
+
+  params.minTrackLength = 1;
+  CHECK_EXCEPTION(generateSyntheticSfm(params), std::invalid_argument);
+}
+
+/* ************************************************************************* */
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
+/* ************************************************************************* */
@@ -28,6 +28,7 @@
 #include <gtsam/geometry/StereoCamera.h>
 #include <gtsam/slam/StereoFactor.h>
 #include <gtsam/inference/Symbol.h>
+#include <gtsam/nonlinear/LinearizationCacheStats.h>
 #include <gtsam/slam/dataset.h>
 
 #include <boost/optional.hpp>
@@ -164,6 +165,9 @@ public:
 
     size_t m = cameras.size();
     bool retriangulate = decideIfTriangulate(cameras);
+    LinearizationCacheStats::RecordTriangulation(!retriangulate);
+    if (!retriangulate)
+      return result_;
 
     // triangulate stereo measurements by treating each stereocamera as a pair of monocular cameras
     MonoCameras monoCameras;
@@ -183,9 +187,8 @@ public:
         monoMeasured.push_back(Point2(zi.uR(),zi.v()));
       }
     }
-    if (retriangulate)
-      result_ = gtsam::triangulateSafe(monoCameras, monoMeasured,
-          params_.triangulation);
+    result_ = gtsam::triangulateSafe(monoCameras, monoMeasured,
+        params_.triangulation);
     return result_;
   }
 
@@ -222,6 +225,11 @@ public:
           Gs, gs, 0.0);
     }
 
+    // Valid point: fixed-size linearization into the factor storage
+    if (result_)
+      return Base::createFixedHessianFactor(cameras, *result_, lambda,
+                                            diagonalDamping);
+
     // Jacobian could be 3D Point3 OR 2D Unit3, difference is E.cols().
     Base::FBlocks Fs;
     Matrix F, E;
@@ -1452,6 +1452,42 @@ TEST( SmartStereoProjectionPoseFactor, HessianWithRotationNonDegenerate ) {
 #endif
 }
 
+/* ************************************************************************* */
+TEST( SmartStereoProjectionPoseFactor, FixedHessian ) {
+  StereoCamera cam1(level_pose, K2), cam2(level_pose * Pose3(Rot3(), Point3(1, 0, 0)), K2),
+      cam3(level_pose * Pose3(Rot3(), Point3(0, -1, 0)), K2);
+  vector<StereoPoint2> measurements =
+      stereo_projectToMultipleCameras(cam1, cam2, cam3, landmark1);
+  // A missing right pixel must not contribute
+  measurements[1] = StereoPoint2(measurements[1].uL(), missing_uR,
+                                 measurements[1].v());
+
+  SmartStereoProjectionPoseFactor smartFactor(model, params, body_P_sensor1);
+  smartFactor.add(measurements, KeyVector{x1, x2, x3}, K2);
+  const Pose3 noise(Rot3::Ypr(0.01, -0.02, 0.01), Point3(0.05, -0.02, 0.03));
+  Values values;
+  values.insert(x1, cam1.pose() * body_P_sensor1.inverse());
+  values.insert(x2, cam2.pose() * noise * body_P_sensor1.inverse());
+  values.insert(x3, cam3.pose() * body_P_sensor1.inverse());
+
+  const SmartStereoProjectionPoseFactor::Cameras cameras =
+      smartFactor.cameras(values);
+  const TriangulationResult point = smartFactor.triangulateSafe(cameras);
+  CHECK(point.valid());
+
+  SmartStereoProjectionPoseFactor::FBlocks Fs;
+  Matrix E;
+  Vector b;
+  smartFactor.computeJacobians(Fs, E, b, cameras, *point);
+  smartFactor.whitenJacobians(Fs, E, b);
+  const SymmetricBlockMatrix expected =
+      SmartStereoProjectionPoseFactor::Cameras::SchurComplement(Fs, E, b, 0.1);
+
+  const auto actual = smartFactor.createFixedHessianFactor(cameras, *point, 0.1);
+  EXPECT(assert_equal(Matrix(expected.selfadjointView()),
+                      Matrix(actual->info().selfadjointView()), 1e-6));
+}
+
 /* ************************************************************************* */
 int main() {
   TestResult tr;
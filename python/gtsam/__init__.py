@@ -26,6 +26,11 @@ def _init():
             return x  # "copy constructor"
         return np.array([x, y, z], dtype=float)
 
+    # futures-returning variants of the long-running calls
+    from .utils.futures import optimize_async, update_async
+    NonlinearOptimizer.optimizeAsync = optimize_async
+    ISAM2.updateAsync = update_async
+
     # for interactive debugging
     if __name__ == "__main__":
         # we want all definitions accessible
@@ -13,3 +13,25 @@ py::bind_vector<std::vector<gtsam::BinaryMeasurement<gtsam::Unit3> > >(m_, "Bina
 py::bind_map<gtsam::IndexPairSetMap>(m_, "IndexPairSetMap");
 py::bind_vector<gtsam::IndexPairVector>(m_, "IndexPairVector");
 py::bind_map<gtsam::KeyPairDoubleMap>(m_, "KeyPairDoubleMap");
+
+// Zero-copy NumPy views of data owned by wrapped objects. A view keeps its
+// owner alive, and is only valid until the owner is resized or reassigned.
+{
+  py::object jacobianFactor = m_.attr("JacobianFactor");
+  jacobianFactor.attr("augmentedJacobianView") = py::cpp_function(
+      [](const gtsam::JacobianFactor& self) {
+        return Eigen::Ref<const gtsam::Matrix, 0, Eigen::OuterStride<> >(
+            self.matrixObject().full());
+      },
+      py::name("augmentedJacobianView"), py::is_method(jacobianFactor),
+      py::return_value_policy::reference_internal,
+      "Read-only view of the unweighted augmented Jacobian [A b]");
+  py::object vectorValues = m_.attr("VectorValues");
+  vectorValues.attr("view") = py::cpp_function(
+      [](gtsam::VectorValues& self, size_t j) {
+        return Eigen::Ref<gtsam::Vector>(self.at(j));
+      },
+      py::name("view"), py::is_method(vectorValues), py::arg("j"),
+      py::return_value_policy::reference_internal,
+      "Writable view of the vector for key j");
+}
@@ -78,6 +78,37 @@ class TestScenario(GtsamTestCase):
         actual3 = DoglegOptimizer(fg, initial_values, dlParams).optimize()
         self.assertAlmostEqual(0, fg.error(actual3))
 
+    def test_optimize_async(self):
+        """Run several optimizers in parallel threads."""
+        fg = NonlinearFactorGraph()
+        model = gtsam.noiseModel.Unit.Create(2)
+        fg.add(PriorFactorPoint2(KEY1, Point2(0, 0), model))
+        futures = []
+        for x in range(4):
+            initial_values = Values()
+            initial_values.insert(KEY1, Point2(x, 3))
+            optimizer = LevenbergMarquardtOptimizer(fg, initial_values)
+            futures.append(optimizer.optimizeAsync())
+        for future in futures:
+            self.assertAlmostEqual(0, fg.error(future.result()))
+
+    def test_update_async(self):
+        """Queue ISAM2 updates on a background thread."""
+        isam = gtsam.ISAM2()
+        model = gtsam.noiseModel.Unit.Create(2)
+        futures = []
+        for key in range(3):
+            graph = NonlinearFactorGraph()
+            graph.add(PriorFactorPoint2(key, Point2(key, 0), model))
+            initial_values = Values()
+            initial_values.insert(key, Point2(key, 3))
+            futures.append(isam.updateAsync(graph, initial_values))
+        for future in futures:
+            future.result()
+        estimate = isam.calculateEstimate()
+        for key in range(3):
+            self.gtsamAssertEquals(estimate.atPoint2(key), Point2(key, 0), 1e-9)
+
 
 if __name__ == "__main__":
     unittest.main()
@@ -0,0 +1,89 @@
+"""
+GTSAM Copyright 2010-2019, Georgia Tech Research Corporation,
+Atlanta, Georgia 30332-0415
+All Rights Reserved
+
+See LICENSE for the license information
+
+Unit tests for the bulk NumPy utilities and zero-copy views.
+"""
+# pylint: disable=invalid-name, no-name-in-module, no-member
+
+import unittest
+
+import numpy as np
+
+import gtsam
+from gtsam import JacobianFactor, Point3, Pose3, Rot3, VectorValues
+from gtsam.utils.test_case import GtsamTestCase
+
+
+class TestUtilities(GtsamTestCase):
+    """Tests for bulk conversions between NumPy arrays and gtsam containers."""
+
+    def setUp(self):
+        self.keys = gtsam.KeyVector([0, 1, 2])
+        self.poses = [Pose3(Rot3.Ypr(0.1 * j, 0.2, 0.3), Point3(j, 1, 2))
+                      for j in range(3)]
+
+    def test_pose3s(self):
+        """Round-trip Pose3 values through an (N, 4, 4) array."""
+        matrices = np.array([pose.matrix() for pose in self.poses])
+        values = gtsam.Values()
+        gtsam.utilities.insertPose3s(values, self.keys,
+                                     matrices.reshape(-1, 4))
+        for j, pose in enumerate(self.poses):
+            self.gtsamAssertEquals(values.atPose3(j), pose, 1e-9)
+
+        actual = gtsam.utilities.extractPose3Matrices(values).reshape(-1, 4, 4)
+        np.testing.assert_allclose(actual, matrices, atol=1e-9)
+
+    def test_points(self):
+        """Round-trip Point3 values through an (N, 3) array."""
+        points = np.random.rand(3, 3)
+        values = gtsam.Values()
+        gtsam.utilities.insertPoint3s(values, self.keys, points)
+        np.testing.assert_allclose(
+            gtsam.utilities.extractPoint3(values), points)
+
+        with self.assertRaises(ValueError):
+            gtsam.utilities.insertPoint2s(values, self.keys, np.zeros((2, 2)))
+
+    def test_between_factors(self):
+        """Build a chain of BetweenFactorPose2 from arrays."""
+        measured = np.array([[1.0, 0, 0], [1.0, 0, 0]])
+        graph = gtsam.NonlinearFactorGraph()
+        gtsam.utilities.insertBetweenFactorPose2s(
+            graph, gtsam.KeyVector([0, 1]), gtsam.KeyVector([1, 2]),
+            measured, gtsam.noiseModel.Unit.Create(3))
+        self.assertEqual(graph.size(), 2)
+
+        values = gtsam.Values()
+        gtsam.utilities.insertPose2s(
+            values, self.keys, np.array([[0.0, 0, 0], [1.0, 0, 0], [2.0, 0, 0]]))
+        self.assertAlmostEqual(graph.error(values), 0.0)
+
+    def test_vector_values(self):
+        """Bulk VectorValues and views of single vectors."""
+        X = np.arange(6.0).reshape(3, 2)
+        x = gtsam.utilities.createVectorValues(self.keys, X)
+        np.testing.assert_allclose(
+            gtsam.utilities.extractVectors(x, self.keys), X)
+
+        view = x.view(1)
+        view[0] = 10
+        np.testing.assert_allclose(x.at(1), [10, 3])
+
+    def test_jacobian_view(self):
+        """The augmented Jacobian view shares the factor's storage."""
+        A = np.array([[1.0, 2.0], [3.0, 4.0]])
+        b = np.array([5.0, 6.0])
+        factor = JacobianFactor(0, A, b, gtsam.noiseModel.Unit.Create(2))
+        view = factor.augmentedJacobianView()
+        np.testing.assert_allclose(view, np.column_stack((A, b)))
+        self.assertFalse(view.flags.writeable)
+        self.assertFalse(view.flags.owndata)
+
+
+if __name__ == "__main__":
+    unittest.main()
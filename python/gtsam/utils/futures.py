@@ -0,0 +1,55 @@
+"""
+Asynchronous optimization: run optimize() and ISAM2.update() in background
+threads and get a concurrent.futures.Future for the result.
+These calls release the GIL in the wrapper, so other Python threads keep
+running, and several optimizers can run in parallel.
+"""
+# pylint: disable=invalid-name
+
+import threading
+from concurrent.futures import ThreadPoolExecutor
+
+_lock = threading.Lock()
+_executors = {}
+
+
+def _executor(name, max_workers):
+    """Lazily created module-wide executor."""
+    with _lock:
+        if name not in _executors:
+            _executors[name] = ThreadPoolExecutor(
+                max_workers=max_workers, thread_name_prefix="gtsam_" + name)
+        return _executors[name]
+
+
+def optimize_async(optimizer, executor=None):
+    """ Start optimizer.optimize() in a background thread.
+        The optimizer must not be used until the future is done.
+        Arguments:
+            optimizer {NonlinearOptimizer} -- optimizer to run
+            executor -- concurrent.futures.Executor to use, by default a
+                        shared thread pool
+        Returns:
+            a Future for the optimized Values
+    """
+    if executor is None:
+        executor = _executor("optimize", None)
+    return executor.submit(optimizer.optimize)
+
+
+def update_async(isam, *args, executor=None):
+    """ Start isam.update(*args) in a background thread.
+        ISAM2 is not thread-safe: with the default executor, all updates run
+        one at a time in the order they were submitted, but other methods of
+        isam must not be called until the future is done.
+        Arguments:
+            isam {ISAM2} -- ISAM2 instance to update
+            args -- arguments of ISAM2.update
+            executor -- concurrent.futures.Executor to use, by default a
+                        single shared worker thread
+        Returns:
+            a Future for the ISAM2Result
+    """
+    if executor is None:
+        executor = _executor("update", 1)
+    return executor.submit(isam.update, *args)
@@ -16,6 +16,7 @@
 #include <gtsam/nonlinear/Marginals.h>
 #include <gtsam/linear/GaussianBayesNet.h>
 #include <gtsam/linear/GaussianBayesTree.h>
+#include <gtsam/linear/BayesTreeSnapshot.h>
 #include <gtsam/linear/GaussianFactorGraph.h>
 #include <gtsam/inference/Ordering.h>
 #include <gtsam/base/debug.h>
@@ -25,6 +26,7 @@
 #include <CppUnitLite/TestHarness.h>
 
 #include <boost/assign/list_of.hpp>
+#include <boost/filesystem/operations.hpp>
 #include <boost/range/adaptor/map.hpp>
 using namespace boost::assign;
 namespace br { using namespace boost::adaptors; using namespace boost::range; }
@@ -379,6 +381,24 @@ TEST(ISAM2, clone) {
   CHECK(assert_equal(ISAM2(), clone1));
 }
 
+/* ************************************************************************* */
+TEST(ISAM2, snapshot) {
+  const ISAM2 isam = createSlamlikeISAM2();
+  const string filename =
+      (boost::filesystem::temp_directory_path() / "testISAM2Snapshot.bin").string();
+  writeBayesTreeSnapshot(isam, filename);
+  const GaussianBayesTree actual = readBayesTreeSnapshot(filename);
+
+  // Same cliques, with the same conditionals
+  LONGS_EQUAL(isam.size(), actual.size());
+  LONGS_EQUAL(isam.roots().size(), actual.roots().size());
+  for (const auto& key_clique : isam.nodes()) {
+    const auto clique = actual[key_clique.first];
+    EXPECT(assert_equal(*key_clique.second->conditional(), *clique->conditional()));
+    EXPECT_LONGS_EQUAL(key_clique.second->children.size(), clique->children.size());
+  }
+}
+
 /* ************************************************************************* */
 TEST(ISAM2, removeFactors)
 {
@@ -28,6 +28,7 @@
 #include <gtsam/inference/Symbol.h>
 #include <gtsam/geometry/Pose2.h>
 #include <gtsam/base/Matrix.h>
+#include <gtsam/base/Metrics.h>
 
 #include <CppUnitLite/TestHarness.h>
 
@@ -566,6 +567,52 @@ TEST( NonlinearOptimizer, logfile )
 //  EXPECT(actual.str()==expected.str());
 }
 
+/* ************************************************************************* */
+namespace {
+// Counts the records of each (source, metric) pair
+struct CountingSink : public MetricsSink {
+  std::map<std::pair<string, string>, size_t> counts;
+  void record(const string& source, size_t, const string& metric,
+              double) override {
+    counts[std::make_pair(source, metric)]++;
+  }
+  size_t count(const string& source, const string& metric) const {
+    auto it = counts.find(std::make_pair(source, metric));
+    return it == counts.end() ? 0 : it->second;
+  }
+};
+}  // namespace
+
+TEST(NonlinearOptimizer, metrics) {
+  NonlinearFactorGraph fg(example::createReallyNonlinearFactorGraph());
+  Values c0;
+  c0.insert(X(1), Point2(3, 3));
+
+  auto sink = boost::make_shared<CountingSink>();
+  setMetricsSink(sink);
+  LevenbergMarquardtOptimizer lm(fg, c0);
+  lm.optimize();
+  GaussNewtonOptimizer gn(fg, c0);
+  gn.optimize();
+  DoglegOptimizer dl(fg, c0);
+  dl.optimize();
+  setMetricsSink(nullptr);
+
+  // One record per iteration, or per lambda trial for LM
+  EXPECT_LONGS_EQUAL(lm.iterations(),
+                     sink->count("LevenbergMarquardtOptimizer", "linearize_seconds"));
+  EXPECT(sink->count("LevenbergMarquardtOptimizer", "lambda") >= lm.iterations());
+  EXPECT(sink->count("LevenbergMarquardtOptimizer", "solve_seconds") > 0);
+  EXPECT_LONGS_EQUAL(gn.iterations(), sink->count("GaussNewtonOptimizer", "error"));
+  EXPECT_LONGS_EQUAL(dl.iterations(), sink->count("DoglegOptimizer", "trust_region"));
+  EXPECT(sink->count("EliminatableClusterTree", "flops") > 0);
+
+  // Nothing is reported without a sink
+  const auto counts = sink->counts;
+  LevenbergMarquardtOptimizer(fg, c0).optimize();
+  EXPECT(counts == sink->counts);
+}
+
 /* ************************************************************************* */
 //// Minimal traits example
 struct MyType : public Vector3 {
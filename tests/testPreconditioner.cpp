@@ -122,6 +122,74 @@ TEST(PCGSolver, simpleLinearSystem) {
   EXPECT(assert_equal(expectedSolution, deltaPCGJacobi, 1e-5));
   //deltaPCGJacobi.print("PCG Jacobi");
 
+  // With incomplete Cholesky preconditioners, IC(0) and ICT
+  pcg->preconditioner_ = boost::make_shared<gtsam::IncompleteCholeskyPreconditionerParameters>();
+  VectorValues deltaPCGIC0 = PCGSolver(*pcg).optimize(simpleGFG);
+  EXPECT(assert_equal(expectedSolution, deltaPCGIC0, 1e-5));
+
+  pcg->preconditioner_ = boost::make_shared<gtsam::IncompleteCholeskyPreconditionerParameters>(1e-3, 2);
+  VectorValues deltaPCGICT = PCGSolver(*pcg).optimize(simpleGFG);
+  EXPECT(assert_equal(expectedSolution, deltaPCGICT, 1e-5));
+
+  // With cluster-Jacobi preconditioner
+  pcg->preconditioner_ = boost::make_shared<gtsam::ClusterJacobiPreconditionerParameters>(4);
+  VectorValues deltaPCGCluster = PCGSolver(*pcg).optimize(simpleGFG);
+  EXPECT(assert_equal(expectedSolution, deltaPCGCluster, 1e-5));
+}
+
+/* ************************************************************************* */
+TEST(Preconditioner, incompleteCholesky) {
+  // A chain has no fill-in, so IC(0) is the exact Cholesky factor
+  GaussianFactorGraph gfg;
+  SharedDiagonal unit2 = noiseModel::Unit::Create(2);
+  gfg += JacobianFactor(0, 2 * I_2x2, Vector2(1, 2), unit2);
+  gfg += JacobianFactor(0, -I_2x2, 1, I_2x2, Vector2(3, 4), unit2);
+  gfg += JacobianFactor(1, -I_2x2, 2, 3 * I_2x2, Vector2(5, 6), unit2);
+  const KeyInfo keyInfo(gfg);
+
+  IncompleteCholeskyPreconditioner ic;
+  ic.build(gfg, keyInfo, std::map<Key, Vector>());
+  DOUBLES_EQUAL(0.0, ic.shift(), 1e-9);
+
+  // M^{-1} = L^{-T} L^{-1} is the inverse Hessian
+  const Matrix H = gfg.hessian(keyInfo.ordering()).first;
+  Matrix actual(6, 6);
+  Vector y(6), x(6);
+  for (size_t j = 0; j < 6; j++) {
+    ic.solve(Vector::Unit(6, j), y);
+    ic.transposeSolve(y, x);
+    actual.col(j) = x;
+  }
+  EXPECT(assert_equal(Matrix(H.inverse()), actual, 1e-9));
+}
+
+/* ************************************************************************* */
+TEST(Preconditioner, clusterJacobi) {
+  GaussianFactorGraph gfg;
+  SharedDiagonal unit2 = noiseModel::Unit::Create(2);
+  gfg += JacobianFactor(0, 2 * I_2x2, Vector2(1, 2), unit2);
+  gfg += JacobianFactor(0, -I_2x2, 1, I_2x2, Vector2(3, 4), unit2);
+  gfg += JacobianFactor(1, -I_2x2, 2, 3 * I_2x2, Vector2(5, 6), unit2);
+  gfg += JacobianFactor(2, -I_2x2, 3, 10 * I_2x2, Vector2(5, 6), unit2);
+  const KeyInfo keyInfo(gfg);
+
+  // Variable 0 takes 1, after which 2 does not fit, and 2 takes 3
+  ClusterJacobiPreconditioner cluster(ClusterJacobiPreconditionerParameters(4));
+  cluster.build(gfg, keyInfo, std::map<Key, Vector>());
+  EXPECT_LONGS_EQUAL(2, cluster.nrClusters());
+  const std::vector<std::vector<size_t> > expected{{0, 1}, {2, 3}};
+  EXPECT(expected == cluster.clusters());
+
+  // One cluster for everything is an exact preconditioner
+  ClusterJacobiPreconditioner exact(ClusterJacobiPreconditionerParameters(8));
+  exact.build(gfg, keyInfo, std::map<Key, Vector>());
+  EXPECT_LONGS_EQUAL(1, exact.nrClusters());
+  const Matrix H = gfg.hessian(keyInfo.ordering()).first;
+  Vector y(8), x(8);
+  const Vector b = Vector::LinSpaced(8, 1, 8);
+  exact.solve(b, y);
+  exact.transposeSolve(y, x);
+  EXPECT(assert_equal(Vector(H.inverse() * b), x, 1e-9));
 }
 
 /* ************************************************************************* */
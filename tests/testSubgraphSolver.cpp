@@ -24,11 +24,14 @@
 #include <gtsam/linear/SubgraphBuilder.h>
 #include <gtsam/inference/Symbol.h>
 #include <gtsam/inference/Ordering.h>
+#include <gtsam/base/DSFVector.h>
 #include <gtsam/base/numericalDerivative.h>
+#include <gtsam/base/TestableAssertions.h>
 
 #include <CppUnitLite/TestHarness.h>
 
 #include <boost/assign/std/list.hpp>
+#include <boost/make_shared.hpp>
 using namespace boost::assign;
 
 using namespace std;
@@ -132,6 +135,117 @@ TEST( SubgraphSolver, constructor3 )
   DOUBLES_EQUAL(0.0, error(Ab, optimized), 1e-5);
 }
 
+/* ************************************************************************* */
+TEST( SubgraphSolver, packed )
+{
+  // Build a planar graph
+  GaussianFactorGraph Ab;
+  VectorValues xtrue;
+  size_t N = 3;
+  std::tie(Ab, xtrue) = example::planarGraph(N); // A*x-b
+
+  GaussianFactorGraph::shared_ptr Ab1, Ab2; // A1*x-b1 and A2*x-b2
+  std::tie(Ab1, Ab2) = example::splitOffPlanarTree(N, Ab);
+
+  // Same solution when the constraints A2 are packed in a JacobianOperator
+  SubgraphSolverParameters parameters;
+  SubgraphSolver expected(*Ab1, Ab2, parameters, kOrdering);
+  parameters.setBlasKernel(ConjugateGradientParameters::PACKED);
+  SubgraphSolver solver(*Ab1, Ab2, parameters, kOrdering);
+  VectorValues optimized = solver.optimize();
+  DOUBLES_EQUAL(0.0, error(Ab, optimized), 1e-5);
+  EXPECT(assert_equal(expected.optimize(), optimized, 1e-9));
+}
+
+/* ************************************************************************* */
+TEST( SubgraphSolver, kruskal )
+{
+  // Large enough for Filter-Kruskal to split the edges
+  GaussianFactorGraph Ab;
+  VectorValues xtrue;
+  std::tie(Ab, xtrue) = example::planarGraph(50);
+  EXPECT(Ab.size() > 4096);
+
+  SubgraphBuilderParameters params;
+  params.skeletonWeight = SubgraphBuilderParameters::EQUAL;
+  params.augmentationFactor = 0.0;
+  const Subgraph subgraph = SubgraphBuilder(params)(Ab);
+
+  // With equal weights, the tree is built greedily in factor order
+  const FastMap<Key, size_t> ordering = Ordering::Natural(Ab).invert();
+  DSFVector dsf(ordering.size());
+  vector<size_t> expected(1, 0);  // the prior on x11
+  for (size_t i = 1; i < Ab.size(); i++) {
+    const size_t u = ordering.at(Ab[i]->keys()[0]),
+                 v = ordering.at(Ab[i]->keys()[1]);
+    if (dsf.find(u) != dsf.find(v)) {
+      dsf.merge(u, v);
+      expected.push_back(i);
+    }
+  }
+  EXPECT_LONGS_EQUAL(2500, expected.size());
+  vector<size_t> actual = subgraph.edgeIndices();
+  sort(actual.begin(), actual.end());
+  EXPECT(expected == actual);
+}
+
+/* ************************************************************************* */
+// Chain of 1D variables 0..n-1 with a prior on 0, and skip edges i -> i+2
+static GaussianFactorGraph growChain(const GaussianFactorGraph& graph,
+                                     size_t n) {
+  GaussianFactorGraph result = graph;
+  auto unit = noiseModel::Unit::Create(1);
+  if (result.empty()) result += JacobianFactor(0, I_1x1, Vector1(0.0), unit);
+  for (Key i = result.keys().size(); i < n; i++) {
+    result += JacobianFactor(i - 1, -I_1x1 * (1.0 + i % 3), i,
+                             I_1x1 * (1.0 + i % 3), Vector1(1.0), unit);
+    if (i >= 2)
+      result += JacobianFactor(i - 2, -I_1x1 * (0.5 + i % 5), i,
+                               I_1x1 * (0.5 + i % 5), Vector1(2.0), unit);
+  }
+  return result;
+}
+
+/* ************************************************************************* */
+TEST( SubgraphSolver, treeCache )
+{
+  SubgraphSolverParameters parameters;
+  parameters.builderParams.skeletonWeight = SubgraphBuilderParameters::LHS_FNORM;
+  parameters.builderParams.augmentationFactor = 0.0;
+  parameters.builderParams.treeCache = boost::make_shared<SpanningTreeCache>();
+  // Converge well below the tolerance the solution is compared with
+  parameters.setEpsilon_rel(1e-10);
+  parameters.setEpsilon_abs(1e-10);
+  const SpanningTreeCache& cache = *parameters.builderParams.treeCache;
+  SubgraphBuilderParameters uncached = parameters.builderParams;
+  uncached.treeCache.reset();
+
+  GaussianFactorGraph graph;
+  for (size_t n : {10, 20, 35}) {
+    graph = growChain(graph, n);
+    const Subgraph subgraph = SubgraphBuilder(parameters.builderParams)(graph);
+    EXPECT_LONGS_EQUAL(graph.size(), cache.nrFactors());
+
+    // Extending the cached tree yields the same tree as building from scratch
+    vector<size_t> expected = SubgraphBuilder(uncached)(graph).edgeIndices(),
+                   actual = subgraph.edgeIndices();
+    sort(expected.begin(), expected.end());
+    sort(actual.begin(), actual.end());
+    EXPECT(expected == actual);
+
+    // The solver uses the cache as well
+    const Ordering ordering = Ordering::Natural(graph);
+    SubgraphSolver solver(graph, parameters, ordering);
+    EXPECT(assert_equal(graph.optimize(), solver.optimize(), 1e-5));
+  }
+  EXPECT_LONGS_EQUAL(1, cache.nrRebuilds());
+  EXPECT_LONGS_EQUAL(5, cache.nrUpdates());
+
+  // A different graph invalidates the cache
+  SubgraphBuilder(parameters.builderParams)(growChain(GaussianFactorGraph(), 5));
+  EXPECT_LONGS_EQUAL(2, cache.nrRebuilds());
+}
+
 /* ************************************************************************* */
 int main() { TestResult tr; return TestRegistry::runAllTests(tr); }
 /* ************************************************************************* */
@@ -0,0 +1,318 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    Benchmark.h
+ * @brief   Minimal benchmark registry and runner used by timeBenchmarks
+ * @date    October 2026
+ *
+ * Cases are registered with a setup function that builds the problem at a
+ * given scale and returns the code to time. The runner times one warm-up run
+ * and a number of repetitions of each case for every requested thread count,
+ * prints a table, writes JSON, and compares medians against a baseline JSON
+ * written by an earlier run.
+ */
+
+#pragma once
+
+#include <gtsam/base/Metrics.h>
+#include <gtsam/config.h>
+
+#ifdef GTSAM_USE_TBB
+#include <tbb/task_arena.h>
+#endif
+
+#include <boost/make_shared.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <ctime>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <numeric>
+#include <regex>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace gtsam {
+namespace benchmark {
+
+/// Builds a case at the given scale and returns the code to time
+typedef std::function<std::function<void()>(size_t scale)> Setup;
+
+/// A registered case, run once per scale, or once if there are no scales
+struct Case {
+  std::string name;
+  std::vector<size_t> scales;
+  Setup setup;
+};
+
+inline std::vector<Case>& Registry() {
+  static std::vector<Case> cases;
+  return cases;
+}
+
+/// Register a case named "name/scale" for each scale
+inline void Register(const std::string& name, const std::vector<size_t>& scales,
+                     const Setup& setup) {
+  Registry().push_back(Case{name, scales, setup});
+}
+
+/// Timing statistics of one case at one scale and thread count
+struct Result {
+  std::string name;
+  size_t threads;
+  size_t repetitions;
+  double minSeconds, medianSeconds, meanSeconds, stddevSeconds;
+  double flops;  ///< per run, estimated by the eliminations, 0 if none
+};
+
+/// Command line options
+struct Options {
+  std::string filter = ".*";
+  size_t repetitions = 5;
+  std::vector<size_t> threads = {1};
+  std::string json, baseline;
+  double threshold = 0.1;  ///< relative slow-down reported as a regression
+  bool list = false;
+};
+
+inline std::vector<size_t> ParseList(const std::string& s) {
+  std::vector<size_t> result;
+  std::stringstream ss(s);
+  std::string item;
+  while (std::getline(ss, item, ',')) result.push_back(std::stoul(item));
+  if (result.empty()) throw std::invalid_argument("empty list: " + s);
+  return result;
+}
+
+inline Options ParseOptions(int argc, char* argv[]) {
+  Options options;
+  for (int i = 1; i < argc; i++) {
+    const std::string arg = argv[i];
+    const size_t eq = arg.find('=');
+    const std::string key = arg.substr(0, eq);
+    const std::string value = eq == std::string::npos ? "" : arg.substr(eq + 1);
+    if (key == "--filter") options.filter = value;
+    else if (key == "--repetitions") options.repetitions = std::stoul(value);
+    else if (key == "--threads") options.threads = ParseList(value);
+    else if (key == "--json") options.json = value;
+    else if (key == "--baseline") options.baseline = value;
+    else if (key == "--threshold") options.threshold = std::stod(value);
+    else if (key == "--list") options.list = true;
+    else
+      throw std::invalid_argument(
+          "Usage: " + std::string(argv[0]) +
+          " [--list] [--filter=REGEX] [--repetitions=N] [--threads=1,2,4]"
+          " [--json=FILE] [--baseline=FILE] [--threshold=0.1]");
+  }
+  if (options.repetitions == 0)
+    throw std::invalid_argument("--repetitions must be positive");
+  return options;
+}
+
+/// Sums the flop estimates reported by EliminatableClusterTree
+class FlopCounter : public MetricsSink {
+ public:
+  void record(const std::string& source, size_t, const std::string& metric,
+              double value) override {
+    if (source == "EliminatableClusterTree" && metric == "flops") {
+      std::lock_guard<std::mutex> lock(mutex_);
+      flops_ += value;
+    }
+  }
+  double flops() const { return flops_; }
+
+ private:
+  std::mutex mutex_;
+  double flops_ = 0;
+};
+
+/// Run f with at most the given number of threads
+inline void RunWithThreads(size_t threads, const std::function<void()>& f) {
+#ifdef GTSAM_USE_TBB
+  tbb::task_arena arena(static_cast<int>(threads));
+  arena.execute(f);
+#else
+  (void)threads;
+  f();
+#endif
+}
+
+inline Result Time(const std::string& name, size_t threads, size_t repetitions,
+                   const std::function<void()>& body) {
+  // The warm-up run also counts flops, timed runs report into no sink
+  const auto counter = boost::make_shared<FlopCounter>();
+  setMetricsSink(counter);
+  RunWithThreads(threads, body);
+  setMetricsSink(nullptr);
+
+  std::vector<double> times;
+  for (size_t r = 0; r < repetitions; r++) {
+    const auto start = std::chrono::steady_clock::now();
+    RunWithThreads(threads, body);
+    times.push_back(std::chrono::duration<double>(
+                        std::chrono::steady_clock::now() - start).count());
+  }
+  std::sort(times.begin(), times.end());
+  const size_t n = times.size();
+  const double mean = std::accumulate(times.begin(), times.end(), 0.0) / n;
+  double variance = 0;
+  for (double t : times) variance += (t - mean) * (t - mean);
+  const double median =
+      n % 2 ? times[n / 2] : 0.5 * (times[n / 2 - 1] + times[n / 2]);
+  return Result{name,   threads,  repetitions,
+                times.front(), median, mean,
+                std::sqrt(variance / n), counter->flops()};
+}
+
+/// Run all cases matching the filter, printing one line per result
+inline std::vector<Result> Run(const Options& options) {
+  std::vector<size_t> threads = options.threads;
+#ifndef GTSAM_USE_TBB
+  if (threads != std::vector<size_t>{1})
+    std::cout << "GTSAM is built without TBB, running single-threaded only\n";
+  threads = {1};
+#endif
+  const std::regex filter(options.filter);
+  std::vector<Result> results;
+  for (const Case& c : Registry()) {
+    const std::vector<size_t> scales =
+        c.scales.empty() ? std::vector<size_t>{0} : c.scales;
+    for (size_t scale : scales) {
+      const std::string name =
+          c.scales.empty() ? c.name : c.name + "/" + std::to_string(scale);
+      if (!std::regex_search(name, filter)) continue;
+      if (options.list) {
+        std::cout << name << "\n";
+        continue;
+      }
+      const std::function<void()> body = c.setup(scale);
+      for (size_t t : threads) {
+        results.push_back(Time(name, t, options.repetitions, body));
+        const Result& r = results.back();
+        std::cout << std::left << std::setw(40) << r.name << std::right
+                  << std::setw(4) << r.threads << std::fixed
+                  << std::setprecision(3) << std::setw(12)
+                  << 1e3 * r.medianSeconds << " ms" << std::setw(12)
+                  << 1e3 * r.minSeconds << " ms";
+        if (r.flops > 0)
+          std::cout << std::setw(10) << r.flops / r.medianSeconds * 1e-9
+                    << " GFLOP/s";
+        std::cout << std::defaultfloat << std::endl;
+      }
+    }
+  }
+  return results;
+}
+
+inline void WriteJson(const std::vector<Result>& results,
+                      const std::string& filename) {
+  std::ofstream os(filename.c_str());
+  if (!os) throw std::invalid_argument("Benchmark: can not open " + filename);
+  const std::time_t now = std::time(nullptr);
+  char date[32];
+  std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+#ifdef GTSAM_USE_TBB
+  const bool tbb = true;
+#else
+  const bool tbb = false;
+#endif
+#ifdef __VERSION__
+  const char* compiler = __VERSION__;
+#else
+  const char* compiler = "unknown";
+#endif
+  os << std::setprecision(17);
+  os << "{\n  \"context\": {\"date\":\"" << date << "\",\"gtsam_version\":\""
+     << GTSAM_VERSION_STRING << "\",\"compiler\":\"" << compiler
+     << "\",\"tbb\":" << (tbb ? "true" : "false")
+     << ",\"hardware_threads\":" << std::thread::hardware_concurrency()
+     << "},\n  \"benchmarks\": [\n";
+  for (size_t i = 0; i < results.size(); i++) {
+    const Result& r = results[i];
+    // One result per line, which is what ReadBaseline expects
+    os << "    {\"name\":\"" << r.name << "\",\"threads\":" << r.threads
+       << ",\"repetitions\":" << r.repetitions
+       << ",\"min_seconds\":" << r.minSeconds
+       << ",\"median_seconds\":" << r.medianSeconds
+       << ",\"mean_seconds\":" << r.meanSeconds
+       << ",\"stddev_seconds\":" << r.stddevSeconds
+       << ",\"flops\":" << r.flops << "}"
+       << (i + 1 < results.size() ? ",\n" : "\n");
+  }
+  os << "  ]\n}\n";
+}
+
+/// Median seconds by name and thread count, from a file written by WriteJson
+inline std::map<std::pair<std::string, size_t>, double> ReadBaseline(
+    const std::string& filename) {
+  std::ifstream is(filename.c_str());
+  if (!is) throw std::invalid_argument("Benchmark: can not open " + filename);
+  const std::regex entry(
+      "\"name\":\"([^\"]*)\",\"threads\":([0-9]+),.*"
+      "\"median_seconds\":([^,}]+)");
+  std::map<std::pair<std::string, size_t>, double> medians;
+  std::string line;
+  std::smatch match;
+  while (std::getline(is, line))
+    if (std::regex_search(line, match, entry))
+      medians[std::make_pair(match[1].str(), std::stoul(match[2].str()))] =
+          std::stod(match[3].str());
+  return medians;
+}
+
+/// Print the ratio to the baseline median, returns the number of regressions
+inline size_t Compare(const std::vector<Result>& results,
+                      const std::string& baseline, double threshold) {
+  const auto medians = ReadBaseline(baseline);
+  size_t regressions = 0;
+  std::cout << "\nComparison with " << baseline << " (median time ratio):\n";
+  for (const Result& r : results) {
+    const auto it = medians.find(std::make_pair(r.name, r.threads));
+    if (it == medians.end()) continue;
+    const double ratio = r.medianSeconds / it->second;
+    std::cout << std::left << std::setw(40) << r.name << std::right
+              << std::setw(4) << r.threads << std::fixed
+              << std::setprecision(3) << std::setw(10) << ratio
+              << std::defaultfloat;
+    if (ratio > 1 + threshold) {
+      std::cout << "  REGRESSION";
+      regressions++;
+    } else if (ratio < 1 - threshold) {
+      std::cout << "  improved";
+    }
+    std::cout << std::endl;
+  }
+  return regressions;
+}
+
+/// Parse options, run, and return non-zero if there were regressions
+inline int Main(int argc, char* argv[]) {
+  const Options options = ParseOptions(argc, argv);
+  const std::vector<Result> results = Run(options);
+  if (!options.json.empty()) WriteJson(results, options.json);
+  if (!options.baseline.empty() &&
+      Compare(results, options.baseline, options.threshold) > 0)
+    return 1;
+  return 0;
+}
+
+}  // namespace benchmark
+}  // namespace gtsam
@@ -0,0 +1,108 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    timeBayesTreeSnapshot.cpp
+ * @brief   Time Bayes tree snapshots against boost serialization
+ * @date    October 2026
+ */
+
+#include <gtsam/linear/BayesTreeSnapshot.h>
+#include <gtsam/linear/GaussianFactorGraph.h>
+#include <gtsam/base/serialization.h>
+
+#include <boost/filesystem/operations.hpp>
+#include <boost/serialization/export.hpp>
+
+#include <chrono>
+#include <iostream>
+#include <random>
+
+using namespace std;
+using namespace gtsam;
+
+BOOST_CLASS_EXPORT_GUID(noiseModel::Diagonal, "gtsam_noiseModel_Diagonal");
+BOOST_CLASS_EXPORT_GUID(noiseModel::Unit, "gtsam_noiseModel_Unit");
+
+/// Wall-clock seconds taken by f
+template <typename F>
+static double seconds(const F& f) {
+  const auto start = chrono::steady_clock::now();
+  f();
+  return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+/// Size of a file in MB
+static double megabytes(const string& filename) {
+  return boost::filesystem::file_size(filename) / 1e6;
+}
+
+/// Random tree of 3-dimensional variables, which eliminates to n cliques
+static GaussianFactorGraph randomTree(size_t n) {
+  std::mt19937 rng(42);
+  std::normal_distribution<double> normal;
+  const auto random3 = [&]() {
+    Matrix3 A;
+    for (size_t k = 0; k < 9; k++) A(k) = normal(rng);
+    return Matrix(A + 5 * I_3x3);
+  };
+  GaussianFactorGraph graph;
+  const SharedDiagonal unit = noiseModel::Unit::Create(3);
+  graph.add(0, random3(), Vector3(1, 2, 3), unit);
+  for (size_t i = 1; i < n; i++) {
+    std::uniform_int_distribution<size_t> parent(0, i - 1);
+    graph.add(i, random3(), parent(rng), random3(), Vector3::Constant(i), unit);
+  }
+  return graph;
+}
+
+int main(int argc, char* argv[]) {
+  const size_t n = argc > 1 ? atoi(argv[1]) : 100000;
+  const string snapshotFile =
+      (boost::filesystem::temp_directory_path() / "timeBayesTree.bin").string();
+  const string boostFile =
+      (boost::filesystem::temp_directory_path() / "timeBayesTree.boost").string();
+#ifdef GTSAM_USE_TBB
+  cout << "Parallel with TBB" << endl;
+#else
+  cout << "Serial, configure with GTSAM_WITH_TBB to time parallel use" << endl;
+#endif
+
+  // Eliminating leaves first gives one clique per variable
+  Ordering ordering;
+  for (size_t i = n; i-- > 0;) ordering.push_back(i);
+  const GaussianBayesTree bayesTree =
+      *randomTree(n).eliminateMultifrontal(ordering);
+  cout << "Bayes tree with " << bayesTree.size() << " cliques" << endl;
+
+  const double boostWrite =
+      seconds([&] { serializeToBinaryFile(bayesTree, boostFile, "bayesTree"); });
+  const double boostRead = seconds([&] {
+    GaussianBayesTree result;
+    deserializeFromBinaryFile(boostFile, result, "bayesTree");
+  });
+  cout << "  boost serialization: " << megabytes(boostFile) << " MB, write "
+       << boostWrite << " s, read " << boostRead << " s" << endl;
+
+  const double snapshotWrite =
+      seconds([&] { writeBayesTreeSnapshot(bayesTree, snapshotFile); });
+  GaussianBayesTree restored;
+  const double snapshotRead =
+      seconds([&] { restored = readBayesTreeSnapshot(snapshotFile); });
+  cout << "  snapshot:            " << megabytes(snapshotFile) << " MB, write "
+       << snapshotWrite << " s, read " << snapshotRead << " s" << endl;
+  if (!assert_equal(bayesTree.optimize(), restored.optimize()))
+    cout << "  snapshot does not match the Bayes tree" << endl;
+
+  boost::filesystem::remove(snapshotFile);
+  boost::filesystem::remove(boostFile);
+  return 0;
+}
@@ -0,0 +1,215 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    timeBenchmarks.cpp
+ * @brief   Benchmark suite for linearization, ordering, elimination and ISAM2
+ * @date    October 2026
+ *
+ * Runs the registered cases on the examples/Data graphs and on the seeded
+ * synthetic pose graph, SfM and VIO problems at several scales, e.g.
+ *   timeBenchmarks --filter=eliminate --threads=1,4 --json=new.json
+ *   timeBenchmarks --baseline=old.json --threshold=0.05
+ * With a baseline, the exit code is 1 if any median slowed down by more
+ * than the threshold.
+ */
+
+#include "Benchmark.h"
+
+#include <gtsam/slam/dataset.h>
+#include <gtsam/slam/BetweenFactor.h>
+#include <gtsam/slam/SyntheticProblems.h>
+#include <gtsam/navigation/SyntheticVio.h>
+#include <gtsam/nonlinear/ISAM2.h>
+#include <gtsam/nonlinear/LevenbergMarquardtOptimizer.h>
+#include <gtsam/linear/GaussianFactorGraph.h>
+#include <gtsam/inference/Ordering.h>
+#include <gtsam/inference/Symbol.h>
+#include <gtsam/base/cholesky.h>
+
+#include <map>
+#include <random>
+
+using namespace std;
+using namespace gtsam;
+
+/// Factor graph and initial estimate of a benchmark problem
+struct Problem {
+  NonlinearFactorGraph graph;
+  Values initial;
+};
+
+/// Compose the odometry edges (i, i+1) of files that have no initial estimate
+template <class POSE>
+static Values composeOdometry(const NonlinearFactorGraph& graph) {
+  map<Key, POSE> odometry;
+  for (const auto& factor : graph) {
+    const auto between = boost::dynamic_pointer_cast<BetweenFactor<POSE>>(factor);
+    if (between && between->key2() == between->key1() + 1)
+      odometry.emplace(between->key1(), between->measured());
+  }
+  Values initial;
+  POSE pose;
+  initial.insert(0, pose);
+  for (Key i = 0; odometry.count(i); i++) {
+    pose = pose * odometry[i];
+    initial.insert(i + 1, pose);
+  }
+  return initial;
+}
+
+/// Load an example data set once, anchored with a prior on the first pose
+static const Problem& dataset(const string& name, bool is3D) {
+  static map<string, Problem> cache;
+  auto it = cache.find(name);
+  if (it == cache.end()) {
+    const string filename = findExampleDataFile(name);
+    const GraphAndValues loaded = is3D ? load3D(filename) : load2D(filename);
+    Problem problem{*loaded.first, *loaded.second};
+    if (problem.initial.empty())
+      problem.initial = is3D ? composeOdometry<Pose3>(problem.graph)
+                             : composeOdometry<Pose2>(problem.graph);
+    const Key first = problem.initial.keys().front();
+    if (is3D)
+      problem.graph.addPrior(first, problem.initial.at<Pose3>(first),
+                             noiseModel::Isotropic::Sigma(6, 1e-3));
+    else
+      problem.graph.addPrior(first, problem.initial.at<Pose2>(first),
+                             noiseModel::Isotropic::Sigma(3, 1e-3));
+    it = cache.emplace(name, std::move(problem)).first;
+  }
+  return it->second;
+}
+
+/// Benchmark problem from the output of a synthetic generator
+static Problem synthetic(const GraphAndValues& generated) {
+  return Problem{*generated.first, *generated.second};
+}
+
+/// Pose3 lattice of about n poses, with 10 x 10 layers
+static Problem gridPoseGraph(size_t n) {
+  GridPoseGraphParams params;
+  params.layers = std::max<size_t>(1, n / 100);
+  return synthetic(generateGridPoseGraph(params));
+}
+
+static Problem manhattanWorld(size_t n) {
+  ManhattanWorldParams params;
+  params.nrPoses = n;
+  return synthetic(generateManhattanWorld(params));
+}
+
+static Problem sfm(size_t nrCameras) {
+  SyntheticSfmParams params;
+  params.nrCameras = nrCameras;
+  Problem problem = synthetic(generateSyntheticSfm(params));
+  // Fix the gauge as in SFMExample_bal
+  const Key p0 = symbol_shorthand::P(0);
+  problem.graph.addPrior(0, problem.initial.at<SfmCamera>(0),
+                         noiseModel::Isotropic::Sigma(9, 0.1));
+  problem.graph.addPrior(p0, problem.initial.at<Point3>(p0),
+                         noiseModel::Isotropic::Sigma(3, 0.1));
+  return problem;
+}
+
+static Problem vio(size_t nrKeyframes) {
+  SyntheticVioParams params;
+  params.nrKeyframes = nrKeyframes;
+  const ConstantTwistScenario circle(Vector3(0, 0, 0.1), Vector3(2, 0, 0));
+  return synthetic(generateSyntheticVio(circle, params));
+}
+
+/// Cases that time linearize, COLAMD and, if built with nested dissection,
+/// METIS orderings, eliminate and a few LM iterations
+static void registerBatchCases(const string& name, const vector<size_t>& scales,
+                               const function<Problem(size_t)>& create) {
+  benchmark::Register("linearize/" + name, scales, [create](size_t scale) {
+    const auto problem = boost::make_shared<Problem>(create(scale));
+    return [problem] { problem->graph.linearize(problem->initial); };
+  });
+  benchmark::Register("colamd/" + name, scales, [create](size_t scale) {
+    const Problem problem = create(scale);
+    const auto linear = problem.graph.linearize(problem.initial);
+    return [linear] { Ordering::Colamd(*linear); };
+  });
+#ifdef GTSAM_SUPPORT_NESTED_DISSECTION
+  benchmark::Register("metis/" + name, scales, [create](size_t scale) {
+    const Problem problem = create(scale);
+    const auto linear = problem.graph.linearize(problem.initial);
+    return [linear] { Ordering::Metis(*linear); };
+  });
+#endif
+  benchmark::Register("eliminate/" + name, scales, [create](size_t scale) {
+    const Problem problem = create(scale);
+    const auto linear = problem.graph.linearize(problem.initial);
+    const auto ordering = boost::make_shared<Ordering>(Ordering::Colamd(*linear));
+    return [linear, ordering] {
+      linear->eliminateMultifrontal(*ordering, EliminatePreferCholesky);
+    };
+  });
+  benchmark::Register("lm/" + name, scales, [create](size_t scale) {
+    const auto problem = boost::make_shared<Problem>(create(scale));
+    return [problem] {
+      LevenbergMarquardtParams params;
+      params.maxIterations = 3;
+      LevenbergMarquardtOptimizer(problem->graph, problem->initial, params)
+          .optimize();
+    };
+  });
+}
+
+static void registerCases() {
+  registerBatchCases("w20000", {}, [](size_t) { return dataset("w20000", false); });
+  registerBatchCases("sphere2500", {},
+                     [](size_t) { return dataset("sphere2500", true); });
+  registerBatchCases("grid3", {1000, 10000, 100000}, gridPoseGraph);
+  registerBatchCases("manhattan", {3500, 35000}, manhattanWorld);
+  registerBatchCases("sfm", {100, 1000}, sfm);
+  registerBatchCases("vio", {100, 1000}, vio);
+
+  // ISAM2 on the synthetic pose graph, one update per pose as generated
+  benchmark::Register("isam2/grid3", {1000, 5000}, [](size_t scale) {
+    GridPoseGraphParams params;
+    params.layers = scale / 100;
+    auto steps = boost::make_shared<vector<pair<NonlinearFactorGraph, Values>>>();
+    generateGridPoseGraph(params, [&steps](const NonlinearFactorGraph& factors,
+                                           const Values& values) {
+      steps->emplace_back(factors, values);
+    });
+    return [steps] {
+      ISAM2 isam;
+      for (const auto& step : *steps) isam.update(step.first, step.second);
+    };
+  });
+
+  // Dense partial Cholesky of a frontal block half the size of the matrix
+  benchmark::Register("cholesky", {100, 400, 1000}, [](size_t n) {
+    mt19937 rng(42);
+    normal_distribution<double> normal;
+    Matrix A(n, n);
+    for (size_t i = 0; i < n * n; i++) A.data()[i] = normal(rng);
+    const auto spd = boost::make_shared<Matrix>(A.transpose() * A);
+    return [spd, n] {
+      Matrix R = *spd;
+      choleskyPartial(R, n / 2);
+    };
+  });
+}
+
+int main(int argc, char* argv[]) {
+  try {
+    registerCases();
+    return benchmark::Main(argc, argv);
+  } catch (const std::exception& e) {
+    cerr << e.what() << endl;
+    return 2;
+  }
+}
@@ -0,0 +1,160 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    timeBinaryGraph.cpp
+ * @brief   Time binary graph files against boost serialization
+ * @date    October 2026
+ */
+
+#include <gtsam/slam/BinaryGraph.h>
+#include <gtsam/slam/BetweenFactor.h>
+#include <gtsam/slam/GeneralSFMFactor.h>
+#include <gtsam/nonlinear/PriorFactor.h>
+#include <gtsam/inference/Symbol.h>
+#include <gtsam/base/serialization.h>
+
+#include <boost/filesystem/operations.hpp>
+#include <boost/serialization/export.hpp>
+
+#include <chrono>
+#include <iostream>
+#include <random>
+
+using namespace std;
+using namespace gtsam;
+using symbol_shorthand::P;
+
+BOOST_CLASS_EXPORT_GUID(noiseModel::Isotropic, "gtsam_noiseModel_Isotropic");
+BOOST_CLASS_EXPORT_GUID(noiseModel::Diagonal, "gtsam_noiseModel_Diagonal");
+BOOST_CLASS_EXPORT_GUID(noiseModel::Unit, "gtsam_noiseModel_Unit");
+BOOST_CLASS_EXPORT_GUID(BetweenFactor<Pose3>, "gtsam::BetweenFactorPose3");
+BOOST_CLASS_EXPORT_GUID(PriorFactor<Pose3>, "gtsam::PriorFactorPose3");
+typedef GeneralSFMFactor<SfmCamera, Point3> SfmFactor;
+BOOST_CLASS_EXPORT_GUID(SfmFactor, "gtsam::SfmFactor");
+GTSAM_VALUE_EXPORT(Pose3);
+GTSAM_VALUE_EXPORT(Point3);
+GTSAM_VALUE_EXPORT(SfmCamera);
+
+/// Wall-clock seconds taken by f
+template <typename F>
+static double seconds(const F& f) {
+  const auto start = chrono::steady_clock::now();
+  f();
+  return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+/// Size of a file in MB
+static double megabytes(const string& filename) {
+  return boost::filesystem::file_size(filename) / 1e6;
+}
+
+/// Pose graph with odometry and random loop closures
+static GraphAndValues poseGraph(size_t n) {
+  std::mt19937 rng(42);
+  std::uniform_real_distribution<double> uniform(-1.0, 1.0);
+  std::uniform_int_distribution<size_t> pose(0, n - 1);
+  const auto graph = boost::make_shared<NonlinearFactorGraph>();
+  const auto values = boost::make_shared<Values>();
+  const SharedNoiseModel odometry = noiseModel::Diagonal::Sigmas(
+      (Vector6() << 0.01, 0.01, 0.01, 0.1, 0.1, 0.1).finished());
+  const auto random = [&]() {
+    return Pose3(Rot3::Ypr(uniform(rng), uniform(rng), uniform(rng)),
+                 Point3(uniform(rng), uniform(rng), uniform(rng)));
+  };
+  graph->addPrior(0, Pose3(), odometry);
+  for (size_t i = 0; i < n; i++) {
+    values->insert(i, random());
+    if (i > 0)
+      graph->emplace_shared<BetweenFactor<Pose3>>(i - 1, i, random(), odometry);
+    if (i % 10 == 0)
+      graph->emplace_shared<BetweenFactor<Pose3>>(pose(rng), i, random(),
+                                                  odometry);
+  }
+  return make_pair(graph, values);
+}
+
+/// Bundle adjustment problem with random cameras, points and measurements
+static GraphAndValues bundleAdjustment(size_t nrCameras, size_t nrPoints,
+                                       size_t trackLength) {
+  std::mt19937 rng(42);
+  std::uniform_real_distribution<double> uniform(-1.0, 1.0);
+  std::uniform_int_distribution<size_t> camera(0, nrCameras - 1);
+  const auto graph = boost::make_shared<NonlinearFactorGraph>();
+  const auto values = boost::make_shared<Values>();
+  const SharedNoiseModel pixel = noiseModel::Isotropic::Sigma(2, 1.0);
+  for (size_t i = 0; i < nrCameras; i++)
+    values->insert(i, SfmCamera(Pose3(Rot3::Ypr(uniform(rng), 0, 0),
+                                      Point3(uniform(rng), uniform(rng), 0)),
+                                Cal3Bundler(500, 1e-2, 1e-4)));
+  for (size_t j = 0; j < nrPoints; j++) {
+    values->insert(P(j), Point3(uniform(rng), uniform(rng), 10));
+    for (size_t k = 0; k < trackLength; k++)
+      graph->emplace_shared<SfmFactor>(
+          Point2(500 * uniform(rng), 500 * uniform(rng)), pixel, camera(rng),
+          P(j));
+  }
+  return make_pair(graph, values);
+}
+
+static void compare(const string& name, const GraphAndValues& problem) {
+  const string binaryFile =
+      (boost::filesystem::temp_directory_path() / "timeBinaryGraph.bin").string();
+  const string boostFile =
+      (boost::filesystem::temp_directory_path() / "timeBinaryGraph.boost").string();
+  const NonlinearFactorGraph& graph = *problem.first;
+  const Values& values = *problem.second;
+  cout << name << ", " << graph.size() << " factors, " << values.size()
+       << " values" << endl;
+
+  const double boostWrite = seconds([&] {
+    serializeToBinaryFile(graph, boostFile, "graph");
+    serializeToBinaryFile(values, boostFile + ".values", "values");
+  });
+  const double boostRead = seconds([&] {
+    NonlinearFactorGraph g;
+    Values v;
+    deserializeFromBinaryFile(boostFile, g, "graph");
+    deserializeFromBinaryFile(boostFile + ".values", v, "values");
+  });
+  cout << "  boost serialization: " << megabytes(boostFile) +
+                                           megabytes(boostFile + ".values")
+       << " MB, write " << boostWrite << " s, read " << boostRead << " s"
+       << endl;
+
+  const double binaryWrite =
+      seconds([&] { writeBinaryGraph(graph, values, binaryFile); });
+  size_t nrRows = 0;
+  const double binaryOpen = seconds([&] {
+    const BinaryGraphFile file(binaryFile);
+    for (const BinaryGraphColumns& s : file.sections()) nrRows += s.count;
+  });
+  const double binaryRead = seconds([&] { readBinaryGraph(binaryFile); });
+  cout << "  binary graph file:   " << megabytes(binaryFile) << " MB, write "
+       << binaryWrite << " s, read " << binaryRead << " s, map " << binaryOpen
+       << " s for " << nrRows << " rows" << endl;
+
+  boost::filesystem::remove(binaryFile);
+  boost::filesystem::remove(boostFile);
+  boost::filesystem::remove(boostFile + ".values");
+}
+
+int main(int argc, char* argv[]) {
+  const size_t scale = argc > 1 ? atoi(argv[1]) : 10;
+#ifdef GTSAM_USE_TBB
+  cout << "Parallel with TBB" << endl;
+#else
+  cout << "Serial, configure with GTSAM_WITH_TBB to time parallel use" << endl;
+#endif
+  compare("Pose3 graph", poseGraph(10000 * scale));
+  compare("Bundle adjustment", bundleAdjustment(100 * scale, 10000 * scale, 6));
+  return 0;
+}
@@ -0,0 +1,80 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    timeCalibrate.cpp
+ * @brief   Time undistortion of 2000 features per frame: scalar calibrate,
+ *          calibrateBatch, and UndistortionGrid, for all distortion models
+ * @date    October 2026
+ */
+
+#include <gtsam/geometry/BatchCalibration.h>
+
+#include <time.h>
+#include <iostream>
+#include <string>
+
+using namespace std;
+using namespace gtsam;
+
+typedef BatchProjection::Array Array;
+
+static double microseconds(long timeLog, long timeLog2, int n) {
+  return 1e6 * (double)(timeLog2 - timeLog) / CLOCKS_PER_SEC / n;
+}
+
+template <class CALIBRATION>
+static void timeCalibrate(const string& name, const CALIBRATION& K) {
+  const int nrFeatures = 2000, nrFrames = 200;
+  Array u = (Array::Random(nrFeatures) + 1.0) * 320.0;
+  Array v = (Array::Random(nrFeatures) + 1.0) * 240.0;
+  Array x(nrFeatures), y(nrFeatures);
+
+  long timeLog = clock();
+  for (int i = 0; i < nrFrames; i++)
+    for (int k = 0; k < nrFeatures; k++) {
+      const Point2 p = K.calibrate(Point2(u[k], v[k]));
+      x[k] = p.x();
+      y[k] = p.y();
+    }
+  long timeLog2 = clock();
+  cout << name << endl;
+  cout << "  scalar calibrate: " << microseconds(timeLog, timeLog2, nrFrames)
+       << " musecs/frame" << endl;
+
+  timeLog = clock();
+  for (int i = 0; i < nrFrames; i++) calibrateBatch(K, u, v, x, y);
+  timeLog2 = clock();
+  cout << "  calibrateBatch:   " << microseconds(timeLog, timeLog2, nrFrames)
+       << " musecs/frame" << endl;
+
+  timeLog = clock();
+  const UndistortionGrid<CALIBRATION> grid(K, 640, 480);
+  timeLog2 = clock();
+  cout << "  grid setup:       " << microseconds(timeLog, timeLog2, 1)
+       << " musecs" << endl;
+  timeLog = clock();
+  for (int i = 0; i < nrFrames; i++) grid.calibrate(u, v, x, y);
+  timeLog2 = clock();
+  cout << "  grid calibrate:   " << microseconds(timeLog, timeLog2, nrFrames)
+       << " musecs/frame" << endl;
+}
+
+int main() {
+  timeCalibrate("Cal3Bundler", Cal3Bundler(500, 0.1, 0.01, 320, 240));
+  timeCalibrate("Cal3DS2",
+                Cal3DS2(500, 480, 0.1, 320, 240, -0.2, 0.05, 1e-3, -2e-3));
+  timeCalibrate("Cal3Unified", Cal3Unified(500, 480, 0.1, 320, 240, -0.2, 0.05,
+                                           1e-3, -2e-3, 0.5));
+  timeCalibrate("Cal3Fisheye", Cal3Fisheye(300, 300, 0.0, 320, 240, -0.01,
+                                           4e-3, -2e-3, 1e-3));
+  return 0;
+}
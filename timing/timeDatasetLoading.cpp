@@ -0,0 +1,147 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    timeDatasetLoading.cpp
+ * @brief   Time the parallel dataset loaders on scaled-up example files
+ * @date    October 2026
+ */
+
+#include <gtsam/slam/dataset.h>
+
+#include <boost/filesystem/operations.hpp>
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <sstream>
+
+using namespace std;
+using namespace gtsam;
+
+/// Wall-clock seconds taken by f
+template <typename F>
+static double seconds(const F& f) {
+  const auto start = chrono::steady_clock::now();
+  f();
+  return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+/// Size of a file in MB
+static double megabytes(const string& filename) {
+  return boost::filesystem::file_size(filename) / 1e6;
+}
+
+/// Concatenate copies of an example g2o/TORO file, offsetting the vertex ids
+/// of every copy so that the copies are disjoint
+static string scaleUp(const string& name, size_t copies) {
+  const string input = findExampleDataFile(name);
+  vector<vector<string>> lines;
+  size_t maxId = 0;
+  ifstream is(input.c_str());
+  string text;
+  while (getline(is, text)) {
+    istringstream tokens(text);
+    vector<string> line((istream_iterator<string>(tokens)),
+                        istream_iterator<string>());
+    if (line.empty()) continue;
+    const size_t nrIds = line[0].compare(0, 6, "VERTEX") == 0 ? 1 : 2;
+    for (size_t k = 1; k <= nrIds && k < line.size(); k++)
+      maxId = max<size_t>(maxId, stoul(line[k]));
+    lines.push_back(line);
+  }
+
+  const string output =
+      (boost::filesystem::temp_directory_path() / ("scaled-" + name)).string();
+  ofstream os(output.c_str());
+  for (size_t c = 0; c < copies; c++)
+    for (const vector<string>& line : lines) {
+      const size_t nrIds = line[0].compare(0, 6, "VERTEX") == 0 ? 1 : 2;
+      os << line[0];
+      for (size_t k = 1; k < line.size(); k++)
+        os << " " << (k <= nrIds ? to_string(stoul(line[k]) + c * (maxId + 1))
+                                 : line[k]);
+      os << "\n";
+    }
+  return output;
+}
+
+/// A random BAL problem
+static string syntheticBAL(size_t nrCameras, size_t nrPoints,
+                           size_t trackLength) {
+  const string output =
+      (boost::filesystem::temp_directory_path() / "synthetic-bal.txt").string();
+  std::mt19937 rng(42);
+  std::uniform_real_distribution<double> uniform(-1.0, 1.0);
+  std::uniform_int_distribution<size_t> camera(0, nrCameras - 1);
+  ofstream os(output.c_str());
+  os.precision(10);
+  os << nrCameras << " " << nrPoints << " " << nrPoints * trackLength << "\n";
+  for (size_t j = 0; j < nrPoints; j++)
+    for (size_t k = 0; k < trackLength; k++)
+      os << camera(rng) << " " << j << " " << 500 * uniform(rng) << " "
+         << 500 * uniform(rng) << "\n";
+  for (size_t i = 0; i < nrCameras; i++) {
+    for (size_t k = 0; k < 6; k++) os << uniform(rng) << "\n";
+    os << "500\n" << 1e-2 * uniform(rng) << "\n" << 1e-4 * uniform(rng) << "\n";
+  }
+  for (size_t j = 0; j < 3 * nrPoints; j++) os << 10 * uniform(rng) << "\n";
+  return output;
+}
+
+int main(int argc, char* argv[]) {
+  const size_t copies = argc > 1 ? atoi(argv[1]) : 20;
+#ifdef GTSAM_USE_TBB
+  cout << "Parallel with TBB" << endl;
+#else
+  cout << "Serial, configure with GTSAM_WITH_TBB to time parallel use" << endl;
+#endif
+
+  // 2D odometry, against the stream-based parsers
+  const string file2D = scaleUp("w20000.txt", copies);
+  cout << "w20000.txt x " << copies << ", " << megabytes(file2D) << " MB" << endl;
+  const double stream2D = seconds([&] { parseFactors<Pose2>(file2D); });
+  cout << "  parseFactors<Pose2>: " << stream2D << " s" << endl;
+  size_t nrFactors = 0;
+  const double load2DTime =
+      seconds([&] { nrFactors = load2D(file2D).first->size(); });
+  cout << "  load2D:              " << load2DTime << " s, " << nrFactors
+       << " factors" << endl;
+
+  // 3D poses and edges, against the stream-based parsers
+  const string file3D = scaleUp("sphere2500.txt", copies);
+  cout << "sphere2500.txt x " << copies << ", " << megabytes(file3D) << " MB"
+       << endl;
+  const double stream3D = seconds([&] {
+    parseVariables<Pose3>(file3D);
+    parseFactors<Pose3>(file3D);
+  });
+  cout << "  parseVariables/Factors<Pose3>: " << stream3D << " s" << endl;
+  const double load3DTime =
+      seconds([&] { nrFactors = load3D(file3D).first->size(); });
+  cout << "  load3D:                        " << load3DTime << " s, "
+       << nrFactors << " factors" << endl;
+
+  // BAL
+  const string fileBAL = syntheticBAL(100 * copies, 10000 * copies, 6);
+  cout << "Synthetic BAL, " << megabytes(fileBAL) << " MB" << endl;
+  SfmData data;
+  const double balTime = seconds([&] { readBAL(fileBAL, data); });
+  cout << "  readBAL: " << balTime << " s, " << megabytes(fileBAL) / balTime
+       << " MB/s" << endl;
+
+  boost::filesystem::remove(file2D);
+  boost::filesystem::remove(file3D);
+  boost::filesystem::remove(fileBAL);
+  return 0;
+}
@@ -0,0 +1,84 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    timeImuPreintegration.cpp
+ * @brief   Time integrateMeasurement per sample against integrateMeasurements
+ * @date    October 2026
+ */
+
+#include <gtsam/navigation/ImuFactor.h>
+
+#include <chrono>
+#include <iostream>
+#include <random>
+
+using namespace std;
+using namespace gtsam;
+
+/// Wall-clock seconds taken by f
+template <typename F>
+static double seconds(const F& f) {
+  const auto start = chrono::steady_clock::now();
+  f();
+  return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char* argv[]) {
+  const size_t n = argc > 1 ? atoi(argv[1]) : 200, nrRepeats = 2000;
+#ifdef GTSAM_TANGENT_PREINTEGRATION
+  cout << "Tangent preintegration, " << n << " samples per batch" << endl;
+#else
+  cout << "Manifold preintegration, " << n << " samples per batch" << endl;
+#endif
+
+  auto p = PreintegrationParams::MakeSharedU(9.81);
+  p->accelerometerCovariance = 1e-4 * I_3x3;
+  p->gyroscopeCovariance = 1e-6 * I_3x3;
+  p->integrationCovariance = 1e-8 * I_3x3;
+
+  // Noisy measurements of a slowly turning, accelerating body at 200Hz
+  std::mt19937 rng(42);
+  std::normal_distribution<double> noise(0.0, 0.01);
+  Matrix accs(3, n), omegas(3, n), dts(1, n);
+  for (size_t j = 0; j < n; j++) {
+    accs.col(j) << 0.5 + noise(rng), noise(rng), 9.81 + noise(rng);
+    omegas.col(j) << noise(rng), noise(rng), 0.3 + noise(rng);
+    dts(0, j) = 0.005;
+  }
+
+  for (bool offset : {false, true}) {
+    if (offset) p->body_P_sensor = Pose3(Rot3::Ypr(0.1, 0, 0), Point3(0.1, 0, 0));
+    cout << (offset ? "With sensor offset" : "Sensor at body origin") << endl;
+
+    PreintegratedImuMeasurements perSample(p), batch(p);
+    const double single = seconds([&] {
+      for (size_t r = 0; r < nrRepeats; r++) {
+        perSample.resetIntegration();
+        for (size_t j = 0; j < n; j++)
+          perSample.integrateMeasurement(accs.col(j), omegas.col(j), dts(0, j));
+      }
+    });
+    cout << "  integrateMeasurement:  " << 1e9 * single / (nrRepeats * n)
+         << " nanosecs/sample" << endl;
+
+    const double batched = seconds([&] {
+      for (size_t r = 0; r < nrRepeats; r++) {
+        batch.resetIntegration();
+        batch.integrateMeasurements(accs, omegas, dts);
+      }
+    });
+    cout << "  integrateMeasurements: " << 1e9 * batched / (nrRepeats * n)
+         << " nanosecs/sample, covariance difference "
+         << (perSample.preintMeasCov() - batch.preintMeasCov()).norm() << endl;
+  }
+  return 0;
+}
@@ -18,6 +18,7 @@
 #include <iostream>
 
 #include <gtsam/base/timing.h>
+#include <gtsam/geometry/BatchLie.h>
 #include <gtsam/geometry/Pose3.h>
 
 using namespace std;
@@ -48,6 +49,25 @@ int main()
   TEST(between_derivatives, T.between(T2,H1,H2))
   TEST(Logmap, Pose3::Logmap(T.between(T2)))
 
+  // Batch versions against the scalar ones with derivatives, on the same
+  // number of elements: n / m calls on m poses each
+  const int m = 1000;
+  Matrix6X xis(6, m), logs(6, m);
+  for (int j = 0; j < m; j++) xis.col(j) = (0.5 + j / double(m)) * v;
+  vector<Pose3> poses(m);
+  vector<Matrix6, Eigen::aligned_allocator<Matrix6>> H(m);
+  auto expmapEach = [&]() {
+    for (int j = 0; j < m; j++) poses[j] = Pose3::Expmap(xis.col(j), H[j]);
+  };
+  auto logmapEach = [&]() {
+    for (int j = 0; j < m; j++) logs.col(j) = Pose3::Logmap(poses[j], H[j]);
+  };
+  n /= m;
+  TEST(Expmap_derivatives, expmapEach())
+  TEST(expmapBatch_derivatives, expmapBatch(xis, poses.data(), H.data()))
+  TEST(Logmap_derivatives, logmapEach())
+  TEST(logmapBatch_derivatives, logmapBatch(poses.data(), m, logs, H.data()))
+
   // Print timings
   tictoc_print_();
 
@@ -18,6 +18,7 @@
 #include <time.h>
 #include <iostream>
 
+#include <gtsam/geometry/BatchLie.h>
 #include <gtsam/geometry/Rot3.h>
 
 using namespace std;
@@ -51,5 +52,27 @@ int main() {
   TEST("Slow rotation matrix", Rot3::Rz(z) * Rot3::Ry(y) * Rot3::Rx(x))
   TEST("Fast Rotation matrix", Rot3::RzRyRx(x, y, z))
 
+  // Batch versions against the scalar ones, on 1000 rotations per call
+  const size_t m = 1000;
+  Matrix3X omegas(3, m), logs(3, m);
+  for (size_t j = 0; j < m; j++) omegas.col(j) = (0.5 + j / double(m)) * v;
+  vector<Rot3> rotations(m);
+  vector<Matrix3> H(m);
+  auto expmapEach = [&]() {
+    for (size_t j = 0; j < m; j++)
+      rotations[j] = Rot3::Expmap(omegas.col(j), H[j]);
+  };
+  auto logmapEach = [&]() {
+    for (size_t j = 0; j < m; j++)
+      logs.col(j) = Rot3::Logmap(rotations[j], H[j]);
+  };
+  n = 1000;
+  TEST("Expmap with derivatives, 1000 rotations", expmapEach())
+  TEST("expmapBatch with derivatives, 1000 rotations",
+       expmapBatch(omegas, rotations.data(), H.data()))
+  TEST("Logmap with derivatives, 1000 rotations", logmapEach())
+  TEST("logmapBatch with derivatives, 1000 rotations",
+       logmapBatch(rotations.data(), m, logs, H.data()))
+
   return 0;
 }
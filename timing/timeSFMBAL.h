@@ -21,10 +21,14 @@
 #include <gtsam/nonlinear/NonlinearFactorGraph.h>
 #include <gtsam/nonlinear/Values.h>
 #include <gtsam/linear/NoiseModel.h>
+#include <gtsam/linear/PCGSolver.h>
+#include <gtsam/linear/Preconditioner.h>
 #include <gtsam/inference/Ordering.h>
 #include <gtsam/inference/Symbol.h>
 #include <gtsam/base/timing.h>
 
+#include <boost/make_shared.hpp>
+
 #include <string>
 #include <vector>
 
@@ -35,16 +39,43 @@ using symbol_shorthand::K;
 using symbol_shorthand::P;
 
 static bool gUseSchur = true;
+static bool gUseSchurSolver = false;
+static bool gPackedPCG = false;
+static PreconditionerParameters::shared_ptr gPreconditioner;
 static SharedNoiseModel gNoiseModel = noiseModel::Unit::Create(2);
 
 // parse options and read BAL file
 SfmData preamble(int argc, char* argv[]) {
   // primitive argument parsing:
+  const string usage =
+      "Usage: timeSFMBALxxx [--colamd | --schur-solver | --packed-pcg | "
+      "--pcg jacobi|ic0|ict|cluster] [BALfile]";
   if (argc > 2) {
-    if (strcmp(argv[1], "--colamd"))
+    if (!strcmp(argv[1], "--colamd"))
       gUseSchur = false;
-    else
-      throw runtime_error("Usage: timeSFMBALxxx [--colamd] [BALfile]");
+    else if (!strcmp(argv[1], "--schur-solver"))
+      gUseSchurSolver = true;
+    else if (!strcmp(argv[1], "--packed-pcg")) {
+      // Block-Jacobi PCG on the packed operator; smart factors use implicit Schur
+      gPackedPCG = true;
+      gPreconditioner = boost::make_shared<BlockJacobiPreconditionerParameters>();
+    }
+    else if (!strcmp(argv[1], "--pcg") && argc > 3) {
+      // PCG with the given preconditioner, to compare convergence and timing
+      const string preconditioner = argv[2];
+      if (preconditioner == "jacobi")
+        gPreconditioner = boost::make_shared<BlockJacobiPreconditionerParameters>();
+      else if (preconditioner == "ic0")
+        gPreconditioner = boost::make_shared<IncompleteCholeskyPreconditionerParameters>();
+      else if (preconditioner == "ict")
+        gPreconditioner =
+            boost::make_shared<IncompleteCholeskyPreconditionerParameters>(1e-3, 20);
+      else if (preconditioner == "cluster")
+        gPreconditioner = boost::make_shared<ClusterJacobiPreconditionerParameters>();
+      else
+        throw runtime_error(usage);
+    } else
+      throw runtime_error(usage);
   }
 
   // Load BAL file
@@ -56,6 +87,7 @@ SfmData preamble(int argc, char* argv[]) {
     filename = findExampleDataFile("dubrovnik-16-22106-pre");
   bool success = readBAL(filename, db);
   if (!success) throw runtime_error("Could not access file!");
+  cout << "initial reprojection error: " << totalReprojectionError(db) << endl;
   return db;
 }
 
@@ -70,7 +102,21 @@ int optimize(const SfmData& db, const NonlinearFactorGraph& graph,
 //  params.setLinearSolverType("SEQUENTIAL_CHOLESKY");
 //  params.setVerbosityLM("SUMMARY");
 
-  if (gUseSchur) {
+  if (gPreconditioner) {
+    // Levenberg-Marquardt with PCG as inner solver
+    params.linearSolverType = NonlinearOptimizerParams::Iterative;
+    auto pcg = boost::make_shared<PCGSolverParameters>();
+    pcg->preconditioner_ = gPreconditioner;
+    if (gPackedPCG) pcg->setBlasKernel(ConjugateGradientParameters::PACKED);
+    params.iterativeParams = pcg;
+  } else if (gUseSchurSolver) {
+    // Eliminate all points in parallel and solve the reduced camera system
+    params.linearSolverType = NonlinearOptimizerParams::SCHUR_COMPLEMENT;
+    auto schurParams = boost::make_shared<SchurComplementSolverParameters>();
+    for (size_t j = 0; j < db.number_tracks(); j++)
+      schurParams->points.insert(P(j));
+    params.setSchurParams(schurParams);
+  } else if (gUseSchur) {
     // Create Schur-complement ordering
     Ordering ordering;
     for (size_t j = 0; j < db.number_tracks(); j++) ordering.push_back(P(j));
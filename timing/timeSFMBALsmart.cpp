@@ -33,10 +33,12 @@ int main(int argc, char* argv[]) {
   // parse options and read BAL file
   SfmData db = preamble(argc, argv);
 
-  // Add smart factors to graph
+  // Add smart factors to graph, linearizing to implicit Schur factors for the
+  // packed PCG and to explicit Hessians otherwise
   NonlinearFactorGraph graph;
+  const SmartProjectionParams smartParams(gPackedPCG ? IMPLICIT_SCHUR : HESSIAN);
   for (size_t j = 0; j < db.number_tracks(); j++) {
-    auto smartFactor = boost::make_shared<SfmFactor>(gNoiseModel);
+    auto smartFactor = boost::make_shared<SfmFactor>(gNoiseModel, smartParams);
     for (const SfmMeasurement& m : db.tracks[j].measurements) {
       size_t i = m.first;
       Point2 z = m.second;
@@ -51,5 +53,40 @@ int main(int argc, char* argv[]) {
   for (const SfmCamera& camera : db.cameras)
     initial.insert(C(i++), camera);
 
+  // Compare the dynamic Schur complement with the fixed-size one used by
+  // linearize, on all smart factors at the initial estimate
+  {
+    vector<SfmFactor::Cameras> cameras;
+    for (const auto& factor : graph) {
+      auto smartFactor = boost::static_pointer_cast<SfmFactor>(factor);
+      cameras.push_back(smartFactor->cameras(initial));
+      smartFactor->triangulateSafe(cameras.back());
+    }
+    for (size_t trial = 0; trial < 10; trial++) {
+      gttic_(linearize_dynamic_Schur);
+      for (size_t j = 0; j < graph.size(); j++) {
+        auto smartFactor = boost::static_pointer_cast<SfmFactor>(graph[j]);
+        const TriangulationResult point = smartFactor->point();
+        if (!point) continue;
+        SfmFactor::FBlocks Fs;
+        Matrix E;
+        Vector b;
+        smartFactor->computeJacobians(Fs, E, b, cameras[j], *point);
+        smartFactor->whitenJacobians(Fs, E, b);
+        boost::make_shared<RegularHessianFactor<9> >(
+            smartFactor->keys(), SfmFactor::Cameras::SchurComplement(Fs, E, b));
+      }
+      gttoc_(linearize_dynamic_Schur);
+      gttic_(linearize_fixed_Schur);
+      for (size_t j = 0; j < graph.size(); j++) {
+        auto smartFactor = boost::static_pointer_cast<SfmFactor>(graph[j]);
+        const TriangulationResult point = smartFactor->point();
+        if (point)
+          smartFactor->createFixedHessianFactor(cameras[j], *point);
+      }
+      gttoc_(linearize_fixed_Schur);
+    }
+  }
+
   return optimize(db, graph, initial);
 }
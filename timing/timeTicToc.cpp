@@ -0,0 +1,60 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    timeTicToc.cpp
+ * @brief   Time the overhead of gttic_/gttoc_ scopes, serially and in threads
+ * @date    October 2026
+ */
+
+#include <gtsam/base/timing.h>
+
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace gtsam;
+
+/// Nanoseconds per empty timed scope, in n iterations of a loop
+static double scopeOverhead(size_t n) {
+  const auto start = chrono::steady_clock::now();
+  for (size_t i = 0; i < n; i++) {
+    gttic_(emptyScope);
+  }
+  return chrono::duration<double, nano>(chrono::steady_clock::now() - start)
+             .count() / n;
+}
+
+int main(int argc, char* argv[]) {
+  const size_t n = argc > 1 ? atoi(argv[1]) : 10000000;
+
+  cout << "gttic_/gttoc_ scope: " << scopeOverhead(n) << " ns" << endl;
+
+  tictoc_enableTrace_();
+  cout << "with tracing:        " << scopeOverhead(n / 10) << " ns" << endl;
+  tictoc_enableTrace_(false);
+  tictoc_reset_();
+
+  const size_t nrThreads = max(2u, thread::hardware_concurrency());
+  vector<double> overhead(nrThreads);
+  vector<thread> threads;
+  for (size_t t = 0; t < nrThreads; t++)
+    threads.emplace_back([&, t] { overhead[t] = scopeOverhead(n / nrThreads); });
+  for (thread& t : threads) t.join();
+  cout << nrThreads << " threads:";
+  for (double ns : overhead) cout << " " << ns;
+  cout << " ns" << endl;
+
+  tictoc_print_();
+  return 0;
+}
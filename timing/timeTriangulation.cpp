@@ -0,0 +1,101 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    timeTriangulation.cpp
+ * @brief   Time triangulateSafe per track against triangulateBatch
+ * @date    October 2026
+ */
+
+#include <gtsam/geometry/Cal3_S2.h>
+#include <gtsam/geometry/triangulation.h>
+
+#include <chrono>
+#include <iostream>
+#include <random>
+
+using namespace std;
+using namespace gtsam;
+
+typedef PinholeCamera<Cal3_S2> Camera;
+
+/// Wall-clock seconds taken by f
+template <typename F>
+static double seconds(const F& f) {
+  const auto start = chrono::steady_clock::now();
+  f();
+  return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char* argv[]) {
+  const size_t nrTracks = argc > 1 ? atoi(argv[1]) : 10000;
+  const size_t nrCameras = 50, trackLength = 5;
+#ifdef GTSAM_USE_TBB
+  cout << "Parallel with TBB" << endl;
+#else
+  cout << "Serial, configure with GTSAM_WITH_TBB to time parallel use" << endl;
+#endif
+
+  // Cameras on a circle looking at the origin, points around the origin
+  const Cal3_S2 K(500, 500, 0, 320, 240);
+  CameraSet<Camera> cameras;
+  for (size_t i = 0; i < nrCameras; i++) {
+    const double theta = 2 * M_PI * i / nrCameras;
+    cameras.emplace_back(PinholeBase::LookatPose(
+                             Point3(10 * cos(theta), 10 * sin(theta), 1),
+                             Point3(0, 0, 0), Point3(0, 0, 1)),
+                         K);
+  }
+  std::mt19937 rng(42);
+  std::uniform_real_distribution<double> position(-2.0, 2.0), pixel(-0.5, 0.5);
+  std::uniform_int_distribution<size_t> start(0, nrCameras - 1);
+  TriangulationTracks tracks;
+  for (size_t j = 0; j < nrTracks; j++) {
+    const Point3 landmark(position(rng), position(rng), position(rng));
+    const size_t first = start(rng);
+    for (size_t k = 0; k < trackLength; k++) {
+      const size_t i = (first + k) % nrCameras;
+      tracks.addObservation(
+          i, cameras[i].project(landmark) + Point2(pixel(rng), pixel(rng)));
+    }
+    tracks.endTrack();
+  }
+
+  for (bool refine : {false, true}) {
+    const TriangulationParameters params(1e-9, refine, -1, 10);
+    cout << (refine ? "DLT and refinement" : "DLT only") << endl;
+
+    size_t nrValid = 0;
+    const double perTrack = seconds([&] {
+      for (size_t j = 0; j < tracks.size(); j++) {
+        CameraSet<Camera> trackCameras;
+        Point2Vector measured;
+        for (size_t k = tracks.offsets[j]; k < tracks.offsets[j + 1]; k++) {
+          trackCameras.push_back(cameras[tracks.cameras[k]]);
+          measured.push_back(tracks.measurements[k]);
+        }
+        nrValid += triangulateSafe(trackCameras, measured, params).valid();
+      }
+    });
+    cout << "  triangulateSafe:  " << 1e9 * perTrack / nrTracks
+         << " nanosecs/track, " << nrValid << " valid" << endl;
+
+    nrValid = 0;
+    const double batch = seconds([&] {
+      for (const TriangulationResult& result :
+           triangulateBatch(cameras, tracks, params))
+        nrValid += result.valid();
+    });
+    cout << "  triangulateBatch: " << 1e9 * batch / nrTracks
+         << " nanosecs/track, " << nrValid << " valid" << endl;
+  }
+  return 0;
+}
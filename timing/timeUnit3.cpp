@@ -0,0 +1,109 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    timeUnit3.cpp
+ * @brief   Time the cached Unit3 basis under concurrent use, and parallel
+ *          linearization of a direction graph the size of a
+ *          TranslationRecovery problem.
+ * @date    October 2026
+ */
+
+#include <gtsam/base/parallelFor.h>
+#include <gtsam/geometry/Unit3.h>
+#include <gtsam/nonlinear/NonlinearFactor.h>
+#include <gtsam/nonlinear/NonlinearFactorGraph.h>
+#include <gtsam/nonlinear/Values.h>
+
+#include <chrono>
+#include <iostream>
+#include <random>
+
+using namespace std;
+using namespace gtsam;
+
+/// Error between two directions, every linearization goes through basis()
+class DirectionFactor : public NoiseModelFactor2<Unit3, Unit3> {
+ public:
+  DirectionFactor(Key a, Key b, const SharedNoiseModel& model)
+      : NoiseModelFactor2<Unit3, Unit3>(model, a, b) {}
+
+  Vector evaluateError(const Unit3& a, const Unit3& b,
+                       boost::optional<Matrix&> H1 = boost::none,
+                       boost::optional<Matrix&> H2 = boost::none) const override {
+    return a.errorVector(b, H1, H2);
+  }
+};
+
+/// Wall-clock seconds taken by f
+template <typename F>
+static double seconds(const F& f) {
+  const auto start = chrono::steady_clock::now();
+  f();
+  return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char* argv[]) {
+  const size_t nrDirections = argc > 1 ? atoi(argv[1]) : 2000;
+  const size_t nrFactors = argc > 2 ? atoi(argv[2]) : 50000;
+  const size_t nrTrials = 10;
+#ifdef GTSAM_USE_TBB
+  cout << "Parallel with TBB" << endl;
+#else
+  cout << "Serial, configure with GTSAM_WITH_TBB to time parallel use" << endl;
+#endif
+
+  std::mt19937 rng(42);
+  Values values;
+  for (size_t j = 0; j < nrDirections; j++)
+    values.insert(j, Unit3::Random(rng));
+
+  // Many threads hammering a few shared directions
+  {
+    vector<Unit3> shared;
+    for (size_t j = 0; j < 16; j++) shared.push_back(Unit3::Random(rng));
+    const size_t n = 10000000;
+    const double t = seconds([&] {
+      parallelFor(n, [&](size_t i) {
+        Matrix62 H;
+        shared[i % 16].basis(H);
+      });
+    });
+    cout << "basis(H) on 16 shared directions: " << 1e9 * t / n
+         << " nanosecs/call" << endl;
+  }
+
+  // Direction graph, with many factors per direction
+  NonlinearFactorGraph graph;
+  auto model = noiseModel::Isotropic::Sigma(2, 0.01);
+  std::uniform_int_distribution<size_t> pick(0, nrDirections - 1);
+  for (size_t k = 0; k < nrFactors; k++) {
+    const size_t a = pick(rng), b = pick(rng);
+    if (a != b) graph.emplace_shared<DirectionFactor>(a, b, model);
+  }
+  cout << graph.size() << " factors on " << nrDirections << " directions"
+       << endl;
+
+  // Fresh values every trial, so the basis caches start empty
+  double cold = 0.0, warm = 0.0;
+  for (size_t trial = 0; trial < nrTrials; trial++) {
+    Values fresh;
+    for (size_t j = 0; j < nrDirections; j++)
+      fresh.insert(j, Unit3(values.at<Unit3>(j).point3()));
+    cold += seconds([&] { graph.linearize(fresh); });
+    warm += seconds([&] { graph.linearize(fresh); });
+  }
+  cout << "linearize, empty caches:  " << 1e3 * cold / nrTrials
+       << " milliseconds" << endl;
+  cout << "linearize, filled caches: " << 1e3 * warm / nrTrials
+       << " milliseconds" << endl;
+  return 0;
+}
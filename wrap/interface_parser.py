@@ -54,6 +54,8 @@ CONST, VIRTUAL, CLASS, STATIC, PAIR, TEMPLATE, TYPEDEF, INCLUDE = map(
     ],
 )
 NAMESPACE = Keyword("namespace")
+# Annotation for methods and functions which may run without the Python GIL
+RELEASE_GIL = Literal("[[") + Keyword("release_gil") + Literal("]]")
 BASIS_TYPES = map(
     Keyword,
     [
@@ -355,6 +357,7 @@ class Template(object):
 class Method(object):
     rule = (
         Optional(Template.rule("template"))
+        + Optional(RELEASE_GIL("release_gil"))
         + ReturnType.rule("return_type")
         + IDENT("name")
         + LPAREN
@@ -364,16 +367,19 @@ class Method(object):
         + SEMI_COLON  # BR
     ).setParseAction(
         lambda t: Method(
-            t.template, t.name, t.return_type, t.args_list, t.is_const
+            t.template, t.name, t.return_type, t.args_list, t.is_const,
+            release_gil=bool(t.release_gil)
         )
     )
 
-    def __init__(self, template, name, return_type, args, is_const, parent=''):
+    def __init__(self, template, name, return_type, args, is_const, parent='',
+                 release_gil=False):
         self.template = template
         self.name = name
         self.return_type = return_type
         self.args = args
         self.is_const = is_const
+        self.release_gil = release_gil
 
         self.parent = parent
 
@@ -389,7 +395,8 @@ class Method(object):
 
 class StaticMethod(object):
     rule = (
-        STATIC
+        Optional(RELEASE_GIL("release_gil"))
+        + STATIC
         + ReturnType.rule("return_type")
         + IDENT("name")
         + LPAREN
@@ -397,13 +404,15 @@ class StaticMethod(object):
         + RPAREN
         + SEMI_COLON  # BR
     ).setParseAction(
-        lambda t: StaticMethod(t.name, t.return_type, t.args_list)
+        lambda t: StaticMethod(t.name, t.return_type, t.args_list,
+                               release_gil=bool(t.release_gil))
     )
 
-    def __init__(self, name, return_type, args, parent=''):
+    def __init__(self, name, return_type, args, parent='', release_gil=False):
         self.name = name
         self.return_type = return_type
         self.args = args
+        self.release_gil = release_gil
 
         self.parent = parent
 
@@ -608,21 +617,25 @@ class ForwardDeclaration(object):
 
 class GlobalFunction(object):
     rule = (
-        ReturnType.rule("return_type")
+        Optional(RELEASE_GIL("release_gil"))
+        + ReturnType.rule("return_type")
         + IDENT("name")
         + LPAREN
         + ArgumentList.rule("args_list")
         + RPAREN
         + SEMI_COLON
     ).setParseAction(
-        lambda t: GlobalFunction(t.name, t.return_type, t.args_list)
+        lambda t: GlobalFunction(t.name, t.return_type, t.args_list,
+                                 release_gil=bool(t.release_gil))
     )
 
-    def __init__(self, name, return_type, args_list, parent=''):
+    def __init__(self, name, return_type, args_list, parent='',
+                 release_gil=False):
         self.name = name
         self.return_type = return_type
         self.args = args_list
         self.is_const = None
+        self.release_gil = release_gil
 
         self.parent = parent
         self.return_type.parent = self
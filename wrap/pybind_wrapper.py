@@ -98,7 +98,7 @@ class PybindWrapper(object):
                '[]({opt_self}{opt_comma}{args_signature_with_names}){{'
                '{function_call}'
                '}}'
-               '{py_args_names}){suffix}'.format(
+               '{py_args_names}{call_guard}){suffix}'.format(
                    prefix=prefix,
                    cdef="def_static" if is_static else "def",
                    py_method=py_method if not py_method in self.python_keywords else py_method + "_",
@@ -109,6 +109,8 @@ class PybindWrapper(object):
                    args_signature_with_names=args_signature_with_names,
                    function_call=function_call,
                    py_args_names=py_args_names,
+                   call_guard=', py::call_guard<py::gil_scoped_release>()'
+                   if getattr(method, 'release_gil', False) else '',
                    suffix=suffix,
                ))
         if method.name == 'print':
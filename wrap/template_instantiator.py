@@ -104,6 +104,7 @@ class InstantiatedMethod(parser.Method):
         self.instantiation = instantiation
         self.template = ''
         self.is_const = original.is_const
+        self.release_gil = original.release_gil
         self.parent = original.parent
 
         if not original.template:
@@ -240,6 +241,7 @@ class InstantiatedClass(parser.Class):
                     ),
                     args=parser.ArgumentList(instantiated_args),
                     parent=self,
+                    release_gil=static_method.release_gil,
                 )
             )
         return instantiated_static_methods
@@ -270,6 +272,7 @@ class InstantiatedClass(parser.Class):
                 args=parser.ArgumentList(instantiated_args),
                 is_const=method.is_const,
                 parent=self,
+                release_gil=method.release_gil,
             ))
         return class_instantiated_methods
 
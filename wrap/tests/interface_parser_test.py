@@ -15,6 +15,19 @@ class TestPyparsing(unittest.TestCase):
         args = ArgumentList.rule.parseString(arg_string)
         print(ArgumentList(args))
 
+    def test_release_gil(self):
+        method = Method.rule.parseString(
+            "[[release_gil]] gtsam::Values optimize();")[0]
+        self.assertTrue(method.release_gil)
+        self.assertEqual(method.name, "optimize")
+        self.assertFalse(Method.rule.parseString("int f() const;")[0].release_gil)
+        static_method = StaticMethod.rule.parseString(
+            "[[release_gil]] static int f(const Class& c);")[0]
+        self.assertTrue(static_method.release_gil)
+        function = GlobalFunction.rule.parseString(
+            "[[release_gil]] void load(string filename);")[0]
+        self.assertTrue(function.release_gil)
+
 
 empty_args = ArgumentList.rule.parseString("")[0]
 print(empty_args)
@@ -256,3 +269,6 @@ print(found_class.name)
 found_class = module.find_class(
     Typename(namespaces_name=['one', 'two', 'Class12a']))
 print(found_class.name)
+
+if __name__ == '__main__':
+    unittest.main()